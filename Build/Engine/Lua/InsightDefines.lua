@@ -18,6 +18,8 @@ function InsightDefines.All()
 
         "IS_PLATFORM_X64",
         "IS_MEMORY_TRACKING",
+        --"IS_ENGINE_HEAP",
+        "IS_OBJECT_POOLS",
         "IS_ENGINE",
         "RENDER_GRAPH_ENABLED",
         "TOBJECTPTR_REF_COUNTING",
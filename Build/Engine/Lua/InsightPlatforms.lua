@@ -12,6 +12,8 @@ function InsightPlatforms.All()
             "IS_MATHS_DIRECTX_MATHS",
             --"IS_MATHS_CONSTRUCTOR_GLM",
             --"IS_MATHS_GLM",
+            -- SSE4.1/AVX2 maths backend, replaces IS_MATHS_DIRECTX_MATHS. Add vectorextensions("AVX2") for the AVX2 paths.
+            --"IS_MATHS_SIMD",
             "IS_DX12_ENABLED",
             "IS_CPP_WINRT",
 
@@ -182,4 +182,6 @@ workspace "InsightTools"
         }
 
 
-include "../../Engine/Tools/AssetPacker/premake.lua"
\ No newline at end of file
+include "../../Engine/Tools/AssetPacker/premake.lua"
+include "../../Engine/Tools/MathsBenchmark/premake.lua"
+include "../../Engine/Tools/OcclusionCullingBenchmark/premake.lua"
\ No newline at end of file
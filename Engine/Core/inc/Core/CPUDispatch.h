@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+#include "Core/CPUInformation.h"
+
+#include <string_view>
+
+namespace Insight
+{
+	namespace Core
+	{
+		/// @brief Instruction sets vectorised kernels can be built for, lowest to highest.
+		enum class CPUInstructionSet : u8
+		{
+			Scalar,
+			SSE42,
+			AVX2,
+			AVX512,
+
+			Count
+		};
+		constexpr const char* CPUInstructionSetToString(const CPUInstructionSet instructionSet)
+		{
+			switch (instructionSet)
+			{
+			case CPUInstructionSet::Scalar: return "Scalar";
+			case CPUInstructionSet::SSE42:  return "SSE4.2";
+			case CPUInstructionSet::AVX2:   return "AVX2";
+			case CPUInstructionSet::AVX512: return "AVX512";
+			default:
+				break;
+			}
+			return "Unknown";
+		}
+		/// @brief Parse "scalar", "sse4.2", "avx2" or "avx512" (any case).
+		/// @return CPUInstructionSet::Count if 'str' is not an instruction set.
+		IS_CORE CPUInstructionSet CPUInstructionSetFromString(std::string_view str);
+
+		/// @brief Selects which variant of the vectorised kernels runs. The active instruction set is the highest one the
+		/// CPU supports, unless an override lowers it (to benchmark or test each variant on one machine).
+		class IS_CORE CPUDispatch
+		{
+		public:
+			using OnChangedFunc = void(*)(const CPUInstructionSet instructionSet);
+
+			/// @brief Find the highest supported instruction set from 'cpuInformation' and make it active.
+			static void Initialise(const CPUInformation& cpuInformation);
+
+			static CPUInstructionSet GetSupported();
+			static CPUInstructionSet GetActive();
+
+			/// @brief Run kernels for 'instructionSet', clamped to what the CPU supports.
+			/// @return The instruction set now active.
+			static CPUInstructionSet SetOverride(const CPUInstructionSet instructionSet);
+			/// @brief Go back to the highest supported instruction set.
+			static void ClearOverride();
+
+			/// @brief Called straight away with the active instruction set and again whenever it changes. Used by modules
+			/// which don't depend on Core (e.g. Maths) to follow the selection.
+			static void AddOnChangedCallback(OnChangedFunc callback);
+		};
+	}
+}
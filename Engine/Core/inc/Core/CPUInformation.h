@@ -56,6 +56,16 @@ namespace Insight
             bool IsSSE42 = false;
             bool IsAVX = false;
             bool IsAVX2 = false;
+            /// @brief AVX-512 Foundation.
+            bool IsAVX512F = false;
+            /// @brief AVX-512 Conflict Detection.
+            bool IsAVX512CD = false;
+            /// @brief AVX-512 Byte and Word.
+            bool IsAVX512BW = false;
+            /// @brief AVX-512 Doubleword and Quadword.
+            bool IsAVX512DQ = false;
+            /// @brief AVX-512 Vector Length extensions.
+            bool IsAVX512VL = false;
 
             bool Initialised = false;
         };
@@ -2,12 +2,14 @@
 
 #include "Core/Defines.h"
 #include "Memory/MemoryAllocCategory.h"
+#include "Memory/ObjectPool.h"
 
 #include <memory>
 #include <atomic>
 #include <type_traits>
 #include <utility>
 #include <cassert>
+#include <new>
 
 /// Helper macro for making a new pointer with tracking.
 #define NewTracked(Type)			::New<Type>()
@@ -31,6 +33,11 @@ namespace Insight::Memory
 	}
 
 	IS_CORE void MemoryUnTrackPtr(void* ptr);
+
+	/// @brief Untracked allocation from the engine heap if 'IS_ENGINE_HEAP' is defined, otherwise the CRT.
+	NO_DISCARD IS_CORE void* HeapAllocate(const u64 size);
+	NO_DISCARD IS_CORE void* HeapReallocate(void* ptr, const u64 size);
+	IS_CORE void HeapFree(void* ptr);
 }
 
 NO_DISCARD IS_CORE void* NewBytes(u64 bytes, Insight::Core::MemoryAllocCategory memoryAllocCategory);
@@ -90,7 +97,7 @@ FORCE_INLINE void DeleteBytes(T*& pointer)
 	if (pointer != nullptr)
 	{
 		Insight::Memory::MemoryUnTrackPtr(pointer);
-		std::free(pointer);
+		Insight::Memory::HeapFree(pointer);
 	}
 	pointer = nullptr;
 }
@@ -109,7 +116,7 @@ FORCE_INLINE void* ReallocBytes(void* bytes, const u64 newSize)
 		return nullptr;
 	}
 	Insight::Memory::MemoryUnTrackPtr(memory);
-	memory = (u8*)std::realloc(memory, newSize);
+	memory = (u8*)Insight::Memory::HeapReallocate(memory, newSize);
 	Insight::Memory::MemoryTrackPtr(memory, newSize);
 	assert(memory != nullptr);
 	return memory;
@@ -129,6 +136,16 @@ namespace Insight
 	class RefCount
 	{
 	public:
+		IS_POOLED_OBJECT(RefCount);
+
+		using DestroyInlineFunc = void(*)(RefCount*);
+
+		RefCount() = default;
+		/// @brief Used by 'RefCountInline', 'destroyInline' destroys the object and frees the shared allocation.
+		explicit RefCount(DestroyInlineFunc destroyInline)
+			: m_destroyInline(destroyInline)
+		{ }
+
 		int Inc() { return ++m_strongRefs; }
 		int Dec() { return --m_strongRefs; }
 		int IncW() { return ++m_weakRefs; }
@@ -138,9 +155,49 @@ namespace Insight
 		int GetCount() const { return m_strongRefs.load() + m_weakRefs.load(); }
 		void Reset() { m_strongRefs = 0; m_weakRefs = 0; }
 
+		/// @brief True if the object was created within the same allocation as this ref count (see 'MakeRPtr').
+		bool IsInline() const { return m_destroyInline != nullptr; }
+		/// @brief Destroy the inline object and free the allocation. This ref count is invalid afterwards.
+		void DestroyInline() { m_destroyInline(this); }
+
 	private:
 		std::atomic<int> m_strongRefs = 0;
 		std::atomic<int> m_weakRefs = 0;
+		DestroyInlineFunc m_destroyInline = nullptr;
+	};
+
+	/// @brief Ref count and object within a single allocation, created by 'MakeRPtr'.
+	/// Saves an allocation per object and keeps the count on the same cache lines as the object.
+	template<typename T>
+	class RefCountInline final : public RefCount
+	{
+	public:
+		IS_POOLED_OBJECT(RefCountInline);
+
+		template<typename... Args>
+		explicit RefCountInline(Args&&... args)
+			: RefCount(&RefCountInline::Destroy)
+		{
+			::new (&m_storage) T(std::forward<Args>(args)...);
+		}
+		RefCountInline(const RefCountInline&) = delete;
+		RefCountInline& operator=(const RefCountInline&) = delete;
+		~RefCountInline()
+		{
+			GetObject()->~T();
+		}
+
+		T* GetObject() { return std::launder(reinterpret_cast<T*>(&m_storage)); }
+
+	private:
+		static void Destroy(RefCount* refCount)
+		{
+			RefCountInline* block = static_cast<RefCountInline*>(refCount);
+			::Delete(block);
+		}
+
+	private:
+		alignas(T) unsigned char m_storage[sizeof(T)];
 	};
 }
 
@@ -346,16 +403,18 @@ public:
 	}
 	void Dec()
 	{
-		if (m_refCount)
-		{
-			m_refCount->Dec();
-		}
-
-		if (m_refCount && !m_refCount->HasRefs())
+		if (m_refCount && m_refCount->Dec() <= 0)
 		{
-			::Delete(m_ptr);
+			if (m_refCount->IsInline())
+			{
+				m_refCount->DestroyInline();
+			}
+			else
+			{
+				::Delete(m_ptr);
+				::Delete(m_refCount);
+			}
 			m_ptr = nullptr;
-			::Delete(m_refCount);
 			m_refCount = nullptr;
 		}
 	}
@@ -387,6 +446,15 @@ public:
 	bool IsValid() const { return Get() != nullptr; }
 	TPtr Get() const { return m_ptr; }
 
+private:
+	/// @brief Take a reference to an object already owned by 'refCount'.
+	RPtr(TPtr ptr, Insight::RefCount* refCount)
+	{
+		m_ptr = ptr;
+		m_refCount = refCount;
+		Inc();
+	}
+
 private:
 	TPtr m_ptr = nullptr;
 	Insight::RefCount* m_refCount = nullptr;
@@ -395,6 +463,8 @@ private:
 	friend class RPtr;
 	template<typename>
 	friend class WPtr;
+	template<typename TObject, Insight::Core::MemoryAllocCategory Category, typename... Args>
+	friend RPtr<TObject> MakeRPtr(Args&&... args);
 };
 
 //// <summary>
@@ -608,23 +678,18 @@ UPtr<T> MakeUPtr(Args&&... args)
 }
 
 //// <summary>
-//// Return a RPtr.
+//// Return a RPtr. The object and its ref count are created within a single allocation.
 //// </summary>
 //// <typeparam name="T"></typeparam>
+//// <typeparam name="Category">Memory category the allocation is tracked under.</typeparam>
 //// <typeparam name="...Args"></typeparam>
 //// <param name="...args"></param>
 //// <returns></returns>
-template<typename T, typename... Args>
+template<typename T, Insight::Core::MemoryAllocCategory Category = Insight::Core::MemoryAllocCategory::General, typename... Args>
 RPtr<T> MakeRPtr(Args&&... args)
 {
-	if constexpr (sizeof...(Args) > 0)
-	{
-		return RPtr<T>(New<T, Insight::Core::MemoryAllocCategory::General>(std::forward<Args>(args)...));
-	}
-	else
-	{
-		return RPtr<T>(New<T, Insight::Core::MemoryAllocCategory::General>());
-	}
+	Insight::RefCountInline<T>* block = New<Insight::RefCountInline<T>, Category>(std::forward<Args>(args)...);
+	return RPtr<T>(block->GetObject(), block);
 }
 
 
@@ -640,6 +705,15 @@ class TObjectPtr;
 class IS_CORE ReferenceCountObject
 {
 public:
+	using InlineFunc = void(*)(ReferenceCountObject*);
+
+	ReferenceCountObject() = default;
+	/// @brief Used by 'ReferenceCountObjectInline'. 'destroyObject' destroys the object, 'freeBlock' frees the shared allocation.
+	ReferenceCountObject(InlineFunc destroyObject, InlineFunc freeBlock)
+		: m_destroyObject(destroyObject)
+		, m_freeBlock(freeBlock)
+	{ }
+
 	int Incr() { return ++m_strongRef; }
 	int Decr() { return --m_strongRef; }
 
@@ -650,9 +724,61 @@ public:
 	int GetCount() const { return m_strongRef.load() + m_weakRef.load(); }
 	void Reset() { m_strongRef = 0; m_weakRef = 0; }
 
+	/// @brief True if the object was created within the same allocation as this ref count (see 'MakeTObject').
+	bool IsInline() const { return m_destroyObject != nullptr; }
+	/// @brief Destroy the inline object. The allocation stays alive until 'Release' as non owning pointers may still read the count.
+	void DestroyInlineObject() { m_destroyObject(this); }
+	/// @brief Free this ref count and, if inline, the allocation it shares with the object.
+	static void Release(ReferenceCountObject*& refCount)
+	{
+		if (refCount->IsInline())
+		{
+			refCount->m_freeBlock(refCount);
+			refCount = nullptr;
+		}
+		else
+		{
+			Delete(refCount);
+		}
+	}
+
 private:
 	std::atomic<int> m_strongRef = 0;
 	std::atomic<int> m_weakRef = 0;
+	InlineFunc m_destroyObject = nullptr;
+	InlineFunc m_freeBlock = nullptr;
+};
+
+/// @brief Ref count and object within a single allocation, created by 'MakeTObject'.
+/// The object is destroyed when the owning pointer is reset, the allocation once no 'TObjectPtr' references it.
+template<typename T>
+class ReferenceCountObjectInline final : public ReferenceCountObject
+{
+public:
+	template<typename... Args>
+	explicit ReferenceCountObjectInline(Args&&... args)
+		: ReferenceCountObject(&ReferenceCountObjectInline::DestroyObject, &ReferenceCountObjectInline::FreeBlock)
+	{
+		::new (&m_storage) T(std::forward<Args>(args)...);
+	}
+	ReferenceCountObjectInline(const ReferenceCountObjectInline&) = delete;
+	ReferenceCountObjectInline& operator=(const ReferenceCountObjectInline&) = delete;
+
+	T* GetObject() { return std::launder(reinterpret_cast<T*>(&m_storage)); }
+
+private:
+	static void DestroyObject(ReferenceCountObject* refCount)
+	{
+		static_cast<ReferenceCountObjectInline*>(refCount)->GetObject()->~T();
+	}
+	static void FreeBlock(ReferenceCountObject* refCount)
+	{
+		ReferenceCountObjectInline* block = static_cast<ReferenceCountObjectInline*>(refCount);
+		::Delete(block);
+	}
+
+private:
+	alignas(T) unsigned char m_storage[sizeof(T)];
 };
 
 /// <summary>
@@ -774,14 +900,25 @@ public:
 	{
 		if (m_ptr)
 		{
-			Delete(m_ptr);
+#ifdef TOBJECTPTR_REF_COUNTING
+			if (m_refCount
+				&& m_refCount->IsInline())
+			{
+				m_refCount->DestroyInlineObject();
+				m_ptr = nullptr;
+			}
+			else
+#endif // TOBJECTPTR_REF_COUNTING
+			{
+				Delete(m_ptr);
+			}
 		}
 #ifdef TOBJECTPTR_REF_COUNTING
 		Decr();
 		if (m_refCount
 			&& m_refCount->GetCount() == 0)
 		{
-			Delete(m_refCount);
+			ReferenceCountObject::Release(m_refCount);
 		}
 		m_refCount = nullptr;
 #endif // TOBJECTPTR_REF_COUNTING
@@ -815,6 +952,17 @@ private:
 	}
 
 
+private:
+#ifdef TOBJECTPTR_REF_COUNTING
+	/// @brief Take ownership of an object created within 'refCount'.
+	TObjectOwnPtr(Ptr pointer, ReferenceCountObject* refCount)
+	{
+		m_ptr = pointer;
+		m_refCount = refCount;
+		Incr();
+	}
+#endif // TOBJECTPTR_REF_COUNTING
+
 private:
 	Ptr m_ptr = nullptr;
 #ifdef TOBJECTPTR_REF_COUNTING
@@ -824,8 +972,23 @@ private:
 	friend class TObjectOwnPtr;
 	template<typename>
 	friend class TObjectPtr;
+	template<typename TObject, Insight::Core::MemoryAllocCategory Category, typename... Args>
+	friend TObjectOwnPtr<TObject> MakeTObject(Args&&... args);
 };
 
+/// @brief Create a 'TObjectOwnPtr'. With TOBJECTPTR_REF_COUNTING the object and its ref count are created within a single allocation.
+/// 'Category' is the memory category the allocation is tracked under.
+template<typename T, Insight::Core::MemoryAllocCategory Category = Insight::Core::MemoryAllocCategory::General, typename... Args>
+TObjectOwnPtr<T> MakeTObject(Args&&... args)
+{
+#ifdef TOBJECTPTR_REF_COUNTING
+	ReferenceCountObjectInline<T>* block = New<ReferenceCountObjectInline<T>, Category>(std::forward<Args>(args)...);
+	return TObjectOwnPtr<T>(block->GetObject(), block);
+#else
+	return TObjectOwnPtr<T>(New<T, Category>(std::forward<Args>(args)...));
+#endif // TOBJECTPTR_REF_COUNTING
+}
+
 /// <summary>
 /// Pointer warpper class to store a pointer which is derived from 'Object'.
 /// This is a non owning pointer.
@@ -1090,7 +1253,7 @@ public:
 		if (m_refCount 
 			&& m_refCount->GetCount() == 0)
 		{
-			Delete(m_refCount);
+			ReferenceCountObject::Release(m_refCount);
 		}
 		m_refCount = nullptr;
 #endif
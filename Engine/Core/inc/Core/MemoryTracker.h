@@ -7,6 +7,8 @@
 #include <unordered_map>
 #include <array>
 #include <mutex>
+#include <atomic>
+#include <string>
 
 //#undef IS_MEMORY_TRACKING
 
@@ -122,6 +124,13 @@ namespace Insight
 			constexpr __declspec(allocator) void* AllocateInternal(u64 align, const size_t _Bytes);
 		};
 
+		/// @brief Raw return addresses captured for a sampled allocation. Only symbolised when reported.
+		struct MemoryTrackedCallStack
+		{
+			std::array<void*, c_CallStackCount> ReturnAddresses = { };
+			u32 Count = 0;
+		};
+
 		struct IS_CORE MemoryTrackedAlloc
 		{
 			MemoryTrackedAlloc()
@@ -130,11 +139,12 @@ namespace Insight
 			MemoryTrackedAlloc(void* ptr, u64 size, MemoryAllocCategory category, MemoryTrackAllocationType type)
 				: Ptr(ptr), Size(size), Category(category), Type(type)
 			{ }
-			MemoryTrackedAlloc(void* ptr, u64 size, MemoryAllocCategory category, MemoryTrackAllocationType type, std::array<char[c_CallstackStringSize], c_CallStackCount> callStack)
-				: Ptr(ptr), Size(size), Category(category), Type(type), CallStack(std::move(callStack))
+			MemoryTrackedAlloc(void* ptr, u64 size, MemoryAllocCategory category, MemoryTrackAllocationType type, MemoryTrackedCallStack* callStack)
+				: Ptr(ptr), Size(size), Category(category), Type(type), CallStack(callStack)
 			{ }
 
-			std::array<char[c_CallstackStringSize], c_CallStackCount> CallStack;
+			/// @brief Only set for sampled allocations. Owned by the tracker.
+			MemoryTrackedCallStack* CallStack = nullptr;
 			void* Ptr;
 			u64 Size;
 			MemoryTrackAllocationType Type;
@@ -145,6 +155,16 @@ namespace Insight
 		{
 			THREAD_SAFE;
 		public:
+			/// @brief Number of independently locked partitions of the address table. Must be a power of two.
+			static constexpr u64 c_ShardCount = 64;
+#if defined(IS_DEBUG) || defined(IS_TESTING)
+			/// @brief Default number of bytes between sampled allocations. Debug builds capture every call stack.
+			static constexpr u64 c_DefaultSampleRate = 1;
+#else
+			/// @brief Default number of bytes between sampled allocations. 0 disables call stack capture.
+			static constexpr u64 c_DefaultSampleRate = 512_KB;
+#endif
+
 			~MemoryTracker();
 
 			static MemoryTracker& Instance()
@@ -163,6 +183,11 @@ namespace Insight
 
 			void NameAllocation(void* ptr, const char* name);
 
+			/// @brief Capture the return addresses of the allocation made after every 'sampleRate' bytes allocated on a thread.
+			/// Sizes and categories are tracked for every allocation regardless. 0 disables capture.
+			void SetSampleRate(u64 sampleRate);
+			u64 GetSampleRate() const;
+
 			/// @brief Get the memory usage for a category in bytes.
 			/// @param category 
 			/// @return u64
@@ -171,27 +196,102 @@ namespace Insight
 			/// @param category 
 			/// @return u64
 			u64 GetTotalNumberOfAllocationsForCategory(MemoryAllocCategory category) const;
+			/// @brief Get the memory usage of every category in bytes, reading each shard once.
+			/// @param usage 
+			void GetCategoryUsage(std::array<u64, static_cast<u64>(MemoryAllocCategory::Size)>& usage) const;
 			/// @brief Get the total number of allocations being tracked.
 			/// @return u64
 			u64 GetTotalNumberOfAllocations() const;
 			/// @brief Get the total amount of allocated bytes being tracked.
 			/// @return u64
 			u64 GetTotalAllocatedInBytes() const;
+			/// @brief Number of live allocations with a captured call stack.
+			/// @return u64
+			u64 GetTotalNumberOfSampledAllocations() const;
 
 			std::array<char[c_CallstackStringSize], c_CallStackCount> GetCallStack();
 
 		private:
-			std::unordered_map<void*, MemoryTrackedAlloc, std::hash<void*>, std::equal_to<void*>, STLNonTrackingAllocator<std::pair<void* const, MemoryTrackedAlloc>>> m_allocations;
+			/// @brief Open addressed (linear probing, backward shift deletion) table of allocations keyed by pointer.
+			/// Entries are stored inline so tracking an allocation doesn't allocate a node. Memory comes from 'NewNoTrack'.
+			class AllocationTable
+			{
+			public:
+				AllocationTable() = default;
+				AllocationTable(const AllocationTable&) = delete;
+				AllocationTable& operator=(const AllocationTable&) = delete;
+				~AllocationTable();
+
+				/// @brief Returns false if 'alloc.Ptr' is already tracked.
+				bool Insert(const MemoryTrackedAlloc& alloc);
+				MemoryTrackedAlloc* Find(const void* ptr) const;
+				void Erase(MemoryTrackedAlloc* alloc);
+				void Clear();
+
+				u64 GetSize() const { return m_count; }
+
+				template<typename Func>
+				void ForEach(Func&& func)
+				{
+					for (u64 i = 0; i < m_capacity; ++i)
+					{
+						if (IsOccupied(m_slots[i]))
+						{
+							func(m_slots[i]);
+						}
+					}
+				}
+
+			private:
+				static bool IsOccupied(const MemoryTrackedAlloc& slot) { return slot.Ptr != nullptr; }
+				u64 GetSlotIndex(const void* ptr) const;
+				void Rehash(const u64 newCapacity);
+
+			private:
+				MemoryTrackedAlloc* m_slots = nullptr;
+				u64 m_capacity = 0;
+				u64 m_count = 0;
+			};
+
+			/// @brief One partition of the address table. Each shard keeps its own totals so the hot path never
+			/// touches shared counters, they are summed when read.
+			struct alignas(64) Shard
+			{
+				mutable std::mutex Lock;
+				AllocationTable Allocations;
+				std::array<u64, static_cast<u64>(MemoryAllocCategory::Size)> CategoryAllocationSizeBytes = { };
+				std::array<u64, static_cast<u64>(MemoryAllocCategory::Size)> CategoryAllocationCount = { };
+				u64 SampledAllocationCount = 0;
+			};
+
+			Shard& GetShard(const void* ptr);
+			/// @brief Returns true if the allocation should have its call stack captured. Thread local, lock free.
+			bool ShouldSample(const u64 size) const;
+			MemoryTrackedCallStack* CaptureCallStack() const;
+			void SymboliseCallStack(const MemoryTrackedCallStack& callStack, std::array<char[c_CallstackStringSize], c_CallStackCount>& callStackStrings);
+			void ReleaseCallStack(MemoryTrackedCallStack*& callStack) const;
+
+			template<typename Func>
+			u64 SumShards(Func&& func) const
+			{
+				u64 total = 0;
+				for (const Shard& shard : m_shards)
+				{
+					std::lock_guard lock(shard.Lock);
+					total += func(shard);
+				}
+				return total;
+			}
+
+		private:
+			std::array<Shard, c_ShardCount> m_shards;
 			std::unordered_map<void*, std::string> m_allocationToName;
 			mutable std::mutex m_allocationToNameLock;
 
+			std::mutex m_symbolLock;
 			bool m_symInitialize = false;
-			bool m_isReady = false;
-
-			mutable std::mutex m_lock;
-			u64 m_totalAllocatedInBytes = 0;
-			std::array<u64, static_cast<u64>(MemoryAllocCategory::Size)> m_categoryAllocationSizeBytes;
-			std::array<u64, static_cast<u64>(MemoryAllocCategory::Size)> m_categoryAllocationCount;
+			std::atomic<bool> m_isReady = false;
+			std::atomic<u64> m_sampleRate = c_DefaultSampleRate;
 		};
 	}
 }
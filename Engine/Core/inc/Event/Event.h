@@ -2,6 +2,7 @@
 
 #include "Core/Defines.h"
 #include "Core/TypeAlias.h"
+#include "Memory/MemoryBudget.h"
 
 namespace Insight
 {
@@ -24,6 +25,8 @@ namespace Insight
 			HotReloadLibraryUnLoaded,
 			HotReloadLibraryLoaded,
 
+			MemoryPressure,
+
 			Size
 		};
 
@@ -43,6 +46,8 @@ namespace Insight
 
 			false,	// HotReloadLibraryUnLoaded
 			false,	// HotReloadLibraryLoaded
+
+			true,	// MemoryPressure
 		};
 		static_assert(ARRAY_COUNT(EventTypeMultiplePerFrame) == static_cast<u64>(EventType::Size));
 
@@ -131,5 +136,23 @@ namespace Insight
 
 			std::string ProjectPath;
 		};
+
+		/// @brief A category's 'MemoryBudget' pressure level has changed. 'LimitBytes' is the limit which was crossed,
+		/// 0 when the level has dropped to 'None'.
+		struct IS_CORE MemoryPressureEvent : public Event
+		{
+			MemoryPressureEvent() { }
+			MemoryPressureEvent(MemoryAllocCategory category, MemoryPressureLevel level, u64 usageBytes, u64 limitBytes)
+				: Category(category), Level(level), UsageBytes(usageBytes), LimitBytes(limitBytes)
+			{ }
+
+			virtual std::string GetName() override { return "MemoryPressureEvent"; }
+			virtual EventType GetEventType() override { return EventType::MemoryPressure; }
+
+			MemoryAllocCategory Category = MemoryAllocCategory::General;
+			MemoryPressureLevel Level = MemoryPressureLevel::None;
+			u64 UsageBytes = 0;
+			u64 LimitBytes = 0;
+		};
 	}
 }
\ No newline at end of file
@@ -4,7 +4,9 @@
 #include "Core/ISysytem.h"
 #include "Event/Event.h"
 #include "Core/Memory.h"
+#include "Threading/MPMCQueue.h"
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #include <functional>
@@ -41,8 +43,13 @@ namespace Insight
 		private:
 			std::mutex m_eventListenersLock;
 			std::unordered_map<EventType, std::unordered_map<void*, EventFunc>> m_eventListeners;
-			std::mutex m_queuedEventsLock;
-			std::vector<RPtr<Event>> m_queuedEvents;
+			/// @brief Number of events which can be queued between updates without taking a lock.
+			static constexpr u64 c_QueuedEventCapacity = 4096;
+			Threading::MPMCQueue<RPtr<Event>, c_QueuedEventCapacity> m_queuedEvents;
+			/// @brief Events dispatched once 'm_queuedEvents' is full. Evaluated after 'm_queuedEvents' to keep ordering.
+			std::mutex m_overflowEventsLock;
+			std::vector<RPtr<Event>> m_overflowEvents;
+			std::atomic<bool> m_hasOverflowEvents = false;
 		};
 	}
 }
\ No newline at end of file
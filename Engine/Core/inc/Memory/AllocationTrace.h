@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+
+#include <atomic>
+#include <string_view>
+#include <vector>
+
+namespace Insight::Core
+{
+	/// @brief Single allocation or free recorded by 'AllocationTrace'.
+	struct AllocationTraceEvent
+	{
+		enum class Types : u8
+		{
+			Allocate,
+			Free
+		};
+
+		/// @brief Sequential id of the allocation, shared between its allocate and free events.
+		u64 AllocationId = 0;
+		u64 Size = 0;
+		/// @brief Index of the thread the event happened on, in order of first appearance.
+		u32 ThreadIndex = 0;
+		Types Type = Types::Allocate;
+	};
+
+	/// @brief Records every tracked allocation and free between 'Start' and 'Stop' so the allocation pattern of a
+	/// real frame can be saved and replayed by allocator benchmarks. Recording takes a lock per event, it is not
+	/// meant to be left on.
+	class IS_CORE AllocationTrace
+	{
+	public:
+		static void Start();
+		static void Stop();
+		static bool IsRecording() { return s_recording.load(std::memory_order_relaxed); }
+
+		static void RecordAllocation(const void* ptr, const u64 size);
+		static void RecordFree(const void* ptr);
+
+		/// @brief Events from the last recording, in the order they happened. Frees of allocations made before
+		/// 'Start' are dropped.
+		static std::vector<AllocationTraceEvent> GetEvents();
+
+		static bool Save(std::string_view filePath);
+		static bool Load(std::string_view filePath, std::vector<AllocationTraceEvent>& events);
+
+	private:
+		static std::atomic<bool> s_recording;
+	};
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+#include "Core/NonCopyable.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Insight::Core
+{
+	struct EngineHeapSpan;
+	struct EngineHeapThread;
+
+	/// @brief Heap usage, gathered under the heap's global lock.
+	struct EngineHeapStats
+	{
+		/// @brief Address space reserved for small allocations.
+		u64 ReservedBytes = 0;
+		/// @brief Address space committed for spans.
+		u64 CommittedBytes = 0;
+		/// @brief Spans currently owned by a thread or abandoned.
+		u64 SpanCount = 0;
+		/// @brief Committed spans waiting to be given to a thread.
+		u64 FreeSpanCount = 0;
+		/// @brief Spans left behind by threads which have exited, waiting to be adopted.
+		u64 AbandonedSpanCount = 0;
+	};
+
+	/// @brief General purpose heap used by 'NewBytes' when 'IS_ENGINE_HEAP' is defined.
+	/// Allocations up to 'c_MaxSmallSize' come from 64KB spans carved into blocks of one size class. Each thread
+	/// owns its own spans so allocating and freeing on the owning thread takes no locks or atomics. Freeing a block
+	/// owned by another thread pushes it onto the span's lock free remote list, which the owner collects when it runs
+	/// out of local blocks. Spans of exited threads are abandoned and adopted by the next thread to need that size class.
+	/// Larger allocations go to the CRT.
+	class IS_CORE EngineHeap : NonCopyable
+	{
+	public:
+		static constexpr u64 c_SpanSize = 64_KB;
+		static constexpr u64 c_SpanHeaderSize = 128;
+		static constexpr u64 c_MaxSmallSize = 16_KB;
+		static constexpr u32 c_SizeClassCount = 36;
+		/// @brief Every block is aligned to at least this.
+		static constexpr u64 c_MinAlignment = 16;
+
+		static EngineHeap& Instance();
+
+		void* Allocate(const u64 size);
+		void* Reallocate(void* ptr, const u64 size);
+		void Free(void* ptr);
+
+		/// @brief True if 'ptr' is a small allocation from this heap.
+		bool Owns(const void* ptr) const { return reinterpret_cast<u64>(ptr) - reinterpret_cast<u64>(m_base) < m_reserveSize; }
+		/// @brief Size of the block 'ptr' was given. 0 if 'ptr' is not a small allocation from this heap.
+		u64 GetBlockSize(const void* ptr) const;
+
+		/// @brief Size class an allocation of 'size' bytes uses. 'size' must not be greater than 'c_MaxSmallSize'.
+		/// Classes step by 16 bytes up to 128, then four classes per power of two.
+		static u32 GetSizeClass(const u64 size);
+		static u64 GetSizeClassBlockSize(const u32 sizeClass);
+
+		EngineHeapStats GetStats() const;
+
+	private:
+		friend struct EngineHeapThread;
+
+		EngineHeap();
+		~EngineHeap() = delete;
+
+		void* AllocateSlow(const u64 size);
+		void FreeRemote(EngineHeapSpan* span, void* ptr);
+		EngineHeapSpan* AcquireSpan(EngineHeapThread& thread, const u32 sizeClass);
+		void ReleaseSpan(EngineHeapThread& thread, EngineHeapSpan* span);
+		EngineHeapSpan* CommitSpan();
+		void AbandonThread(EngineHeapThread& thread);
+
+		static EngineHeapThread* GetThread();
+		static EngineHeapSpan* GetSpan(const void* ptr);
+
+	private:
+		u8* m_base = nullptr;
+		u64 m_reserveSize = 0;
+
+		mutable std::mutex m_lock;
+		u64 m_committedSize = 0;
+		EngineHeapSpan* m_freeSpans = nullptr;
+		EngineHeapSpan* m_abandonedSpans[c_SizeClassCount] = { };
+		u64 m_freeSpanCount = 0;
+		u64 m_abandonedSpanCount = 0;
+
+		std::atomic<u64> m_nextThreadId = 1;
+	};
+}
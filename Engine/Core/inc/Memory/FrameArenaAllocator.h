@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+#include "Core/Memory.h"
+#include "Core/NonCopyable.h"
+#include "Memory/MemoryAllocCategory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Insight::Core
+{
+	/// @brief Fixed size block of memory handed out with an atomic bump pointer. Individual allocations are never
+	/// freed, everything is released at once with 'Reset'. Once the block is full allocations fall back to the heap
+	/// and are freed on 'Reset'.
+	class IS_CORE FrameArena : NonCopyable
+	{
+	public:
+		FrameArena(const u64 capacity, const MemoryAllocCategory memoryAllocCategory);
+		~FrameArena();
+
+		/// @brief Allocate 'size' bytes aligned to 'alignment'. Thread safe.
+		void* Allocate(const u64 size, const u64 alignment);
+		/// @brief Release every allocation. No other thread may be allocating from the arena.
+		void Reset();
+
+		/// @brief Bytes allocated since the last reset, including heap overflow.
+		u64 GetUsedBytes() const;
+		/// @brief Bytes which did not fit within the block and came from the heap.
+		u64 GetOverflowBytes() const { return m_overflowBytes.load(std::memory_order_relaxed); }
+		u64 GetCapacity() const { return m_capacity; }
+
+	private:
+		void* AllocateOverflow(const u64 size, const u64 alignment);
+
+	private:
+		u8* m_memory = nullptr;
+		u64 m_capacity = 0;
+		MemoryAllocCategory m_memoryAllocCategory = MemoryAllocCategory::General;
+		std::atomic<u64> m_offset = 0;
+
+		std::mutex m_overflowMutex;
+		std::vector<void*> m_overflowAllocations;
+		std::atomic<u64> m_overflowBytes = 0;
+	};
+
+	/// @brief Arena usage reported once per frame.
+	struct FrameArenaStats
+	{
+		/// @brief Size of each arena's block.
+		u64 Capacity = 0;
+		/// @brief Bytes the last finished frame allocated.
+		u64 LastFrameUsedBytes = 0;
+		/// @brief Bytes the last finished frame allocated which did not fit within the arena.
+		u64 LastFrameOverflowBytes = 0;
+		/// @brief Most bytes any single frame has allocated.
+		u64 PeakUsedBytes = 0;
+		/// @brief Number of arenas created. Grows if frames retire later than expected.
+		u64 ArenaCount = 0;
+	};
+
+	/// @brief Linear allocator for data which only lives for a single frame.
+	/// Allocations are made from the current arena. 'EndFrame' binds the current arena to the frame index the frame
+	/// will be rendered with and starts a new one, 'RetireFrame' is called once that frame index's fence has been
+	/// waited on and resets every arena from an earlier frame with the same index.
+	class IS_CORE FrameArenaAllocator : NonCopyable
+	{
+	public:
+		static constexpr u64 c_DefaultArenaSize = 16_MB;
+
+		FrameArenaAllocator() = default;
+		~FrameArenaAllocator();
+
+		/// @brief Create enough arenas for 'frameCount' frames in flight plus the frame being built.
+		void Initialise(const u32 frameCount, const u64 arenaSize = c_DefaultArenaSize, const MemoryAllocCategory memoryAllocCategory = MemoryAllocCategory::General);
+		void Shutdown();
+		bool IsInitialised() const { return m_currentArena.load(std::memory_order_acquire) != nullptr; }
+
+		/// @brief Arena new per frame allocations come from. nullptr if not initialised.
+		FrameArena* GetCurrentArena() const { return m_currentArena.load(std::memory_order_acquire); }
+		/// @brief Allocate from the current arena. Falls back to the heap if not initialised. Thread safe.
+		void* Allocate(const u64 size, const u64 alignment = alignof(std::max_align_t));
+
+		/// @brief All allocations for the frame which will be rendered with 'frameIndex' have been made.
+		void EndFrame(const u32 frameIndex);
+		/// @brief The fence for 'frameIndex' has been waited on. Reset the arenas from earlier frames with the same index.
+		void RetireFrame(const u32 frameIndex);
+
+		FrameArenaStats GetStats() const;
+
+	private:
+		FrameArena* AcquireArena();
+
+	private:
+		u64 m_arenaSize = c_DefaultArenaSize;
+		MemoryAllocCategory m_memoryAllocCategory = MemoryAllocCategory::General;
+
+		mutable std::mutex m_mutex;
+		std::vector<FrameArena*> m_arenas;
+		std::vector<FrameArena*> m_freeArenas;
+		/// @brief Arenas bound to each frame index, oldest first. The last one is still in flight.
+		std::unordered_map<u32, std::vector<FrameArena*>> m_frameArenas;
+		std::atomic<FrameArena*> m_currentArena = nullptr;
+
+		FrameArenaStats m_stats;
+	};
+
+	/// @brief STL allocator which allocates from a 'FrameArena'. A default constructed allocator uses the heap.
+	/// Copying a container gives the copy a heap allocator, as copies can outlive the frame.
+	template<typename T>
+	class FrameArenaStlAllocator
+	{
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::false_type;
+
+		static_assert(alignof(T) <= alignof(std::max_align_t), "[FrameArenaStlAllocator] Over aligned types are not supported.");
+
+		FrameArenaStlAllocator() = default;
+		explicit FrameArenaStlAllocator(FrameArena* arena)
+			: m_arena(arena)
+		{ }
+		template<typename U>
+		FrameArenaStlAllocator(const FrameArenaStlAllocator<U>& other)
+			: m_arena(other.GetArena())
+		{ }
+
+		T* allocate(const std::size_t count)
+		{
+			if (m_arena)
+			{
+				return static_cast<T*>(m_arena->Allocate(sizeof(T) * count, alignof(T)));
+			}
+			return static_cast<T*>(NewBytes(sizeof(T) * count, MemoryAllocCategory::General));
+		}
+
+		void deallocate(T* ptr, const std::size_t)
+		{
+			if (!m_arena)
+			{
+				DeleteBytes(ptr);
+			}
+		}
+
+		FrameArenaStlAllocator select_on_container_copy_construction() const { return FrameArenaStlAllocator(); }
+
+		FrameArena* GetArena() const { return m_arena; }
+
+		template<typename U>
+		bool operator==(const FrameArenaStlAllocator<U>& other) const { return m_arena == other.GetArena(); }
+		template<typename U>
+		bool operator!=(const FrameArenaStlAllocator<U>& other) const { return m_arena != other.GetArena(); }
+
+	private:
+		FrameArena* m_arena = nullptr;
+	};
+
+	template<typename T>
+	using FrameArenaVector = std::vector<T, FrameArenaStlAllocator<T>>;
+}
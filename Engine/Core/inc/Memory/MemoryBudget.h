@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+#include "Core/NonCopyable.h"
+#include "Memory/MemoryAllocCategory.h"
+
+#include <array>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace Insight::Core
+{
+	/// @brief Soft and hard limits for a single category. A limit of 0 is unlimited.
+	struct MemoryCategoryBudget
+	{
+		u64 SoftLimitBytes = 0;
+		u64 HardLimitBytes = 0;
+	};
+
+	enum class MemoryPressureLevel : u8
+	{
+		None,
+		/// @brief Usage is above the soft limit. Caches should be trimmed.
+		Soft,
+		/// @brief Usage is above the hard limit. Anything which can be released should be.
+		Hard,
+
+		Size
+	};
+	constexpr const char* MemoryPressureLevelToString[] =
+	{
+		"None",
+		"Soft",
+		"Hard",
+	};
+	static_assert(ARRAY_COUNT(MemoryPressureLevelToString) == static_cast<u64>(MemoryPressureLevel::Size));
+
+	/// @brief Per category memory budgets. 'Update' is called once a frame, it samples the usage 'MemoryTracker' has
+	/// for each category, records it in a fixed size history and dispatches a 'MemoryPressureEvent' whenever a category's
+	/// pressure level changes.
+	/// A category drops back a level once its usage is below 'c_ReleaseThreshold' of the limit, so usage sat on a limit
+	/// doesn't fire an event every frame.
+	class IS_CORE MemoryBudget : NonCopyable
+	{
+		THREAD_SAFE;
+	public:
+		static constexpr u64 c_CategoryCount = static_cast<u64>(MemoryAllocCategory::Size);
+		/// @brief Number of frames of usage kept. Older frames are overwritten.
+		static constexpr u32 c_HistoryFrameCount = 4096;
+		static constexpr float c_ReleaseThreshold = 0.9f;
+
+		using CategoryUsage = std::array<u64, c_CategoryCount>;
+
+		static MemoryBudget& Instance();
+
+		void SetBudget(const MemoryAllocCategory category, const MemoryCategoryBudget budget);
+		MemoryCategoryBudget GetBudget(const MemoryAllocCategory category) const;
+		MemoryPressureLevel GetPressureLevel(const MemoryAllocCategory category) const;
+
+		/// @brief Sample the tracked usage of every category for 'frameIndex'.
+		void Update(const u64 frameIndex);
+		/// @brief Record 'usage' for 'frameIndex' and update the pressure levels.
+		void Update(const u64 frameIndex, const CategoryUsage& usage);
+
+		/// @brief Number of frames currently held in the history.
+		u32 GetHistorySize() const;
+		/// @brief Write the history as CSV, oldest frame first. One row per frame, one column of KB per category.
+		bool SaveCsv(std::string_view filePath) const;
+		void ClearHistory();
+
+	private:
+		MemoryBudget();
+
+		MemoryPressureLevel EvaluateLevel(const MemoryCategoryBudget& budget, const MemoryPressureLevel currentLevel, const u64 usage) const;
+
+	private:
+		/// @brief Usage in KB. Saturates at 4TB.
+		struct HistoryFrame
+		{
+			u64 FrameIndex = 0;
+			std::array<u32, c_CategoryCount> UsageKB = { };
+		};
+
+		mutable std::mutex m_lock;
+		std::array<MemoryCategoryBudget, c_CategoryCount> m_budgets = { };
+		std::array<MemoryPressureLevel, c_CategoryCount> m_levels = { };
+
+		std::vector<HistoryFrame> m_history;
+		u32 m_historyHead = 0;
+		u32 m_historySize = 0;
+	};
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+#include "Core/NonCopyable.h"
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <utility>
+
+namespace Insight::Core
+{
+	/// @brief Pool usage. Blocks held by thread magazines count as used.
+	struct ObjectPoolStats
+	{
+		u64 BlockSize = 0;
+		u64 SlabCount = 0;
+		u64 BlockCount = 0;
+		u64 UsedBlockCount = 0;
+	};
+
+	/// @brief Pool of fixed size blocks carved from slabs. Free blocks are kept on an intrusive free list and slabs are
+	/// only released when the pool is destroyed.
+	/// With thread caching each thread keeps a small magazine of free blocks per pool, so most allocations and frees
+	/// don't take the pool's lock. Only the first 'c_MaxThreadCachedPools' pools created get magazines.
+	/// In IS_DEBUG builds free blocks are poisoned and checked on allocation to catch writes after free.
+	/// Slabs come from the heap untracked, objects created with 'New' are still tracked individually.
+	class IS_CORE FixedBlockPool : NonCopyable
+	{
+	public:
+		static constexpr u32 c_DefaultBlocksPerSlab = 256;
+		static constexpr u32 c_MaxThreadCachedPools = 128;
+		static constexpr u32 c_MagazineSize = 32;
+
+		FixedBlockPool(const u64 blockSize, const u64 alignment, const u32 blocksPerSlab = c_DefaultBlocksPerSlab, const bool threadCache = true);
+		~FixedBlockPool();
+
+		void* Allocate();
+		void Free(void* ptr);
+
+		u64 GetBlockSize() const { return m_blockSize; }
+		ObjectPoolStats GetStats() const;
+
+		/// @brief Pool shared by every module for 'name', 'blockSize' and 'alignment'. Created on first use and never
+		/// destroyed, as pooled objects may be released by static destructors.
+		static FixedBlockPool& GetShared(std::string_view name, const u64 blockSize, const u64 alignment);
+
+		/// @brief Heap allocations for objects which can't use their class's pool, e.g. a derived type of a different size.
+		static void* AllocateUnpooled(const u64 size);
+		static void FreeUnpooled(void* ptr);
+
+	private:
+		struct Magazine;
+		struct SlabHeader;
+
+		Magazine* GetMagazine();
+		void* AllocateLocked();
+		void FreeLocked(void* ptr);
+		void Refill(Magazine& magazine);
+		void Flush(Magazine& magazine, const u32 count);
+		void AllocateSlab();
+
+		void Poison(void* ptr) const;
+		void CheckPoison(void* ptr) const;
+
+		friend struct FixedBlockPoolThreadMagazines;
+
+	private:
+		u64 m_blockSize = 0;
+		u64 m_alignment = 0;
+		u32 m_blocksPerSlab = 0;
+		/// @brief Index of the pool's magazine in each thread. Never reused. 'c_MaxThreadCachedPools' or above if the
+		/// pool has no magazines.
+		u32 m_id = 0;
+
+		mutable std::mutex m_lock;
+		void* m_freeList = nullptr;
+		SlabHeader* m_slabs = nullptr;
+		u64 m_slabCount = 0;
+		u64 m_usedBlockCount = 0;
+	};
+
+	/// @brief Typed pool of 'T'. 'Create'/'Destroy' construct and destroy objects in place within pool blocks.
+	template<typename T>
+	class ObjectPool : NonCopyable
+	{
+	public:
+		explicit ObjectPool(const u32 blocksPerSlab = FixedBlockPool::c_DefaultBlocksPerSlab, const bool threadCache = true)
+			: m_pool(sizeof(T), alignof(T), blocksPerSlab, threadCache)
+		{ }
+
+		template<typename... Args>
+		T* Create(Args&&... args)
+		{
+			return ::new (m_pool.Allocate()) T(std::forward<Args>(args)...);
+		}
+
+		void Destroy(T* object)
+		{
+			if (object)
+			{
+				object->~T();
+				m_pool.Free(object);
+			}
+		}
+
+		ObjectPoolStats GetStats() const { return m_pool.GetStats(); }
+
+	private:
+		FixedBlockPool m_pool;
+	};
+}
+
+#ifdef IS_OBJECT_POOLS
+/// @brief Give 'Type' class specific new/delete which use a 'FixedBlockPool' shared across modules, so 'New', 'Delete'
+/// and the smart pointers use the pool without changes at the call site. Derived types of a different size which don't
+/// declare their own pool use the heap.
+#define IS_POOLED_OBJECT(Type)																										\
+	static ::Insight::Core::FixedBlockPool& GetObjectPool()																			\
+	{																																\
+		static ::Insight::Core::FixedBlockPool& pool = ::Insight::Core::FixedBlockPool::GetShared(#Type, sizeof(Type), alignof(Type));	\
+		return pool;																												\
+	}																																\
+	static void* operator new(const std::size_t size)																				\
+	{																																\
+		return size == sizeof(Type) ? GetObjectPool().Allocate() : ::Insight::Core::FixedBlockPool::AllocateUnpooled(size);		\
+	}																																\
+	static void operator delete(void* ptr, const std::size_t size)																	\
+	{																																\
+		if (size == sizeof(Type)) { GetObjectPool().Free(ptr); }																	\
+		else { ::Insight::Core::FixedBlockPool::FreeUnpooled(ptr); }																\
+	}
+#else
+#define IS_POOLED_OBJECT(Type)
+#endif
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+#include "Core/NonCopyable.h"
+#include "Memory/MemoryAllocCategory.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Insight::Core
+{
+	/// @brief Position within a 'ScratchAllocator' to rewind to.
+	struct ScratchMarker
+	{
+		u32 ChunkIndex = 0;
+		u64 Offset = 0;
+	};
+
+	struct ScratchAllocatorStats
+	{
+		u64 ChunkCount = 0;
+		/// @brief Bytes held by chunks, used or not.
+		u64 ReservedBytes = 0;
+		/// @brief Bytes allocated, including alignment padding.
+		u64 UsedBytes = 0;
+		/// @brief Most bytes allocated at once.
+		u64 PeakUsedBytes = 0;
+	};
+
+	/// @brief Linear allocator for temporary memory which is released in LIFO order with 'ScratchScope'.
+	/// Memory is bumped from a list of chunks. Rewinding keeps chunks up to 'maxRetainedBytes' for reuse so repeated
+	/// work (importing many meshes, textures) doesn't go back to the heap. Allocations which don't fit within a chunk get
+	/// a chunk of their own.
+	/// Not thread safe, each thread has its own allocator from 'GetThreadAllocator'.
+	class IS_CORE ScratchAllocator : NonCopyable
+	{
+	public:
+		static constexpr u64 c_DefaultChunkSize = 1_MB;
+		static constexpr u64 c_DefaultMaxRetainedBytes = 8_MB;
+		static constexpr u64 c_DefaultAlignment = 16;
+
+		ScratchAllocator(const u64 chunkSize = c_DefaultChunkSize, const u64 maxRetainedBytes = c_DefaultMaxRetainedBytes
+			, const MemoryAllocCategory memoryAllocCategory = MemoryAllocCategory::General);
+		~ScratchAllocator();
+
+		/// @brief The calling thread's allocator.
+		static ScratchAllocator& GetThreadAllocator();
+
+		/// @brief Allocate 'size' bytes. Must be called within a 'ScratchScope'.
+		void* Allocate(const u64 size, const u64 alignment = c_DefaultAlignment);
+		/// @brief Grow or shrink an allocation. The last allocation made is resized in place when it fits.
+		void* Reallocate(void* ptr, const u64 oldSize, const u64 newSize, const u64 alignment = c_DefaultAlignment);
+		/// @brief Only the last allocation made is released, anything else is released when its scope ends.
+		void Free(void* ptr, const u64 size);
+
+		ScratchMarker GetMarker() const;
+		/// @brief Release everything allocated since 'marker' was taken.
+		void Rewind(const ScratchMarker marker);
+
+		/// @brief Number of open 'ScratchScope's.
+		u32 GetScopeDepth() const { return m_scopeDepth; }
+		ScratchAllocatorStats GetStats() const;
+
+	private:
+		struct Chunk
+		{
+			u8* Memory = nullptr;
+			u64 Size = 0;
+			u64 Used = 0;
+		};
+
+		/// @brief Move to a chunk after the current one which can fit 'size' bytes, creating one if needed.
+		Chunk& NextChunk(const u64 size, const u64 alignment);
+		void ReleaseUnusedChunks();
+		void Poison(Chunk& chunk, const u64 from, const u64 to) const;
+
+		friend class ScratchScope;
+
+	private:
+		u64 m_chunkSize = 0;
+		u64 m_maxRetainedBytes = 0;
+		MemoryAllocCategory m_memoryAllocCategory = MemoryAllocCategory::General;
+
+		std::vector<Chunk> m_chunks;
+		u32 m_currentChunk = 0;
+		u32 m_scopeDepth = 0;
+
+		u64 m_reservedBytes = 0;
+		u64 m_usedBytes = 0;
+		u64 m_peakUsedBytes = 0;
+	};
+
+	/// @brief Rewinds a 'ScratchAllocator' to where it was when the scope was opened.
+	/// Containers using scratch memory must not grow while a scope nested inside the one they were created in is open.
+	class IS_CORE ScratchScope : NonCopyable
+	{
+	public:
+		ScratchScope();
+		explicit ScratchScope(ScratchAllocator& allocator);
+		~ScratchScope();
+
+		ScratchAllocator& GetAllocator() const { return m_allocator; }
+
+	private:
+		ScratchAllocator& m_allocator;
+		ScratchMarker m_marker;
+	};
+
+	/// @brief STL allocator using a 'ScratchAllocator', the calling thread's by default.
+	template<typename T>
+	class ScratchStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		ScratchStlAllocator() noexcept
+			: m_allocator(&ScratchAllocator::GetThreadAllocator())
+		{ }
+		explicit ScratchStlAllocator(ScratchAllocator& allocator) noexcept
+			: m_allocator(&allocator)
+		{ }
+		template<typename TOther>
+		ScratchStlAllocator(const ScratchStlAllocator<TOther>& other) noexcept
+			: m_allocator(other.m_allocator)
+		{ }
+
+		T* allocate(const std::size_t count)
+		{
+			return static_cast<T*>(m_allocator->Allocate(count * sizeof(T), alignof(T) > ScratchAllocator::c_DefaultAlignment ? alignof(T) : ScratchAllocator::c_DefaultAlignment));
+		}
+		void deallocate(T* ptr, const std::size_t count) noexcept
+		{
+			m_allocator->Free(ptr, count * sizeof(T));
+		}
+
+		template<typename TOther>
+		bool operator==(const ScratchStlAllocator<TOther>& other) const noexcept { return m_allocator == other.m_allocator; }
+		template<typename TOther>
+		bool operator!=(const ScratchStlAllocator<TOther>& other) const noexcept { return m_allocator != other.m_allocator; }
+
+	private:
+		ScratchAllocator* m_allocator = nullptr;
+
+		template<typename>
+		friend class ScratchStlAllocator;
+	};
+
+	template<typename T>
+	using ScratchVector = std::vector<T, ScratchStlAllocator<T>>;
+}
@@ -33,6 +33,7 @@ namespace Insight
 
             void Clear();
             void Deserialise(const std::vector<Byte>& data);
+            void Deserialise(const Byte* data, const u64 dataSize);
 
         public:
             Byte* Data = nullptr;
@@ -145,6 +146,7 @@ namespace Insight
             /// @brief Used for internal reading of the ISerialiserHeader.
             /// @param data 
             void DeserialiseNoValidate(const std::vector<Byte>& data);
+            void DeserialiseNoValidate(const Byte* data, const u64 dataSize);
 
         private:
             BinaryHead m_head;
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace Insight
+{
+    namespace Threading
+    {
+        /// @brief Thin wrapper around the OS address wait primitives (WaitOnAddress/futex).
+        /// Lets a thread sleep on a 32 bit atomic without needing a mutex and condition variable.
+        class IS_CORE Futex
+        {
+        public:
+            /// @brief Block while 'value' equals 'expectedValue'. Can return spuriously, callers must re-check.
+            template<typename T>
+            static void Wait(std::atomic<T>& value, const T expectedValue)
+            {
+                static_assert(sizeof(std::atomic<T>) == sizeof(u32), "[Futex::Wait] Only 32 bit values are supported.");
+                u32 expected = 0;
+                std::memcpy(&expected, &expectedValue, sizeof(u32));
+                WaitOnAddress(&value, expected);
+            }
+
+            /// @brief Wake all threads waiting on 'value'.
+            template<typename T>
+            static void WakeAll(std::atomic<T>& value)
+            {
+                static_assert(sizeof(std::atomic<T>) == sizeof(u32), "[Futex::WakeAll] Only 32 bit values are supported.");
+                WakeAllOnAddress(&value);
+            }
+
+        private:
+            static void WaitOnAddress(void* address, const u32 expectedValue);
+            static void WakeAllOnAddress(void* address);
+        };
+    }
+}
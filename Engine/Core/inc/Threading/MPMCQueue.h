@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+#include "Core/Memory.h"
+#include "Threading/QueueWaitSignal.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Insight
+{
+    namespace Threading
+    {
+        /// @brief Bounded lock free multi producer multi consumer FIFO queue (Vyukov).
+        /// Each slot has a sequence number which tells producers and consumers whose turn it is, so a push or pop
+        /// is a single CAS on the shared cursor plus a store to the slot.
+        /// @tparam Capacity Must be a power of two.
+        /// @tparam Blocking Enables Push/Pop which sleep while the queue is full/empty. Costs a fence per operation.
+        template<typename T, u64 Capacity, bool Blocking = false>
+        class MPMCQueue
+        {
+            static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "[MPMCQueue] Capacity must be a power of two.");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "[MPMCQueue] Over aligned types are not supported.");
+
+        public:
+            MPMCQueue()
+            {
+                m_cells = static_cast<Cell*>(NewBytes(sizeof(Cell) * Capacity, Core::MemoryAllocCategory::Threading));
+                for (u64 i = 0; i < Capacity; ++i)
+                {
+                    new (&m_cells[i]) Cell();
+                    m_cells[i].Sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+            MPMCQueue(const MPMCQueue&) = delete;
+            MPMCQueue& operator=(const MPMCQueue&) = delete;
+            ~MPMCQueue()
+            {
+                const u64 enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+                for (u64 position = m_dequeuePosition.load(std::memory_order_relaxed); position < enqueuePosition; ++position)
+                {
+                    m_cells[position & c_Mask].GetItem()->~T();
+                }
+                for (u64 i = 0; i < Capacity; ++i)
+                {
+                    m_cells[i].~Cell();
+                }
+                DeleteBytes(m_cells);
+            }
+
+            /// @brief Push a copy of 'item'. Returns false if the queue is full.
+            bool TryPush(const T& item) { return TryEmplace(item); }
+            /// @brief Push 'item'. Returns false if the queue is full, 'item' is only moved from on success.
+            bool TryPush(T&& item) { return TryEmplace(std::move(item)); }
+
+            /// @brief Pop the oldest item. Returns false if the queue is empty.
+            bool TryPop(T& item)
+            {
+                Cell* cell = nullptr;
+                u64 position = m_dequeuePosition.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    cell = &m_cells[position & c_Mask];
+                    const u64 sequence = cell->Sequence.load(std::memory_order_acquire);
+                    const i64 difference = static_cast<i64>(sequence) - static_cast<i64>(position + 1);
+                    if (difference == 0)
+                    {
+                        if (m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (difference < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        position = m_dequeuePosition.load(std::memory_order_relaxed);
+                    }
+                }
+
+                T* storedItem = cell->GetItem();
+                item = std::move(*storedItem);
+                storedItem->~T();
+                cell->Sequence.store(position + Capacity, std::memory_order_release);
+
+                if constexpr (Blocking)
+                {
+                    m_notFullSignal.NotifyAll();
+                }
+                return true;
+            }
+
+            /// @brief Push 'item', sleeping while the queue is full.
+            void Push(T item)
+            {
+                static_assert(Blocking, "[MPMCQueue::Push] Queue must be created with Blocking enabled.");
+                m_notFullSignal.Wait([this, &item]() { return TryPush(std::move(item)); });
+            }
+
+            /// @brief Pop the oldest item, sleeping while the queue is empty.
+            void Pop(T& item)
+            {
+                static_assert(Blocking, "[MPMCQueue::Pop] Queue must be created with Blocking enabled.");
+                m_notEmptySignal.Wait([this, &item]() { return TryPop(item); });
+            }
+
+            /// @brief Approximate number of items within the queue.
+            u64 GetSize() const
+            {
+                const u64 enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+                const u64 dequeuePosition = m_dequeuePosition.load(std::memory_order_relaxed);
+                return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+            }
+            bool IsEmpty() const { return GetSize() == 0; }
+            static constexpr u64 GetCapacity() { return Capacity; }
+
+        private:
+            struct Cell
+            {
+                std::atomic<u64> Sequence;
+                alignas(T) unsigned char Storage[sizeof(T)];
+
+                T* GetItem() { return std::launder(reinterpret_cast<T*>(Storage)); }
+            };
+
+            template<typename U>
+            bool TryEmplace(U&& item)
+            {
+                Cell* cell = nullptr;
+                u64 position = m_enqueuePosition.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    cell = &m_cells[position & c_Mask];
+                    const u64 sequence = cell->Sequence.load(std::memory_order_acquire);
+                    const i64 difference = static_cast<i64>(sequence) - static_cast<i64>(position);
+                    if (difference == 0)
+                    {
+                        if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (difference < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        position = m_enqueuePosition.load(std::memory_order_relaxed);
+                    }
+                }
+
+                new (cell->Storage) T(std::forward<U>(item));
+                cell->Sequence.store(position + 1, std::memory_order_release);
+
+                if constexpr (Blocking)
+                {
+                    m_notEmptySignal.NotifyAll();
+                }
+                return true;
+            }
+
+        private:
+            static constexpr u64 c_Mask = Capacity - 1;
+
+            /// @brief Separate cache lines for producers and consumers.
+            alignas(64) std::atomic<u64> m_enqueuePosition = 0;
+            alignas(64) std::atomic<u64> m_dequeuePosition = 0;
+            alignas(64) Cell* m_cells = nullptr;
+
+            QueueWaitSignal m_notEmptySignal;
+            QueueWaitSignal m_notFullSignal;
+        };
+    }
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#include "Threading/TaskSystem.h"
+#include "Core/Collections/Span.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <vector>
+
+namespace Insight
+{
+    namespace Threading
+    {
+        namespace Internal
+        {
+            /// @brief Run 'func(begin, end)' over [0, count) in chunks of 'grainSize'. Chunks are handed out with a
+            /// single atomic cursor, the calling thread takes part so it is never just waiting on workers.
+            template<typename Func>
+            void ParallelForChunks(const u64 count, const u64 grainSize, Func& func)
+            {
+                if (count == 0)
+                {
+                    return;
+                }
+
+                const u64 chunkSize = std::max<u64>(1, grainSize);
+                const u64 chunkCount = IntDivideRoundUp(count, chunkSize);
+                const u32 threadCount = TaskSystem::IsValidInstance() ? TaskSystem::Instance().GetThreadCount() : 0;
+                const u64 helperCount = std::min<u64>(chunkCount - 1, threadCount);
+                if (helperCount == 0)
+                {
+                    func(static_cast<u64>(0), count);
+                    return;
+                }
+
+                std::atomic<u64> cursor = 0;
+                const auto processChunks = [&cursor, &func, count, chunkSize]()
+                {
+                    while (true)
+                    {
+                        const u64 begin = cursor.fetch_add(chunkSize, std::memory_order_relaxed);
+                        if (begin >= count)
+                        {
+                            break;
+                        }
+                        const u64 end = std::min(begin + chunkSize, count);
+                        IS_PROFILE_SCOPE("ParallelFor");
+                        func(begin, end);
+                    }
+                };
+
+                std::vector<std::shared_ptr<TaskWithResult<void>>> helpers;
+                helpers.reserve(helperCount);
+                for (u64 helperIdx = 0; helperIdx < helperCount; ++helperIdx)
+                {
+                    helpers.push_back(TaskSystem::CreateTask([&processChunks]() { processChunks(); }));
+                }
+
+                processChunks();
+
+                for (const std::shared_ptr<TaskWithResult<void>>& helper : helpers)
+                {
+                    IS_PROFILE_SCOPE("Wait");
+                    helper->Wait();
+                }
+            }
+        }
+
+        /// @brief Call 'func(begin, end)' for each chunk of [0, count). 'func' is inlined, not type erased.
+        template<typename Func>
+        void ParallelForRange(const u64 count, const u64 grainSize, Func&& func)
+        {
+            Internal::ParallelForChunks(count, grainSize, func);
+        }
+
+        /// @brief Call 'func(index)' for each index in [0, count).
+        template<typename Func>
+        void ParallelFor(const u64 count, const u64 grainSize, Func&& func)
+        {
+            const auto rangeFunc = [&func](const u64 begin, const u64 end)
+            {
+                for (u64 i = begin; i < end; ++i)
+                {
+                    func(i);
+                }
+            };
+            Internal::ParallelForChunks(count, grainSize, rangeFunc);
+        }
+
+        /// @brief Call 'func(item)' for each item in 'span'.
+        template<typename T, typename Func>
+        void ParallelFor(const u32 workGroupSize, Span<T> span, Func&& func)
+        {
+            T* data = span.Data();
+            const auto rangeFunc = [data, &func](const u64 begin, const u64 end)
+            {
+                for (u64 i = begin; i < end; ++i)
+                {
+                    func(data[i]);
+                }
+            };
+            Internal::ParallelForChunks(span.Size(), workGroupSize, rangeFunc);
+        }
+
+        /// @brief Call 'func(item)' for each item in 'vec'.
+        template<typename T, typename Func>
+        void ParallelFor(const u32 workGroupSize, std::vector<T>& vec, Func&& func)
+        {
+            ParallelFor(workGroupSize, Span<T>(vec.data(), vec.size()), std::forward<Func>(func));
+        }
+
+        /// @brief Reduce [0, count) in parallel.
+        /// 'func(begin, end, identity)' returns the partial result for a chunk, 'reduce(a, b)' combines two partials.
+        /// Partials are combined in chunk order so the result is deterministic for a given grain size.
+        template<typename T, typename Func, typename ReduceFunc>
+        T ParallelReduce(const u64 count, const u64 grainSize, const T identity, Func&& func, ReduceFunc&& reduce)
+        {
+            if (count == 0)
+            {
+                return identity;
+            }
+
+            const u64 chunkSize = std::max<u64>(1, grainSize);
+            const u64 chunkCount = IntDivideRoundUp(count, chunkSize);
+            std::vector<T> partials(chunkCount, identity);
+
+            const auto chunkFunc = [&](const u64 chunkBegin, const u64 chunkEnd)
+            {
+                for (u64 chunkIdx = chunkBegin; chunkIdx < chunkEnd; ++chunkIdx)
+                {
+                    const u64 begin = chunkIdx * chunkSize;
+                    const u64 end = std::min(begin + chunkSize, count);
+                    partials[chunkIdx] = func(begin, end, identity);
+                }
+            };
+            Internal::ParallelForChunks(chunkCount, 1, chunkFunc);
+
+            T result = identity;
+            for (const T& partial : partials)
+            {
+                result = reduce(result, partial);
+            }
+            return result;
+        }
+
+        /// @brief Sort [first, last) in parallel. Chunks are sorted on workers then merged pairwise in parallel rounds.
+        template<typename RandomIt, typename Compare>
+        void ParallelSort(RandomIt first, RandomIt last, Compare compare, const u64 grainSize = 2048)
+        {
+            const u64 count = static_cast<u64>(std::distance(first, last));
+            const u32 threadCount = TaskSystem::IsValidInstance() ? TaskSystem::Instance().GetThreadCount() : 0;
+            if (count <= grainSize || threadCount == 0)
+            {
+                std::sort(first, last, compare);
+                return;
+            }
+
+            // One chunk per thread (including the caller), each at least 'grainSize' items.
+            const u64 chunkCount = std::min<u64>(threadCount + 1, IntDivideRoundUp(count, grainSize));
+            const u64 chunkSize = IntDivideRoundUp(count, chunkCount);
+
+            ParallelFor(chunkCount, 1, [&](const u64 chunkIdx)
+                {
+                    const u64 begin = chunkIdx * chunkSize;
+                    const u64 end = std::min(begin + chunkSize, count);
+                    std::sort(first + begin, first + end, compare);
+                });
+
+            for (u64 width = chunkSize; width < count; width *= 2)
+            {
+                const u64 mergeCount = IntDivideRoundUp(count, width * 2);
+                ParallelFor(mergeCount, 1, [&](const u64 mergeIdx)
+                    {
+                        const u64 begin = mergeIdx * width * 2;
+                        const u64 middle = std::min(begin + width, count);
+                        const u64 end = std::min(begin + width * 2, count);
+                        if (middle < end)
+                        {
+                            std::inplace_merge(first + begin, first + middle, first + end, compare);
+                        }
+                    });
+            }
+        }
+
+        template<typename RandomIt>
+        void ParallelSort(RandomIt first, RandomIt last)
+        {
+            ParallelSort(first, last, std::less<>());
+        }
+
+        /// @brief Exclusive scan of 'input' into 'output' (which can alias 'input').
+        /// First pass reduces each chunk in parallel, the chunk totals are scanned serially, then a second
+        /// parallel pass scans each chunk starting from its offset.
+        template<typename T, typename BinaryOp>
+        void ParallelExclusiveScan(const T* input, T* output, const u64 count, const T init, BinaryOp op, const u64 grainSize = 4096)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+
+            const u64 chunkSize = std::max<u64>(1, grainSize);
+            const u64 chunkCount = IntDivideRoundUp(count, chunkSize);
+            const u32 threadCount = TaskSystem::IsValidInstance() ? TaskSystem::Instance().GetThreadCount() : 0;
+            if (chunkCount == 1 || threadCount == 0)
+            {
+                T sum = init;
+                for (u64 i = 0; i < count; ++i)
+                {
+                    const T value = input[i];
+                    output[i] = sum;
+                    sum = op(sum, value);
+                }
+                return;
+            }
+
+            std::vector<T> chunkOffsets(chunkCount);
+            ParallelFor(chunkCount, 1, [&](const u64 chunkIdx)
+                {
+                    const u64 begin = chunkIdx * chunkSize;
+                    const u64 end = std::min(begin + chunkSize, count);
+                    T sum = input[begin];
+                    for (u64 i = begin + 1; i < end; ++i)
+                    {
+                        sum = op(sum, input[i]);
+                    }
+                    chunkOffsets[chunkIdx] = sum;
+                });
+
+            T sum = init;
+            for (u64 chunkIdx = 0; chunkIdx < chunkCount; ++chunkIdx)
+            {
+                const T chunkTotal = chunkOffsets[chunkIdx];
+                chunkOffsets[chunkIdx] = sum;
+                sum = op(sum, chunkTotal);
+            }
+
+            ParallelFor(chunkCount, 1, [&](const u64 chunkIdx)
+                {
+                    const u64 begin = chunkIdx * chunkSize;
+                    const u64 end = std::min(begin + chunkSize, count);
+                    T chunkSum = chunkOffsets[chunkIdx];
+                    for (u64 i = begin; i < end; ++i)
+                    {
+                        const T value = input[i];
+                        output[i] = chunkSum;
+                        chunkSum = op(chunkSum, value);
+                    }
+                });
+        }
+
+        template<typename T>
+        void ParallelExclusiveScan(const T* input, T* output, const u64 count, const T init)
+        {
+            ParallelExclusiveScan(input, output, count, init, std::plus<>());
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+#include "Threading/Futex.h"
+
+#include <atomic>
+#include <thread>
+
+namespace Insight
+{
+    namespace Threading
+    {
+        /// @brief Lets threads sleep until a lock free queue changes state (not empty/not full).
+        /// The notifying side only pays for a fence and a load unless someone is actually waiting.
+        class QueueWaitSignal
+        {
+        public:
+            /// @brief Number of failed attempts before the waiting thread sleeps.
+            static constexpr u32 c_SpinCount = 64;
+
+            /// @brief Block until 'tryFunc()' returns true. 'tryFunc' should attempt the queue operation itself.
+            template<typename TryFunc>
+            void Wait(TryFunc&& tryFunc)
+            {
+                for (u32 spinIdx = 0; spinIdx < c_SpinCount; ++spinIdx)
+                {
+                    if (tryFunc())
+                    {
+                        return;
+                    }
+                    std::this_thread::yield();
+                }
+
+                while (true)
+                {
+                    // Register as a waiter before the final attempt so a notify can't be missed in between.
+                    m_waiterCount.fetch_add(1, std::memory_order_seq_cst);
+                    const u32 epoch = m_epoch.load(std::memory_order_seq_cst);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (tryFunc())
+                    {
+                        m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    Futex::Wait(m_epoch, epoch);
+                    m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+
+            /// @brief Wake every waiting thread. Must be called after the queue state has been published.
+            void NotifyAll()
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (m_waiterCount.load(std::memory_order_relaxed) > 0)
+                {
+                    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+                    Futex::WakeAll(m_epoch);
+                }
+            }
+
+        private:
+            std::atomic<u32> m_epoch = 0;
+            std::atomic<u32> m_waiterCount = 0;
+        };
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+#include "Core/Memory.h"
+#include "Threading/QueueWaitSignal.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Insight
+{
+    namespace Threading
+    {
+        /// @brief Bounded lock free single producer single consumer FIFO queue.
+        /// Only one thread may push and only one (other) thread may pop. Each side keeps a cached copy of the
+        /// other side's index so the shared cache line is only touched when the queue looks full/empty.
+        /// @tparam Capacity Must be a power of two.
+        /// @tparam Blocking Enables Push/Pop which sleep while the queue is full/empty. Costs a fence per operation.
+        template<typename T, u64 Capacity, bool Blocking = false>
+        class SPSCQueue
+        {
+            static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "[SPSCQueue] Capacity must be a power of two.");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "[SPSCQueue] Over aligned types are not supported.");
+
+        public:
+            SPSCQueue()
+            {
+                m_items = static_cast<T*>(NewBytes(sizeof(T) * Capacity, Core::MemoryAllocCategory::Threading));
+            }
+            SPSCQueue(const SPSCQueue&) = delete;
+            SPSCQueue& operator=(const SPSCQueue&) = delete;
+            ~SPSCQueue()
+            {
+                const u64 tail = m_tail.load(std::memory_order_relaxed);
+                for (u64 head = m_head.load(std::memory_order_relaxed); head < tail; ++head)
+                {
+                    m_items[head & c_Mask].~T();
+                }
+                DeleteBytes(m_items);
+            }
+
+            /// @brief Push a copy of 'item'. Returns false if the queue is full. Producer thread only.
+            bool TryPush(const T& item) { return TryEmplace(item); }
+            /// @brief Push 'item'. Returns false if the queue is full, 'item' is only moved from on success. Producer thread only.
+            bool TryPush(T&& item) { return TryEmplace(std::move(item)); }
+
+            /// @brief Pop the oldest item. Returns false if the queue is empty. Consumer thread only.
+            bool TryPop(T& item)
+            {
+                const u64 head = m_head.load(std::memory_order_relaxed);
+                if (head == m_cachedTail)
+                {
+                    m_cachedTail = m_tail.load(std::memory_order_acquire);
+                    if (head == m_cachedTail)
+                    {
+                        return false;
+                    }
+                }
+
+                T* storedItem = std::launder(&m_items[head & c_Mask]);
+                item = std::move(*storedItem);
+                storedItem->~T();
+                m_head.store(head + 1, std::memory_order_release);
+
+                if constexpr (Blocking)
+                {
+                    m_notFullSignal.NotifyAll();
+                }
+                return true;
+            }
+
+            /// @brief Push 'item', sleeping while the queue is full. Producer thread only.
+            void Push(T item)
+            {
+                static_assert(Blocking, "[SPSCQueue::Push] Queue must be created with Blocking enabled.");
+                m_notFullSignal.Wait([this, &item]() { return TryPush(std::move(item)); });
+            }
+
+            /// @brief Pop the oldest item, sleeping while the queue is empty. Consumer thread only.
+            void Pop(T& item)
+            {
+                static_assert(Blocking, "[SPSCQueue::Pop] Queue must be created with Blocking enabled.");
+                m_notEmptySignal.Wait([this, &item]() { return TryPop(item); });
+            }
+
+            /// @brief Approximate number of items within the queue.
+            u64 GetSize() const
+            {
+                const u64 tail = m_tail.load(std::memory_order_relaxed);
+                const u64 head = m_head.load(std::memory_order_relaxed);
+                return tail > head ? tail - head : 0;
+            }
+            bool IsEmpty() const { return GetSize() == 0; }
+            static constexpr u64 GetCapacity() { return Capacity; }
+
+        private:
+            template<typename U>
+            bool TryEmplace(U&& item)
+            {
+                const u64 tail = m_tail.load(std::memory_order_relaxed);
+                if (tail - m_cachedHead >= Capacity)
+                {
+                    m_cachedHead = m_head.load(std::memory_order_acquire);
+                    if (tail - m_cachedHead >= Capacity)
+                    {
+                        return false;
+                    }
+                }
+
+                new (&m_items[tail & c_Mask]) T(std::forward<U>(item));
+                m_tail.store(tail + 1, std::memory_order_release);
+
+                if constexpr (Blocking)
+                {
+                    m_notEmptySignal.NotifyAll();
+                }
+                return true;
+            }
+
+        private:
+            static constexpr u64 c_Mask = Capacity - 1;
+
+            /// @brief Consumer owned. 'm_cachedTail' is the last tail the consumer saw.
+            alignas(64) std::atomic<u64> m_head = 0;
+            u64 m_cachedTail = 0;
+            /// @brief Producer owned. 'm_cachedHead' is the last head the producer saw.
+            alignas(64) std::atomic<u64> m_tail = 0;
+            u64 m_cachedHead = 0;
+            alignas(64) T* m_items = nullptr;
+
+            QueueWaitSignal m_notEmptySignal;
+            QueueWaitSignal m_notFullSignal;
+        };
+    }
+}
@@ -1,11 +1,12 @@
 #pragma once
 
 #include "Threading/TaskFuncWrapper.h"
+#include "Threading/SpinLock.h"
 #include "Core/Memory.h"
 
 #include <atomic>
 #include <memory>
-#include <condition_variable>
+#include <vector>
 
 namespace Insight
 {
@@ -20,7 +21,7 @@ namespace Insight
 		//template<typename ResultType>
 		//using TaskWithResultShared = RPtr<TaskWithResult<ResultType>>;
 
-		enum class TaskStates
+		enum class TaskStates : u32
 		{
 			Queued,
 			Running,
@@ -29,12 +30,38 @@ namespace Insight
 			Canceled,
 		};
 
+		/// @brief Controls which queue a task is dispatched from. Workers always take the highest priority task available.
+		enum class TaskPriority : u8
+		{
+			/// @brief Work which the current frame is waiting on.
+			FrameCritical,
+			Normal,
+			/// @brief Long running work (asset imports, world saves). Never occupies every worker.
+			Background,
+			/// @brief Blocking I/O. Runs on the dedicated I/O threads, never on a compute worker.
+			IO,
+
+			Count
+		};
+		constexpr const char* TaskPriorityToString(const TaskPriority priority)
+		{
+			switch (priority)
+			{
+			case TaskPriority::FrameCritical: return "FrameCritical";
+			case TaskPriority::Normal: return "Normal";
+			case TaskPriority::Background: return "Background";
+			case TaskPriority::IO: return "IO";
+			default:
+				break;
+			}
+			return "Unknown";
+		}
+
 		// Task with no result.
-		class IS_CORE Task
+		class IS_CORE Task : public std::enable_shared_from_this<Task>
 		{
 		public:
 			Task();
-			Task(ITaskFuncWrapper* funcWrapper);
 			virtual ~Task();
 
 			bool IsQueued() const { return m_state.load() == TaskStates::Queued; }
@@ -43,19 +70,62 @@ namespace Insight
 			bool IsWaiting() const { return m_state.load() == TaskStates::Running; }
 			bool IsFinished() const { return m_state.load() == TaskStates::Finished; }
 			bool IsCancled() const { return m_state.load() == TaskStates::Canceled; }
+			/// @brief Is the task either finished or canceled.
+			bool IsComplete() const { return IsFinished() || IsCancled(); }
 			TaskStates GetState() { return m_state.load(); }
+			TaskPriority GetPriority() const { return m_priority; }
 
+			/// @brief Wait for this task to complete. If called from a TaskSystem worker, the worker
+			/// runs other queued tasks while waiting instead of blocking.
 			void Wait();
 
+			/// @brief Create a task which will be queued once this task has finished.
+			/// Defined in "Threading/TaskSystem.h".
+			template<typename Func, typename... Args>
+			auto Then(Func func, Args&&... args);
+
+			/// @brief Cancel a task which has not started. Has no effect once the task is running.
+			/// Successors which can no longer run are canceled as well.
+			void Cancel();
+
 		private:
+			/// @brief Run the task's callable. Implemented by 'TaskWithFunc'.
+			virtual void Execute() { }
 			virtual void Call();
 
+			/// @brief Add a task to be notified when this task completes.
+			/// @return False if this task has already completed.
+			bool AddSuccessor(const std::shared_ptr<Task>& successor);
+			/// @brief Called when one of this task's predecessors has completed.
+			/// @return True if the task is now ready to be queued.
+			bool OnPredecessorComplete();
+			/// @brief Called when one of this task's predecessors has been canceled.
+			/// @return True if the task can no longer run and should be canceled.
+			bool OnPredecessorCanceled();
+			/// @brief Wake every thread blocked in 'Wait', called once the task has completed.
+			void WakeWaiters();
+
 		private:
-			std::atomic<TaskStates> m_state;
-			ITaskFuncWrapper* m_functionWrapper = nullptr;
+			std::atomic<TaskStates> m_state = TaskStates::Queued;
+			TaskPriority m_priority = TaskPriority::Normal;
+			/// @brief Time (nanoseconds) the task was pushed onto a queue. Used for dispatch latency stats.
+			u64 m_queuedTimeNs = 0;
+			/// @brief Number of threads sleeping on 'm_state' in 'Wait'. Avoids a wake syscall when nobody waits.
+			std::atomic<u32> m_waiterCount = 0;
+			/// @brief Number of workers parked in the TaskSystem waiting on this task in 'Wait'.
+			std::atomic<u32> m_parkedWorkerCount = 0;
+			/// @brief Keep the task alive while it is queued within the TaskSystem.
+			std::shared_ptr<Task> m_queuedReference;
 
-			std::condition_variable m_cv;
-			std::mutex m_mutex;
+			/// @brief Tasks waiting on this task to complete.
+			SpinLock m_successorsLock;
+			std::vector<std::shared_ptr<Task>> m_successors;
+			/// @brief Number of predecessors which must complete before this task is queued.
+			/// For 'm_waitForAny' tasks, the number of predecessors which have not been canceled.
+			std::atomic<u32> m_predecessorCount = 0;
+			/// @brief Queue this task when any (rather than all) predecessors complete.
+			bool m_waitForAny = false;
+			std::atomic<bool> m_anyPredecessorComplete = false;
 
 			friend class TaskSystem;
 		};
@@ -65,19 +135,33 @@ namespace Insight
 		{
 		public:
 			TaskWithResult() = default;
-			TaskWithResult(TaskResult<ResultType>* taskResult, ITaskFuncWrapper* funcWrapper)
-				: Task(funcWrapper)
-				, m_taskResult(taskResult)
+			virtual ~TaskWithResult() override = default;
+
+			TaskResult<ResultType>& GetResult() const { return m_taskResult; }
+
+		private:
+			mutable TaskResult<ResultType> m_taskResult;
+		};
+
+		/// @brief Task which stores its callable, arguments and result inline so creating a task is a
+		/// single (pooled) allocation.
+		template<typename ResultType, typename Func, typename... Args>
+		class TaskWithFunc : public TaskWithResult<ResultType>
+		{
+		public:
+			TaskWithFunc(Func func, Args... args)
+				: m_funcWrapper(&this->GetResult(), std::move(func), std::move(args)...)
 			{ }
-			~TaskWithResult()
+			virtual ~TaskWithFunc() override = default;
+
+		private:
+			virtual void Execute() override
 			{
-				Delete(m_taskResult);
+				m_funcWrapper.Call();
 			}
 
-			TaskResult<ResultType>& GetResult() const { return *m_taskResult; }
-
 		private:
-			TaskResult<ResultType>* m_taskResult;
+			TaskFuncWrapper<ResultType, Func, Args...> m_funcWrapper;
 		};
 	}
 }
\ No newline at end of file
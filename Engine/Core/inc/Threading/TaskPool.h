@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+
+#include <new>
+#include <type_traits>
+
+namespace Insight
+{
+    namespace Threading
+    {
+        /// @brief Size class block pool used for task allocations.
+        /// Each thread keeps a cache of free blocks per size class, blocks are carved from large slabs and
+        /// are never returned to the OS. Blocks freed on a different thread from the one which allocated them
+        /// go into the freeing thread's cache, overflow is moved to a shared list to rebalance threads.
+        class IS_CORE TaskPool
+        {
+        public:
+            static constexpr u64 c_MinBlockSize = 64;
+            static constexpr u64 c_SizeClassCount = 5;
+            static constexpr u64 c_MaxBlockSize = c_MinBlockSize << (c_SizeClassCount - 1);
+            static constexpr u64 c_BlockAlignment = 16;
+            static constexpr u64 c_SlabSize = 64_KB;
+
+            /// @brief Allocate 'size' bytes. Falls back to the general heap if 'size' is above 'c_MaxBlockSize'.
+            static void* Allocate(const u64 size);
+            /// @brief Free memory allocated from 'Allocate'. 'size' must match the size given to 'Allocate'.
+            static void Free(void* ptr, const u64 size);
+
+            /// @brief Number of slabs allocated across all threads.
+            static u64 GetSlabCount();
+        };
+
+        /// @brief STL allocator which allocates from 'TaskPool'. Used with 'std::allocate_shared' so a task,
+        /// its callable, its result and the shared_ptr control block are a single pooled allocation.
+        template<typename T>
+        class TaskPoolAllocator
+        {
+        public:
+            using value_type = T;
+
+            TaskPoolAllocator() = default;
+            template<typename U>
+            TaskPoolAllocator(const TaskPoolAllocator<U>&) { }
+
+            T* allocate(const std::size_t count)
+            {
+                if constexpr (alignof(T) > TaskPool::c_BlockAlignment)
+                {
+                    return static_cast<T*>(::operator new(sizeof(T) * count, std::align_val_t(alignof(T))));
+                }
+                else
+                {
+                    return static_cast<T*>(TaskPool::Allocate(sizeof(T) * count));
+                }
+            }
+
+            void deallocate(T* ptr, const std::size_t count)
+            {
+                if constexpr (alignof(T) > TaskPool::c_BlockAlignment)
+                {
+                    ::operator delete(ptr, std::align_val_t(alignof(T)));
+                }
+                else
+                {
+                    TaskPool::Free(ptr, sizeof(T) * count);
+                }
+            }
+
+            template<typename U>
+            bool operator==(const TaskPoolAllocator<U>&) const { return true; }
+            template<typename U>
+            bool operator!=(const TaskPoolAllocator<U>&) const { return false; }
+        };
+    }
+}
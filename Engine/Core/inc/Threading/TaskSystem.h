@@ -7,161 +7,219 @@
 
 #include "Threading/Task.h"
 #include "Threading/Thread.h"
+#include "Threading/WorkStealingQueue.h"
+#include "Threading/MPMCQueue.h"
+#include "Threading/TaskPool.h"
 
 #include <mutex>
-#include <queue>
-#include <unordered_set>
 #include <memory>
 #include <functional>
 #include <algorithm>
+#include <condition_variable>
 
 namespace Insight
 {
 	namespace Threading
 	{
+		/// @brief Dispatch statistics for a single task priority.
+		struct TaskPriorityStats
+		{
+			/// @brief Number of tasks queued and not yet started.
+			u64 QueueDepth = 0;
+			/// @brief Number of tasks started since the stats were last reset.
+			u64 ExecutedCount = 0;
+			/// @brief Time between a task being queued and a thread starting it.
+			u64 AverageDispatchLatencyNs = 0;
+			u64 MaxDispatchLatencyNs = 0;
+		};
+
+		/// @brief Task scheduler. Each worker thread owns a lock free work stealing queue per priority, tasks created
+		/// from a worker thread are pushed onto that worker's queue, tasks created from any other thread are
+		/// pushed onto a shared lock free global queue. Idle workers steal from each other and park on a condition variable
+		/// when there is no work left, so idle workers don't burn a core.
+		/// IO tasks run on a small separate pool of threads so blocking file access never holds a compute worker.
 		class IS_CORE TaskSystem : public Core::Singleton<TaskSystem>, public Core::ISystem
 		{
 		public:
 			IS_SYSTEM(TaskSystem);
 
+			/// @brief Max number of tasks a single worker queue can hold before spilling into the global queue.
+			static constexpr u64 c_WorkerQueueCapacity = 2048;
+			/// @brief Number of times a worker will look for work before parking.
+			static constexpr u32 c_WorkerSpinCount = 64;
+			/// @brief Max number of tasks each global queue can hold. Producers help run tasks while it is full.
+			static constexpr u64 c_GlobalQueueCapacity = 8192;
+			/// @brief Max number of IO tasks which can be waiting at once. Producers block while it is full.
+			static constexpr u64 c_IOQueueCapacity = 4096;
+			/// @brief Number of threads dedicated to IO tasks.
+			static constexpr u32 c_IOThreadCount = 2;
+			/// @brief Number of priorities dispatched by the compute workers (everything but IO).
+			static constexpr u32 c_WorkerPriorityCount = static_cast<u32>(TaskPriority::IO);
+
 			virtual void Initialise() override;
+			/// @brief Initialise the task system with a specific number of worker threads.
+			void Initialise(const u32 workerThreadCount);
 			virtual void Shutdown() override;
 
 			u32 GetThreadCount() const { return static_cast<u32>(m_threads.size()); }
+			u32 GetIOThreadCount() const { return static_cast<u32>(m_ioThreads.size()); }
+			/// @brief Approximate number of tasks queued and not yet started.
+			u64 GetQueuedTaskCount() const { return static_cast<u64>(std::max<i64>(0, m_queuedTaskCount.load(std::memory_order_relaxed))); }
 
+			/// @brief Get the queue depth and dispatch latency for a priority.
+			TaskPriorityStats GetPriorityStats(const TaskPriority priority) const;
+			/// @brief Reset executed counts and latencies for all priorities.
+			void ResetPriorityStats();
+
+			/// @brief Create a 'Normal' priority task and queue it straight away.
 			template<typename Func, typename... Args>
 			static auto CreateTask(Func func, Args&&... args)
+			{
+				return CreateTaskWithPriority(TaskPriority::Normal, std::move(func), std::forward<Args>(args)...);
+			}
+
+			/// @brief Create a task and queue it straight away.
+			template<typename Func, typename... Args>
+			static auto CreateTaskWithPriority(const TaskPriority priority, Func func, Args&&... args)
 			{
 				IS_PROFILE_FUNCTION();
+				auto task = MakeTask(priority, std::move(func), std::forward<Args>(args)...);
+				ScheduleTask(task);
+				return task;
+			}
 
-				using ResultType = std::invoke_result_t<Func, Args...>;
-				TaskResult<ResultType>* taskResult = New<TaskResult<ResultType>, Core::MemoryAllocCategory::Threading>();
-				TaskFuncWrapper<ResultType, Func, Args...>* taskWrapper = New<TaskFuncWrapper<ResultType, Func, Args...>>(taskResult, std::move(func), std::move(args)...);
+			/// @brief Create a task which runs on the IO threads. Use for anything which blocks on file access.
+			template<typename Func, typename... Args>
+			static auto CreateIOTask(Func func, Args&&... args)
+			{
+				return CreateTaskWithPriority(TaskPriority::IO, std::move(func), std::forward<Args>(args)...);
+			}
 
-				std::shared_ptr<TaskWithResult<ResultType>> taskShared = std::make_shared<TaskWithResult<ResultType>>(taskResult, taskWrapper);
-			
-				if (TaskSystem::Instance().m_threads.size() > 0)
-				{
-					std::unique_lock lock(TaskSystem::Instance().m_mutex);
-					TaskSystem::Instance().m_queuedTasks.push(taskShared);
-					lock.unlock();
-				}
-				else
+			/// @brief Create a task which is only queued once 'predecessorCount' calls to 'SignalTask' have been made.
+			template<typename Func, typename... Args>
+			static auto CreateTaskWithPredecessorCount(const u32 predecessorCount, Func func, Args&&... args)
+			{
+				IS_PROFILE_FUNCTION();
+				auto task = MakeTask(TaskPriority::Normal, std::move(func), std::forward<Args>(args)...);
+				task->m_predecessorCount = predecessorCount;
+				if (predecessorCount == 0)
 				{
-					taskShared->Call();
+					ScheduleTask(task);
 				}
-				return taskShared;
+				return task;
 			}
 
-		private:
-			bool GetTask(std::shared_ptr<Task>& task);
-			static void ThreadWorker(ThreadData threadData);
-
-		private:
-			std::mutex m_mutex;
-			std::queue<std::shared_ptr<Task>> m_queuedTasks;
-			std::unordered_set<Task*> m_runningTasks;
-			std::vector<Thread> m_threads;
-
-			std::atomic<bool> m_destroy = false;
-		};
+			/// @brief Create a task which is queued once all 'predecessors' have completed. No thread blocks waiting.
+			template<typename Func, typename... Args>
+			static auto CreateDependentTask(const std::vector<std::shared_ptr<Task>>& predecessors, Func func, Args&&... args)
+			{
+				return CreateDependentTaskWithPriority(TaskPriority::Normal, predecessors, std::move(func), std::forward<Args>(args)...);
+			}
 
-		template<typename T>
-		void ParallelFor(const u32 workGroupSize, std::vector<T>& vec, std::function<void(T&)> func)
-		{
-			const u32 vecSize = static_cast<u32>(vec.size());
-			if (vecSize == 0)
+			template<typename Func, typename... Args>
+			static auto CreateDependentTaskWithPriority(const TaskPriority priority, const std::vector<std::shared_ptr<Task>>& predecessors, Func func, Args&&... args)
 			{
-				return;
+				IS_PROFILE_FUNCTION();
+				auto task = MakeTask(priority, std::move(func), std::forward<Args>(args)...);
+				AddPredecessors(task, predecessors);
+				return task;
 			}
 
-			// Store all the start indexes to be completed.
-			std::queue<u32> startIdxs;
-			std::mutex startIdxsMutex;
+			/// @brief Return a task which completes once all 'tasks' have completed.
+			static std::shared_ptr<Task> WhenAll(const std::vector<std::shared_ptr<Task>>& tasks);
+			/// @brief Return a task which completes once any of 'tasks' has completed.
+			static std::shared_ptr<Task> WhenAny(const std::vector<std::shared_ptr<Task>>& tasks);
+
+			/// @brief Satisfy one predecessor of a task created with 'CreateTaskWithPredecessorCount'.
+			static void SignalTask(const std::shared_ptr<Task>& task);
+
+			/// @brief Is the calling thread one of the TaskSystem's workers.
+			static bool IsWorkerThread();
+
+			/// @brief Try and run a single queued (non IO) task on the calling thread.
+			/// @return True if a task was run.
+			bool RunPendingTask();
 
-			const u32 taskNum = IntDivideRoundUp(vecSize, workGroupSize);
-			for (u32 taskIdx = 1; taskIdx < taskNum; ++taskIdx)
+		private:
+			template<typename Func, typename... Args>
+			static auto MakeTask(const TaskPriority priority, Func func, Args&&... args)
 			{
-				startIdxs.push(workGroupSize * taskIdx);
+				using ResultType = std::invoke_result_t<Func, Args...>;
+				using TaskType = TaskWithFunc<ResultType, Func, Args...>;
+				std::shared_ptr<TaskWithResult<ResultType>> task = std::allocate_shared<TaskType>(TaskPoolAllocator<TaskType>(), std::move(func), std::move(args)...);
+				task->m_priority = priority;
+				return task;
 			}
-			// Don't add index 0 as the caller thread will handle this range (0->workGroupSize). This should mean that the caller thread
-			// "always" has some of the most amount of work to do so we aren't wasting a lot of time just waiting.
-			// The caller thread should have some of the highest amount of work to do other wise it will be waiting for worker threads. 
-			// Really we want the worker threads to have less work so they can finish early and then move onto other work which has been queued.
-			//startIdxs.push(0);
-
-			std::vector<std::shared_ptr<Task>> tasks;
-			tasks.reserve(taskNum);
-
-			// Minus 1, as one of the worker threads will be the caller thread. The caller thread shouldn't be just waiting for work from other threads
-			// it should also be helping.
-			const u32 workerThreads = std::min(IntDivideRoundUp(vecSize, workGroupSize), TaskSystem::Instance().GetThreadCount()) - 1;
-			if (workerThreads > 0)
+
+			/// @brief Queue a task which has no outstanding predecessors. Runs inline if there are no threads for it.
+			static void ScheduleTask(std::shared_ptr<Task> task);
+			/// @brief Register 'predecessors' with 'task', queueing 'task' if all have already completed.
+			static void AddPredecessors(const std::shared_ptr<Task>& task, const std::vector<std::shared_ptr<Task>>& predecessors);
+
+			/// @brief Per worker state. Aligned so workers don't false share.
+			struct alignas(64) Worker
 			{
-				for (size_t threadIdx = 0; threadIdx < workerThreads; ++threadIdx)
-				{
-					// Kick off all our tasks. These will run on objects vec[0] + workGroupSize.
-					tasks.push_back(TaskSystem::Instance().CreateTask([&]()
-						{
-							while (true)
-							{
-								u32 startIdx = 0;
-								{
-									std::lock_guard l(startIdxsMutex);
-									if (startIdxs.empty())
-									{
-										break;
-									}
-									startIdx = startIdxs.front();
-									startIdxs.pop();
-								}
-								const u32 endIdx = std::min(startIdx + workGroupSize, vecSize);
-								IS_PROFILE_SCOPE("ParallelFor");
-								ZoneTextF("ParallelFor (%d)", endIdx - startIdx);
-
-								for (size_t i = startIdx; i < endIdx; ++i)
-								{
-									func(vec[i]);
-								}
-							}
-						}));
-				}
-			}
+				WorkStealingQueue<Task*, c_WorkerQueueCapacity> Queues[c_WorkerPriorityCount];
+			};
 
-			// Make sure the caller thread always does the items from 0->workGroupSize so it "should" have a "full"
-			// load of work.
-			bool completedIndexZero = false;
-			while (true)
+			struct alignas(64) PriorityCounters
 			{
-				u32 startIdx = 0;
-				if (completedIndexZero)
-				{
-					std::lock_guard l(startIdxsMutex);
-					if (startIdxs.empty())
-					{
-						break;
-					}
-					startIdx = startIdxs.front();
-					startIdxs.pop();
-				}
+				std::atomic<i64> QueueDepth = 0;
+				std::atomic<u64> ExecutedCount = 0;
+				std::atomic<u64> TotalDispatchLatencyNs = 0;
+				std::atomic<u64> MaxDispatchLatencyNs = 0;
+			};
+
+			void QueueTask(std::shared_ptr<Task> task);
+			bool GetTask(Task*& task, const u32 workerIndex);
+			bool GetTaskWithPriority(Task*& task, const u32 workerIndex, const u32 priorityIndex);
+			bool StealTask(Task*& task, const u32 workerIndex, const u32 priorityIndex);
+			void ExecuteTask(Task* task);
+			/// @brief Cancel a task which was queued but never started, releasing the queue's reference.
+			static void CancelQueuedTask(Task* task);
+			/// @brief Max number of background tasks allowed to run at once, so one worker is always free for other work.
+			u32 GetMaxRunningBackgroundTasks() const;
+
+			bool HasRunnableTask() const;
+			void WakeWorker();
+			void ParkWorker();
+			/// @brief Park a worker waiting on 'task' until it completes or there is work it can help with.
+			void ParkWorkerUntilComplete(const Task& task);
+			/// @brief Wake every parked worker so those waiting on a task which has just completed see it.
+			void WakeParkedWorkers();
 
-				completedIndexZero = true;
-				const u32 endIdx = std::min(startIdx + workGroupSize, vecSize);
-				IS_PROFILE_SCOPE("ParallelFor");
-				ZoneTextF("ParallelFor (%d)", endIdx - startIdx);
+			static void ThreadWorker(ThreadData threadData);
+			static void IOThreadWorker(ThreadData threadData);
 
-				for (size_t i = startIdx; i < endIdx; ++i)
-				{
-					func(vec[i]);
-				}
-			}
+		private:
+			std::vector<Thread> m_threads;
+			std::vector<Worker*> m_workers;
+			/// @brief Queues for tasks created from non worker threads (or when a worker queue is full).
+			MPMCQueue<Task*, c_GlobalQueueCapacity> m_globalQueues[c_WorkerPriorityCount];
 
-			// Wait for all other tasks to complete.
-			for (size_t taskIdx = 0; taskIdx < tasks.size(); ++taskIdx)
-			{
-				IS_PROFILE_SCOPE("Wait");
-				tasks[taskIdx]->Wait();
-			}
+			std::vector<Thread> m_ioThreads;
+			/// @brief IO threads sleep on this queue. A null task tells an IO thread to exit.
+			MPMCQueue<Task*, c_IOQueueCapacity, true> m_ioQueue;
+
+			PriorityCounters m_priorityCounters[static_cast<u32>(TaskPriority::Count)];
+			std::atomic<u32> m_runningBackgroundTaskCount = 0;
+
+			/// @brief Total number of tasks waiting to be picked up by any worker.
+			std::atomic<i64> m_queuedTaskCount = 0;
+
+			std::mutex m_parkMutex;
+			std::condition_variable m_parkCV;
+			std::atomic<u32> m_parkedThreadCount = 0;
+
+			std::atomic<bool> m_destroy = false;
+
+			friend class Task;
+		};
+
+		template<typename Func, typename... Args>
+		auto Task::Then(Func func, Args&&... args)
+		{
+			return TaskSystem::CreateDependentTaskWithPriority(m_priority, { shared_from_this() }, std::move(func), std::forward<Args>(args)...);
 		}
 	}
 }
\ No newline at end of file
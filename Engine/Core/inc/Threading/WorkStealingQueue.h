@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Core/Defines.h"
+#include "Core/TypeAlias.h"
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+namespace Insight
+{
+    namespace Threading
+    {
+        /// @brief Bounded lock free work stealing deque (Chase-Lev).
+        /// The owner thread pushes and pops from the bottom while any other thread can steal from the top.
+        /// Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Nardelli).
+        /// @tparam T Must be trivially copyable (normally a pointer).
+        /// @tparam Capacity Must be a power of two.
+        template<typename T, u64 Capacity>
+        class WorkStealingQueue
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "[WorkStealingQueue] T must be trivially copyable.");
+            static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "[WorkStealingQueue] Capacity must be a power of two.");
+
+        public:
+            WorkStealingQueue() = default;
+            WorkStealingQueue(const WorkStealingQueue&) = delete;
+            WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+            /// @brief Push an item onto the bottom of the queue. Must only be called by the owner thread.
+            /// @return False if the queue is full.
+            bool Push(const T item)
+            {
+                const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+                const i64 top = m_top.load(std::memory_order_acquire);
+                if (bottom - top >= static_cast<i64>(Capacity))
+                {
+                    return false;
+                }
+
+                m_buffer[bottom & c_Mask].store(item, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return true;
+            }
+
+            /// @brief Pop an item from the bottom of the queue. Must only be called by the owner thread.
+            bool Pop(T& item)
+            {
+                const i64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+                m_bottom.store(bottom, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                i64 top = m_top.load(std::memory_order_relaxed);
+
+                if (top > bottom)
+                {
+                    // Queue is empty.
+                    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                item = m_buffer[bottom & c_Mask].load(std::memory_order_relaxed);
+                if (top == bottom)
+                {
+                    // Last item, race any thieves for it.
+                    const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                    return won;
+                }
+                return true;
+            }
+
+            /// @brief Steal an item from the top of the queue. Can be called from any thread.
+            bool Steal(T& item)
+            {
+                i64 top = m_top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const i64 bottom = m_bottom.load(std::memory_order_acquire);
+
+                if (top >= bottom)
+                {
+                    return false;
+                }
+
+                item = m_buffer[top & c_Mask].load(std::memory_order_relaxed);
+                return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            }
+
+            /// @brief Approximate number of items within the queue.
+            u64 GetSize() const
+            {
+                const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+                const i64 top = m_top.load(std::memory_order_relaxed);
+                return bottom > top ? static_cast<u64>(bottom - top) : 0;
+            }
+
+            bool IsEmpty() const { return GetSize() == 0; }
+
+        private:
+            static constexpr i64 c_Mask = static_cast<i64>(Capacity) - 1;
+
+            /// @brief Separate cache lines for top and bottom so the owner and thieves don't false share.
+            alignas(64) std::atomic<i64> m_top = 0;
+            alignas(64) std::atomic<i64> m_bottom = 0;
+            alignas(64) std::array<std::atomic<T>, Capacity> m_buffer = { };
+        };
+    }
+}
@@ -99,6 +99,7 @@ function CoreConfig.FilterPlatforms(AMD_Ryzen_Master_SDK, OutputDir)
             "Ole32.lib",
             "dbghelp.lib",
             "Rpcrt4.lib",
+            "Synchronization.lib",
         }
 end
 
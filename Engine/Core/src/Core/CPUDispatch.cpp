@@ -0,0 +1,176 @@
+#include "Core/CPUDispatch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <vector>
+
+namespace Insight
+{
+	namespace Core
+	{
+		namespace
+		{
+			std::atomic<CPUInstructionSet> s_supported = CPUInstructionSet::Scalar;
+			std::atomic<CPUInstructionSet> s_active = CPUInstructionSet::Scalar;
+
+			std::mutex s_callbackLock;
+			std::vector<CPUDispatch::OnChangedFunc> s_callbacks;
+
+			void SetActive(const CPUInstructionSet instructionSet)
+			{
+				std::lock_guard lock(s_callbackLock);
+				s_active = instructionSet;
+				for (const CPUDispatch::OnChangedFunc& callback : s_callbacks)
+				{
+					callback(instructionSet);
+				}
+			}
+		}
+
+		CPUInstructionSet CPUInstructionSetFromString(std::string_view str)
+		{
+			for (u8 i = 0; i < static_cast<u8>(CPUInstructionSet::Count); ++i)
+			{
+				const std::string_view name = CPUInstructionSetToString(static_cast<CPUInstructionSet>(i));
+				if (std::equal(str.begin(), str.end(), name.begin(), name.end(),
+					[](const char a, const char b) { return std::tolower(a) == std::tolower(b); }))
+				{
+					return static_cast<CPUInstructionSet>(i);
+				}
+			}
+			return CPUInstructionSet::Count;
+		}
+
+		void CPUDispatch::Initialise(const CPUInformation& cpuInformation)
+		{
+			// The AVX-512 kernels are built with '/arch:AVX512', which can emit CD, BW, DQ and VL instructions as well as F.
+			const bool isAVX512 = cpuInformation.IsAVX512F && cpuInformation.IsAVX512CD && cpuInformation.IsAVX512BW
+				&& cpuInformation.IsAVX512DQ && cpuInformation.IsAVX512VL;
+
+			CPUInstructionSet supported = CPUInstructionSet::Scalar;
+			if (isAVX512 && cpuInformation.IsAVX2)
+			{
+				supported = CPUInstructionSet::AVX512;
+			}
+			else if (cpuInformation.IsAVX2 && cpuInformation.IsAVX)
+			{
+				supported = CPUInstructionSet::AVX2;
+			}
+			else if (cpuInformation.IsSSE42)
+			{
+				supported = CPUInstructionSet::SSE42;
+			}
+			s_supported = supported;
+			SetActive(supported);
+		}
+
+		CPUInstructionSet CPUDispatch::GetSupported()
+		{
+			return s_supported;
+		}
+
+		CPUInstructionSet CPUDispatch::GetActive()
+		{
+			return s_active.load(std::memory_order_relaxed);
+		}
+
+		CPUInstructionSet CPUDispatch::SetOverride(const CPUInstructionSet instructionSet)
+		{
+			const CPUInstructionSet active = std::min(instructionSet, GetSupported());
+			SetActive(active);
+			return active;
+		}
+
+		void CPUDispatch::ClearOverride()
+		{
+			SetActive(GetSupported());
+		}
+
+		void CPUDispatch::AddOnChangedCallback(OnChangedFunc callback)
+		{
+			std::lock_guard lock(s_callbackLock);
+			s_callbacks.push_back(callback);
+			callback(s_active);
+		}
+	}
+}
+
+#ifdef IS_TESTING
+#include "Platforms/Platform.h"
+
+#include "doctest.h"
+
+namespace test
+{
+	using namespace Insight::Core;
+
+	TEST_SUITE("CPUDispatch")
+	{
+		TEST_CASE("Instruction set from string")
+		{
+			CHECK(CPUInstructionSetFromString("avx2") == CPUInstructionSet::AVX2);
+			CHECK(CPUInstructionSetFromString("SSE4.2") == CPUInstructionSet::SSE42);
+			CHECK(CPUInstructionSetFromString("neon") == CPUInstructionSet::Count);
+		}
+
+		TEST_CASE("Overrides are clamped to the supported instruction set")
+		{
+			CPUInformation cpuInformation;
+			cpuInformation.IsSSE42 = true;
+			cpuInformation.IsAVX = true;
+			cpuInformation.IsAVX2 = true;
+			cpuInformation.IsAVX512F = true;
+			cpuInformation.IsAVX512CD = true;
+			cpuInformation.IsAVX512BW = true;
+			cpuInformation.IsAVX512DQ = true;
+			cpuInformation.IsAVX512VL = true;
+			CPUDispatch::Initialise(cpuInformation);
+			CHECK(CPUDispatch::GetSupported() == CPUInstructionSet::AVX512);
+
+			CHECK(CPUDispatch::SetOverride(CPUInstructionSet::SSE42) == CPUInstructionSet::SSE42);
+			CHECK(CPUDispatch::GetActive() == CPUInstructionSet::SSE42);
+			CPUDispatch::ClearOverride();
+			CHECK(CPUDispatch::GetActive() == CPUInstructionSet::AVX512);
+
+			// Overrides can't go above what the CPU supports.
+			cpuInformation.IsAVX512F = false;
+			CPUDispatch::Initialise(cpuInformation);
+			CHECK(CPUDispatch::SetOverride(CPUInstructionSet::AVX512) == CPUInstructionSet::AVX2);
+			CHECK(CPUDispatch::GetActive() == CPUInstructionSet::AVX2);
+
+			CPUDispatch::Initialise(CPUInformation());
+			CHECK(CPUDispatch::GetActive() == CPUInstructionSet::Scalar);
+
+			CPUDispatch::Initialise(Insight::Platform::GetCPUInformation());
+		}
+
+		TEST_CASE("AVX-512 needs every subset the kernels are built with")
+		{
+			CPUInformation cpuInformation;
+			cpuInformation.IsSSE42 = true;
+			cpuInformation.IsAVX = true;
+			cpuInformation.IsAVX2 = true;
+			cpuInformation.IsAVX512F = true;
+			CPUDispatch::Initialise(cpuInformation);
+			CHECK(CPUDispatch::GetSupported() == CPUInstructionSet::AVX2);
+			// 'cpu_instruction_set=AVX512' goes through 'SetOverride' and can't force it either.
+			CHECK(CPUDispatch::SetOverride(CPUInstructionSet::AVX512) == CPUInstructionSet::AVX2);
+			CHECK(CPUDispatch::GetActive() == CPUInstructionSet::AVX2);
+
+			cpuInformation.IsAVX512CD = true;
+			cpuInformation.IsAVX512BW = true;
+			cpuInformation.IsAVX512DQ = true;
+			CPUDispatch::Initialise(cpuInformation);
+			CHECK(CPUDispatch::GetSupported() == CPUInstructionSet::AVX2);
+
+			cpuInformation.IsAVX512VL = true;
+			CPUDispatch::Initialise(cpuInformation);
+			CHECK(CPUDispatch::GetSupported() == CPUInstructionSet::AVX512);
+
+			CPUDispatch::Initialise(Insight::Platform::GetCPUInformation());
+		}
+	}
+}
+#endif
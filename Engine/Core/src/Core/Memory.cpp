@@ -1,5 +1,6 @@
 #include "Core/Memory.h"
 #include "Core/MemoryTracker.h"
+#include "Memory/EngineHeap.h"
 
 namespace Insight::Memory
 {
@@ -12,11 +13,38 @@ namespace Insight::Memory
 	{
 		::Insight::Core::MemoryTracker::Instance().UnTrack(ptr);
 	}
+
+	void* HeapAllocate(const u64 size)
+	{
+#ifdef IS_ENGINE_HEAP
+		return ::Insight::Core::EngineHeap::Instance().Allocate(size);
+#else
+		return std::malloc(size);
+#endif
+	}
+
+	void* HeapReallocate(void* ptr, const u64 size)
+	{
+#ifdef IS_ENGINE_HEAP
+		return ::Insight::Core::EngineHeap::Instance().Reallocate(ptr, size);
+#else
+		return std::realloc(ptr, size);
+#endif
+	}
+
+	void HeapFree(void* ptr)
+	{
+#ifdef IS_ENGINE_HEAP
+		::Insight::Core::EngineHeap::Instance().Free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
 }
 
 void* NewBytes(u64 bytes, Insight::Core::MemoryAllocCategory memoryAllocCategory)
 {
-	void* ptr = std::malloc(bytes);
+	void* ptr = Insight::Memory::HeapAllocate(bytes);
 	Insight::Core::MemoryTracker::Instance().Track(ptr, bytes, memoryAllocCategory, Insight::Core::MemoryTrackAllocationType::Array);
 	return ptr;
 }
@@ -83,4 +111,133 @@ void* NewBytes(u64 bytes)
 //		}
 //	}
 //}
-#endif
\ No newline at end of file
+#endif
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+
+#include <array>
+#include <vector>
+
+namespace test
+{
+	struct RefCountedBase
+	{
+		virtual ~RefCountedBase() = default;
+		int Value = 0;
+	};
+
+	struct RefCountedDerived : public RefCountedBase
+	{
+		RefCountedDerived(int* destructCount, const int value)
+			: DestructCount(destructCount)
+		{
+			Value = value;
+		}
+		~RefCountedDerived() override { ++(*DestructCount); }
+
+		int* DestructCount = nullptr;
+	};
+
+	/// @brief Create 'objectCount' objects, copy every pointer 'copyCount' times then release them all.
+	/// @return Nanoseconds for the create, copy and release phases.
+	template<typename CreateFunc>
+	static std::array<double, 3> RunRPtrBenchmark(const u32 objectCount, const u32 copyCount, CreateFunc&& createFunc)
+	{
+		std::array<double, 3> timings = { };
+		std::vector<RPtr<RefCountedBase>> pointers;
+		pointers.reserve(objectCount);
+
+		Insight::Core::Timer timer;
+		timer.Start();
+		for (u32 i = 0; i < objectCount; ++i)
+		{
+			pointers.push_back(createFunc(i));
+		}
+		timer.Stop();
+		timings[0] = static_cast<double>(timer.GetElapsedTimeNano().count());
+
+		u64 sum = 0;
+		timer.Start();
+		for (u32 copyIdx = 0; copyIdx < copyCount; ++copyIdx)
+		{
+			for (const RPtr<RefCountedBase>& pointer : pointers)
+			{
+				RPtr<RefCountedBase> copy = pointer;
+				sum += copy->Value;
+			}
+		}
+		timer.Stop();
+		timings[1] = static_cast<double>(timer.GetElapsedTimeNano().count());
+		CHECK(sum != 0);
+
+		timer.Start();
+		pointers.clear();
+		timer.Stop();
+		timings[2] = static_cast<double>(timer.GetElapsedTimeNano().count());
+		return timings;
+	}
+
+	TEST_SUITE("Memory")
+	{
+		TEST_CASE("MakeRPtr shares the object between copies and destroys it once")
+		{
+			int destructCount = 0;
+			{
+				RPtr<RefCountedBase> base;
+				{
+					RPtr<RefCountedDerived> derived = MakeRPtr<RefCountedDerived>(&destructCount, 5);
+					base = derived;
+					CHECK(base.Get() == derived.Get());
+					CHECK(base->Value == 5);
+				}
+				CHECK(destructCount == 0);
+				CHECK(base->Value == 5);
+			}
+			CHECK(destructCount == 1);
+		}
+
+		TEST_CASE("MakeTObject destroys the object with the owner and keeps the count for non owning pointers")
+		{
+			int destructCount = 0;
+			TObjectOwnPtr<RefCountedDerived> owner = MakeTObject<RefCountedDerived>(&destructCount, 7);
+			TObjectPtr<RefCountedBase> view = owner;
+			CHECK(view);
+			CHECK(view->Value == 7);
+
+			owner.Reset();
+			CHECK(destructCount == 1);
+			CHECK(!view);
+			view.Reset();
+			CHECK(destructCount == 1);
+		}
+
+		TEST_CASE("RPtr control block benchmark")
+		{
+			constexpr u32 c_ObjectCount = 100'000;
+			constexpr u32 c_CopyCount = 10;
+			int destructCount = 0;
+
+			const std::array<double, 3> separate = RunRPtrBenchmark(c_ObjectCount, c_CopyCount, [&destructCount](const u32 i)
+				{
+					return RPtr<RefCountedBase>(New<RefCountedDerived>(&destructCount, static_cast<int>(i) + 1));
+				});
+			const std::array<double, 3> single = RunRPtrBenchmark(c_ObjectCount, c_CopyCount, [&destructCount](const u32 i)
+				{
+					return RPtr<RefCountedBase>(MakeRPtr<RefCountedDerived>(&destructCount, static_cast<int>(i) + 1));
+				});
+			CHECK(destructCount == c_ObjectCount * 2);
+
+			const double copyCount = static_cast<double>(c_ObjectCount) * c_CopyCount;
+			MESSAGE("Separate control block | allocations per object: 2"
+				<< " | create ns/object: " << separate[0] / c_ObjectCount
+				<< " | copy ns/ref: " << separate[1] / copyCount
+				<< " | release ns/object: " << separate[2] / c_ObjectCount);
+			MESSAGE("MakeRPtr single block  | allocations per object: 1"
+				<< " | create ns/object: " << single[0] / c_ObjectCount
+				<< " | copy ns/ref: " << single[1] / copyCount
+				<< " | release ns/object: " << single[2] / c_ObjectCount);
+		}
+	}
+}
+#endif
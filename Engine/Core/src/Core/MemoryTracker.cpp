@@ -6,11 +6,14 @@
 
 #include "Core/Profiler.h"
 #include "Core/Asserts.h"
+#include "Memory/AllocationTrace.h"
 
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <charconv>
+#include <cstdio>
+#include <new>
 
 
 #ifdef IS_PLATFORM_WINDOWS
@@ -29,6 +32,12 @@ namespace Insight
 {
     namespace Core
     {
+        namespace
+        {
+            /// @brief Bytes left to allocate on this thread before the next sampled allocation.
+            thread_local i64 t_bytesUntilSample = 0;
+        }
+
         MemoryTracker::~MemoryTracker()
         {
             Destroy();
@@ -37,13 +46,14 @@ namespace Insight
         void MemoryTracker::Initialise()
         {
 #ifdef IS_MEMORY_TRACKING
-            std::lock_guard lock(m_lock);
-            m_isReady = true;
-            for (size_t i = 0; i < static_cast<u64>(MemoryAllocCategory::Size); ++i)
+            for (Shard& shard : m_shards)
             {
-                m_categoryAllocationSizeBytes[i] = 0;
-                m_categoryAllocationCount[i] = 0;
+                std::lock_guard lock(shard.Lock);
+                shard.CategoryAllocationSizeBytes.fill(0);
+                shard.CategoryAllocationCount.fill(0);
+                shard.SampledAllocationCount = 0;
             }
+            m_isReady.store(true, std::memory_order_release);
 #endif
         }
 
@@ -52,62 +62,65 @@ namespace Insight
             IS_PROFILE_FUNCTION();
 
 #ifdef IS_MEMORY_TRACKING
-            std::lock_guard allocationLock(m_lock);
-            std::lock_guard allocationToNameLock(m_allocationToNameLock);
-
-            if (!m_isReady)
+            if (!m_isReady.exchange(false, std::memory_order_acq_rel))
             {
                 return;
             }
-            m_isReady = false;
 
-            if (m_allocations.size() > 0)
+            u64 totalAllocatedInBytes = 0;
+            std::array<char[c_CallstackStringSize], c_CallStackCount> callStackStrings;
+
+            for (Shard& shard : m_shards)
             {
-                for (const auto& pair : m_allocations)
+                std::lock_guard lock(shard.Lock);
+                std::lock_guard allocationToNameLock(m_allocationToNameLock);
+                shard.Allocations.ForEach([&](MemoryTrackedAlloc& alloc)
                 {
-                    const MemoryTrackedAlloc& alloc = pair.second;
+                    totalAllocatedInBytes += alloc.Size;
+
                     IS_LOG_CORE_ERROR("Allocation leak:");
                     IS_LOG_CORE_ERROR("\tPtr: {}", alloc.Ptr);
                     IS_LOG_CORE_ERROR("\tName: {}", m_allocationToName[alloc.Ptr]);
                     IS_LOG_CORE_ERROR("\tSize: {}", alloc.Size);
                     IS_LOG_CORE_ERROR("\tType: {}", (int)alloc.Type);
-                    IS_LOG_CORE_ERROR("\tCallstack: ");
-                    for (int i = c_CallStackCount - 1; i >= 0; --i)
+                    if (alloc.CallStack)
                     {
-                        const std::string& str = alloc.CallStack[i];
-                        if (str.empty() || str == "\0")
+                        IS_LOG_CORE_ERROR("\tCallstack: ");
+                        SymboliseCallStack(*alloc.CallStack, callStackStrings);
+                        for (int i = static_cast<int>(alloc.CallStack->Count) - 1; i >= 0; --i)
                         {
-                            continue;
+                            if (callStackStrings[i][0] == '\0')
+                            {
+                                continue;
+                            }
+                            IS_LOG_CORE_ERROR("\t\t{}", callStackStrings[i]);
                         }
-
-                        IS_LOG_CORE_ERROR("\t\t{}", str);
+                        ReleaseCallStack(alloc.CallStack);
                     }
-                }
+                });
+                shard.Allocations.Clear();
+                shard.CategoryAllocationSizeBytes.fill(0);
+                shard.CategoryAllocationCount.fill(0);
+                shard.SampledAllocationCount = 0;
             }
-            m_allocations = {};
 
             const char* TotalAllocatedBytesText = "Total allocated bytes: '{}'";
-            if (m_totalAllocatedInBytes > 0)
+            if (totalAllocatedInBytes > 0)
             {
-                IS_LOG_CORE_ERROR(TotalAllocatedBytesText, m_totalAllocatedInBytes);
+                IS_LOG_CORE_ERROR(TotalAllocatedBytesText, totalAllocatedInBytes);
             }
             else
             {
-                IS_LOG_CORE_INFO(TotalAllocatedBytesText, m_totalAllocatedInBytes);
-            }
-
-            m_totalAllocatedInBytes = 0;
-            for (size_t i = 0; i < static_cast<u64>(MemoryAllocCategory::Size); ++i)
-            {
-                m_categoryAllocationSizeBytes[i] = 0;
-                m_categoryAllocationCount[i] = 0;
+                IS_LOG_CORE_INFO(TotalAllocatedBytesText, totalAllocatedInBytes);
             }
 
+            std::lock_guard symbolLock(m_symbolLock);
             if (m_symInitialize)
             {
 #ifdef IS_PLATFORM_WINDOWS
                 SymCleanup(GetCurrentProcess());
 #endif
+                m_symInitialize = false;
             }
 #endif // IS_MEMORY_TRACKING
         }
@@ -119,31 +132,28 @@ namespace Insight
 
         void MemoryTracker::Track(void* ptr, u64 size, MemoryAllocCategory category, MemoryTrackAllocationType type)
         {
-            IS_PROFILE_FUNCTION();
-
+            // No profile scope, this is called for every allocation.
 #ifdef IS_MEMORY_TRACKING
-            std::unique_lock lock(m_lock);
-
-            if (!m_isReady)
+            if (!m_isReady.load(std::memory_order_acquire))
             {
                 return;
             }
 
-            auto itr = m_allocations.find(ptr);
-            //ASSERT(itr == m_allocations.end());
-            if (itr == m_allocations.end())
-            {
-                lock.unlock();
-                MemoryTrackedAlloc memoryTrackedAlloc(ptr, size, category, type, GetCallStack());
-
-                lock.lock();
-                m_allocations[ptr] = memoryTrackedAlloc;
-                
-                m_totalAllocatedInBytes += size;
-                m_categoryAllocationSizeBytes.at(static_cast<u64>(category)) += size;
-                ++m_categoryAllocationCount.at(static_cast<u64>(category));
+            // Capture outside of the shard lock, capturing is by far the most expensive part of tracking.
+            MemoryTrackedCallStack* callStack = ShouldSample(size) ? CaptureCallStack() : nullptr;
 
+            Shard& shard = GetShard(ptr);
+            std::unique_lock lock(shard.Lock);
+            if (shard.Allocations.Insert(MemoryTrackedAlloc(ptr, size, category, type, callStack)))
+            {
+                shard.CategoryAllocationSizeBytes[static_cast<u64>(category)] += size;
+                ++shard.CategoryAllocationCount[static_cast<u64>(category)];
+                shard.SampledAllocationCount += callStack ? 1 : 0;
                 lock.unlock();
+                if (AllocationTrace::IsRecording())
+                {
+                    AllocationTrace::RecordAllocation(ptr, size);
+                }
 #ifdef IS_PROFILE_TRACY
                 TracyAlloc(ptr, size);
 #endif
@@ -151,31 +161,38 @@ namespace Insight
             else
             {
                 lock.unlock();
+                ReleaseCallStack(callStack);
             }
 #endif // IS_MEMORY_TRACKING
         }
 
         void MemoryTracker::UnTrack(void* ptr)
         {
-            IS_PROFILE_FUNCTION();
-
 #ifdef IS_MEMORY_TRACKING
-            std::lock_guard lock(m_lock);
-
-            if (!m_isReady)
+            if (!m_isReady.load(std::memory_order_acquire))
             {
                 return;
             }
 
-            auto itr = m_allocations.find(ptr);
-            ASSERT(itr != m_allocations.end());
-            if (itr != m_allocations.end())
+            Shard& shard = GetShard(ptr);
+            std::unique_lock lock(shard.Lock);
+            MemoryTrackedAlloc* alloc = shard.Allocations.Find(ptr);
+            ASSERT(alloc != nullptr);
+            if (alloc)
             {
-                m_categoryAllocationSizeBytes.at(static_cast<u64>(itr->second.Category)) -= itr->second.Size;
-                --m_categoryAllocationCount.at(static_cast<u64>(itr->second.Category));
-                m_totalAllocatedInBytes -= itr->second.Size;
+                shard.CategoryAllocationSizeBytes[static_cast<u64>(alloc->Category)] -= alloc->Size;
+                --shard.CategoryAllocationCount[static_cast<u64>(alloc->Category)];
+
+                MemoryTrackedCallStack* callStack = alloc->CallStack;
+                shard.SampledAllocationCount -= callStack ? 1 : 0;
+                shard.Allocations.Erase(alloc);
+                lock.unlock();
 
-                m_allocations.erase(itr);
+                ReleaseCallStack(callStack);
+                if (AllocationTrace::IsRecording())
+                {
+                    AllocationTrace::RecordFree(ptr);
+                }
 #ifdef IS_PROFILE_TRACY
                 TracyFree(ptr);
 #endif
@@ -185,24 +202,32 @@ namespace Insight
 
         void MemoryTracker::NameAllocation(void* ptr, const char* name)
         {
-            std::lock_guard allocationLock(m_lock);
+            Shard& shard = GetShard(ptr);
+            std::lock_guard allocationLock(shard.Lock);
             std::lock_guard allocationToNameLock(m_allocationToNameLock);
-            if (auto iter = m_allocations.find(ptr);
-                iter != m_allocations.end())
+            if (shard.Allocations.Find(ptr))
             {
                 m_allocationToName[ptr] = name;
             }
         }
 
+        void MemoryTracker::SetSampleRate(u64 sampleRate)
+        {
+            m_sampleRate.store(sampleRate, std::memory_order_relaxed);
+        }
+
+        u64 MemoryTracker::GetSampleRate() const
+        {
+            return m_sampleRate.load(std::memory_order_relaxed);
+        }
+
         u64 MemoryTracker::GetUsage(MemoryAllocCategory category) const
         {
             if (category == MemoryAllocCategory::Size)
             {
                 return 0;
             }
-
-            std::lock_guard lock(m_lock);
-            return m_categoryAllocationSizeBytes.at(static_cast<u64>(category));
+            return SumShards([category](const Shard& shard) { return shard.CategoryAllocationSizeBytes[static_cast<u64>(category)]; });
         }
 
         u64 MemoryTracker::GetTotalNumberOfAllocationsForCategory(MemoryAllocCategory category) const
@@ -211,152 +236,487 @@ namespace Insight
             {
                 return 0;
             }
-            std::lock_guard lock(m_lock);
-            return m_categoryAllocationCount.at(static_cast<u64>(category));
+            return SumShards([category](const Shard& shard) { return shard.CategoryAllocationCount[static_cast<u64>(category)]; });
+        }
+
+        void MemoryTracker::GetCategoryUsage(std::array<u64, static_cast<u64>(MemoryAllocCategory::Size)>& usage) const
+        {
+            usage.fill(0);
+            for (const Shard& shard : m_shards)
+            {
+                std::lock_guard lock(shard.Lock);
+                for (u64 i = 0; i < usage.size(); ++i)
+                {
+                    usage[i] += shard.CategoryAllocationSizeBytes[i];
+                }
+            }
         }
 
         u64 MemoryTracker::GetTotalNumberOfAllocations() const
         {
-            std::lock_guard lock(m_lock);
-            return m_allocations.size();
+            return SumShards([](const Shard& shard) { return shard.Allocations.GetSize(); });
         }
 
         u64 MemoryTracker::GetTotalAllocatedInBytes() const
         {
-            std::lock_guard lock(m_lock);
-            return m_totalAllocatedInBytes;
+            return SumShards([](const Shard& shard)
+                {
+                    u64 total = 0;
+                    for (const u64 bytes : shard.CategoryAllocationSizeBytes)
+                    {
+                        total += bytes;
+                    }
+                    return total;
+                });
+        }
+
+        u64 MemoryTracker::GetTotalNumberOfSampledAllocations() const
+        {
+            return SumShards([](const Shard& shard) { return shard.SampledAllocationCount; });
         }
 
 //#define MEMORY_TRACK_CALLSTACK
         std::array<char[c_CallstackStringSize], c_CallStackCount> MemoryTracker::GetCallStack()
         {
             IS_PROFILE_FUNCTION();
-            ///std::vector<std::string> callStackVector = Platform::GetCallStack(c_CallStackCount);
             std::array<char[c_CallstackStringSize], c_CallStackCount> callStack;
             for (size_t i = 0; i < c_CallStackCount; ++i)
             {
                 callStack[i][0] = '\0';
             }
 
-#ifndef MEMORY_TRACK_CALLSTACK
-            return callStack;
-#else
-            std::unique_lock lock(m_lock);
-            if (!m_isReady)
+#if defined(IS_MEMORY_TRACKING) && defined(MEMORY_TRACK_CALLSTACK)
+            if (m_isReady.load(std::memory_order_acquire))
             {
-                lock.unlock();
-                return callStack;
+                if (MemoryTrackedCallStack* capturedCallStack = CaptureCallStack())
+                {
+                    SymboliseCallStack(*capturedCallStack, callStack);
+                    ReleaseCallStack(capturedCallStack);
+                }
             }
-            lock.unlock();
 #endif
+            return callStack;
+        }
 
-#ifdef IS_MEMORY_TRACKING
-            /// TOOD: Think of a better way to have this supported. Would be nice to have this. Maybe a call stack should only be gotten
-            /// if there is a crash? Look at third party options for getting the callstack. Disabled for non debug due to performance.
-#if defined(IS_PLATFORM_WINDOWS) && defined(MEMORY_TRACK_CALLSTACK)
+        MemoryTracker::AllocationTable::~AllocationTable()
+        {
+            Clear();
+        }
+
+        bool MemoryTracker::AllocationTable::Insert(const MemoryTrackedAlloc& alloc)
+        {
+            // Keep the load under 3/4 so probes stay short.
+            if ((m_count + 1) * 4 > m_capacity * 3)
+            {
+                Rehash(std::max<u64>(m_capacity * 2, 64));
+            }
+
+            const u64 mask = m_capacity - 1;
+            for (u64 index = GetSlotIndex(alloc.Ptr);; index = (index + 1) & mask)
+            {
+                MemoryTrackedAlloc& slot = m_slots[index];
+                if (slot.Ptr == alloc.Ptr)
+                {
+                    return false;
+                }
+                if (slot.Ptr == nullptr)
+                {
+                    slot = alloc;
+                    ++m_count;
+                    return true;
+                }
+            }
+        }
+
+        MemoryTrackedAlloc* MemoryTracker::AllocationTable::Find(const void* ptr) const
+        {
+            if (m_count == 0)
+            {
+                return nullptr;
+            }
+
+            const u64 mask = m_capacity - 1;
+            for (u64 index = GetSlotIndex(ptr);; index = (index + 1) & mask)
+            {
+                MemoryTrackedAlloc& slot = m_slots[index];
+                if (slot.Ptr == ptr)
+                {
+                    return &slot;
+                }
+                if (slot.Ptr == nullptr)
+                {
+                    return nullptr;
+                }
+            }
+        }
+
+        void MemoryTracker::AllocationTable::Erase(MemoryTrackedAlloc* alloc)
+        {
+            ASSERT(alloc >= m_slots && alloc < m_slots + m_capacity);
+            const u64 mask = m_capacity - 1;
+            u64 emptyIndex = static_cast<u64>(alloc - m_slots);
+
+            // Shift following entries back into the hole, unless doing so would move them before their home slot.
+            for (u64 index = (emptyIndex + 1) & mask; IsOccupied(m_slots[index]); index = (index + 1) & mask)
+            {
+                const u64 homeIndex = GetSlotIndex(m_slots[index].Ptr);
+                const u64 distanceFromHome = (index - homeIndex) & mask;
+                const u64 distanceToEmpty = (index - emptyIndex) & mask;
+                if (distanceFromHome >= distanceToEmpty)
+                {
+                    m_slots[emptyIndex] = m_slots[index];
+                    emptyIndex = index;
+                }
+            }
+            m_slots[emptyIndex] = MemoryTrackedAlloc();
+            --m_count;
+        }
+
+        void MemoryTracker::AllocationTable::Clear()
+        {
+            if (m_slots)
+            {
+                ::DeleteNoTrack(m_slots);
+            }
+            m_slots = nullptr;
+            m_capacity = 0;
+            m_count = 0;
+        }
+
+        u64 MemoryTracker::AllocationTable::GetSlotIndex(const void* ptr) const
+        {
+            // Shards use the upper bits of the same hash, take the lower bits so entries spread within a shard.
+            const u64 hash = (reinterpret_cast<u64>(ptr) >> 4) * 0x9E3779B97F4A7C15ull;
+            return (hash ^ (hash >> 29)) & (m_capacity - 1);
+        }
+
+        void MemoryTracker::AllocationTable::Rehash(const u64 newCapacity)
+        {
+            ASSERT((newCapacity & (newCapacity - 1)) == 0);
+            MemoryTrackedAlloc* oldSlots = m_slots;
+            const u64 oldCapacity = m_capacity;
+
+            m_slots = static_cast<MemoryTrackedAlloc*>(::NewNoTrack(sizeof(MemoryTrackedAlloc) * newCapacity));
+            for (u64 i = 0; i < newCapacity; ++i)
+            {
+                new (&m_slots[i]) MemoryTrackedAlloc();
+            }
+            m_capacity = newCapacity;
+            m_count = 0;
 
-            // Skip the two stack frames which are included because of the calls within MemoryTracker. 
+            for (u64 i = 0; i < oldCapacity; ++i)
+            {
+                if (IsOccupied(oldSlots[i]))
+                {
+                    Insert(oldSlots[i]);
+                }
+            }
+            if (oldSlots)
+            {
+                ::DeleteNoTrack(oldSlots);
+            }
+        }
+
+        MemoryTracker::Shard& MemoryTracker::GetShard(const void* ptr)
+        {
+            static_assert((c_ShardCount & (c_ShardCount - 1)) == 0, "[MemoryTracker] c_ShardCount must be a power of two.");
+            // Allocations are at least 16 byte aligned, drop the low bits and mix so neighbouring blocks spread across shards.
+            const u64 address = reinterpret_cast<u64>(ptr) >> 4;
+            const u64 hash = address * 0x9E3779B97F4A7C15ull;
+            return m_shards[(hash >> 32) & (c_ShardCount - 1)];
+        }
+
+        bool MemoryTracker::ShouldSample(const u64 size) const
+        {
+            const u64 sampleRate = m_sampleRate.load(std::memory_order_relaxed);
+            if (sampleRate == 0)
+            {
+                return false;
+            }
+
+            // The rate may have been lowered since this thread last sampled.
+            t_bytesUntilSample = std::min(t_bytesUntilSample, static_cast<i64>(sampleRate));
+            t_bytesUntilSample -= static_cast<i64>(size);
+            if (t_bytesUntilSample > 0)
+            {
+                return false;
+            }
+            t_bytesUntilSample = static_cast<i64>(sampleRate);
+            return true;
+        }
+
+        MemoryTrackedCallStack* MemoryTracker::CaptureCallStack() const
+        {
+            MemoryTrackedCallStack* callStack = static_cast<MemoryTrackedCallStack*>(::NewNoTrack(sizeof(MemoryTrackedCallStack)));
+            new (callStack) MemoryTrackedCallStack();
+#ifdef IS_PLATFORM_WINDOWS
+            // Skip the frames within MemoryTracker.
             const ULONG framesToSkip = 2;
-            const ULONG framesToCapture = c_CallStackCount;
-            void* backTrace[framesToCapture]{};
-            ULONG backTraceHash = 0;
+            callStack->Count = CaptureStackBackTrace(framesToSkip, c_CallStackCount, callStack->ReturnAddresses.data(), nullptr);
+#endif
+            return callStack;
+        }
 
-            SYMBOL_INFO* symbol = nullptr;
-            static HANDLE process = nullptr;
-            if (!process)
+        void MemoryTracker::SymboliseCallStack(const MemoryTrackedCallStack& callStack, std::array<char[c_CallstackStringSize], c_CallStackCount>& callStackStrings)
+        {
+            IS_PROFILE_FUNCTION();
+            for (size_t i = 0; i < c_CallStackCount; ++i)
             {
-                process = GetCurrentProcess();
+                callStackStrings[i][0] = '\0';
             }
 
+#ifdef IS_PLATFORM_WINDOWS
+            std::lock_guard lock(m_symbolLock);
+            HANDLE process = GetCurrentProcess();
             if (!m_symInitialize)
             {
                 m_symInitialize = SymInitialize(process, NULL, TRUE);
             }
 
-            const USHORT nFrame = CaptureStackBackTrace(
-                framesToSkip
-                , framesToCapture
-                , backTrace
-                , &backTraceHash
-            );
+            constexpr u64 c_MaxNameLength = 255;
+            alignas(SYMBOL_INFO) char symbolBuffer[sizeof(SYMBOL_INFO) + (c_MaxNameLength + 1) * sizeof(char)] = { };
+            SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(symbolBuffer);
+            symbol->MaxNameLen = c_MaxNameLength;
+            symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
 
-            symbol = (SYMBOL_INFO*)calloc(sizeof(SYMBOL_INFO) + 256 * sizeof(char), 1);
-            if (symbol)
+            for (u32 i = 0; i < callStack.Count; ++i)
             {
-                symbol->MaxNameLen = 255;
-                symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+                if (!SymFromAddr(process, reinterpret_cast<DWORD64>(callStack.ReturnAddresses[i]), 0, symbol))
+                {
+                    continue;
+                }
+                snprintf(callStackStrings[i], c_CallstackStringSize, "%u: %s - 0x%llX", callStack.Count - i, symbol->Name, symbol->Address);
+            }
+#else
+            IS_UNUSED(callStack);
+#endif
+        }
+
+        void MemoryTracker::ReleaseCallStack(MemoryTrackedCallStack*& callStack) const
+        {
+            if (callStack)
+            {
+                callStack->~MemoryTrackedCallStack();
+                ::DeleteNoTrack(callStack);
+                callStack = nullptr;
+            }
+        }
+    }
+}
+
+#if defined(IS_TESTING) && defined(IS_MEMORY_TRACKING)
+#include "doctest.h"
+#include "Core/Timer.h"
 
-                for (int i = 0; i < nFrame; ++i)
+#include <thread>
+#include <vector>
+
+namespace test
+{
+    using namespace Insight;
+    using namespace Insight::Core;
+
+    /// @brief Single lock, single map tracker with an inline call stack per entry. The layout MemoryTracker used
+    /// before it was sharded, used as the benchmark baseline.
+    struct GlobalLockTracker
+    {
+        struct Entry
+        {
+            std::array<char[c_CallstackStringSize], c_CallStackCount> CallStack;
+            u64 Size;
+            MemoryAllocCategory Category;
+        };
+
+        void Track(void* ptr, const u64 size, const MemoryAllocCategory category)
+        {
+            Entry entry;
+            entry.CallStack[0][0] = '\0';
+            entry.Size = size;
+            entry.Category = category;
+
+            std::lock_guard lock(Lock);
+            Allocations[ptr] = entry;
+            CategoryBytes[static_cast<u64>(category)] += size;
+        }
+        void UnTrack(void* ptr)
+        {
+            std::lock_guard lock(Lock);
+            if (auto itr = Allocations.find(ptr); itr != Allocations.end())
+            {
+                CategoryBytes[static_cast<u64>(itr->second.Category)] -= itr->second.Size;
+                Allocations.erase(itr);
+            }
+        }
+
+        std::mutex Lock;
+        std::unordered_map<void*, Entry, std::hash<void*>, std::equal_to<void*>, STLNonTrackingAllocator<std::pair<void* const, Entry>>> Allocations;
+        std::array<u64, static_cast<u64>(MemoryAllocCategory::Size)> CategoryBytes = { };
+    };
+
+    /// @brief Each thread keeps 'liveCount' allocations alive and replaces them round robin 'iterations' times.
+    /// @return Nanoseconds taken.
+    template<typename TrackFunc, typename UnTrackFunc>
+    static double RunAllocationLoop(const u32 threadCount, const u32 iterations, TrackFunc&& trackFunc, UnTrackFunc&& unTrackFunc)
+    {
+        constexpr u32 c_LiveCount = 256;
+        std::vector<std::thread> threads;
+        Timer timer;
+        timer.Start();
+        for (u32 threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+        {
+            threads.emplace_back([&, threadIdx]()
                 {
-                    if (!SymFromAddr(process, (DWORD64)(backTrace[i]), 0, symbol))
+                    std::array<void*, c_LiveCount> live = { };
+                    for (u32 i = 0; i < iterations; ++i)
                     {
-                        Platform::MemSet(callStack[i], '\0', c_CallstackStringSize);
-                        continue;
+                        const u32 slot = i % c_LiveCount;
+                        if (live[slot])
+                        {
+                            unTrackFunc(live[slot]);
+                            ::DeleteNoTrack(live[slot]);
+                        }
+                        const u64 size = 16 + ((i * 7 + threadIdx) % 64) * 16;
+                        live[slot] = ::NewNoTrack(size);
+                        trackFunc(live[slot], size, static_cast<MemoryAllocCategory>(i % static_cast<u32>(MemoryAllocCategory::Size)));
                     }
-
-                    //std::stringstream hexAddressStream;
-                    //hexAddressStream << std::hex << symbol->Address;
-                    //std::string hexAddress = hexAddressStream.str();
-                    //std::transform(hexAddress.begin(), hexAddress.end(), hexAddress.begin(), [](const char c)
-                    //    {
-                    //        return std::toupper(c);
-                    //    });
-
-#define ADVANCE_CHAR(cPtr, lPtr) \
-if (cPtr == lPtr) \
-{ \
-    IS_LOG_CORE_ERROR("[MemoryTracker::GetCallStack] Call stack string size is too small."); \
-    DEBUG_BREAK; \
-    break; \
-} \
-else \
-{ \
-    ++cPtr; \
-} 
-                    char* firstChar = callStack[i];
-                    char* lastChar = callStack[i] + (c_CallstackStringSize - 1ull);
-                    char* currentChar = callStack[i];
-
-                    currentChar = std::to_chars(currentChar, lastChar, nFrame - i).ptr;
-                    *currentChar = ':';
-                    ADVANCE_CHAR(currentChar, lastChar);
-                    *currentChar = ' ';
-                    ADVANCE_CHAR(currentChar, lastChar);
-                    
-                    u64 strlen = strnlen_s(symbol->Name, lastChar - currentChar);
-                    Platform::MemCopy(currentChar, symbol->Name, strlen);
-                    currentChar += strlen;
-
-                    *currentChar = ' ';
-                    ADVANCE_CHAR(currentChar, lastChar);
-                    *currentChar = '-';
-                    ADVANCE_CHAR(currentChar, lastChar);
-                    *currentChar = ' ';
-                    ADVANCE_CHAR(currentChar, lastChar);
-
-                    currentChar = std::to_chars(currentChar, lastChar, symbol->Address).ptr;
-
-                    if (currentChar < lastChar)
+                    for (void*& ptr : live)
                     {
-                        *currentChar = '\0';
+                        if (ptr)
+                        {
+                            unTrackFunc(ptr);
+                            ::DeleteNoTrack(ptr);
+                        }
                     }
-                    else
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        timer.Stop();
+        return static_cast<double>(timer.GetElapsedTimeNano().count());
+    }
+
+    TEST_SUITE("MemoryTracker")
+    {
+        TEST_CASE("Per category accounting across threads")
+        {
+            MemoryTracker tracker;
+            tracker.Initialise();
+
+            constexpr u32 c_ThreadCount = 8;
+            constexpr u32 c_AllocationsPerThread = 1'000;
+            std::vector<std::vector<void*>> allocations(c_ThreadCount);
+            std::vector<std::thread> threads;
+            for (u32 threadIdx = 0; threadIdx < c_ThreadCount; ++threadIdx)
+            {
+                threads.emplace_back([&tracker, &allocations, threadIdx]()
                     {
-                        lastChar = '\0';
-                    }
+                        for (u32 i = 0; i < c_AllocationsPerThread; ++i)
+                        {
+                            void* ptr = ::NewNoTrack(32);
+                            tracker.Track(ptr, 32, MemoryAllocCategory::Graphics, MemoryTrackAllocationType::Single);
+                            allocations[threadIdx].push_back(ptr);
+                        }
+                    });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
 
-                    //callStack[i - 1] = (std::to_string(nFrame - i - 1) +
-                    //    ": " +
-                    //    std::string(symbol->Name) +
-                    //    " - 0x" +
-                    //    hexAddress);
-#undef OUT_OF_BOUNDS_CHECK
-                }
-                free(symbol);
+            CHECK(tracker.GetTotalNumberOfAllocations() == c_ThreadCount * c_AllocationsPerThread);
+            CHECK(tracker.GetTotalNumberOfAllocationsForCategory(MemoryAllocCategory::Graphics) == c_ThreadCount * c_AllocationsPerThread);
+            CHECK(tracker.GetUsage(MemoryAllocCategory::Graphics) == c_ThreadCount * c_AllocationsPerThread * 32);
+            CHECK(tracker.GetUsage(MemoryAllocCategory::General) == 0);
+
+            // Free on a different thread from the one which allocated.
+            threads.clear();
+            for (u32 threadIdx = 0; threadIdx < c_ThreadCount; ++threadIdx)
+            {
+                threads.emplace_back([&tracker, &allocations, threadIdx]()
+                    {
+                        for (void* ptr : allocations[(threadIdx + 1) % c_ThreadCount])
+                        {
+                            tracker.UnTrack(ptr);
+                            ::DeleteNoTrack(ptr);
+                        }
+                    });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            CHECK(tracker.GetTotalNumberOfAllocations() == 0);
+            CHECK(tracker.GetTotalAllocatedInBytes() == 0);
+            tracker.Destroy();
+        }
+
+        TEST_CASE("Sampling captures one allocation per sample rate bytes")
+        {
+            MemoryTracker tracker;
+            tracker.Initialise();
+            tracker.SetSampleRate(1_KB);
+
+            std::vector<void*> allocations;
+            for (u32 i = 0; i < 1024; ++i)
+            {
+                void* ptr = ::NewNoTrack(64);
+                tracker.Track(ptr, 64, MemoryAllocCategory::General, MemoryTrackAllocationType::Single);
+                allocations.push_back(ptr);
+            }
+            // 64KB allocated with a sample every 1KB. The first sample may land anywhere within the first 1KB.
+            const u64 sampledCount = tracker.GetTotalNumberOfSampledAllocations();
+            CHECK(sampledCount >= 63);
+            CHECK(sampledCount <= 65);
+            CHECK(tracker.GetTotalNumberOfAllocations() == 1024);
+
+            for (void* ptr : allocations)
+            {
+                tracker.UnTrack(ptr);
+                ::DeleteNoTrack(ptr);
+            }
+            CHECK(tracker.GetTotalNumberOfSampledAllocations() == 0);
+            tracker.Destroy();
+        }
+
+        TEST_CASE("Tracking overhead 1-16 threads")
+        {
+            constexpr u32 c_Iterations = 200'000;
+            const u32 threadCounts[] = { 1, 4, 8, 16 };
+            for (const u32 threadCount : threadCounts)
+            {
+                const double untracked = RunAllocationLoop(threadCount, c_Iterations
+                    , [](void*, const u64, const MemoryAllocCategory) { }
+                    , [](void*) { });
+
+                GlobalLockTracker globalLockTracker;
+                const double globalLock = RunAllocationLoop(threadCount, c_Iterations
+                    , [&globalLockTracker](void* ptr, const u64 size, const MemoryAllocCategory category) { globalLockTracker.Track(ptr, size, category); }
+                    , [&globalLockTracker](void* ptr) { globalLockTracker.UnTrack(ptr); });
+
+                MemoryTracker shardedTracker;
+                shardedTracker.Initialise();
+                shardedTracker.SetSampleRate(0);
+                const double sharded = RunAllocationLoop(threadCount, c_Iterations
+                    , [&shardedTracker](void* ptr, const u64 size, const MemoryAllocCategory category) { shardedTracker.Track(ptr, size, category, MemoryTrackAllocationType::Single); }
+                    , [&shardedTracker](void* ptr) { shardedTracker.UnTrack(ptr); });
+
+                shardedTracker.SetSampleRate(512_KB);
+                const double shardedSampled = RunAllocationLoop(threadCount, c_Iterations
+                    , [&shardedTracker](void* ptr, const u64 size, const MemoryAllocCategory category) { shardedTracker.Track(ptr, size, category, MemoryTrackAllocationType::Single); }
+                    , [&shardedTracker](void* ptr) { shardedTracker.UnTrack(ptr); });
+                shardedTracker.Destroy();
+
+                const double operationCount = static_cast<double>(threadCount) * c_Iterations;
+                MESSAGE("Threads: " << threadCount
+                    << " | untracked ns/alloc: " << untracked / operationCount
+                    << " | global lock ns/alloc: " << globalLock / operationCount
+                    << " | sharded ns/alloc: " << sharded / operationCount
+                    << " | sharded + 512KB sampling ns/alloc: " << shardedSampled / operationCount);
             }
-#endif
-#endif // IS_MEMORY_TRACKING
-            return callStack;
         }
     }
-}
\ No newline at end of file
+}
+#endif
@@ -4,6 +4,8 @@
 
 #include "Algorithm/Vector.h"
 
+#include <iterator>
+
 namespace Insight
 {
 	namespace Core
@@ -38,8 +40,16 @@ namespace Insight
 
 		void EventSystem::DispatchEvent(RPtr<Event> e)
 		{
-			std::lock_guard queuedEventsLock(m_queuedEventsLock);
-			m_queuedEvents.push_back(std::move(e));
+			// Once the queue has overflowed, keep adding to the overflow so events stay in order.
+			if (!m_hasOverflowEvents.load(std::memory_order_acquire)
+				&& m_queuedEvents.TryPush(std::move(e)))
+			{
+				return;
+			}
+
+			std::lock_guard overflowLock(m_overflowEventsLock);
+			m_overflowEvents.push_back(std::move(e));
+			m_hasOverflowEvents.store(true, std::memory_order_release);
 		}
 
 		void EventSystem::DispatchEventNow(RPtr<Event> e)
@@ -55,9 +65,24 @@ namespace Insight
 		void EventSystem::Update()
 		{
 			std::vector<RPtr<Event>> eventsToEvaluate;
+			eventsToEvaluate.reserve(m_queuedEvents.GetSize());
+			RPtr<Event> queuedEvent;
+			while (m_queuedEvents.TryPop(queuedEvent))
 			{
-				std::lock_guard queuedEventsLock(m_queuedEventsLock);
-				eventsToEvaluate = std::move(m_queuedEvents);
+				eventsToEvaluate.push_back(std::move(queuedEvent));
+			}
+			if (m_hasOverflowEvents.load(std::memory_order_acquire))
+			{
+				std::lock_guard overflowLock(m_overflowEventsLock);
+				// Anything pushed to the queue before the overflow flag was seen is older than the overflow events.
+				while (m_queuedEvents.TryPop(queuedEvent))
+				{
+					eventsToEvaluate.push_back(std::move(queuedEvent));
+				}
+				eventsToEvaluate.insert(eventsToEvaluate.end(),
+					std::make_move_iterator(m_overflowEvents.begin()), std::make_move_iterator(m_overflowEvents.end()));
+				m_overflowEvents.clear();
+				m_hasOverflowEvents.store(false, std::memory_order_release);
 			}
 			DiscardOutOfDateEvente(eventsToEvaluate);
 
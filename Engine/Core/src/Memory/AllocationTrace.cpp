@@ -0,0 +1,165 @@
+#include "Memory/AllocationTrace.h"
+
+#include "Core/MemoryTracker.h"
+#include "Core/Logger.h"
+
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+namespace Insight::Core
+{
+	namespace
+	{
+		constexpr u32 c_TraceFileMagic = 0x54415349; // "ISAT"
+		constexpr u32 c_TraceFileVersion = 1;
+
+		/// @brief Recording state. Containers use 'STLNonTrackingAllocator' as they are written to from within
+		/// allocation tracking.
+		struct TraceState
+		{
+			std::mutex Lock;
+			std::vector<AllocationTraceEvent, STLNonTrackingAllocator<AllocationTraceEvent>> Events;
+			std::unordered_map<const void*, u64, std::hash<const void*>, std::equal_to<const void*>
+				, STLNonTrackingAllocator<std::pair<const void* const, u64>>> LiveAllocations;
+			u64 NextAllocationId = 0;
+			/// @brief Incremented per recording so thread indices are reassigned.
+			u32 Generation = 0;
+			u32 ThreadCount = 0;
+		};
+
+		TraceState& GetTraceState()
+		{
+			static TraceState state;
+			return state;
+		}
+
+		thread_local u32 t_threadGeneration = 0;
+		thread_local u32 t_threadIndex = 0;
+
+		/// @brief Must be called with the trace lock held.
+		u32 GetThreadIndex(TraceState& state)
+		{
+			if (t_threadGeneration != state.Generation)
+			{
+				t_threadGeneration = state.Generation;
+				t_threadIndex = state.ThreadCount++;
+			}
+			return t_threadIndex;
+		}
+	}
+
+	std::atomic<bool> AllocationTrace::s_recording = false;
+
+	void AllocationTrace::Start()
+	{
+		TraceState& state = GetTraceState();
+		{
+			std::lock_guard lock(state.Lock);
+			state.Events.clear();
+			state.LiveAllocations.clear();
+			state.NextAllocationId = 0;
+			state.ThreadCount = 0;
+			++state.Generation;
+		}
+		s_recording.store(true, std::memory_order_release);
+	}
+
+	void AllocationTrace::Stop()
+	{
+		s_recording.store(false, std::memory_order_release);
+	}
+
+	void AllocationTrace::RecordAllocation(const void* ptr, const u64 size)
+	{
+		TraceState& state = GetTraceState();
+		std::lock_guard lock(state.Lock);
+		if (!IsRecording())
+		{
+			return;
+		}
+
+		AllocationTraceEvent traceEvent;
+		traceEvent.AllocationId = state.NextAllocationId++;
+		traceEvent.Size = size;
+		traceEvent.ThreadIndex = GetThreadIndex(state);
+		traceEvent.Type = AllocationTraceEvent::Types::Allocate;
+		state.LiveAllocations[ptr] = traceEvent.AllocationId;
+		state.Events.push_back(traceEvent);
+	}
+
+	void AllocationTrace::RecordFree(const void* ptr)
+	{
+		TraceState& state = GetTraceState();
+		std::lock_guard lock(state.Lock);
+		if (!IsRecording())
+		{
+			return;
+		}
+
+		auto iter = state.LiveAllocations.find(ptr);
+		if (iter == state.LiveAllocations.end())
+		{
+			return;
+		}
+
+		AllocationTraceEvent traceEvent;
+		traceEvent.AllocationId = iter->second;
+		traceEvent.ThreadIndex = GetThreadIndex(state);
+		traceEvent.Type = AllocationTraceEvent::Types::Free;
+		state.LiveAllocations.erase(iter);
+		state.Events.push_back(traceEvent);
+	}
+
+	std::vector<AllocationTraceEvent> AllocationTrace::GetEvents()
+	{
+		TraceState& state = GetTraceState();
+		std::lock_guard lock(state.Lock);
+		return std::vector<AllocationTraceEvent>(state.Events.begin(), state.Events.end());
+	}
+
+	bool AllocationTrace::Save(std::string_view filePath)
+	{
+		const std::vector<AllocationTraceEvent> events = GetEvents();
+
+		std::ofstream file(std::string(filePath), std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			IS_LOG_CORE_ERROR("[AllocationTrace::Save] Unable to open '{}'.", filePath);
+			return false;
+		}
+
+		const u64 eventCount = events.size();
+		file.write(reinterpret_cast<const char*>(&c_TraceFileMagic), sizeof(c_TraceFileMagic));
+		file.write(reinterpret_cast<const char*>(&c_TraceFileVersion), sizeof(c_TraceFileVersion));
+		file.write(reinterpret_cast<const char*>(&eventCount), sizeof(eventCount));
+		file.write(reinterpret_cast<const char*>(events.data()), sizeof(AllocationTraceEvent) * eventCount);
+		IS_LOG_CORE_INFO("[AllocationTrace::Save] Saved {} allocation events to '{}'.", eventCount, filePath);
+		return file.good();
+	}
+
+	bool AllocationTrace::Load(std::string_view filePath, std::vector<AllocationTraceEvent>& events)
+	{
+		std::ifstream file(std::string(filePath), std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		u32 magic = 0;
+		u32 version = 0;
+		u64 eventCount = 0;
+		file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+		file.read(reinterpret_cast<char*>(&version), sizeof(version));
+		file.read(reinterpret_cast<char*>(&eventCount), sizeof(eventCount));
+		if (!file.good() || magic != c_TraceFileMagic || version != c_TraceFileVersion)
+		{
+			IS_LOG_CORE_ERROR("[AllocationTrace::Load] '{}' is not a version {} allocation trace.", filePath, c_TraceFileVersion);
+			return false;
+		}
+
+		events.resize(eventCount);
+		file.read(reinterpret_cast<char*>(events.data()), sizeof(AllocationTraceEvent) * eventCount);
+		return file.good();
+	}
+}
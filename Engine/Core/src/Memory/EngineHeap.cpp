@@ -0,0 +1,875 @@
+#include "Memory/EngineHeap.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef IS_PLATFORM_WINDOWS
+#include <Windows.h>
+#include <intrin.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace Insight::Core
+{
+	namespace
+	{
+		/// @brief Address space reserved up front. Only the spans in use are committed.
+		constexpr u64 c_ReserveSize = 64_GB;
+		/// @brief Spans are committed this many bytes at a time.
+		constexpr u64 c_CommitSize = 1_MB;
+		/// @brief Empty spans a thread keeps before returning them to the global pool.
+		constexpr u32 c_MaxThreadEmptySpans = 4;
+		/// @brief Full spans checked for remote frees each time a thread runs out of blocks for a size class.
+		constexpr u32 c_FullSpanSweepCount = 8;
+
+		u32 FloorLog2(const u64 value)
+		{
+#ifdef IS_PLATFORM_WINDOWS
+			unsigned long index = 0;
+			_BitScanReverse64(&index, value);
+			return static_cast<u32>(index);
+#else
+			return 63 - static_cast<u32>(__builtin_clzll(value));
+#endif
+		}
+	}
+
+	/// @brief Header at the start of every span. Everything other than 'RemoteFree' is only accessed by the owning thread.
+	struct EngineHeapSpan
+	{
+		void* LocalFree = nullptr;
+		EngineHeapSpan* Next = nullptr;
+		EngineHeapSpan* Prev = nullptr;
+		/// @brief Id of the thread which owns the span. 0 while abandoned.
+		std::atomic<u64> OwnerId = 0;
+		u32 BlockSize = 0;
+		u32 SizeClass = 0;
+		u32 Capacity = 0;
+		/// @brief Blocks handed out which have not come back to 'LocalFree', including blocks on 'RemoteFree'.
+		u32 Used = 0;
+		/// @brief Blocks are carved from the span as they are needed so a new span isn't written to up front.
+		u32 Carved = 0;
+		bool InFull = false;
+		/// @brief Blocks freed by other threads. On its own cache line as other threads write to it.
+		alignas(64) std::atomic<void*> RemoteFree = nullptr;
+
+		void Initialise(const u32 sizeClass, const u64 ownerId)
+		{
+			LocalFree = nullptr;
+			Next = nullptr;
+			Prev = nullptr;
+			OwnerId.store(ownerId, std::memory_order_relaxed);
+			BlockSize = static_cast<u32>(EngineHeap::GetSizeClassBlockSize(sizeClass));
+			SizeClass = sizeClass;
+			Capacity = static_cast<u32>((EngineHeap::c_SpanSize - EngineHeap::c_SpanHeaderSize) / BlockSize);
+			Used = 0;
+			Carved = 0;
+			InFull = false;
+			RemoteFree.store(nullptr, std::memory_order_relaxed);
+		}
+
+		void* PopLocal()
+		{
+			void* block = LocalFree;
+			if (block)
+			{
+				LocalFree = *static_cast<void**>(block);
+			}
+			else if (Carved < Capacity)
+			{
+				block = reinterpret_cast<u8*>(this) + EngineHeap::c_SpanHeaderSize + static_cast<u64>(Carved) * BlockSize;
+				++Carved;
+			}
+			else
+			{
+				return nullptr;
+			}
+			++Used;
+			return block;
+		}
+
+		void PushLocal(void* block)
+		{
+			*static_cast<void**>(block) = LocalFree;
+			LocalFree = block;
+			--Used;
+		}
+
+		/// @brief Move every block freed by other threads onto the local free list.
+		void CollectRemote()
+		{
+			if (!RemoteFree.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			void* block = RemoteFree.exchange(nullptr, std::memory_order_acquire);
+			while (block)
+			{
+				void* next = *static_cast<void**>(block);
+				PushLocal(block);
+				block = next;
+			}
+		}
+	};
+	static_assert(sizeof(EngineHeapSpan) <= EngineHeap::c_SpanHeaderSize);
+
+	struct EngineHeapSpanList
+	{
+		EngineHeapSpan* Head = nullptr;
+		/// @brief Where the next sweep of a full list starts, so every full span is eventually checked.
+		EngineHeapSpan* Cursor = nullptr;
+
+		void PushFront(EngineHeapSpan* span)
+		{
+			span->Prev = nullptr;
+			span->Next = Head;
+			if (Head)
+			{
+				Head->Prev = span;
+			}
+			Head = span;
+		}
+
+		void Remove(EngineHeapSpan* span)
+		{
+			if (Cursor == span)
+			{
+				Cursor = span->Next;
+			}
+			if (span->Prev)
+			{
+				span->Prev->Next = span->Next;
+			}
+			else
+			{
+				Head = span->Next;
+			}
+			if (span->Next)
+			{
+				span->Next->Prev = span->Prev;
+			}
+			span->Next = nullptr;
+			span->Prev = nullptr;
+		}
+	};
+
+	namespace
+	{
+		thread_local EngineHeapThread* t_thread = nullptr;
+		/// @brief Set once the thread's heap has been abandoned. Later allocations on the thread use the CRT.
+		thread_local bool t_threadReleased = false;
+	}
+
+	/// @brief Spans owned by one thread.
+	struct EngineHeapThread
+	{
+		u64 Id = 0;
+		EngineHeapSpanList Partial[EngineHeap::c_SizeClassCount];
+		EngineHeapSpanList Full[EngineHeap::c_SizeClassCount];
+		/// @brief Empty spans kept for any size class, linked through 'Next'.
+		EngineHeapSpan* EmptySpans = nullptr;
+		u32 EmptySpanCount = 0;
+
+		~EngineHeapThread()
+		{
+			t_thread = nullptr;
+			t_threadReleased = true;
+			if (Id != 0)
+			{
+				EngineHeap::Instance().AbandonThread(*this);
+			}
+		}
+	};
+
+	EngineHeap& EngineHeap::Instance()
+	{
+		// Never destroyed, blocks may be freed by static destructors which run after this would have been.
+		alignas(EngineHeap) static u8 storage[sizeof(EngineHeap)];
+		static EngineHeap* heap = new (storage) EngineHeap();
+		return *heap;
+	}
+
+	EngineHeap::EngineHeap()
+	{
+#ifdef IS_PLATFORM_WINDOWS
+		// Reservations are aligned to 64KB, the span size.
+		m_base = static_cast<u8*>(VirtualAlloc(nullptr, c_ReserveSize, MEM_RESERVE, PAGE_NOACCESS));
+#else
+		void* reserve = mmap(nullptr, c_ReserveSize + c_SpanSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (reserve != MAP_FAILED)
+		{
+			m_base = reinterpret_cast<u8*>((reinterpret_cast<u64>(reserve) + c_SpanSize - 1) & ~(c_SpanSize - 1));
+		}
+#endif
+		// If nothing could be reserved 'Owns' is always false and every allocation goes to the CRT.
+		m_reserveSize = m_base ? c_ReserveSize : 0;
+	}
+
+	void* EngineHeap::Allocate(const u64 size)
+	{
+		if (size > c_MaxSmallSize)
+		{
+			return std::malloc(size);
+		}
+
+		if (EngineHeapThread* thread = t_thread)
+		{
+			if (EngineHeapSpan* span = thread->Partial[GetSizeClass(size)].Head)
+			{
+				if (void* block = span->PopLocal())
+				{
+					return block;
+				}
+			}
+		}
+		return AllocateSlow(size);
+	}
+
+	void* EngineHeap::Reallocate(void* ptr, const u64 size)
+	{
+		if (!ptr)
+		{
+			return Allocate(size);
+		}
+		if (size == 0)
+		{
+			Free(ptr);
+			return nullptr;
+		}
+		// The size of CRT allocations isn't known, keep them in the CRT.
+		if (!Owns(ptr))
+		{
+			return std::realloc(ptr, size);
+		}
+
+		const u64 blockSize = GetSpan(ptr)->BlockSize;
+		if (size <= blockSize)
+		{
+			return ptr;
+		}
+
+		void* newPtr = Allocate(size);
+		if (newPtr)
+		{
+			std::memcpy(newPtr, ptr, blockSize);
+			Free(ptr);
+		}
+		return newPtr;
+	}
+
+	void EngineHeap::Free(void* ptr)
+	{
+		if (!ptr)
+		{
+			return;
+		}
+		if (!Owns(ptr))
+		{
+			std::free(ptr);
+			return;
+		}
+
+		EngineHeapSpan* span = GetSpan(ptr);
+		EngineHeapThread* thread = t_thread;
+		if (!thread || span->OwnerId.load(std::memory_order_relaxed) != thread->Id)
+		{
+			FreeRemote(span, ptr);
+			return;
+		}
+
+		span->PushLocal(ptr);
+		if (span->InFull)
+		{
+			thread->Full[span->SizeClass].Remove(span);
+			span->InFull = false;
+			thread->Partial[span->SizeClass].PushFront(span);
+		}
+		else if (span->Used == 0 && thread->Partial[span->SizeClass].Head != span)
+		{
+			// Keep the span at the front of the list, it is the one being allocated from.
+			thread->Partial[span->SizeClass].Remove(span);
+			ReleaseSpan(*thread, span);
+		}
+	}
+
+	u64 EngineHeap::GetBlockSize(const void* ptr) const
+	{
+		return Owns(ptr) ? GetSpan(ptr)->BlockSize : 0;
+	}
+
+	u32 EngineHeap::GetSizeClass(const u64 size)
+	{
+		if (size <= 128)
+		{
+			return size == 0 ? 0 : static_cast<u32>((size - 1) >> 4);
+		}
+		const u32 log2 = FloorLog2(size - 1);
+		return 8 + (log2 - 7) * 4 + static_cast<u32>((size - 1 - (1ull << log2)) >> (log2 - 2));
+	}
+
+	u64 EngineHeap::GetSizeClassBlockSize(const u32 sizeClass)
+	{
+		if (sizeClass < 8)
+		{
+			return (static_cast<u64>(sizeClass) + 1) * 16;
+		}
+		const u32 log2 = 7 + (sizeClass - 8) / 4;
+		const u32 step = (sizeClass - 8) % 4;
+		return (1ull << log2) + (static_cast<u64>(step) + 1) * (1ull << (log2 - 2));
+	}
+
+	EngineHeapStats EngineHeap::GetStats() const
+	{
+		std::lock_guard lock(m_lock);
+		EngineHeapStats stats;
+		stats.ReservedBytes = m_reserveSize;
+		stats.CommittedBytes = m_committedSize;
+		stats.FreeSpanCount = m_freeSpanCount;
+		stats.AbandonedSpanCount = m_abandonedSpanCount;
+		stats.SpanCount = m_committedSize / c_SpanSize - m_freeSpanCount;
+		return stats;
+	}
+
+	void* EngineHeap::AllocateSlow(const u64 size)
+	{
+		EngineHeapThread* thread = GetThread();
+		if (!thread)
+		{
+			return std::malloc(size);
+		}
+
+		const u32 sizeClass = GetSizeClass(size);
+		EngineHeapSpanList& partial = thread->Partial[sizeClass];
+		EngineHeapSpanList& full = thread->Full[sizeClass];
+		while (true)
+		{
+			// Spans at the front of the partial list have either been freed into by other threads or are full.
+			while (EngineHeapSpan* span = partial.Head)
+			{
+				span->CollectRemote();
+				if (void* block = span->PopLocal())
+				{
+					return block;
+				}
+				partial.Remove(span);
+				span->InFull = true;
+				full.PushFront(span);
+			}
+
+			// Full spans other threads have freed into.
+			EngineHeapSpan* span = full.Cursor ? full.Cursor : full.Head;
+			for (u32 sweepIdx = 0; span && sweepIdx < c_FullSpanSweepCount; ++sweepIdx)
+			{
+				EngineHeapSpan* next = span->Next;
+				if (span->RemoteFree.load(std::memory_order_relaxed))
+				{
+					span->CollectRemote();
+					full.Remove(span);
+					span->InFull = false;
+					partial.PushFront(span);
+				}
+				span = next;
+			}
+			full.Cursor = span;
+			if (partial.Head)
+			{
+				continue;
+			}
+
+			span = AcquireSpan(*thread, sizeClass);
+			if (!span)
+			{
+				return std::malloc(size);
+			}
+			partial.PushFront(span);
+		}
+	}
+
+	void EngineHeap::FreeRemote(EngineHeapSpan* span, void* ptr)
+	{
+		void* head = span->RemoteFree.load(std::memory_order_relaxed);
+		do
+		{
+			*static_cast<void**>(ptr) = head;
+		} while (!span->RemoteFree.compare_exchange_weak(head, ptr, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	EngineHeapSpan* EngineHeap::AcquireSpan(EngineHeapThread& thread, const u32 sizeClass)
+	{
+		if (EngineHeapSpan* span = thread.EmptySpans)
+		{
+			thread.EmptySpans = span->Next;
+			--thread.EmptySpanCount;
+			span->Initialise(sizeClass, thread.Id);
+			return span;
+		}
+
+		EngineHeapSpan* span = nullptr;
+		{
+			std::lock_guard lock(m_lock);
+			if (EngineHeapSpan* abandonedSpan = m_abandonedSpans[sizeClass])
+			{
+				m_abandonedSpans[sizeClass] = abandonedSpan->Next;
+				--m_abandonedSpanCount;
+				abandonedSpan->Next = nullptr;
+				abandonedSpan->Prev = nullptr;
+				abandonedSpan->InFull = false;
+				abandonedSpan->OwnerId.store(thread.Id, std::memory_order_relaxed);
+				return abandonedSpan;
+			}
+
+			if (m_freeSpans)
+			{
+				span = m_freeSpans;
+				m_freeSpans = span->Next;
+				--m_freeSpanCount;
+			}
+			else
+			{
+				span = CommitSpan();
+			}
+		}
+
+		if (span)
+		{
+			span->Initialise(sizeClass, thread.Id);
+		}
+		return span;
+	}
+
+	void EngineHeap::ReleaseSpan(EngineHeapThread& thread, EngineHeapSpan* span)
+	{
+		if (thread.EmptySpanCount < c_MaxThreadEmptySpans)
+		{
+			span->Next = thread.EmptySpans;
+			thread.EmptySpans = span;
+			++thread.EmptySpanCount;
+			return;
+		}
+
+		std::lock_guard lock(m_lock);
+		span->OwnerId.store(0, std::memory_order_relaxed);
+		span->Next = m_freeSpans;
+		m_freeSpans = span;
+		++m_freeSpanCount;
+	}
+
+	EngineHeapSpan* EngineHeap::CommitSpan()
+	{
+		if (m_committedSize + c_CommitSize > m_reserveSize)
+		{
+			return nullptr;
+		}
+
+		u8* commit = m_base + m_committedSize;
+#ifdef IS_PLATFORM_WINDOWS
+		if (!VirtualAlloc(commit, c_CommitSize, MEM_COMMIT, PAGE_READWRITE))
+		{
+			return nullptr;
+		}
+#else
+		if (mprotect(commit, c_CommitSize, PROT_READ | PROT_WRITE) != 0)
+		{
+			return nullptr;
+		}
+#endif
+		m_committedSize += c_CommitSize;
+
+		// The first span is used straight away, the rest go to the free list.
+		for (u64 offset = c_CommitSize - c_SpanSize; offset > 0; offset -= c_SpanSize)
+		{
+			EngineHeapSpan* span = new (commit + offset) EngineHeapSpan();
+			span->Next = m_freeSpans;
+			m_freeSpans = span;
+			++m_freeSpanCount;
+		}
+		return new (commit) EngineHeapSpan();
+	}
+
+	void EngineHeap::AbandonThread(EngineHeapThread& thread)
+	{
+		std::lock_guard lock(m_lock);
+		auto abandonList = [this](EngineHeapSpanList& list)
+		{
+			while (EngineHeapSpan* span = list.Head)
+			{
+				list.Remove(span);
+				span->CollectRemote();
+				if (span->Used == 0)
+				{
+					span->OwnerId.store(0, std::memory_order_relaxed);
+					span->Next = m_freeSpans;
+					m_freeSpans = span;
+					++m_freeSpanCount;
+				}
+				else
+				{
+					// Blocks freed from now on all go to the remote list until another thread adopts the span.
+					span->OwnerId.store(0, std::memory_order_relaxed);
+					span->Next = m_abandonedSpans[span->SizeClass];
+					m_abandonedSpans[span->SizeClass] = span;
+					++m_abandonedSpanCount;
+				}
+			}
+		};
+
+		for (u32 sizeClass = 0; sizeClass < c_SizeClassCount; ++sizeClass)
+		{
+			abandonList(thread.Partial[sizeClass]);
+			abandonList(thread.Full[sizeClass]);
+		}
+
+		while (EngineHeapSpan* span = thread.EmptySpans)
+		{
+			thread.EmptySpans = span->Next;
+			span->OwnerId.store(0, std::memory_order_relaxed);
+			span->Next = m_freeSpans;
+			m_freeSpans = span;
+			++m_freeSpanCount;
+		}
+		thread.EmptySpanCount = 0;
+	}
+
+	EngineHeapThread* EngineHeap::GetThread()
+	{
+		if (t_thread || t_threadReleased)
+		{
+			return t_thread;
+		}
+
+		thread_local EngineHeapThread thread;
+		thread.Id = Instance().m_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+		t_thread = &thread;
+		return t_thread;
+	}
+
+	EngineHeapSpan* EngineHeap::GetSpan(const void* ptr)
+	{
+		return reinterpret_cast<EngineHeapSpan*>(reinterpret_cast<u64>(ptr) & ~(c_SpanSize - 1));
+	}
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+#include "Memory/AllocationTrace.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Core;
+
+	/// @brief Frame shaped allocation pattern used when no recorded trace is available. Each thread makes short lived
+	/// allocations it frees itself, results freed by the next thread at the end of the frame and a few long lived
+	/// allocations freed by the first thread some frames later.
+	static std::vector<AllocationTraceEvent> MakeSyntheticTrace(const u32 threadCount, const u32 frameCount, const u32 allocationsPerThreadPerFrame)
+	{
+		constexpr u32 c_LongLivedFrameCount = 8;
+
+		std::mt19937 random(1234);
+		auto randomSize = [&random]() -> u64
+		{
+			const u32 bucket = random() % 100;
+			if (bucket < 70) { return 8 + random() % 248; }
+			if (bucket < 95) { return 256 + random() % 3840; }
+			return 4_KB + random() % (60_KB);
+		};
+
+		struct PendingFree
+		{
+			u64 AllocationId;
+			u32 ThreadIndex;
+		};
+
+		std::vector<AllocationTraceEvent> events;
+		std::vector<std::vector<u64>> threadLiveAllocations(threadCount);
+		std::vector<std::vector<PendingFree>> longLived(c_LongLivedFrameCount);
+		u64 nextAllocationId = 0;
+
+		auto addEvent = [&events](const u64 allocationId, const u64 size, const u32 threadIdx, const AllocationTraceEvent::Types type)
+		{
+			AllocationTraceEvent traceEvent;
+			traceEvent.AllocationId = allocationId;
+			traceEvent.Size = size;
+			traceEvent.ThreadIndex = threadIdx;
+			traceEvent.Type = type;
+			events.push_back(traceEvent);
+		};
+
+		for (u32 frameIdx = 0; frameIdx < frameCount; ++frameIdx)
+		{
+			std::vector<PendingFree> endOfFrameFrees;
+			for (u32 allocationIdx = 0; allocationIdx < allocationsPerThreadPerFrame; ++allocationIdx)
+			{
+				for (u32 threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+				{
+					const u64 allocationId = nextAllocationId++;
+					addEvent(allocationId, randomSize(), threadIdx, AllocationTraceEvent::Types::Allocate);
+
+					const u32 lifetime = random() % 100;
+					if (lifetime < 65)
+					{
+						threadLiveAllocations[threadIdx].push_back(allocationId);
+					}
+					else if (lifetime < 95)
+					{
+						endOfFrameFrees.push_back({ allocationId, (threadIdx + 1) % threadCount });
+					}
+					else
+					{
+						longLived[frameIdx % c_LongLivedFrameCount].push_back({ allocationId, 0 });
+					}
+
+					std::vector<u64>& live = threadLiveAllocations[threadIdx];
+					if (live.size() > 4 && random() % 2 == 0)
+					{
+						const u64 liveIdx = random() % live.size();
+						addEvent(live[liveIdx], 0, threadIdx, AllocationTraceEvent::Types::Free);
+						live[liveIdx] = live.back();
+						live.pop_back();
+					}
+				}
+			}
+
+			for (u32 threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+			{
+				for (const u64 allocationId : threadLiveAllocations[threadIdx])
+				{
+					addEvent(allocationId, 0, threadIdx, AllocationTraceEvent::Types::Free);
+				}
+				threadLiveAllocations[threadIdx].clear();
+			}
+			for (const PendingFree& pendingFree : endOfFrameFrees)
+			{
+				addEvent(pendingFree.AllocationId, 0, pendingFree.ThreadIndex, AllocationTraceEvent::Types::Free);
+			}
+
+			std::vector<PendingFree>& expired = longLived[(frameIdx + 1) % c_LongLivedFrameCount];
+			for (const PendingFree& pendingFree : expired)
+			{
+				addEvent(pendingFree.AllocationId, 0, pendingFree.ThreadIndex, AllocationTraceEvent::Types::Free);
+			}
+			expired.clear();
+		}
+		return events;
+	}
+
+	/// @brief Replay 'events' with one thread per recorded thread. A free waits until its allocation has been made.
+	/// Allocations never freed within the trace are freed once timing has stopped.
+	/// @return Nanoseconds per event.
+	template<typename AllocateFunc, typename FreeFunc>
+	static double ReplayTrace(const std::vector<AllocationTraceEvent>& events, AllocateFunc allocate, FreeFunc free)
+	{
+		u32 threadCount = 0;
+		u64 allocationCount = 0;
+		for (const AllocationTraceEvent& traceEvent : events)
+		{
+			threadCount = std::max(threadCount, traceEvent.ThreadIndex + 1);
+			allocationCount = std::max(allocationCount, traceEvent.AllocationId + 1);
+		}
+
+		std::vector<std::vector<AllocationTraceEvent>> threadEvents(threadCount);
+		for (const AllocationTraceEvent& traceEvent : events)
+		{
+			threadEvents[traceEvent.ThreadIndex].push_back(traceEvent);
+		}
+
+		std::vector<std::atomic<void*>> allocations(allocationCount);
+		std::atomic<bool> start = false;
+		std::vector<std::thread> threads;
+		for (u32 threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+		{
+			threads.emplace_back([&, threadIdx]()
+				{
+					while (!start.load()) { std::this_thread::yield(); }
+					for (const AllocationTraceEvent& traceEvent : threadEvents[threadIdx])
+					{
+						std::atomic<void*>& allocation = allocations[traceEvent.AllocationId];
+						if (traceEvent.Type == AllocationTraceEvent::Types::Allocate)
+						{
+							void* ptr = allocate(std::max<u64>(traceEvent.Size, 1));
+							*static_cast<u8*>(ptr) = 1;
+							allocation.store(ptr, std::memory_order_release);
+						}
+						else
+						{
+							void* ptr = nullptr;
+							while (!(ptr = allocation.exchange(nullptr, std::memory_order_acquire)))
+							{
+								std::this_thread::yield();
+							}
+							free(ptr);
+						}
+					}
+				});
+		}
+
+		Core::Timer timer;
+		timer.Start();
+		start = true;
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		timer.Stop();
+
+		for (std::atomic<void*>& allocation : allocations)
+		{
+			if (void* ptr = allocation.load())
+			{
+				free(ptr);
+			}
+		}
+		return static_cast<double>(timer.GetElapsedTimeNano().count()) / std::max<u64>(events.size(), 1);
+	}
+
+	TEST_SUITE("EngineHeap")
+	{
+		TEST_CASE("Size classes cover every small size")
+		{
+			bool allValid = true;
+			for (u64 size = 1; size <= EngineHeap::c_MaxSmallSize; ++size)
+			{
+				const u32 sizeClass = EngineHeap::GetSizeClass(size);
+				const u64 blockSize = EngineHeap::GetSizeClassBlockSize(sizeClass);
+				allValid &= sizeClass < EngineHeap::c_SizeClassCount;
+				allValid &= blockSize >= size;
+				allValid &= blockSize % EngineHeap::c_MinAlignment == 0;
+				// Never more than a quarter of a block is wasted once past the 16 byte steps.
+				allValid &= size <= 128 || (blockSize - size) * 4 < blockSize;
+				allValid &= sizeClass == 0 || EngineHeap::GetSizeClassBlockSize(sizeClass - 1) < size;
+			}
+			CHECK(allValid);
+			CHECK(EngineHeap::GetSizeClass(EngineHeap::c_MaxSmallSize) == EngineHeap::c_SizeClassCount - 1);
+		}
+
+		TEST_CASE("Allocations are aligned and large allocations use the CRT")
+		{
+			EngineHeap& heap = EngineHeap::Instance();
+
+			std::vector<void*> allocations;
+			for (u64 size = 1; size <= EngineHeap::c_MaxSmallSize; size += 37)
+			{
+				void* ptr = heap.Allocate(size);
+				CHECK(reinterpret_cast<u64>(ptr) % EngineHeap::c_MinAlignment == 0);
+				CHECK(heap.Owns(ptr));
+				CHECK(heap.GetBlockSize(ptr) >= size);
+				std::memset(ptr, 0xAB, size);
+				allocations.push_back(ptr);
+			}
+
+			void* large = heap.Allocate(EngineHeap::c_MaxSmallSize + 1);
+			CHECK_FALSE(heap.Owns(large));
+			allocations.push_back(large);
+
+			void* grown = heap.Reallocate(heap.Allocate(24), 1_KB);
+			CHECK(heap.GetBlockSize(grown) >= 1_KB);
+			allocations.push_back(grown);
+
+			for (void* ptr : allocations)
+			{
+				heap.Free(ptr);
+			}
+		}
+
+		TEST_CASE("Blocks freed on other threads are reused by the owner")
+		{
+			constexpr u32 c_AllocationCount = 10'000;
+			EngineHeap& heap = EngineHeap::Instance();
+
+			std::vector<u64*> allocations;
+			for (u32 i = 0; i < c_AllocationCount; ++i)
+			{
+				u64* value = static_cast<u64*>(heap.Allocate(sizeof(u64) * 4));
+				value[1] = i;
+				allocations.push_back(value);
+			}
+			std::thread freeThread([&]()
+				{
+					for (u64* value : allocations)
+					{
+						heap.Free(value);
+					}
+				});
+			freeThread.join();
+
+			const u64 committedBytes = heap.GetStats().CommittedBytes;
+			std::vector<u64*> reused;
+			for (u32 i = 0; i < c_AllocationCount; ++i)
+			{
+				reused.push_back(static_cast<u64*>(heap.Allocate(sizeof(u64) * 4)));
+			}
+			CHECK(heap.GetStats().CommittedBytes == committedBytes);
+
+			std::sort(reused.begin(), reused.end());
+			CHECK(std::adjacent_find(reused.begin(), reused.end()) == reused.end());
+			for (u64* value : reused)
+			{
+				heap.Free(value);
+			}
+		}
+
+		TEST_CASE("Spans of exited threads are adopted")
+		{
+			EngineHeap& heap = EngineHeap::Instance();
+
+			std::vector<void*> allocations;
+			std::thread allocateThread([&]()
+				{
+					for (u32 i = 0; i < 1'000; ++i)
+					{
+						allocations.push_back(heap.Allocate(EngineHeap::c_MaxSmallSize - 1));
+					}
+				});
+			allocateThread.join();
+			const u64 abandonedSpanCount = heap.GetStats().AbandonedSpanCount;
+			CHECK(abandonedSpanCount > 0);
+
+			for (void* ptr : allocations)
+			{
+				heap.Free(ptr);
+			}
+			void* adoptedPtr = nullptr;
+			std::thread adoptThread([&]()
+				{
+					adoptedPtr = heap.Allocate(EngineHeap::c_MaxSmallSize - 1);
+					heap.Free(adoptedPtr);
+				});
+			adoptThread.join();
+			// The new thread takes one of the abandoned spans instead of a fresh one, and reuses a block freed into it.
+			CHECK(heap.GetStats().AbandonedSpanCount == abandonedSpanCount - 1);
+			CHECK(std::find(allocations.begin(), allocations.end(), adoptedPtr) != allocations.end());
+		}
+
+		TEST_CASE("Trace replay benchmark")
+		{
+			std::vector<AllocationTraceEvent> events;
+			const bool recordedTrace = AllocationTrace::Load("AllocationTrace.bin", events);
+			if (!recordedTrace)
+			{
+				events = MakeSyntheticTrace(4, 60, 2'000);
+			}
+
+			EngineHeap& heap = EngineHeap::Instance();
+			const double engineHeapNs = ReplayTrace(events
+				, [&heap](const u64 size) { return heap.Allocate(size); }
+				, [&heap](void* ptr) { heap.Free(ptr); });
+			const double crtNs = ReplayTrace(events
+				, [](const u64 size) { return std::malloc(size); }
+				, [](void* ptr) { std::free(ptr); });
+
+			MESSAGE("Trace: " << (recordedTrace ? "AllocationTrace.bin" : "synthetic") << " | Events: " << events.size()
+				<< " | EngineHeap ns/event: " << engineHeapNs
+				<< " | CRT ns/event: " << crtNs);
+		}
+	}
+}
+#endif
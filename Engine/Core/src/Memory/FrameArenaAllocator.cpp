@@ -0,0 +1,328 @@
+#include "Memory/FrameArenaAllocator.h"
+
+#include "Core/Asserts.h"
+#include "Core/Logger.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
+
+namespace Insight::Core
+{
+	namespace
+	{
+		u64 AlignUp(const u64 value, const u64 alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	//=============================================================
+	// FrameArena
+	//=============================================================
+	FrameArena::FrameArena(const u64 capacity, const MemoryAllocCategory memoryAllocCategory)
+		: m_capacity(capacity)
+		, m_memoryAllocCategory(memoryAllocCategory)
+	{
+		m_memory = static_cast<u8*>(NewBytes(m_capacity, m_memoryAllocCategory));
+	}
+
+	FrameArena::~FrameArena()
+	{
+		Reset();
+		DeleteBytes(m_memory);
+	}
+
+	void* FrameArena::Allocate(const u64 size, const u64 alignment)
+	{
+		ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+		const u64 base = reinterpret_cast<u64>(m_memory);
+		u64 offset = m_offset.load(std::memory_order_relaxed);
+		while (true)
+		{
+			const u64 alignedOffset = AlignUp(base + offset, alignment) - base;
+			const u64 newOffset = alignedOffset + size;
+			if (newOffset > m_capacity)
+			{
+				return AllocateOverflow(size, alignment);
+			}
+			if (m_offset.compare_exchange_weak(offset, newOffset, std::memory_order_relaxed))
+			{
+				return m_memory + alignedOffset;
+			}
+		}
+	}
+
+	void FrameArena::Reset()
+	{
+		{
+			std::lock_guard lock(m_overflowMutex);
+			for (void* allocation : m_overflowAllocations)
+			{
+				DeleteBytes(allocation);
+			}
+			m_overflowAllocations.clear();
+		}
+		m_overflowBytes.store(0, std::memory_order_relaxed);
+		m_offset.store(0, std::memory_order_relaxed);
+	}
+
+	u64 FrameArena::GetUsedBytes() const
+	{
+		return std::min(m_offset.load(std::memory_order_relaxed), m_capacity) + GetOverflowBytes();
+	}
+
+	void* FrameArena::AllocateOverflow(const u64 size, const u64 alignment)
+	{
+		ASSERT_MSG(alignment <= alignof(std::max_align_t), "[FrameArena::AllocateOverflow] Over aligned allocations can't overflow to the heap.");
+
+		void* allocation = NewBytes(size, m_memoryAllocCategory);
+		std::lock_guard lock(m_overflowMutex);
+		m_overflowAllocations.push_back(allocation);
+		m_overflowBytes.fetch_add(size, std::memory_order_relaxed);
+		return allocation;
+	}
+
+	//=============================================================
+	// FrameArenaAllocator
+	//=============================================================
+	FrameArenaAllocator::~FrameArenaAllocator()
+	{
+		Shutdown();
+	}
+
+	void FrameArenaAllocator::Initialise(const u32 frameCount, const u64 arenaSize, const MemoryAllocCategory memoryAllocCategory)
+	{
+		ASSERT(!IsInitialised());
+		std::lock_guard lock(m_mutex);
+
+		m_arenaSize = arenaSize;
+		m_memoryAllocCategory = memoryAllocCategory;
+		m_stats = { };
+		m_stats.Capacity = m_arenaSize;
+
+		// Every frame in flight, the frame being built and one spare for the window between 'EndFrame' binding a
+		// frame index and 'RetireFrame' releasing that index's previous arena.
+		const u32 arenaCount = frameCount + 2;
+		for (u32 arenaIdx = 0; arenaIdx < arenaCount; ++arenaIdx)
+		{
+			FrameArena* arena = ::New<FrameArena>(m_arenaSize, m_memoryAllocCategory);
+			m_arenas.push_back(arena);
+			m_freeArenas.push_back(arena);
+		}
+		m_stats.ArenaCount = m_arenas.size();
+
+		m_currentArena.store(AcquireArena(), std::memory_order_release);
+	}
+
+	void FrameArenaAllocator::Shutdown()
+	{
+		std::lock_guard lock(m_mutex);
+		m_currentArena.store(nullptr, std::memory_order_release);
+		for (FrameArena*& arena : m_arenas)
+		{
+			Delete(arena);
+		}
+		m_arenas.clear();
+		m_freeArenas.clear();
+		m_frameArenas.clear();
+	}
+
+	void* FrameArenaAllocator::Allocate(const u64 size, const u64 alignment)
+	{
+		if (FrameArena* arena = GetCurrentArena())
+		{
+			return arena->Allocate(size, alignment);
+		}
+		return NewBytes(size, m_memoryAllocCategory);
+	}
+
+	void FrameArenaAllocator::EndFrame(const u32 frameIndex)
+	{
+		IS_PROFILE_FUNCTION();
+		std::lock_guard lock(m_mutex);
+
+		FrameArena* finishedArena = m_currentArena.load(std::memory_order_relaxed);
+		if (!finishedArena)
+		{
+			return;
+		}
+
+		m_stats.LastFrameUsedBytes = finishedArena->GetUsedBytes();
+		m_stats.LastFrameOverflowBytes = finishedArena->GetOverflowBytes();
+		m_stats.PeakUsedBytes = std::max(m_stats.PeakUsedBytes, m_stats.LastFrameUsedBytes);
+
+		m_frameArenas[frameIndex].push_back(finishedArena);
+		m_currentArena.store(AcquireArena(), std::memory_order_release);
+	}
+
+	void FrameArenaAllocator::RetireFrame(const u32 frameIndex)
+	{
+		IS_PROFILE_FUNCTION();
+		std::lock_guard lock(m_mutex);
+
+		auto iter = m_frameArenas.find(frameIndex);
+		if (iter == m_frameArenas.end())
+		{
+			return;
+		}
+
+		// The most recently bound arena belongs to the frame about to be rendered with this index.
+		std::vector<FrameArena*>& frameArenas = iter->second;
+		while (frameArenas.size() > 1)
+		{
+			FrameArena* arena = frameArenas.front();
+			frameArenas.erase(frameArenas.begin());
+			arena->Reset();
+			m_freeArenas.push_back(arena);
+		}
+	}
+
+	FrameArenaStats FrameArenaAllocator::GetStats() const
+	{
+		std::lock_guard lock(m_mutex);
+		return m_stats;
+	}
+
+	FrameArena* FrameArenaAllocator::AcquireArena()
+	{
+		if (m_freeArenas.empty())
+		{
+			IS_LOG_CORE_WARN("[FrameArenaAllocator::AcquireArena] No retired arenas, creating a new arena. Frames are retiring later than expected.");
+			FrameArena* arena = ::New<FrameArena>(m_arenaSize, m_memoryAllocCategory);
+			m_arenas.push_back(arena);
+			m_stats.ArenaCount = m_arenas.size();
+			return arena;
+		}
+
+		FrameArena* arena = m_freeArenas.back();
+		m_freeArenas.pop_back();
+		return arena;
+	}
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+
+#include <thread>
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Core;
+
+	TEST_SUITE("FrameArenaAllocator")
+	{
+		TEST_CASE("Allocations are aligned and overflow to the heap")
+		{
+			FrameArena arena(256, MemoryAllocCategory::General);
+
+			void* first = arena.Allocate(3, 1);
+			void* second = arena.Allocate(8, 16);
+			CHECK(reinterpret_cast<u64>(second) % 16 == 0);
+			CHECK(static_cast<u8*>(second) > static_cast<u8*>(first));
+
+			void* overflow = arena.Allocate(512, 8);
+			CHECK(overflow != nullptr);
+			CHECK(arena.GetOverflowBytes() == 512);
+			CHECK(arena.GetUsedBytes() > 512);
+
+			arena.Reset();
+			CHECK(arena.GetUsedBytes() == 0);
+			CHECK(arena.Allocate(3, 1) == first);
+		}
+
+		TEST_CASE("Concurrent allocations never overlap")
+		{
+			constexpr u32 c_ThreadCount = 8;
+			constexpr u32 c_AllocationsPerThread = 10'000;
+			FrameArena arena(c_ThreadCount * c_AllocationsPerThread * 16, MemoryAllocCategory::General);
+
+			std::vector<std::vector<u64*>> allocations(c_ThreadCount);
+			std::vector<std::thread> threads;
+			for (u32 threadIdx = 0; threadIdx < c_ThreadCount; ++threadIdx)
+			{
+				threads.emplace_back([&arena, &allocations, threadIdx]()
+					{
+						for (u32 i = 0; i < c_AllocationsPerThread; ++i)
+						{
+							u64* value = static_cast<u64*>(arena.Allocate(sizeof(u64), alignof(u64)));
+							*value = (static_cast<u64>(threadIdx) << 32) | i;
+							allocations[threadIdx].push_back(value);
+						}
+					});
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+
+			bool allValid = true;
+			for (u32 threadIdx = 0; threadIdx < c_ThreadCount; ++threadIdx)
+			{
+				for (u32 i = 0; i < c_AllocationsPerThread; ++i)
+				{
+					allValid &= *allocations[threadIdx][i] == ((static_cast<u64>(threadIdx) << 32) | i);
+				}
+			}
+			CHECK(allValid);
+			CHECK(arena.GetOverflowBytes() == 0);
+		}
+
+		TEST_CASE("Arenas are only reset once their frame index retires")
+		{
+			FrameArenaAllocator allocator;
+			allocator.Initialise(2, 1_KB);
+
+			FrameArena* frame0Arena = allocator.GetCurrentArena();
+			allocator.Allocate(100);
+			allocator.EndFrame(0);
+			CHECK(frame0Arena->GetUsedBytes() == 100);
+
+			FrameArena* frame1Arena = allocator.GetCurrentArena();
+			CHECK(frame1Arena != frame0Arena);
+			allocator.Allocate(200);
+			allocator.EndFrame(1);
+
+			// The fence for index 0 has never been signalled so nothing is released.
+			allocator.RetireFrame(0);
+			CHECK(frame0Arena->GetUsedBytes() == 100);
+
+			allocator.Allocate(50);
+			allocator.EndFrame(0);
+			// Index 0 is reused, once its fence has been waited on the first frame's arena is released.
+			allocator.RetireFrame(0);
+			CHECK(frame0Arena->GetUsedBytes() == 0);
+			CHECK(frame1Arena->GetUsedBytes() == 200);
+
+			const FrameArenaStats stats = allocator.GetStats();
+			CHECK(stats.LastFrameUsedBytes == 50);
+			CHECK(stats.PeakUsedBytes == 200);
+			CHECK(stats.ArenaCount == 4);
+		}
+
+		TEST_CASE("STL adapter")
+		{
+			FrameArena arena(4_KB, MemoryAllocCategory::General);
+
+			FrameArenaVector<u64> values{ FrameArenaStlAllocator<u64>(&arena) };
+			for (u64 i = 0; i < 100; ++i)
+			{
+				values.push_back(i);
+			}
+			CHECK(values.size() == 100);
+			CHECK(values.back() == 99);
+			CHECK(arena.GetUsedBytes() >= sizeof(u64) * 100);
+
+			// Copies can outlive the frame so are given heap memory.
+			FrameArenaVector<u64> copy = values;
+			CHECK(copy.get_allocator().GetArena() == nullptr);
+			CHECK(copy == values);
+
+			FrameArenaVector<u64> moved = std::move(values);
+			CHECK(moved.get_allocator().GetArena() == &arena);
+			CHECK(moved.size() == 100);
+		}
+	}
+}
+#endif
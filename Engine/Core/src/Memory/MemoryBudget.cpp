@@ -0,0 +1,271 @@
+#include "Memory/MemoryBudget.h"
+
+#include "Core/Logger.h"
+#include "Core/MemoryTracker.h"
+#include "Core/Profiler.h"
+#include "Event/EventSystem.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+
+namespace Insight::Core
+{
+	MemoryBudget& MemoryBudget::Instance()
+	{
+		static MemoryBudget instance;
+		return instance;
+	}
+
+	MemoryBudget::MemoryBudget()
+	{
+		m_history.resize(c_HistoryFrameCount);
+	}
+
+	void MemoryBudget::SetBudget(const MemoryAllocCategory category, const MemoryCategoryBudget budget)
+	{
+		ASSERT(category != MemoryAllocCategory::Size);
+		ASSERT(budget.HardLimitBytes == 0 || budget.SoftLimitBytes <= budget.HardLimitBytes);
+
+		std::lock_guard lock(m_lock);
+		m_budgets[static_cast<u64>(category)] = budget;
+	}
+
+	MemoryCategoryBudget MemoryBudget::GetBudget(const MemoryAllocCategory category) const
+	{
+		ASSERT(category != MemoryAllocCategory::Size);
+		std::lock_guard lock(m_lock);
+		return m_budgets[static_cast<u64>(category)];
+	}
+
+	MemoryPressureLevel MemoryBudget::GetPressureLevel(const MemoryAllocCategory category) const
+	{
+		ASSERT(category != MemoryAllocCategory::Size);
+		std::lock_guard lock(m_lock);
+		return m_levels[static_cast<u64>(category)];
+	}
+
+	void MemoryBudget::Update(const u64 frameIndex)
+	{
+		IS_PROFILE_FUNCTION();
+
+		CategoryUsage usage;
+		MemoryTracker::Instance().GetCategoryUsage(usage);
+		Update(frameIndex, usage);
+	}
+
+	void MemoryBudget::Update(const u64 frameIndex, const CategoryUsage& usage)
+	{
+		std::vector<RPtr<MemoryPressureEvent>> events;
+		{
+			std::lock_guard lock(m_lock);
+
+			HistoryFrame& historyFrame = m_history[m_historyHead];
+			historyFrame.FrameIndex = frameIndex;
+			for (u64 i = 0; i < c_CategoryCount; ++i)
+			{
+				historyFrame.UsageKB[i] = static_cast<u32>(std::min<u64>(usage[i] / 1_KB, std::numeric_limits<u32>::max()));
+			}
+			m_historyHead = (m_historyHead + 1) % c_HistoryFrameCount;
+			m_historySize = std::min(m_historySize + 1, c_HistoryFrameCount);
+
+			for (u64 i = 0; i < c_CategoryCount; ++i)
+			{
+				const MemoryCategoryBudget& budget = m_budgets[i];
+				const MemoryPressureLevel level = EvaluateLevel(budget, m_levels[i], usage[i]);
+				if (level == m_levels[i])
+				{
+					continue;
+				}
+				m_levels[i] = level;
+
+				u64 limit = 0;
+				if (level == MemoryPressureLevel::Hard)
+				{
+					limit = budget.HardLimitBytes;
+				}
+				else if (level == MemoryPressureLevel::Soft)
+				{
+					limit = budget.SoftLimitBytes;
+				}
+				events.push_back(MakeRPtr<MemoryPressureEvent>(static_cast<MemoryAllocCategory>(i), level, usage[i], limit));
+			}
+		}
+
+		for (RPtr<MemoryPressureEvent>& event : events)
+		{
+			if (event->Level != MemoryPressureLevel::None)
+			{
+				IS_LOG_CORE_WARN("[MemoryBudget::Update] Category '{}' is under {} memory pressure, {} bytes used of {}.",
+					MemoryAllocCategoryToString[static_cast<u64>(event->Category)], MemoryPressureLevelToString[static_cast<u64>(event->Level)],
+					event->UsageBytes, event->LimitBytes);
+			}
+			if (EventSystem::IsValidInstance())
+			{
+				EventSystem::Instance().DispatchEvent(std::move(event));
+			}
+		}
+	}
+
+	u32 MemoryBudget::GetHistorySize() const
+	{
+		std::lock_guard lock(m_lock);
+		return m_historySize;
+	}
+
+	bool MemoryBudget::SaveCsv(std::string_view filePath) const
+	{
+		std::ofstream file(std::string(filePath), std::ios::trunc);
+		if (!file.is_open())
+		{
+			IS_LOG_CORE_ERROR("[MemoryBudget::SaveCsv] Unable to open '{}'.", filePath);
+			return false;
+		}
+
+		file << "Frame";
+		for (const char* categoryName : MemoryAllocCategoryToString)
+		{
+			file << ',' << categoryName;
+		}
+		file << '\n';
+
+		std::lock_guard lock(m_lock);
+		const u32 firstFrame = (m_historyHead + c_HistoryFrameCount - m_historySize) % c_HistoryFrameCount;
+		for (u32 i = 0; i < m_historySize; ++i)
+		{
+			const HistoryFrame& historyFrame = m_history[(firstFrame + i) % c_HistoryFrameCount];
+			file << historyFrame.FrameIndex;
+			for (const u32 usageKB : historyFrame.UsageKB)
+			{
+				file << ',' << usageKB;
+			}
+			file << '\n';
+		}
+		return file.good();
+	}
+
+	void MemoryBudget::ClearHistory()
+	{
+		std::lock_guard lock(m_lock);
+		m_historyHead = 0;
+		m_historySize = 0;
+	}
+
+	MemoryPressureLevel MemoryBudget::EvaluateLevel(const MemoryCategoryBudget& budget, const MemoryPressureLevel currentLevel, const u64 usage) const
+	{
+		const auto isAbove = [usage, currentLevel](const u64 limit, const MemoryPressureLevel limitLevel)
+		{
+			if (limit == 0)
+			{
+				return false;
+			}
+			// Once at or above a level only drop back below it after usage has fallen clear of the limit.
+			const u64 threshold = currentLevel >= limitLevel ? static_cast<u64>(static_cast<double>(limit) * c_ReleaseThreshold) : limit;
+			return usage > threshold;
+		};
+
+		if (isAbove(budget.HardLimitBytes, MemoryPressureLevel::Hard))
+		{
+			return MemoryPressureLevel::Hard;
+		}
+		if (isAbove(budget.SoftLimitBytes, MemoryPressureLevel::Soft))
+		{
+			return MemoryPressureLevel::Soft;
+		}
+		return MemoryPressureLevel::None;
+	}
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Core;
+
+	TEST_SUITE("MemoryBudget")
+	{
+		void ResetMemoryBudget()
+		{
+			MemoryBudget& budget = MemoryBudget::Instance();
+			budget.SetBudget(MemoryAllocCategory::Resources, { });
+			budget.Update(0, { });
+			budget.ClearHistory();
+		}
+
+		TEST_CASE("Pressure levels follow soft and hard limits")
+		{
+			ResetMemoryBudget();
+			MemoryBudget& budget = MemoryBudget::Instance();
+			budget.SetBudget(MemoryAllocCategory::Resources, { 100_MB, 200_MB });
+
+			MemoryBudget::CategoryUsage usage = { };
+			usage[static_cast<u64>(MemoryAllocCategory::Resources)] = 50_MB;
+			budget.Update(1, usage);
+			CHECK(budget.GetPressureLevel(MemoryAllocCategory::Resources) == MemoryPressureLevel::None);
+
+			usage[static_cast<u64>(MemoryAllocCategory::Resources)] = 150_MB;
+			budget.Update(2, usage);
+			CHECK(budget.GetPressureLevel(MemoryAllocCategory::Resources) == MemoryPressureLevel::Soft);
+
+			usage[static_cast<u64>(MemoryAllocCategory::Resources)] = 250_MB;
+			budget.Update(3, usage);
+			CHECK(budget.GetPressureLevel(MemoryAllocCategory::Resources) == MemoryPressureLevel::Hard);
+
+			// Just under the hard limit stays hard until usage falls clear of it.
+			usage[static_cast<u64>(MemoryAllocCategory::Resources)] = 195_MB;
+			budget.Update(4, usage);
+			CHECK(budget.GetPressureLevel(MemoryAllocCategory::Resources) == MemoryPressureLevel::Hard);
+
+			usage[static_cast<u64>(MemoryAllocCategory::Resources)] = 120_MB;
+			budget.Update(5, usage);
+			CHECK(budget.GetPressureLevel(MemoryAllocCategory::Resources) == MemoryPressureLevel::Soft);
+
+			usage[static_cast<u64>(MemoryAllocCategory::Resources)] = 10_MB;
+			budget.Update(6, usage);
+			CHECK(budget.GetPressureLevel(MemoryAllocCategory::Resources) == MemoryPressureLevel::None);
+
+			CHECK(budget.GetPressureLevel(MemoryAllocCategory::Graphics) == MemoryPressureLevel::None);
+			ResetMemoryBudget();
+		}
+
+		TEST_CASE("History wraps and saves oldest frame first")
+		{
+			ResetMemoryBudget();
+			MemoryBudget& budget = MemoryBudget::Instance();
+
+			const u64 frameCount = MemoryBudget::c_HistoryFrameCount + 10;
+			MemoryBudget::CategoryUsage usage = { };
+			for (u64 frameIdx = 0; frameIdx < frameCount; ++frameIdx)
+			{
+				usage[static_cast<u64>(MemoryAllocCategory::General)] = frameIdx * 1_KB;
+				budget.Update(frameIdx, usage);
+			}
+			CHECK(budget.GetHistorySize() == MemoryBudget::c_HistoryFrameCount);
+
+			const char* filePath = "MemoryBudgetTest.csv";
+			CHECK(budget.SaveCsv(filePath));
+
+			std::ifstream file(filePath);
+			std::string line;
+			std::getline(file, line);
+			CHECK(line.rfind("Frame,General,Threading", 0) == 0);
+			std::getline(file, line);
+			CHECK(line.rfind("10,10,0", 0) == 0);
+
+			u64 rowCount = 1;
+			while (std::getline(file, line))
+			{
+				++rowCount;
+			}
+			CHECK(rowCount == MemoryBudget::c_HistoryFrameCount);
+			file.close();
+			std::remove(filePath);
+			ResetMemoryBudget();
+		}
+	}
+}
+#endif
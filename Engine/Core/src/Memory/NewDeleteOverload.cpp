@@ -1,5 +1,6 @@
 #include "Memory/NewDeleteOverload.h"
 
+#include "Core/Memory.h"
 #include "Core/MemoryTracker.h"
 
 #ifdef IS_MEMORY_OVERRIDES
@@ -10,7 +11,7 @@ void* operator new(const size_t size)
         return nullptr;
     }
 
-    if (void* ptr = std::malloc(size))
+    if (void* ptr = Insight::Memory::HeapAllocate(size))
     {
         Insight::Core::MemoryTracker::Instance().Track(ptr, size, Insight::Core::MemoryTrackAllocationType::Single);
         return ptr;
@@ -25,7 +26,7 @@ void* operator new[](const size_t size)
         return nullptr;
     }
 
-    if (void* ptr = std::malloc(size))
+    if (void* ptr = Insight::Memory::HeapAllocate(size))
     {
         Insight::Core::MemoryTracker::Instance().Track(ptr, size, Insight::Core::MemoryTrackAllocationType::Array);
         return ptr;
@@ -36,23 +37,23 @@ void* operator new[](const size_t size)
 void operator delete(void* ptr)
 {
     Insight::Core::MemoryTracker::Instance().UnTrack(ptr);
-    std::free(ptr);
+    Insight::Memory::HeapFree(ptr);
 }
 
 void operator delete(void* ptr, u64 bytes)
 {
     Insight::Core::MemoryTracker::Instance().UnTrack(ptr);
-    std::free(ptr);
+    Insight::Memory::HeapFree(ptr);
 }
 
 void operator delete[](void* ptr)
 {
     Insight::Core::MemoryTracker::Instance().UnTrack(ptr);
-    std::free(ptr);
+    Insight::Memory::HeapFree(ptr);
 }
 void operator delete[](void* ptr, u64 bytes)
 {
     Insight::Core::MemoryTracker::Instance().UnTrack(ptr);
-    std::free(ptr);
+    Insight::Memory::HeapFree(ptr);
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,457 @@
+#include "Memory/ObjectPool.h"
+
+#include "Core/Memory.h"
+#include "Core/Asserts.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace Insight::Core
+{
+	namespace
+	{
+		constexpr u8 c_PoisonByte = 0xDD;
+#ifdef IS_DEBUG
+		constexpr bool c_PoisonBlocks = true;
+#else
+		constexpr bool c_PoisonBlocks = false;
+#endif
+		/// @brief Target slab size for shared pools, so pools of large objects don't reserve too much up front.
+		constexpr u64 c_SharedSlabSize = 64_KB;
+
+		u64 AlignUp(const u64 value, const u64 alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		std::atomic<u32> s_nextPoolId = 0;
+		/// @brief Live pools by id, so a thread's magazines are only flushed to pools which still exist.
+		std::atomic<FixedBlockPool*> s_livePools[FixedBlockPool::c_MaxThreadCachedPools] = { };
+	}
+
+	struct FixedBlockPool::Magazine
+	{
+		void* Blocks[c_MagazineSize];
+		u32 Count = 0;
+	};
+
+	struct FixedBlockPool::SlabHeader
+	{
+		SlabHeader* Next = nullptr;
+	};
+
+	/// @brief A thread's magazine for every thread cached pool. Flushed back to the pools when the thread exits.
+	struct FixedBlockPoolThreadMagazines
+	{
+		FixedBlockPool::Magazine Magazines[FixedBlockPool::c_MaxThreadCachedPools];
+
+		~FixedBlockPoolThreadMagazines();
+	};
+
+	namespace
+	{
+		thread_local FixedBlockPoolThreadMagazines* t_magazines = nullptr;
+		thread_local bool t_magazinesReleased = false;
+
+		FixedBlockPoolThreadMagazines* GetThreadMagazines()
+		{
+			if (t_magazines || t_magazinesReleased)
+			{
+				return t_magazines;
+			}
+			thread_local FixedBlockPoolThreadMagazines magazines;
+			t_magazines = &magazines;
+			return t_magazines;
+		}
+	}
+
+	FixedBlockPoolThreadMagazines::~FixedBlockPoolThreadMagazines()
+	{
+		t_magazines = nullptr;
+		t_magazinesReleased = true;
+		for (u32 poolId = 0; poolId < FixedBlockPool::c_MaxThreadCachedPools; ++poolId)
+		{
+			FixedBlockPool::Magazine& magazine = Magazines[poolId];
+			if (magazine.Count == 0)
+			{
+				continue;
+			}
+			if (FixedBlockPool* pool = s_livePools[poolId].load(std::memory_order_acquire))
+			{
+				pool->Flush(magazine, magazine.Count);
+			}
+		}
+	}
+
+	FixedBlockPool::FixedBlockPool(const u64 blockSize, const u64 alignment, const u32 blocksPerSlab, const bool threadCache)
+		: m_alignment(std::max<u64>(alignment, alignof(void*)))
+		, m_blocksPerSlab(std::max<u32>(blocksPerSlab, 1))
+	{
+		ASSERT((m_alignment & (m_alignment - 1)) == 0);
+		m_blockSize = AlignUp(std::max<u64>(blockSize, sizeof(void*)), m_alignment);
+
+		m_id = c_MaxThreadCachedPools;
+		if (threadCache)
+		{
+			m_id = s_nextPoolId.fetch_add(1, std::memory_order_relaxed);
+			if (m_id < c_MaxThreadCachedPools)
+			{
+				s_livePools[m_id].store(this, std::memory_order_release);
+			}
+		}
+	}
+
+	FixedBlockPool::~FixedBlockPool()
+	{
+		if (m_id < c_MaxThreadCachedPools)
+		{
+			s_livePools[m_id].store(nullptr, std::memory_order_release);
+			if (t_magazines)
+			{
+				t_magazines->Magazines[m_id].Count = 0;
+			}
+		}
+
+		std::lock_guard lock(m_lock);
+		while (m_slabs)
+		{
+			SlabHeader* slab = m_slabs;
+			m_slabs = slab->Next;
+			FreeUnpooled(slab);
+		}
+	}
+
+	void* FixedBlockPool::Allocate()
+	{
+		if (Magazine* magazine = GetMagazine())
+		{
+			if (magazine->Count == 0)
+			{
+				Refill(*magazine);
+			}
+			void* block = magazine->Blocks[--magazine->Count];
+			CheckPoison(block);
+			return block;
+		}
+
+		std::lock_guard lock(m_lock);
+		return AllocateLocked();
+	}
+
+	void FixedBlockPool::Free(void* ptr)
+	{
+		if (!ptr)
+		{
+			return;
+		}
+
+		Poison(ptr);
+		if (Magazine* magazine = GetMagazine())
+		{
+			if (magazine->Count == c_MagazineSize)
+			{
+				Flush(*magazine, c_MagazineSize / 2);
+			}
+			magazine->Blocks[magazine->Count++] = ptr;
+			return;
+		}
+
+		std::lock_guard lock(m_lock);
+		FreeLocked(ptr);
+	}
+
+	ObjectPoolStats FixedBlockPool::GetStats() const
+	{
+		std::lock_guard lock(m_lock);
+		ObjectPoolStats stats;
+		stats.BlockSize = m_blockSize;
+		stats.SlabCount = m_slabCount;
+		stats.BlockCount = m_slabCount * m_blocksPerSlab;
+		stats.UsedBlockCount = m_usedBlockCount;
+		return stats;
+	}
+
+	FixedBlockPool& FixedBlockPool::GetShared(std::string_view name, const u64 blockSize, const u64 alignment)
+	{
+		struct SharedPools
+		{
+			std::mutex Lock;
+			std::unordered_map<std::string, FixedBlockPool*> Pools;
+		};
+		// Never destroyed, see 'GetShared'.
+		alignas(SharedPools) static u8 storage[sizeof(SharedPools)];
+		static SharedPools* sharedPools = new (storage) SharedPools();
+
+		std::string key = std::string(name) + ":" + std::to_string(blockSize) + ":" + std::to_string(alignment);
+		std::lock_guard lock(sharedPools->Lock);
+		FixedBlockPool*& pool = sharedPools->Pools[std::move(key)];
+		if (!pool)
+		{
+			const u32 blocksPerSlab = static_cast<u32>(std::clamp<u64>(c_SharedSlabSize / std::max<u64>(blockSize, 1), 1, c_DefaultBlocksPerSlab));
+			pool = new (NewNoTrack(sizeof(FixedBlockPool))) FixedBlockPool(blockSize, alignment, blocksPerSlab, true);
+		}
+		return *pool;
+	}
+
+	void* FixedBlockPool::AllocateUnpooled(const u64 size)
+	{
+		return ::Insight::Memory::HeapAllocate(size);
+	}
+
+	void FixedBlockPool::FreeUnpooled(void* ptr)
+	{
+		::Insight::Memory::HeapFree(ptr);
+	}
+
+	FixedBlockPool::Magazine* FixedBlockPool::GetMagazine()
+	{
+		if (m_id >= c_MaxThreadCachedPools)
+		{
+			return nullptr;
+		}
+		FixedBlockPoolThreadMagazines* magazines = GetThreadMagazines();
+		return magazines ? &magazines->Magazines[m_id] : nullptr;
+	}
+
+	void* FixedBlockPool::AllocateLocked()
+	{
+		if (!m_freeList)
+		{
+			AllocateSlab();
+		}
+		void* block = m_freeList;
+		m_freeList = *static_cast<void**>(block);
+		++m_usedBlockCount;
+		CheckPoison(block);
+		return block;
+	}
+
+	void FixedBlockPool::FreeLocked(void* ptr)
+	{
+		*static_cast<void**>(ptr) = m_freeList;
+		m_freeList = ptr;
+		--m_usedBlockCount;
+	}
+
+	void FixedBlockPool::Refill(Magazine& magazine)
+	{
+		std::lock_guard lock(m_lock);
+		while (magazine.Count < c_MagazineSize / 2)
+		{
+			if (!m_freeList)
+			{
+				AllocateSlab();
+			}
+			void* block = m_freeList;
+			m_freeList = *static_cast<void**>(block);
+			++m_usedBlockCount;
+			magazine.Blocks[magazine.Count++] = block;
+		}
+	}
+
+	void FixedBlockPool::Flush(Magazine& magazine, const u32 count)
+	{
+		std::lock_guard lock(m_lock);
+		for (u32 i = 0; i < count; ++i)
+		{
+			FreeLocked(magazine.Blocks[--magazine.Count]);
+		}
+	}
+
+	void FixedBlockPool::AllocateSlab()
+	{
+		const u64 headerSize = AlignUp(sizeof(SlabHeader), m_alignment);
+		// Allocations from the heap are only aligned to 16, over allocate for anything larger.
+		const u64 alignmentPadding = m_alignment > 16 ? m_alignment : 0;
+		u8* memory = static_cast<u8*>(AllocateUnpooled(headerSize + m_blockSize * m_blocksPerSlab + alignmentPadding));
+		ASSERT(memory);
+
+		SlabHeader* slab = new (memory) SlabHeader();
+		slab->Next = m_slabs;
+		m_slabs = slab;
+		++m_slabCount;
+
+		// Blocks are never at the start of the slab, so a block is never tracked with the slab's address.
+		u8* blocks = reinterpret_cast<u8*>(AlignUp(reinterpret_cast<u64>(memory) + headerSize, m_alignment));
+		for (u32 blockIdx = m_blocksPerSlab; blockIdx > 0; --blockIdx)
+		{
+			void* block = blocks + (blockIdx - 1) * m_blockSize;
+			Poison(block);
+			*static_cast<void**>(block) = m_freeList;
+			m_freeList = block;
+		}
+	}
+
+	void FixedBlockPool::Poison(void* ptr) const
+	{
+		if constexpr (c_PoisonBlocks)
+		{
+			std::memset(static_cast<u8*>(ptr) + sizeof(void*), c_PoisonByte, m_blockSize - sizeof(void*));
+		}
+	}
+
+	void FixedBlockPool::CheckPoison(void* ptr) const
+	{
+		if constexpr (c_PoisonBlocks)
+		{
+			const u8* bytes = static_cast<const u8*>(ptr);
+			for (u64 byteIdx = sizeof(void*); byteIdx < m_blockSize; ++byteIdx)
+			{
+				ASSERT_MSG(bytes[byteIdx] == c_PoisonByte, "[FixedBlockPool::CheckPoison] Block was written to after being freed.");
+			}
+		}
+	}
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+
+#include <thread>
+#include <vector>
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Core;
+
+	/// @brief Roughly the size of an entity.
+	struct PoolTestObject
+	{
+		PoolTestObject() = default;
+		explicit PoolTestObject(const u64 value) : Value(value) { }
+
+		u64 Value = 0;
+		u8 Payload[248];
+	};
+
+	struct alignas(64) PoolTestAlignedObject
+	{
+		u64 Value = 0;
+	};
+
+	TEST_SUITE("ObjectPool")
+	{
+		TEST_CASE("Blocks are aligned and reused")
+		{
+			ObjectPool<PoolTestAlignedObject> pool(16, false);
+
+			std::vector<PoolTestAlignedObject*> objects;
+			for (u32 i = 0; i < 40; ++i)
+			{
+				PoolTestAlignedObject* object = pool.Create();
+				CHECK(reinterpret_cast<u64>(object) % alignof(PoolTestAlignedObject) == 0);
+				object->Value = i;
+				objects.push_back(object);
+			}
+			ObjectPoolStats stats = pool.GetStats();
+			CHECK(stats.SlabCount == 3);
+			CHECK(stats.UsedBlockCount == 40);
+
+			PoolTestAlignedObject* last = objects.back();
+			pool.Destroy(last);
+			objects.pop_back();
+			CHECK(pool.Create() == last);
+			objects.push_back(last);
+
+			for (PoolTestAlignedObject* object : objects)
+			{
+				pool.Destroy(object);
+			}
+			stats = pool.GetStats();
+			CHECK(stats.UsedBlockCount == 0);
+			CHECK(stats.SlabCount == 3);
+		}
+
+		TEST_CASE("Objects freed on other threads return to the pool")
+		{
+			constexpr u32 c_ObjectCount = 10'000;
+			ObjectPool<PoolTestObject> pool;
+
+			std::vector<PoolTestObject*> objects;
+			for (u32 i = 0; i < c_ObjectCount; ++i)
+			{
+				objects.push_back(pool.Create(i));
+			}
+			std::thread destroyThread([&]()
+				{
+					for (PoolTestObject* object : objects)
+					{
+						pool.Destroy(object);
+					}
+				});
+			destroyThread.join();
+
+			// The destroying thread's magazine is flushed when it exits.
+			const ObjectPoolStats stats = pool.GetStats();
+			CHECK(stats.UsedBlockCount <= FixedBlockPool::c_MagazineSize);
+			CHECK(stats.BlockCount >= c_ObjectCount);
+
+			const u64 slabCount = stats.SlabCount;
+			for (u32 i = 0; i < c_ObjectCount; ++i)
+			{
+				objects[i] = pool.Create(i);
+			}
+			CHECK(pool.GetStats().SlabCount == slabCount);
+			for (PoolTestObject* object : objects)
+			{
+				pool.Destroy(object);
+			}
+		}
+
+		TEST_CASE("Shared pools are found by name, size and alignment")
+		{
+			FixedBlockPool& pool = FixedBlockPool::GetShared("PoolTestObject", sizeof(PoolTestObject), alignof(PoolTestObject));
+			CHECK(&FixedBlockPool::GetShared("PoolTestObject", sizeof(PoolTestObject), alignof(PoolTestObject)) == &pool);
+			CHECK(&FixedBlockPool::GetShared("PoolTestObject", sizeof(PoolTestObject) * 2, alignof(PoolTestObject)) != &pool);
+			CHECK(pool.GetBlockSize() == sizeof(PoolTestObject));
+		}
+
+		TEST_CASE("Create and destroy benchmark")
+		{
+			constexpr u32 c_ObjectCount = 100'000;
+			constexpr u32 c_RepeatCount = 10;
+			std::vector<PoolTestObject*> objects(c_ObjectCount);
+
+			Core::Timer heapTimer;
+			heapTimer.Start();
+			for (u32 repeatIdx = 0; repeatIdx < c_RepeatCount; ++repeatIdx)
+			{
+				for (u32 i = 0; i < c_ObjectCount; ++i)
+				{
+					objects[i] = ::New<PoolTestObject>(i);
+				}
+				for (PoolTestObject*& object : objects)
+				{
+					::Delete(object);
+				}
+			}
+			heapTimer.Stop();
+
+			ObjectPool<PoolTestObject> pool;
+			Core::Timer poolTimer;
+			poolTimer.Start();
+			for (u32 repeatIdx = 0; repeatIdx < c_RepeatCount; ++repeatIdx)
+			{
+				for (u32 i = 0; i < c_ObjectCount; ++i)
+				{
+					objects[i] = pool.Create(i);
+				}
+				for (PoolTestObject* object : objects)
+				{
+					pool.Destroy(object);
+				}
+			}
+			poolTimer.Stop();
+
+			const double operationCount = static_cast<double>(c_ObjectCount) * c_RepeatCount;
+			MESSAGE("Objects: " << c_ObjectCount
+				<< " | New/Delete ns/object: " << heapTimer.GetElapsedTimeNano().count() / operationCount
+				<< " | ObjectPool ns/object: " << poolTimer.GetElapsedTimeNano().count() / operationCount);
+		}
+	}
+}
+#endif
@@ -0,0 +1,449 @@
+#include "Memory/ScratchAllocator.h"
+
+#include "Core/Asserts.h"
+#include "Core/Memory.h"
+#include "Platforms/Platform.h"
+
+#include <algorithm>
+
+namespace Insight::Core
+{
+	namespace
+	{
+		constexpr u8 c_PoisonByte = 0xCD;
+#ifdef IS_DEBUG
+		constexpr bool c_PoisonMemory = true;
+#else
+		constexpr bool c_PoisonMemory = false;
+#endif
+
+		u64 AlignUp(const u64 value, const u64 alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		/// @brief Offset within 'memory' an allocation of 'alignment' can start at, 'used' bytes in.
+		u64 AlignedOffset(const u8* memory, const u64 used, const u64 alignment)
+		{
+			const u64 address = reinterpret_cast<u64>(memory) + used;
+			return AlignUp(address, alignment) - reinterpret_cast<u64>(memory);
+		}
+	}
+
+	//=============================================================
+	// ScratchAllocator
+	//=============================================================
+	ScratchAllocator::ScratchAllocator(const u64 chunkSize, const u64 maxRetainedBytes, const MemoryAllocCategory memoryAllocCategory)
+		: m_chunkSize(chunkSize)
+		, m_maxRetainedBytes(maxRetainedBytes)
+		, m_memoryAllocCategory(memoryAllocCategory)
+	{
+		ASSERT(m_chunkSize > 0);
+	}
+
+	ScratchAllocator::~ScratchAllocator()
+	{
+		ASSERT_MSG(m_scopeDepth == 0, "[ScratchAllocator::~ScratchAllocator] Allocator destroyed with scopes still open.");
+		for (Chunk& chunk : m_chunks)
+		{
+			DeleteBytes(chunk.Memory);
+		}
+		m_chunks.clear();
+	}
+
+	ScratchAllocator& ScratchAllocator::GetThreadAllocator()
+	{
+		thread_local ScratchAllocator allocator;
+		return allocator;
+	}
+
+	void* ScratchAllocator::Allocate(const u64 size, const u64 alignment)
+	{
+		ASSERT_MSG(m_scopeDepth > 0, "[ScratchAllocator::Allocate] Scratch memory must be allocated within a 'ScratchScope'.");
+		ASSERT((alignment & (alignment - 1)) == 0);
+
+		Chunk* chunk = m_chunks.empty() ? nullptr : &m_chunks[m_currentChunk];
+		u64 offset = chunk ? AlignedOffset(chunk->Memory, chunk->Used, alignment) : 0;
+		if (!chunk || offset + size > chunk->Size)
+		{
+			chunk = &NextChunk(size, alignment);
+			offset = AlignedOffset(chunk->Memory, 0, alignment);
+		}
+
+		const u64 newUsed = offset + size;
+		m_usedBytes += newUsed - chunk->Used;
+		m_peakUsedBytes = std::max(m_peakUsedBytes, m_usedBytes);
+		chunk->Used = newUsed;
+		return chunk->Memory + offset;
+	}
+
+	void* ScratchAllocator::Reallocate(void* ptr, const u64 oldSize, const u64 newSize, const u64 alignment)
+	{
+		if (!ptr)
+		{
+			return Allocate(newSize, alignment);
+		}
+
+		Chunk& chunk = m_chunks[m_currentChunk];
+		u8* bytes = static_cast<u8*>(ptr);
+		const bool isLastAllocation = bytes + oldSize == chunk.Memory + chunk.Used;
+		if (isLastAllocation)
+		{
+			const u64 offset = static_cast<u64>(bytes - chunk.Memory);
+			if (offset + newSize <= chunk.Size)
+			{
+				const u64 newUsed = offset + newSize;
+				if (newUsed < chunk.Used)
+				{
+					Poison(chunk, newUsed, chunk.Used);
+				}
+				m_usedBytes = m_usedBytes - chunk.Used + newUsed;
+				m_peakUsedBytes = std::max(m_peakUsedBytes, m_usedBytes);
+				chunk.Used = newUsed;
+				return ptr;
+			}
+		}
+
+		void* newPtr = Allocate(newSize, alignment);
+		Platform::MemCopy(newPtr, ptr, std::min(oldSize, newSize));
+		return newPtr;
+	}
+
+	void ScratchAllocator::Free(void* ptr, const u64 size)
+	{
+		if (!ptr || m_chunks.empty())
+		{
+			return;
+		}
+
+		Chunk& chunk = m_chunks[m_currentChunk];
+		u8* bytes = static_cast<u8*>(ptr);
+		if (bytes + size == chunk.Memory + chunk.Used)
+		{
+			const u64 newUsed = static_cast<u64>(bytes - chunk.Memory);
+			Poison(chunk, newUsed, chunk.Used);
+			m_usedBytes -= chunk.Used - newUsed;
+			chunk.Used = newUsed;
+		}
+	}
+
+	ScratchMarker ScratchAllocator::GetMarker() const
+	{
+		ScratchMarker marker;
+		marker.ChunkIndex = m_currentChunk;
+		marker.Offset = m_chunks.empty() ? 0 : m_chunks[m_currentChunk].Used;
+		return marker;
+	}
+
+	void ScratchAllocator::Rewind(const ScratchMarker marker)
+	{
+		if (m_chunks.empty())
+		{
+			ASSERT(marker.ChunkIndex == 0 && marker.Offset == 0);
+			return;
+		}
+
+		ASSERT_MSG(marker.ChunkIndex < m_currentChunk
+			|| (marker.ChunkIndex == m_currentChunk && marker.Offset <= m_chunks[m_currentChunk].Used)
+			, "[ScratchAllocator::Rewind] Scratch scopes must be released in the reverse order they were opened.");
+
+		for (u32 chunkIdx = marker.ChunkIndex; chunkIdx <= m_currentChunk; ++chunkIdx)
+		{
+			Chunk& chunk = m_chunks[chunkIdx];
+			const u64 newUsed = chunkIdx == marker.ChunkIndex ? marker.Offset : 0;
+			Poison(chunk, newUsed, chunk.Used);
+			m_usedBytes -= chunk.Used - newUsed;
+			chunk.Used = newUsed;
+		}
+		m_currentChunk = marker.ChunkIndex;
+
+		ReleaseUnusedChunks();
+	}
+
+	ScratchAllocatorStats ScratchAllocator::GetStats() const
+	{
+		ScratchAllocatorStats stats;
+		stats.ChunkCount = m_chunks.size();
+		stats.ReservedBytes = m_reservedBytes;
+		stats.UsedBytes = m_usedBytes;
+		stats.PeakUsedBytes = m_peakUsedBytes;
+		return stats;
+	}
+
+	ScratchAllocator::Chunk& ScratchAllocator::NextChunk(const u64 size, const u64 alignment)
+	{
+		// Chunks are aligned to at least 'c_DefaultAlignment', only larger alignments need padding.
+		const u64 requiredSize = size + (alignment > c_DefaultAlignment ? alignment : 0);
+
+		const u32 nextChunkIdx = m_chunks.empty() ? 0 : m_currentChunk + 1;
+		if (nextChunkIdx < m_chunks.size()
+			&& m_chunks[nextChunkIdx].Size >= requiredSize)
+		{
+			m_currentChunk = nextChunkIdx;
+			return m_chunks[m_currentChunk];
+		}
+
+		Chunk chunk;
+		chunk.Size = std::max(m_chunkSize, requiredSize);
+		chunk.Memory = static_cast<u8*>(NewBytes(chunk.Size, m_memoryAllocCategory));
+		m_reservedBytes += chunk.Size;
+
+		// Chunks after the current one are unused, so a new chunk can go before them.
+		m_chunks.insert(m_chunks.begin() + nextChunkIdx, chunk);
+		m_currentChunk = nextChunkIdx;
+		return m_chunks[m_currentChunk];
+	}
+
+	void ScratchAllocator::ReleaseUnusedChunks()
+	{
+		u64 retainedBytes = 0;
+		for (u32 chunkIdx = 0; chunkIdx <= m_currentChunk; ++chunkIdx)
+		{
+			retainedBytes += m_chunks[chunkIdx].Size;
+		}
+
+		for (u64 chunkIdx = m_currentChunk + 1; chunkIdx < m_chunks.size();)
+		{
+			Chunk& chunk = m_chunks[chunkIdx];
+			if (retainedBytes + chunk.Size <= m_maxRetainedBytes)
+			{
+				retainedBytes += chunk.Size;
+				++chunkIdx;
+				continue;
+			}
+
+			m_reservedBytes -= chunk.Size;
+			DeleteBytes(chunk.Memory);
+			m_chunks.erase(m_chunks.begin() + chunkIdx);
+		}
+
+		// With nothing allocated the first chunk can go too if it is a single oversized allocation.
+		if (m_currentChunk == 0 && m_chunks[0].Used == 0 && m_chunks[0].Size > m_maxRetainedBytes)
+		{
+			m_reservedBytes -= m_chunks[0].Size;
+			DeleteBytes(m_chunks[0].Memory);
+			m_chunks.erase(m_chunks.begin());
+		}
+	}
+
+	void ScratchAllocator::Poison(Chunk& chunk, const u64 from, const u64 to) const
+	{
+		if (c_PoisonMemory && to > from)
+		{
+			Platform::MemSet(chunk.Memory + from, c_PoisonByte, to - from);
+		}
+	}
+
+	//=============================================================
+	// ScratchScope
+	//=============================================================
+	ScratchScope::ScratchScope()
+		: ScratchScope(ScratchAllocator::GetThreadAllocator())
+	{ }
+
+	ScratchScope::ScratchScope(ScratchAllocator& allocator)
+		: m_allocator(allocator)
+		, m_marker(allocator.GetMarker())
+	{
+		++m_allocator.m_scopeDepth;
+	}
+
+	ScratchScope::~ScratchScope()
+	{
+		ASSERT(m_allocator.m_scopeDepth > 0);
+		--m_allocator.m_scopeDepth;
+		m_allocator.Rewind(m_marker);
+	}
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+
+#include <memory>
+#include <vector>
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Core;
+
+	/// @brief Bytes currently allocated and the most allocated at once through 'CountingAllocator'.
+	struct HeapUsage
+	{
+		u64 UsedBytes = 0;
+		u64 PeakUsedBytes = 0;
+	};
+
+	/// @brief Heap allocator which records its usage, so the heap path can be compared against scratch memory.
+	template<typename T>
+	struct CountingAllocator
+	{
+		using value_type = T;
+
+		explicit CountingAllocator(HeapUsage& usage) : Usage(&usage) { }
+		template<typename TOther>
+		CountingAllocator(const CountingAllocator<TOther>& other) : Usage(other.Usage) { }
+
+		T* allocate(const std::size_t count)
+		{
+			Usage->UsedBytes += count * sizeof(T);
+			Usage->PeakUsedBytes = std::max(Usage->PeakUsedBytes, Usage->UsedBytes);
+			return std::allocator<T>().allocate(count);
+		}
+		void deallocate(T* ptr, const std::size_t count)
+		{
+			Usage->UsedBytes -= count * sizeof(T);
+			std::allocator<T>().deallocate(ptr, count);
+		}
+
+		template<typename TOther>
+		bool operator==(const CountingAllocator<TOther>& other) const { return Usage == other.Usage; }
+		template<typename TOther>
+		bool operator!=(const CountingAllocator<TOther>& other) const { return Usage != other.Usage; }
+
+		HeapUsage* Usage = nullptr;
+	};
+
+	TEST_SUITE("ScratchAllocator")
+	{
+		TEST_CASE("Scopes rewind in LIFO order and reuse memory")
+		{
+			ScratchAllocator allocator(1_KB, 4_KB);
+
+			void* outerFirst = nullptr;
+			{
+				ScratchScope outerScope(allocator);
+				outerFirst = allocator.Allocate(100);
+				void* aligned = allocator.Allocate(8, 64);
+				CHECK(reinterpret_cast<u64>(aligned) % 64 == 0);
+
+				void* innerFirst = nullptr;
+				{
+					ScratchScope innerScope(allocator);
+					innerFirst = allocator.Allocate(200);
+					// Larger than a chunk, gets a chunk of its own.
+					void* large = allocator.Allocate(8_KB);
+					CHECK(large != nullptr);
+					CHECK(allocator.GetStats().ChunkCount == 2);
+				}
+				// The oversized chunk is over the retained limit and released.
+				CHECK(allocator.GetStats().ChunkCount == 1);
+
+				{
+					ScratchScope innerScope(allocator);
+					CHECK(allocator.Allocate(200) == innerFirst);
+				}
+			}
+			CHECK(allocator.GetStats().UsedBytes == 0);
+			CHECK(allocator.GetStats().PeakUsedBytes >= 8_KB);
+
+			ScratchScope scope(allocator);
+			CHECK(allocator.Allocate(100) == outerFirst);
+		}
+
+		TEST_CASE("Last allocation is resized and freed in place")
+		{
+			ScratchAllocator allocator(1_KB);
+			ScratchScope scope(allocator);
+
+			u8* first = static_cast<u8*>(allocator.Allocate(64));
+			first[0] = 42;
+			CHECK(allocator.Reallocate(first, 64, 512) == first);
+			CHECK(first[0] == 42);
+
+			void* second = allocator.Allocate(32);
+			// Not the last allocation any more so it moves.
+			u8* moved = static_cast<u8*>(allocator.Reallocate(first, 512, 600));
+			CHECK(moved != first);
+			CHECK(moved[0] == 42);
+
+			const u64 usedBytes = allocator.GetStats().UsedBytes;
+			allocator.Free(second, 32);
+			CHECK(allocator.GetStats().UsedBytes == usedBytes);
+			allocator.Free(moved, 600);
+			CHECK(allocator.GetStats().UsedBytes < usedBytes);
+		}
+
+		TEST_CASE("ScratchVector uses the thread allocator")
+		{
+			ScratchAllocator& allocator = ScratchAllocator::GetThreadAllocator();
+			const u64 usedBytes = allocator.GetStats().UsedBytes;
+			{
+				ScratchScope scope;
+				ScratchVector<u32> values;
+				for (u32 i = 0; i < 10'000; ++i)
+				{
+					values.push_back(i);
+				}
+				CHECK(values[9'999] == 9'999);
+				CHECK(allocator.GetStats().UsedBytes > usedBytes);
+			}
+			CHECK(allocator.GetStats().UsedBytes == usedBytes);
+		}
+
+		TEST_CASE("Benchmark importer temporaries")
+		{
+			// Mimics a mesh import: per mesh vertex, index and remap buffers which are thrown away once uploaded.
+			constexpr u32 c_MeshCount = 2'000;
+			constexpr u32 c_MaxVertexCount = 20'000;
+			struct Vertex
+			{
+				float Data[16];
+			};
+
+			u64 checksum = 0;
+			HeapUsage heapUsage;
+			Timer heapTimer;
+			heapTimer.Start();
+			for (u32 meshIdx = 0; meshIdx < c_MeshCount; ++meshIdx)
+			{
+				const u32 vertexCount = 1'000 + (meshIdx * 7919) % c_MaxVertexCount;
+				std::vector<Vertex, CountingAllocator<Vertex>> vertices{ CountingAllocator<Vertex>(heapUsage) };
+				std::vector<u32, CountingAllocator<u32>> indices{ CountingAllocator<u32>(heapUsage) };
+				vertices.reserve(vertexCount);
+				indices.reserve(vertexCount * 3);
+				for (u32 i = 0; i < vertexCount; ++i)
+				{
+					vertices.push_back(Vertex{ { static_cast<float>(i) } });
+					indices.push_back(i);
+					indices.push_back(i);
+					indices.push_back(i);
+				}
+				std::vector<u32, CountingAllocator<u32>> remap(vertexCount, 0, CountingAllocator<u32>(heapUsage));
+				checksum += vertices.size() + indices.size() + remap.size();
+			}
+			heapTimer.Stop();
+
+			ScratchAllocator& allocator = ScratchAllocator::GetThreadAllocator();
+			Timer scratchTimer;
+			scratchTimer.Start();
+			for (u32 meshIdx = 0; meshIdx < c_MeshCount; ++meshIdx)
+			{
+				ScratchScope scope;
+				const u32 vertexCount = 1'000 + (meshIdx * 7919) % c_MaxVertexCount;
+				ScratchVector<Vertex> vertices;
+				ScratchVector<u32> indices;
+				vertices.reserve(vertexCount);
+				indices.reserve(vertexCount * 3);
+				for (u32 i = 0; i < vertexCount; ++i)
+				{
+					vertices.push_back(Vertex{ { static_cast<float>(i) } });
+					indices.push_back(i);
+					indices.push_back(i);
+					indices.push_back(i);
+				}
+				ScratchVector<u32> remap(vertexCount);
+				checksum -= vertices.size() + indices.size() + remap.size();
+			}
+			scratchTimer.Stop();
+			CHECK(checksum == 0);
+
+			const ScratchAllocatorStats stats = allocator.GetStats();
+			MESSAGE("Importer temporaries, " << c_MeshCount << " meshes. Heap: " << heapTimer.GetElapsedTimeNano().count() / 1'000'000.0 << "ms, Scratch: "
+				<< scratchTimer.GetElapsedTimeNano().count() / 1'000'000.0 << "ms. Heap peak: " << heapUsage.PeakUsedBytes / 1024 << "KB, Scratch peak: "
+				<< stats.PeakUsedBytes / 1024 << "KB, retained: " << stats.ReservedBytes / 1024 << "KB.");
+		}
+	}
+}
+#endif
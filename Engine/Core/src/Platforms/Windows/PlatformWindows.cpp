@@ -389,6 +389,12 @@ namespace Insight
 				const u32 SSE42_POS = 0x00100000;
 				const u32 AVX_POS = 0x10000000;
 				const u32 AVX2_POS = 0x00000020;
+				const u32 AVX512F_POS = 0x00010000;
+				const u32 AVX512DQ_POS = 0x00020000;
+				const u32 AVX512CD_POS = 0x10000000;
+				const u32 AVX512BW_POS = 0x40000000;
+				const u32 AVX512VL_POS = 0x80000000;
+				const u32 OSXSAVE_POS = 0x08000000;
 				const u32 LVL_NUM = 0x000000FF;
 				const u32 LVL_TYPE = 0x0000FF00;
 				const u32 LVL_CORES = 0x0000FFFF;
@@ -408,12 +414,23 @@ namespace Insight
 				s_cpuInformation.IsSSE2  = cpuID1.EDX() & SSE2_POS;
 				s_cpuInformation.IsSSE3  = cpuID1.ECX() & SSE3_POS;
 				s_cpuInformation.IsSSE41 = cpuID1.ECX() & SSE41_POS;
-				s_cpuInformation.IsSSE42 = cpuID1.ECX() & SSE41_POS;
-				s_cpuInformation.IsAVX   = cpuID1.ECX() & AVX_POS;
+				s_cpuInformation.IsSSE42 = cpuID1.ECX() & SSE42_POS;
 
-				// Get AVX2 instructions availability
+				// AVX registers are only usable if the OS saves them on a context switch (YMM state, plus the opmask and
+				// ZMM state for AVX-512).
+				const u64 xcr0 = (cpuID1.ECX() & OSXSAVE_POS) ? _xgetbv(0) : 0;
+				const bool osSavesYmm = (xcr0 & 0x6) == 0x6;
+				const bool osSavesZmm = (xcr0 & 0xE6) == 0xE6;
+				s_cpuInformation.IsAVX   = (cpuID1.ECX() & AVX_POS) && osSavesYmm;
+
+				// Get AVX2 and AVX-512 instructions availability
 				CPUID cpuID7(7, 0);
-				s_cpuInformation.IsAVX2 = cpuID7.EBX()  & AVX2_POS;
+				s_cpuInformation.IsAVX2   = (cpuID7.EBX() & AVX2_POS) && osSavesYmm;
+				s_cpuInformation.IsAVX512F  = (cpuID7.EBX() & AVX512F_POS) && osSavesZmm;
+				s_cpuInformation.IsAVX512CD = (cpuID7.EBX() & AVX512CD_POS) && osSavesZmm;
+				s_cpuInformation.IsAVX512BW = (cpuID7.EBX() & AVX512BW_POS) && osSavesZmm;
+				s_cpuInformation.IsAVX512DQ = (cpuID7.EBX() & AVX512DQ_POS) && osSavesZmm;
+				s_cpuInformation.IsAVX512VL = (cpuID7.EBX() & AVX512VL_POS) && osSavesZmm;
 
 				std::string upVId = s_cpuInformation.Vendor;
 				std::for_each(upVId.begin(), upVId.end(), [](char& in) { in = ::toupper(in); });
@@ -6,6 +6,8 @@
 #include "Core/Logger.h"
 #include "Core/Asserts.h"
 
+#include <algorithm>
+
 namespace Insight
 {
     namespace Serialisation
@@ -30,7 +32,8 @@ namespace Insight
             const u64 requiredSize = Size + sizeBytes;
             if (requiredSize > Capacity)
             {
-                Resize(requiredSize);
+                // Grow geometrically, growing to the exact size copied the whole buffer on every write once full.
+                Resize(std::max(requiredSize, Capacity * 2));
             }
             Platform::MemCopy(Data + Size, data, sizeBytes);
             Size += sizeBytes;
@@ -51,11 +54,11 @@ namespace Insight
             }
 
             Byte* newBlock = static_cast<Byte*>(NewBytes(newSize));
-            Platform::MemSet(newBlock, 0, newSize);
+            Platform::MemSet(newBlock + Capacity, 0, newSize - Capacity);
             if (Data)
             {
                 Platform::MemCopy(newBlock, Data, Capacity);
-                Delete(Data);
+                DeleteBytes(Data);
             }
             Data = newBlock;
             Capacity = newSize;
@@ -90,9 +93,14 @@ namespace Insight
 
         void BinaryHead::Deserialise(const std::vector<Byte>& data)
         {
-            Resize(data.size());
-            Platform::MemCopy(Data, data.data(), data.size());
-            ReadSize = data.size();
+            Deserialise(data.data(), data.size());
+        }
+
+        void BinaryHead::Deserialise(const Byte* data, const u64 dataSize)
+        {
+            Resize(dataSize);
+            Platform::MemCopy(Data, data, dataSize);
+            ReadSize = dataSize;
             Clear();
         }
 
@@ -198,14 +206,14 @@ namespace Insight
             {
                 if (m_objectTracking)
                 {
-                    Read(std::string(name) + "ObjectSize", m_head.Top().Size);
+                    Read("ObjectSize", m_head.Top().Size);
                 }
             }
             else
             {
                 if (m_objectTracking)
                 {
-                    Write(std::string(name) + "ObjectSize", 0ull);
+                    Write("ObjectSize", 0ull);
                 }
             }
 
@@ -420,5 +428,10 @@ namespace Insight
         {
             m_head.Deserialise(data);
         }
+
+        void BinarySerialiser::DeserialiseNoValidate(const Byte* data, const u64 dataSize)
+        {
+            m_head.Deserialise(data, dataSize);
+        }
     }
 }
\ No newline at end of file
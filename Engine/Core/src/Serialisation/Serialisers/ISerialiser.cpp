@@ -9,6 +9,8 @@
 
 #include "Platforms/Platform.h"
 
+#include <algorithm>
+
 namespace Insight
 {
     namespace Serialisation
@@ -103,8 +105,10 @@ namespace Insight
             /// circle of the binary serialiser always going Deserialise->ValidateHeader->Deserialise->ValidateHeader...
             /// We don't care about any data after the header and as the header should always be in binary format this should
             /// be ok.
+            /// Only the header is read, so only copy enough for it rather than the whole of 'data'.
+            constexpr u64 c_MaxHeaderSize = 1_KB;
             BinarySerialiser serialiser(true);
-            serialiser.DeserialiseNoValidate(data);
+            serialiser.DeserialiseNoValidate(data.data(), std::min<u64>(data.size(), c_MaxHeaderSize));
 
             ISerialiserHeader header;
             header.Deserialise(&serialiser);
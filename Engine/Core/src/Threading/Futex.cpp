@@ -0,0 +1,43 @@
+#include "Threading/Futex.h"
+
+#ifdef IS_PLATFORM_WINDOWS
+#include <Windows.h>
+#elif defined(IS_PLATFORM_LINUX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+namespace Insight
+{
+    namespace Threading
+    {
+        void Futex::WaitOnAddress(void* address, const u32 expectedValue)
+        {
+#ifdef IS_PLATFORM_WINDOWS
+            u32 compareValue = expectedValue;
+            ::WaitOnAddress(address, &compareValue, sizeof(u32), INFINITE);
+#elif defined(IS_PLATFORM_LINUX)
+            syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expectedValue, nullptr, nullptr, 0);
+#else
+            if (reinterpret_cast<std::atomic<u32>*>(address)->load() == expectedValue)
+            {
+                std::this_thread::yield();
+            }
+#endif
+        }
+
+        void Futex::WakeAllOnAddress(void* address)
+        {
+#ifdef IS_PLATFORM_WINDOWS
+            ::WakeByAddressAll(address);
+#elif defined(IS_PLATFORM_LINUX)
+            syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+#else
+            IS_UNUSED(address);
+#endif
+        }
+    }
+}
@@ -0,0 +1,222 @@
+#include "Threading/MPMCQueue.h"
+
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Threading;
+
+	/// @brief Encode the producer index and a per producer sequence number into one item.
+	static u64 MakeItem(const u64 producerIdx, const u64 sequence) { return (producerIdx << 32) | sequence; }
+	static u64 GetProducer(const u64 item) { return item >> 32; }
+	static u64 GetSequence(const u64 item) { return item & 0xFFFF'FFFF; }
+
+	/// @brief Mutex and vector queue, the pattern the lock free queues replace. Used as the benchmark baseline.
+	struct MutexQueue
+	{
+		bool TryPush(const u64 item)
+		{
+			std::lock_guard lock(Mutex);
+			Items.push_back(item);
+			return true;
+		}
+		bool TryPop(u64& item)
+		{
+			std::lock_guard lock(Mutex);
+			if (Head == Items.size())
+			{
+				return false;
+			}
+			item = Items[Head++];
+			return true;
+		}
+
+		std::mutex Mutex;
+		std::vector<u64> Items;
+		u64 Head = 0;
+	};
+
+	/// @brief Push 'itemsPerProducer' items from each producer and pop them all on 'consumerCount' threads.
+	/// @return Items per second.
+	template<typename Queue>
+	static double RunProducersConsumers(Queue& queue, const u32 producerCount, const u32 consumerCount, const u64 itemsPerProducer
+		, std::vector<std::vector<u64>>* consumedItems)
+	{
+		const u64 totalItemCount = producerCount * itemsPerProducer;
+		std::atomic<u64> consumedCount = 0;
+		std::atomic<bool> start = false;
+
+		std::vector<std::thread> threads;
+		for (u32 producerIdx = 0; producerIdx < producerCount; ++producerIdx)
+		{
+			threads.emplace_back([&, producerIdx]()
+				{
+					while (!start.load()) { std::this_thread::yield(); }
+					for (u64 sequence = 0; sequence < itemsPerProducer; ++sequence)
+					{
+						while (!queue.TryPush(MakeItem(producerIdx, sequence)))
+						{
+							std::this_thread::yield();
+						}
+					}
+				});
+		}
+		for (u32 consumerIdx = 0; consumerIdx < consumerCount; ++consumerIdx)
+		{
+			threads.emplace_back([&, consumerIdx]()
+				{
+					while (!start.load()) { std::this_thread::yield(); }
+					u64 item = 0;
+					while (consumedCount.load(std::memory_order_relaxed) < totalItemCount)
+					{
+						if (queue.TryPop(item))
+						{
+							consumedCount.fetch_add(1, std::memory_order_relaxed);
+							if (consumedItems)
+							{
+								(*consumedItems)[consumerIdx].push_back(item);
+							}
+						}
+						else
+						{
+							std::this_thread::yield();
+						}
+					}
+				});
+		}
+
+		Core::Timer timer;
+		timer.Start();
+		start = true;
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		timer.Stop();
+		return totalItemCount / (timer.GetElapsedTimeNano().count() / 1'000'000'000.0);
+	}
+
+	TEST_SUITE("MPMCQueue")
+	{
+		TEST_CASE("Single thread FIFO and capacity")
+		{
+			MPMCQueue<u64, 8> queue;
+			for (u64 i = 0; i < 8; ++i)
+			{
+				CHECK(queue.TryPush(i));
+			}
+			CHECK_FALSE(queue.TryPush(8));
+			CHECK(queue.GetSize() == 8);
+
+			u64 item = 0;
+			for (u64 i = 0; i < 8; ++i)
+			{
+				CHECK(queue.TryPop(item));
+				CHECK(item == i);
+			}
+			CHECK_FALSE(queue.TryPop(item));
+			CHECK(queue.IsEmpty());
+		}
+
+		TEST_CASE("Every item is received once and in order per producer under contention")
+		{
+			constexpr u32 c_ProducerCount = 8;
+			constexpr u32 c_ConsumerCount = 4;
+			constexpr u64 c_ItemsPerProducer = 100'000;
+
+			MPMCQueue<u64, 1024> queue;
+			std::vector<std::vector<u64>> consumedItems(c_ConsumerCount);
+			RunProducersConsumers(queue, c_ProducerCount, c_ConsumerCount, c_ItemsPerProducer, &consumedItems);
+
+			std::vector<u64> receivedCount(c_ProducerCount, 0);
+			bool inOrder = true;
+			for (const std::vector<u64>& items : consumedItems)
+			{
+				std::vector<i64> lastSequence(c_ProducerCount, -1);
+				for (const u64 item : items)
+				{
+					const u64 producerIdx = GetProducer(item);
+					const i64 sequence = static_cast<i64>(GetSequence(item));
+					inOrder &= sequence > lastSequence[producerIdx];
+					lastSequence[producerIdx] = sequence;
+					++receivedCount[producerIdx];
+				}
+			}
+			CHECK(inOrder);
+			for (const u64 count : receivedCount)
+			{
+				CHECK(count == c_ItemsPerProducer);
+			}
+		}
+
+		TEST_CASE("Blocking push and pop")
+		{
+			constexpr u64 c_ItemCount = 100'000;
+			MPMCQueue<u64, 64, true> queue;
+
+			u64 sum = 0;
+			std::thread consumer([&]()
+				{
+					u64 item = 0;
+					for (u64 i = 0; i < c_ItemCount; ++i)
+					{
+						queue.Pop(item);
+						sum += item;
+					}
+				});
+			for (u64 i = 0; i < c_ItemCount; ++i)
+			{
+				queue.Push(i);
+			}
+			consumer.join();
+			CHECK(sum == (c_ItemCount * (c_ItemCount - 1)) / 2);
+		}
+
+		TEST_CASE("Non trivial items are destroyed")
+		{
+			std::shared_ptr<int> value = std::make_shared<int>(1);
+			{
+				MPMCQueue<std::shared_ptr<int>, 16> queue;
+				CHECK(queue.TryPush(value));
+				CHECK(queue.TryPush(value));
+				std::shared_ptr<int> popped;
+				CHECK(queue.TryPop(popped));
+				CHECK(value.use_count() == 3);
+			}
+			CHECK(value.use_count() == 1);
+		}
+
+		TEST_CASE("Throughput 1-32 producers")
+		{
+			constexpr u64 c_TotalItemCount = 1'000'000;
+			const u32 producerCounts[] = { 1, 2, 4, 8, 16, 32 };
+			for (const u32 producerCount : producerCounts)
+			{
+				const u64 itemsPerProducer = c_TotalItemCount / producerCount;
+
+				MPMCQueue<u64, 4096> lockFreeQueue;
+				const double lockFreeMPSC = RunProducersConsumers(lockFreeQueue, producerCount, 1, itemsPerProducer, nullptr);
+				MPMCQueue<u64, 4096> lockFreeQueueMPMC;
+				const double lockFreeMPMC = RunProducersConsumers(lockFreeQueueMPMC, producerCount, 4, itemsPerProducer, nullptr);
+
+				MutexQueue mutexQueue;
+				mutexQueue.Items.reserve(c_TotalItemCount);
+				const double mutexMPSC = RunProducersConsumers(mutexQueue, producerCount, 1, itemsPerProducer, nullptr);
+
+				MESSAGE("Producers: " << producerCount
+					<< " | MPMCQueue 1 consumer items/s: " << lockFreeMPSC
+					<< " | MPMCQueue 4 consumers items/s: " << lockFreeMPMC
+					<< " | std::mutex 1 consumer items/s: " << mutexMPSC);
+			}
+		}
+	}
+}
+#endif
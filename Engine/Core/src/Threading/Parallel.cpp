@@ -0,0 +1,151 @@
+#include "Threading/Parallel.h"
+
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+
+#include <numeric>
+#include <random>
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Threading;
+
+	template<typename Func>
+	double TimeMilliseconds(Func&& func)
+	{
+		Core::Timer timer;
+		timer.Start();
+		func();
+		timer.Stop();
+		return static_cast<double>(timer.GetElapsedTimeNano().count()) / 1'000'000.0;
+	}
+
+	TEST_SUITE("Parallel")
+	{
+		constexpr u64 c_ElementCount = 4'000'000;
+
+		TEST_CASE("ParallelFor")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+			taskSystem.Initialise();
+
+			std::vector<float> serialValues(c_ElementCount, 4.0f);
+			const double serialMs = TimeMilliseconds([&]()
+				{
+					for (float& value : serialValues)
+					{
+						value = std::sqrt(value * 4.0f);
+					}
+				});
+			std::vector<float> values(c_ElementCount, 4.0f);
+			const double parallelMs = TimeMilliseconds([&]()
+				{
+					ParallelFor(1024, values, [](float& value)
+						{
+							value = std::sqrt(value * 4.0f);
+						});
+				});
+			CHECK(values == serialValues);
+
+			std::vector<u32> visited(c_ElementCount, 0);
+			ParallelFor(visited.size(), 4096, [&visited](const u64 index) { ++visited[index]; });
+			CHECK(std::all_of(visited.begin(), visited.end(), [](const u32 value) { return value == 1; }));
+
+			MESSAGE("ParallelFor serial: " << serialMs << "ms | parallel: " << parallelMs << "ms");
+			taskSystem.Shutdown();
+		}
+
+		TEST_CASE("ParallelReduce")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+			taskSystem.Initialise();
+
+			std::vector<u64> values(c_ElementCount);
+			std::iota(values.begin(), values.end(), 0);
+
+			u64 serialSum = 0;
+			const double serialMs = TimeMilliseconds([&]() { serialSum = std::accumulate(values.begin(), values.end(), u64(0)); });
+
+			u64 parallelSum = 0;
+			const double parallelMs = TimeMilliseconds([&]()
+				{
+					parallelSum = ParallelReduce(values.size(), 16384, u64(0),
+						[&values](const u64 begin, const u64 end, u64 sum)
+						{
+							for (u64 i = begin; i < end; ++i)
+							{
+								sum += values[i];
+							}
+							return sum;
+						},
+						[](const u64 a, const u64 b) { return a + b; });
+				});
+			CHECK(parallelSum == serialSum);
+
+			MESSAGE("ParallelReduce serial: " << serialMs << "ms | parallel: " << parallelMs << "ms");
+			taskSystem.Shutdown();
+		}
+
+		TEST_CASE("ParallelSort")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+			taskSystem.Initialise();
+
+			std::mt19937 rng(1234);
+			std::vector<u32> values(c_ElementCount);
+			for (u32& value : values)
+			{
+				value = rng();
+			}
+			std::vector<u32> serialValues = values;
+
+			const double serialMs = TimeMilliseconds([&]() { std::sort(serialValues.begin(), serialValues.end()); });
+			const double parallelMs = TimeMilliseconds([&]() { ParallelSort(values.begin(), values.end()); });
+			CHECK(values == serialValues);
+
+			MESSAGE("ParallelSort serial: " << serialMs << "ms | parallel: " << parallelMs << "ms");
+			taskSystem.Shutdown();
+		}
+
+		TEST_CASE("ParallelExclusiveScan")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+			taskSystem.Initialise();
+
+			std::vector<u32> values(c_ElementCount);
+			for (u64 i = 0; i < values.size(); ++i)
+			{
+				values[i] = static_cast<u32>(i % 3);
+			}
+
+			std::vector<u32> serialResult(values.size());
+			const double serialMs = TimeMilliseconds([&]() { std::exclusive_scan(values.begin(), values.end(), serialResult.begin(), 0u); });
+
+			std::vector<u32> parallelResult(values.size());
+			const double parallelMs = TimeMilliseconds([&]() { ParallelExclusiveScan(values.data(), parallelResult.data(), values.size(), 0u); });
+			CHECK(parallelResult == serialResult);
+
+			MESSAGE("ParallelExclusiveScan serial: " << serialMs << "ms | parallel: " << parallelMs << "ms");
+			taskSystem.Shutdown();
+		}
+	}
+}
+#endif
@@ -0,0 +1,92 @@
+#include "Threading/SPSCQueue.h"
+
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+
+#include <thread>
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Threading;
+
+	TEST_SUITE("SPSCQueue")
+	{
+		TEST_CASE("Single thread FIFO and capacity")
+		{
+			SPSCQueue<u64, 8> queue;
+			for (u64 i = 0; i < 8; ++i)
+			{
+				CHECK(queue.TryPush(i));
+			}
+			CHECK_FALSE(queue.TryPush(8));
+
+			u64 item = 0;
+			for (u64 i = 0; i < 8; ++i)
+			{
+				CHECK(queue.TryPop(item));
+				CHECK(item == i);
+			}
+			CHECK_FALSE(queue.TryPop(item));
+		}
+
+		TEST_CASE("Items arrive in order and throughput")
+		{
+			constexpr u64 c_ItemCount = 10'000'000;
+			SPSCQueue<u64, 1024> queue;
+
+			bool inOrder = true;
+			Core::Timer timer;
+			timer.Start();
+			std::thread consumer([&]()
+				{
+					u64 item = 0;
+					for (u64 expected = 0; expected < c_ItemCount; ++expected)
+					{
+						while (!queue.TryPop(item))
+						{
+							std::this_thread::yield();
+						}
+						inOrder &= item == expected;
+					}
+				});
+			for (u64 i = 0; i < c_ItemCount; ++i)
+			{
+				while (!queue.TryPush(i))
+				{
+					std::this_thread::yield();
+				}
+			}
+			consumer.join();
+			timer.Stop();
+
+			CHECK(inOrder);
+			MESSAGE("SPSCQueue items/s: " << c_ItemCount / (timer.GetElapsedTimeNano().count() / 1'000'000'000.0));
+		}
+
+		TEST_CASE("Blocking push and pop")
+		{
+			constexpr u64 c_ItemCount = 100'000;
+			SPSCQueue<u64, 64, true> queue;
+
+			u64 sum = 0;
+			std::thread consumer([&]()
+				{
+					u64 item = 0;
+					for (u64 i = 0; i < c_ItemCount; ++i)
+					{
+						queue.Pop(item);
+						sum += item;
+					}
+				});
+			for (u64 i = 0; i < c_ItemCount; ++i)
+			{
+				queue.Push(i);
+			}
+			consumer.join();
+			CHECK(sum == (c_ItemCount * (c_ItemCount - 1)) / 2);
+		}
+	}
+}
+#endif
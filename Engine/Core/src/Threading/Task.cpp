@@ -1,4 +1,6 @@
 #include "Threading/Task.h"
+#include "Threading/TaskSystem.h"
+#include "Threading/Futex.h"
 
 namespace Insight
 {
@@ -7,39 +9,148 @@ namespace Insight
 		Task::Task()
 		{ }
 
-		Task::Task(ITaskFuncWrapper* funcWrapper)
-			: m_functionWrapper(std::move(funcWrapper))
-			, m_state(TaskStates::Queued)
+		Task::~Task()
+		{ }
+
+		void Task::Wait()
 		{
+			if (IsComplete())
+			{
+				return;
+			}
+
+			if (TaskSystem::IsValidInstance() && TaskSystem::IsWorkerThread())
+			{
+				// Help drain the queues until our task is done. When there is nothing to help with, spin for a
+				// while and then park until either our task completes or more work is queued.
+				TaskSystem& taskSystem = TaskSystem::Instance();
+				u32 spinCount = 0;
+				while (!IsComplete())
+				{
+					if (taskSystem.RunPendingTask())
+					{
+						spinCount = 0;
+						continue;
+					}
+
+					if (++spinCount < TaskSystem::c_WorkerSpinCount)
+					{
+						std::this_thread::yield();
+						continue;
+					}
+
+					spinCount = 0;
+					m_parkedWorkerCount.fetch_add(1, std::memory_order_seq_cst);
+					taskSystem.ParkWorkerUntilComplete(*this);
+					m_parkedWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+				}
+				return;
+			}
+
+			m_waiterCount.fetch_add(1, std::memory_order_seq_cst);
+			TaskStates state = m_state.load(std::memory_order_seq_cst);
+			while (state != TaskStates::Finished && state != TaskStates::Canceled)
+			{
+				Futex::Wait(m_state, state);
+				state = m_state.load(std::memory_order_seq_cst);
+			}
+			m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
 		}
 
-		Task::~Task()
+		void Task::Call()
 		{
-			Delete(m_functionWrapper);
+			TaskStates expectedState = TaskStates::Queued;
+			if (!m_state.compare_exchange_strong(expectedState, TaskStates::Running, std::memory_order_seq_cst))
+			{
+				// Canceled before it was picked up.
+				return;
+			}
+			Execute();
+
+			std::vector<std::shared_ptr<Task>> successors;
+			{
+				std::lock_guard lock(m_successorsLock);
+				m_state.store(TaskStates::Finished, std::memory_order_seq_cst);
+				successors = std::move(m_successors);
+			}
+			WakeWaiters();
+
+			for (std::shared_ptr<Task>& successor : successors)
+			{
+				if (successor->OnPredecessorComplete())
+				{
+					TaskSystem::ScheduleTask(std::move(successor));
+				}
+			}
 		}
 
-		void Task::Wait()
+		void Task::Cancel()
 		{
-			std::unique_lock lock(m_mutex);
-			if (!IsFinished() || !IsCancled())
+			std::vector<std::shared_ptr<Task>> successors;
 			{
-				m_cv.wait(lock, [this]()
-					{
-							return m_state == TaskStates::Finished
-								|| m_state == TaskStates::Canceled;
-					});
+				std::lock_guard lock(m_successorsLock);
+				TaskStates expectedState = TaskStates::Queued;
+				if (!m_state.compare_exchange_strong(expectedState, TaskStates::Canceled, std::memory_order_seq_cst))
+				{
+					// Already running, finished or canceled.
+					return;
+				}
+				successors = std::move(m_successors);
+			}
+			WakeWaiters();
+
+			// Cancel successors which can no longer run so nothing waits on them forever.
+			for (std::shared_ptr<Task>& successor : successors)
+			{
+				if (successor->OnPredecessorCanceled())
+				{
+					successor->Cancel();
+				}
 			}
 		}
 
-		void Task::Call()
+		void Task::WakeWaiters()
+		{
+			if (m_waiterCount.load(std::memory_order_seq_cst) > 0)
+			{
+				Futex::WakeAll(m_state);
+			}
+			if (m_parkedWorkerCount.load(std::memory_order_seq_cst) > 0 && TaskSystem::IsValidInstance())
+			{
+				TaskSystem::Instance().WakeParkedWorkers();
+			}
+		}
+
+		bool Task::AddSuccessor(const std::shared_ptr<Task>& successor)
+		{
+			std::lock_guard lock(m_successorsLock);
+			if (IsComplete())
+			{
+				return false;
+			}
+			m_successors.push_back(successor);
+			return true;
+		}
+
+		bool Task::OnPredecessorComplete()
+		{
+			if (m_waitForAny)
+			{
+				return !m_anyPredecessorComplete.exchange(true);
+			}
+			return m_predecessorCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		}
+
+		bool Task::OnPredecessorCanceled()
 		{
+			if (m_waitForAny)
 			{
-				std::lock_guard lock(m_mutex);
-				m_state = TaskStates::Running;
-				m_functionWrapper->Call();
-				m_state = TaskStates::Finished;
+				// Another predecessor may still finish, only give up once all of them have been canceled.
+				return m_predecessorCount.fetch_sub(1, std::memory_order_acq_rel) == 1
+					&& !m_anyPredecessorComplete.exchange(true);
 			}
-			m_cv.notify_all();
+			// At least one predecessor will never finish.
+			return true;
 		}
 	}
-}
\ No newline at end of file
+}
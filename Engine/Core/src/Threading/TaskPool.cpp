@@ -0,0 +1,187 @@
+#include "Threading/TaskPool.h"
+#include "Threading/SpinLock.h"
+
+#include "Core/Memory.h"
+
+#include <array>
+#include <mutex>
+
+namespace Insight
+{
+    namespace Threading
+    {
+        namespace
+        {
+            struct FreeBlock
+            {
+                FreeBlock* Next = nullptr;
+            };
+
+            /// @brief Max number of free blocks a thread caches per size class before giving half back.
+            constexpr u32 c_MaxCachedBlocks = 256;
+
+            u64 GetSizeClass(const u64 size)
+            {
+                u64 sizeClass = 0;
+                u64 blockSize = TaskPool::c_MinBlockSize;
+                while (blockSize < size)
+                {
+                    blockSize <<= 1;
+                    ++sizeClass;
+                }
+                return sizeClass;
+            }
+
+            constexpr u64 GetBlockSize(const u64 sizeClass)
+            {
+                return TaskPool::c_MinBlockSize << sizeClass;
+            }
+
+            /// @brief Blocks given back by threads with too many cached blocks.
+            struct SharedFreeList
+            {
+                SpinLock Lock;
+                FreeBlock* Head = nullptr;
+                u32 Count = 0;
+            };
+            std::array<SharedFreeList, TaskPool::c_SizeClassCount> s_sharedFreeLists;
+            std::atomic<u64> s_slabCount = 0;
+
+            struct ThreadCache
+            {
+                ~ThreadCache();
+
+                std::array<FreeBlock*, TaskPool::c_SizeClassCount> Heads = { };
+                std::array<u32, TaskPool::c_SizeClassCount> Counts = { };
+            };
+            thread_local ThreadCache t_threadCache;
+
+            ThreadCache::~ThreadCache()
+            {
+                // Give every cached block back so other threads can reuse them.
+                for (u64 sizeClass = 0; sizeClass < TaskPool::c_SizeClassCount; ++sizeClass)
+                {
+                    FreeBlock* head = Heads[sizeClass];
+                    if (head == nullptr)
+                    {
+                        continue;
+                    }
+
+                    FreeBlock* tail = head;
+                    while (tail->Next != nullptr)
+                    {
+                        tail = tail->Next;
+                    }
+
+                    SharedFreeList& sharedList = s_sharedFreeLists[sizeClass];
+                    std::lock_guard lock(sharedList.Lock);
+                    tail->Next = sharedList.Head;
+                    sharedList.Head = head;
+                    sharedList.Count += Counts[sizeClass];
+                }
+            }
+
+            void RefillThreadCache(ThreadCache& cache, const u64 sizeClass)
+            {
+                SharedFreeList& sharedList = s_sharedFreeLists[sizeClass];
+                {
+                    std::lock_guard lock(sharedList.Lock);
+                    if (sharedList.Head != nullptr)
+                    {
+                        cache.Heads[sizeClass] = sharedList.Head;
+                        cache.Counts[sizeClass] = sharedList.Count;
+                        sharedList.Head = nullptr;
+                        sharedList.Count = 0;
+                        return;
+                    }
+                }
+
+                // Carve a new slab into blocks.
+                const u64 blockSize = GetBlockSize(sizeClass);
+                Byte* slab = static_cast<Byte*>(NewBytes(TaskPool::c_SlabSize, Core::MemoryAllocCategory::Threading));
+                s_slabCount.fetch_add(1, std::memory_order_relaxed);
+
+                const u64 blockCount = TaskPool::c_SlabSize / blockSize;
+                FreeBlock* head = nullptr;
+                for (u64 blockIdx = blockCount; blockIdx > 0; --blockIdx)
+                {
+                    FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + ((blockIdx - 1) * blockSize));
+                    block->Next = head;
+                    head = block;
+                }
+                cache.Heads[sizeClass] = head;
+                cache.Counts[sizeClass] = static_cast<u32>(blockCount);
+            }
+
+            void ReleaseHalfThreadCache(ThreadCache& cache, const u64 sizeClass)
+            {
+                const u32 releaseCount = cache.Counts[sizeClass] / 2;
+                FreeBlock* releaseHead = cache.Heads[sizeClass];
+                FreeBlock* releaseTail = releaseHead;
+                for (u32 i = 1; i < releaseCount; ++i)
+                {
+                    releaseTail = releaseTail->Next;
+                }
+                cache.Heads[sizeClass] = releaseTail->Next;
+                cache.Counts[sizeClass] -= releaseCount;
+
+                SharedFreeList& sharedList = s_sharedFreeLists[sizeClass];
+                std::lock_guard lock(sharedList.Lock);
+                releaseTail->Next = sharedList.Head;
+                sharedList.Head = releaseHead;
+                sharedList.Count += releaseCount;
+            }
+        }
+
+        void* TaskPool::Allocate(const u64 size)
+        {
+            if (size > c_MaxBlockSize)
+            {
+                return NewBytes(size, Core::MemoryAllocCategory::Threading);
+            }
+
+            const u64 sizeClass = GetSizeClass(size);
+            ThreadCache& cache = t_threadCache;
+            if (cache.Heads[sizeClass] == nullptr)
+            {
+                RefillThreadCache(cache, sizeClass);
+            }
+
+            FreeBlock* block = cache.Heads[sizeClass];
+            cache.Heads[sizeClass] = block->Next;
+            --cache.Counts[sizeClass];
+            return block;
+        }
+
+        void TaskPool::Free(void* ptr, const u64 size)
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+
+            if (size > c_MaxBlockSize)
+            {
+                DeleteBytes(ptr);
+                return;
+            }
+
+            const u64 sizeClass = GetSizeClass(size);
+            ThreadCache& cache = t_threadCache;
+            FreeBlock* block = static_cast<FreeBlock*>(ptr);
+            block->Next = cache.Heads[sizeClass];
+            cache.Heads[sizeClass] = block;
+            ++cache.Counts[sizeClass];
+
+            if (cache.Counts[sizeClass] > c_MaxCachedBlocks)
+            {
+                ReleaseHalfThreadCache(cache, sizeClass);
+            }
+        }
+
+        u64 TaskPool::GetSlabCount()
+        {
+            return s_slabCount.load(std::memory_order_relaxed);
+        }
+    }
+}
@@ -1,21 +1,44 @@
 #include "Threading/TaskSystem.h"
 #include "Core/Profiler.h"
 
+#include <chrono>
+
 namespace Insight
 {
 	namespace Threading
 	{
+		constexpr u32 c_InvalidWorkerIndex = std::numeric_limits<u32>::max();
+		constexpr u32 c_BackgroundPriorityIndex = static_cast<u32>(TaskPriority::Background);
+		/// @brief Index of the worker the current thread is. Invalid if the current thread is not a worker.
+		thread_local u32 t_workerIndex = c_InvalidWorkerIndex;
+		thread_local bool t_isIOThread = false;
+
+		u64 GetTaskTimeNs()
+		{
+			return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
 
 		void TaskSystem::Initialise()
+		{
+			const u32 threadCount = std::thread::hardware_concurrency();
+			Initialise(threadCount > 1 ? threadCount - 1 : 1);
+		}
+
+		void TaskSystem::Initialise(const u32 workerThreadCount)
 		{
 			IS_PROFILE_FUNCTION();
 			Shutdown();
 			m_destroy = false;
+			ResetPriorityStats();
 
-			u32 threadCount = std::thread::hardware_concurrency();
-			std::lock_guard lock(m_mutex);
-			m_threads.resize(threadCount - 1);
+			m_workers.resize(workerThreadCount);
+			for (size_t workerIdx = 0; workerIdx < m_workers.size(); ++workerIdx)
+			{
+				m_workers[workerIdx] = New<Worker, Core::MemoryAllocCategory::Threading>();
+			}
 
+			m_threads.resize(workerThreadCount);
 			for (size_t threadIdx = 0; threadIdx < m_threads.size(); ++threadIdx)
 			{
 				Thread& thread = m_threads[threadIdx];
@@ -23,6 +46,16 @@ namespace Insight
 				thread.Spwan(ThreadWorker, ThreadData(this, &thread));
 				thread.SetName("InsightWorkerThread");
 			}
+
+			// No workers means everything runs inline, IO included.
+			m_ioThreads.resize(workerThreadCount > 0 ? c_IOThreadCount : 0);
+			for (size_t threadIdx = 0; threadIdx < m_ioThreads.size(); ++threadIdx)
+			{
+				Thread& thread = m_ioThreads[threadIdx];
+				thread.SetThreadIndex(static_cast<u8>(threadIdx));
+				thread.Spwan(IOThreadWorker, ThreadData(this, &thread));
+				thread.SetName("InsightIOThread");
+			}
 			m_state = Core::SystemStates::Initialised;
 		}
 
@@ -30,50 +63,908 @@ namespace Insight
 		{
 			IS_PROFILE_FUNCTION();
 
-			m_destroy = true;
+			{
+				std::lock_guard lock(m_parkMutex);
+				m_destroy = true;
+			}
+			m_parkCV.notify_all();
+			for (size_t i = 0; i < m_ioThreads.size(); ++i)
+			{
+				m_ioQueue.Push(nullptr);
+			}
+
 			for (size_t i = 0; i < m_threads.size(); ++i)
 			{
 				m_threads.at(i).Join();
 			}
-
-			std::lock_guard lock(m_mutex);
-			m_queuedTasks = {};
 			m_threads.clear();
+			for (size_t i = 0; i < m_ioThreads.size(); ++i)
+			{
+				m_ioThreads.at(i).Join();
+			}
+			m_ioThreads.clear();
+
+			// Cancel any tasks which never got picked up.
+			Task* task = nullptr;
+			for (size_t workerIdx = 0; workerIdx < m_workers.size(); ++workerIdx)
+			{
+				for (u32 priorityIdx = 0; priorityIdx < c_WorkerPriorityCount; ++priorityIdx)
+				{
+					while (m_workers[workerIdx]->Queues[priorityIdx].Steal(task))
+					{
+						CancelQueuedTask(task);
+					}
+				}
+				Delete(m_workers[workerIdx]);
+			}
+			m_workers.clear();
+
+			for (MPMCQueue<Task*, c_GlobalQueueCapacity>& globalQueue : m_globalQueues)
+			{
+				while (globalQueue.TryPop(task))
+				{
+					CancelQueuedTask(task);
+				}
+			}
+
+			while (m_ioQueue.TryPop(task))
+			{
+				if (task)
+				{
+					CancelQueuedTask(task);
+				}
+			}
+
+			for (PriorityCounters& counters : m_priorityCounters)
+			{
+				counters.QueueDepth = 0;
+			}
+			m_queuedTaskCount = 0;
+			m_runningBackgroundTaskCount = 0;
+
 			m_state = Core::SystemStates::Not_Initialised;
 		}
 
-		bool TaskSystem::GetTask(std::shared_ptr<Task>& task)
+		TaskPriorityStats TaskSystem::GetPriorityStats(const TaskPriority priority) const
 		{
-			std::lock_guard lock(m_mutex);
-			if (m_queuedTasks.size() > 0)
+			const PriorityCounters& counters = m_priorityCounters[static_cast<u32>(priority)];
+
+			TaskPriorityStats stats;
+			stats.QueueDepth = static_cast<u64>(std::max<i64>(0, counters.QueueDepth.load(std::memory_order_relaxed)));
+			stats.ExecutedCount = counters.ExecutedCount.load(std::memory_order_relaxed);
+			stats.AverageDispatchLatencyNs = stats.ExecutedCount > 0 ? counters.TotalDispatchLatencyNs.load(std::memory_order_relaxed) / stats.ExecutedCount : 0;
+			stats.MaxDispatchLatencyNs = counters.MaxDispatchLatencyNs.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+		void TaskSystem::ResetPriorityStats()
+		{
+			for (PriorityCounters& counters : m_priorityCounters)
 			{
-				task = m_queuedTasks.front();
-				m_queuedTasks.pop();
-				m_runningTasks.insert(task.get());
+				counters.ExecutedCount = 0;
+				counters.TotalDispatchLatencyNs = 0;
+				counters.MaxDispatchLatencyNs = 0;
+			}
+		}
+
+		bool TaskSystem::RunPendingTask()
+		{
+			Task* task = nullptr;
+			if (GetTask(task, t_workerIndex))
+			{
+				ExecuteTask(task);
 				return true;
 			}
+			return false;
+		}
+
+		std::shared_ptr<Task> TaskSystem::WhenAll(const std::vector<std::shared_ptr<Task>>& tasks)
+		{
+			return CreateDependentTask(tasks, []() { });
+		}
+
+		std::shared_ptr<Task> TaskSystem::WhenAny(const std::vector<std::shared_ptr<Task>>& tasks)
+		{
+			std::shared_ptr<Task> task = MakeTask(TaskPriority::Normal, []() { });
+			task->m_waitForAny = true;
+			if (tasks.empty())
+			{
+				ScheduleTask(task);
+				return task;
+			}
+
+			// Hold an extra count while registering so the task can't be canceled until every predecessor has been added.
+			task->m_predecessorCount.store(1, std::memory_order_relaxed);
+			for (const std::shared_ptr<Task>& predecessor : tasks)
+			{
+				task->m_predecessorCount.fetch_add(1, std::memory_order_relaxed);
+				if (predecessor->AddSuccessor(task))
+				{
+					continue;
+				}
+
+				// Predecessor has already completed.
+				if (predecessor->IsCancled())
+				{
+					if (task->OnPredecessorCanceled())
+					{
+						task->Cancel();
+					}
+				}
+				else if (task->OnPredecessorComplete())
+				{
+					ScheduleTask(task);
+				}
+			}
+
+			if (task->OnPredecessorCanceled())
+			{
+				task->Cancel();
+			}
+			return task;
+		}
+
+		void TaskSystem::SignalTask(const std::shared_ptr<Task>& task)
+		{
+			if (task->OnPredecessorComplete())
+			{
+				ScheduleTask(task);
+			}
+		}
+
+		bool TaskSystem::IsWorkerThread()
+		{
+			return t_workerIndex != c_InvalidWorkerIndex;
+		}
+
+		void TaskSystem::ScheduleTask(std::shared_ptr<Task> task)
+		{
+			if (task->IsCancled())
+			{
+				return;
+			}
+
+			TaskSystem& taskSystem = TaskSystem::Instance();
+			const bool hasThreads = task->m_priority == TaskPriority::IO
+				? taskSystem.m_ioThreads.size() > 0
+				: taskSystem.m_threads.size() > 0;
+			if (hasThreads)
+			{
+				taskSystem.QueueTask(std::move(task));
+			}
 			else
+			{
+				task->Call();
+			}
+		}
+
+		void TaskSystem::AddPredecessors(const std::shared_ptr<Task>& task, const std::vector<std::shared_ptr<Task>>& predecessors)
+		{
+			// Hold an extra count while registering so the task can't be queued until every predecessor has been added.
+			task->m_predecessorCount.store(1, std::memory_order_relaxed);
+			for (const std::shared_ptr<Task>& predecessor : predecessors)
+			{
+				task->m_predecessorCount.fetch_add(1, std::memory_order_relaxed);
+				if (!predecessor->AddSuccessor(task))
+				{
+					// Predecessor has already completed.
+					if (predecessor->IsCancled())
+					{
+						// Keep its count so the task is never queued.
+						task->Cancel();
+						continue;
+					}
+					task->m_predecessorCount.fetch_sub(1, std::memory_order_relaxed);
+				}
+			}
+
+			if (task->OnPredecessorComplete())
+			{
+				ScheduleTask(task);
+			}
+		}
+
+		void TaskSystem::QueueTask(std::shared_ptr<Task> task)
+		{
+			Task* rawTask = task.get();
+			rawTask->m_queuedReference = std::move(task);
+			rawTask->m_queuedTimeNs = GetTaskTimeNs();
+
+			const u32 priorityIndex = static_cast<u32>(rawTask->m_priority);
+			m_priorityCounters[priorityIndex].QueueDepth.fetch_add(1, std::memory_order_relaxed);
+
+			if (rawTask->m_priority == TaskPriority::IO)
+			{
+				if (!m_ioQueue.TryPush(rawTask))
+				{
+					if (t_isIOThread)
+					{
+						// Blocking here could leave every IO thread waiting on itself.
+						ExecuteTask(rawTask);
+						return;
+					}
+					m_ioQueue.Push(rawTask);
+				}
+				return;
+			}
+
+			// Worker threads push onto their own queue, everything else (or overflow) goes to the global queue.
+			const u32 workerIndex = t_workerIndex;
+			if (workerIndex >= m_workers.size() || !m_workers[workerIndex]->Queues[priorityIndex].Push(rawTask))
+			{
+				while (!m_globalQueues[priorityIndex].TryPush(rawTask))
+				{
+					// Global queue is full, help drain it instead of waiting.
+					if (!RunPendingTask())
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+
+			m_queuedTaskCount.fetch_add(1, std::memory_order_seq_cst);
+			WakeWorker();
+		}
+
+		bool TaskSystem::GetTask(Task*& task, const u32 workerIndex)
+		{
+			for (u32 priorityIdx = 0; priorityIdx < c_WorkerPriorityCount; ++priorityIdx)
+			{
+				if (priorityIdx == c_BackgroundPriorityIndex)
+				{
+					// Reserve a background slot before looking so we never go over the limit.
+					if (m_runningBackgroundTaskCount.fetch_add(1, std::memory_order_acq_rel) >= GetMaxRunningBackgroundTasks())
+					{
+						m_runningBackgroundTaskCount.fetch_sub(1, std::memory_order_relaxed);
+						continue;
+					}
+					if (!GetTaskWithPriority(task, workerIndex, priorityIdx))
+					{
+						m_runningBackgroundTaskCount.fetch_sub(1, std::memory_order_relaxed);
+						continue;
+					}
+					return true;
+				}
+
+				if (GetTaskWithPriority(task, workerIndex, priorityIdx))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool TaskSystem::GetTaskWithPriority(Task*& task, const u32 workerIndex, const u32 priorityIndex)
+		{
+			bool foundTask = workerIndex < m_workers.size()
+				&& m_workers[workerIndex]->Queues[priorityIndex].Pop(task);
+
+			if (!foundTask)
+			{
+				foundTask = m_globalQueues[priorityIndex].TryPop(task);
+			}
+
+			if (!foundTask)
+			{
+				foundTask = StealTask(task, workerIndex, priorityIndex);
+			}
+
+			if (foundTask)
+			{
+				m_queuedTaskCount.fetch_sub(1, std::memory_order_relaxed);
+			}
+			return foundTask;
+		}
+
+		bool TaskSystem::StealTask(Task*& task, const u32 workerIndex, const u32 priorityIndex)
+		{
+			const u32 workerCount = static_cast<u32>(m_workers.size());
+			if (workerCount == 0)
 			{
 				return false;
 			}
+
+			// Start stealing from the worker after ourself so all thieves don't hammer worker 0.
+			const u32 startIndex = workerIndex < workerCount ? workerIndex + 1 : 0;
+			for (u32 i = 0; i < workerCount; ++i)
+			{
+				const u32 victimIndex = (startIndex + i) % workerCount;
+				if (victimIndex == workerIndex)
+				{
+					continue;
+				}
+				if (m_workers[victimIndex]->Queues[priorityIndex].Steal(task))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void TaskSystem::ExecuteTask(Task* task)
+		{
+			// Take ownership of the queued reference so the task stays valid even if every other
+			// reference is released as soon as the task finishes.
+			std::shared_ptr<Task> queuedReference = std::move(task->m_queuedReference);
+
+			const TaskPriority priority = task->m_priority;
+			PriorityCounters& counters = m_priorityCounters[static_cast<u32>(priority)];
+			const u64 latencyNs = GetTaskTimeNs() - task->m_queuedTimeNs;
+			counters.QueueDepth.fetch_sub(1, std::memory_order_relaxed);
+			counters.ExecutedCount.fetch_add(1, std::memory_order_relaxed);
+			counters.TotalDispatchLatencyNs.fetch_add(latencyNs, std::memory_order_relaxed);
+			u64 maxLatencyNs = counters.MaxDispatchLatencyNs.load(std::memory_order_relaxed);
+			while (latencyNs > maxLatencyNs
+				&& !counters.MaxDispatchLatencyNs.compare_exchange_weak(maxLatencyNs, latencyNs, std::memory_order_relaxed))
+			{ }
+
+			queuedReference->Call();
+
+			if (priority == TaskPriority::Background)
+			{
+				m_runningBackgroundTaskCount.fetch_sub(1, std::memory_order_acq_rel);
+			}
+		}
+
+		void TaskSystem::CancelQueuedTask(Task* task)
+		{
+			std::shared_ptr<Task> queuedReference = std::move(task->m_queuedReference);
+			queuedReference->Cancel();
+		}
+
+		u32 TaskSystem::GetMaxRunningBackgroundTasks() const
+		{
+			const u32 workerCount = static_cast<u32>(m_workers.size());
+			return workerCount > 1 ? workerCount - 1 : 1;
+		}
+
+		bool TaskSystem::HasRunnableTask() const
+		{
+			const i64 queuedCount = m_queuedTaskCount.load(std::memory_order_seq_cst);
+			if (queuedCount <= 0)
+			{
+				return false;
+			}
+			// Don't wake for background tasks which can't run because the background limit has been reached.
+			const i64 backgroundQueued = m_priorityCounters[c_BackgroundPriorityIndex].QueueDepth.load(std::memory_order_relaxed);
+			return queuedCount > backgroundQueued
+				|| m_runningBackgroundTaskCount.load(std::memory_order_relaxed) < GetMaxRunningBackgroundTasks();
+		}
+
+		void TaskSystem::WakeWorker()
+		{
+			if (m_parkedThreadCount.load(std::memory_order_seq_cst) > 0)
+			{
+				// Lock to make sure a worker which is about to park either sees the new task or is already waiting.
+				std::lock_guard lock(m_parkMutex);
+				m_parkCV.notify_one();
+			}
+		}
+
+		void TaskSystem::ParkWorker()
+		{
+			IS_PROFILE_SCOPE("Park");
+			std::unique_lock lock(m_parkMutex);
+			m_parkedThreadCount.fetch_add(1, std::memory_order_seq_cst);
+			m_parkCV.wait(lock, [this]()
+				{
+					return m_destroy.load() || HasRunnableTask();
+				});
+			m_parkedThreadCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void TaskSystem::ParkWorkerUntilComplete(const Task& task)
+		{
+			IS_PROFILE_SCOPE("Park until complete");
+			std::unique_lock lock(m_parkMutex);
+			m_parkedThreadCount.fetch_add(1, std::memory_order_seq_cst);
+			m_parkCV.wait(lock, [this, &task]()
+				{
+					return m_destroy.load() || task.IsComplete() || HasRunnableTask();
+				});
+			m_parkedThreadCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void TaskSystem::WakeParkedWorkers()
+		{
+			// Lock to make sure a worker which is about to park either sees the task complete or is already waiting.
+			std::lock_guard lock(m_parkMutex);
+			m_parkCV.notify_all();
 		}
 
 		void TaskSystem::ThreadWorker(ThreadData threadData)
 		{
-			while (!threadData.TaskSystem->m_destroy.load())
+			TaskSystem* taskSystem = threadData.TaskSystem;
+			t_workerIndex = threadData.Thread->m_tls.ThreadIndex;
+
+			u32 spinCount = 0;
+			while (!taskSystem->m_destroy.load())
+			{
+				Task* task = nullptr;
+				if (taskSystem->GetTask(task, t_workerIndex))
+				{
+					taskSystem->ExecuteTask(task);
+					spinCount = 0;
+					continue;
+				}
+
+				if (++spinCount < c_WorkerSpinCount)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				spinCount = 0;
+				taskSystem->ParkWorker();
+			}
+			t_workerIndex = c_InvalidWorkerIndex;
+		}
+
+		void TaskSystem::IOThreadWorker(ThreadData threadData)
+		{
+			TaskSystem* taskSystem = threadData.TaskSystem;
+			t_isIOThread = true;
+			while (true)
 			{
-				std::shared_ptr<Task> task;
-				if (threadData.TaskSystem->GetTask(task))
+				Task* task = nullptr;
+				taskSystem->m_ioQueue.Pop(task);
+				if (task == nullptr)
 				{
-					task->Call();
+					break;
+				}
+				if (taskSystem->m_destroy.load())
+				{
+					CancelQueuedTask(task);
+					continue;
+				}
+				taskSystem->ExecuteTask(task);
+			}
+			t_isIOThread = false;
+		}
+	}
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+
+#include <ctime>
+#include <functional>
+#include <queue>
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Threading;
+
+	/// @brief Process CPU time (user + kernel) in nanoseconds.
+	static u64 GetProcessCPUTimeNano()
+	{
+#ifdef _WIN32
+		FILETIME creationTime, exitTime, kernelTime, userTime;
+		GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+		const u64 kernel = (static_cast<u64>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+		const u64 user = (static_cast<u64>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+		return (kernel + user) * 100;
+#else
+		return static_cast<u64>(std::clock()) * (1'000'000'000ull / CLOCKS_PER_SEC);
+#endif
+	}
+
+	/// @brief Percentage of one core the process uses while the calling thread sleeps.
+	static double MeasureIdleCorePercent()
+	{
+		constexpr u32 c_IdleTimeMs = 250;
+		std::this_thread::sleep_for(std::chrono::milliseconds(c_IdleTimeMs));
+		const u64 cpuTimeStart = GetProcessCPUTimeNano();
+		std::this_thread::sleep_for(std::chrono::milliseconds(c_IdleTimeMs));
+		const u64 cpuTimeEnd = GetProcessCPUTimeNano();
+		return (static_cast<double>(cpuTimeEnd - cpuTimeStart) / (c_IdleTimeMs * 1'000'000.0)) * 100.0;
+	}
+
+	/// @brief One std::mutex guarded std::queue shared by workers which spin on it, the scheduler the work stealing
+	/// workers replace. Used as the benchmark baseline.
+	class MutexQueueTaskPool
+	{
+	public:
+		explicit MutexQueueTaskPool(const u32 threadCount)
+		{
+			for (u32 threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+			{
+				m_threads.emplace_back([this]()
 					{
-						std::lock_guard lock(threadData.TaskSystem->m_mutex);
-						threadData.TaskSystem->m_runningTasks.erase(task.get());
+						while (!m_destroy.load())
+						{
+							RunPendingTask();
+						}
+					});
+			}
+		}
+		~MutexQueueTaskPool()
+		{
+			m_destroy = true;
+			for (std::thread& thread : m_threads)
+			{
+				thread.join();
+			}
+		}
+
+		void Push(std::function<void()> func)
+		{
+			std::lock_guard lock(m_mutex);
+			m_queuedTasks.push(std::move(func));
+		}
+
+		bool RunPendingTask()
+		{
+			std::function<void()> func;
+			{
+				std::lock_guard lock(m_mutex);
+				if (m_queuedTasks.empty())
+				{
+					return false;
+				}
+				func = std::move(m_queuedTasks.front());
+				m_queuedTasks.pop();
+			}
+			func();
+			return true;
+		}
+
+	private:
+		std::vector<std::thread> m_threads;
+		std::mutex m_mutex;
+		std::queue<std::function<void()>> m_queuedTasks;
+		std::atomic<bool> m_destroy = false;
+	};
+
+	TEST_SUITE("TaskSystem")
+	{
+		TEST_CASE("Throughput and idle CPU usage")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+
+			constexpr u32 c_TaskCount = 100'000;
+			constexpr u32 c_ChildTaskCount = 16;
+			const u32 threadCounts[] = { 1, 4, 16, std::thread::hardware_concurrency() };
+
+			for (const u32 threadCount : threadCounts)
+			{
+				taskSystem.Initialise(threadCount);
+
+				// Flat submission from a non worker thread.
+				std::atomic<u32> counter = 0;
+				Core::Timer timer;
+				timer.Start();
+				std::vector<std::shared_ptr<Task>> tasks;
+				tasks.reserve(c_TaskCount);
+				for (u32 i = 0; i < c_TaskCount; ++i)
+				{
+					tasks.push_back(TaskSystem::CreateTask([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); }));
+				}
+				for (std::shared_ptr<Task>& task : tasks)
+				{
+					task->Wait();
+				}
+				timer.Stop();
+				CHECK(counter.load() == c_TaskCount);
+				const double flatTasksPerSecond = c_TaskCount / (timer.GetElapsedTimeNano().count() / 1'000'000'000.0);
+				tasks.clear();
+
+				// Nested submission, children are pushed onto the worker's local queue and stolen.
+				counter = 0;
+				timer.Start();
+				for (u32 i = 0; i < c_TaskCount / c_ChildTaskCount; ++i)
+				{
+					tasks.push_back(TaskSystem::CreateTask([&counter]()
+						{
+							for (u32 childIdx = 0; childIdx < c_ChildTaskCount; ++childIdx)
+							{
+								TaskSystem::CreateTask([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+							}
+						}));
+				}
+				for (std::shared_ptr<Task>& task : tasks)
+				{
+					task->Wait();
+				}
+				while (counter.load() < (c_TaskCount / c_ChildTaskCount) * c_ChildTaskCount)
+				{
+					taskSystem.RunPendingTask();
+				}
+				timer.Stop();
+				const double nestedTasksPerSecond = c_TaskCount / (timer.GetElapsedTimeNano().count() / 1'000'000'000.0);
+				tasks.clear();
+
+				// Idle, all workers should park.
+				const double idleCorePercent = MeasureIdleCorePercent();
+				CHECK(idleCorePercent < 50.0);
+
+				// The same workloads on the baseline, with the same number of workers. Its tasks report nothing
+				// back, so the caller helps run tasks until the counter shows they are all done.
+				double mutexFlatTasksPerSecond = 0.0;
+				double mutexNestedTasksPerSecond = 0.0;
+				double mutexIdleCorePercent = 0.0;
+				{
+					MutexQueueTaskPool mutexPool(threadCount);
+
+					counter = 0;
+					timer.Start();
+					for (u32 i = 0; i < c_TaskCount; ++i)
+					{
+						mutexPool.Push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+					}
+					while (counter.load() < c_TaskCount)
+					{
+						mutexPool.RunPendingTask();
 					}
-					task.reset();
+					timer.Stop();
+					mutexFlatTasksPerSecond = c_TaskCount / (timer.GetElapsedTimeNano().count() / 1'000'000'000.0);
+
+					counter = 0;
+					timer.Start();
+					for (u32 i = 0; i < c_TaskCount / c_ChildTaskCount; ++i)
+					{
+						mutexPool.Push([&counter, &mutexPool]()
+							{
+								for (u32 childIdx = 0; childIdx < c_ChildTaskCount; ++childIdx)
+								{
+									mutexPool.Push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+								}
+							});
+					}
+					while (counter.load() < (c_TaskCount / c_ChildTaskCount) * c_ChildTaskCount)
+					{
+						mutexPool.RunPendingTask();
+					}
+					timer.Stop();
+					mutexNestedTasksPerSecond = c_TaskCount / (timer.GetElapsedTimeNano().count() / 1'000'000'000.0);
+
+					mutexIdleCorePercent = MeasureIdleCorePercent();
 				}
-				//threadData.Thread->SleepFor(16);
+
+				MESSAGE("Threads: " << threadCount
+					<< " | Flat tasks/s: " << flatTasksPerSecond << " (std::mutex queue: " << mutexFlatTasksPerSecond << ")"
+					<< " | Nested tasks/s: " << nestedTasksPerSecond << " (std::mutex queue: " << mutexNestedTasksPerSecond << ")"
+					<< " | Idle CPU (% of one core): " << idleCorePercent << " (std::mutex queue: " << mutexIdleCorePercent << ")");
 			}
+
+			taskSystem.Shutdown();
+		}
+
+		TEST_CASE("Continuations and dependencies")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+			taskSystem.Initialise(4);
+
+			std::atomic<u32> order = 0;
+			u32 first = 0, second = 0, third = 0;
+			std::shared_ptr<Task> firstTask = TaskSystem::CreateTask([&]() { first = order++; });
+			std::shared_ptr<Task> thirdTask = firstTask->Then([&]() { second = order++; })->Then([&]() { third = order++; });
+			thirdTask->Wait();
+			CHECK(first == 0);
+			CHECK(second == 1);
+			CHECK(third == 2);
+
+			std::atomic<u32> counter = 0;
+			std::vector<std::shared_ptr<Task>> tasks;
+			for (u32 i = 0; i < 256; ++i)
+			{
+				tasks.push_back(TaskSystem::CreateTask([&counter]() { ++counter; }));
+			}
+			TaskSystem::WhenAll(tasks)->Wait();
+			CHECK(counter.load() == 256);
+
+			std::shared_ptr<Task> anyTask = TaskSystem::WhenAny({ TaskSystem::CreateTask([]() { }), TaskSystem::CreateTask([]() { }) });
+			anyTask->Wait();
+			CHECK(anyTask->IsFinished());
+
+			auto countedTask = TaskSystem::CreateTaskWithPredecessorCount(2, []() { return 42; });
+			TaskSystem::SignalTask(countedTask);
+			CHECK(!countedTask->IsComplete());
+			TaskSystem::SignalTask(countedTask);
+			countedTask->Wait();
+			CHECK(countedTask->GetResult().GetResult() == 42);
+
+			taskSystem.Shutdown();
+		}
+
+		TEST_CASE("Workers waiting on a task park")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+			taskSystem.Initialise(2);
+
+			// The worker waiting on the IO task has nothing to help with, so it should park rather than spin.
+			static constexpr u32 c_WaitTimeMs = 250;
+			std::shared_ptr<Task> ioTask = TaskSystem::CreateIOTask([]()
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(c_WaitTimeMs));
+				});
+			std::shared_ptr<Task> waitingTask = TaskSystem::CreateTask([ioTask]() { ioTask->Wait(); });
+
+			const u64 cpuTimeStart = GetProcessCPUTimeNano();
+			waitingTask->Wait();
+			const u64 cpuTimeEnd = GetProcessCPUTimeNano();
+			const double waitCorePercent = (static_cast<double>(cpuTimeEnd - cpuTimeStart) / (c_WaitTimeMs * 1'000'000.0)) * 100.0;
+			CHECK(ioTask->IsFinished());
+			CHECK(waitingTask->IsFinished());
+			CHECK(waitCorePercent < 50.0);
+			MESSAGE("Waiting worker CPU (% of one core): " << waitCorePercent);
+
+			taskSystem.Shutdown();
+		}
+
+		TEST_CASE("Cancellation")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+			taskSystem.Initialise(1);
+
+			// WhenAny still runs if one predecessor is canceled and another finishes.
+			auto canceledTask = TaskSystem::CreateTaskWithPredecessorCount(1, []() { });
+			auto signalledTask = TaskSystem::CreateTaskWithPredecessorCount(1, []() { });
+			std::shared_ptr<Task> anyTask = TaskSystem::WhenAny({ canceledTask, signalledTask });
+			canceledTask->Cancel();
+			CHECK(canceledTask->IsCancled());
+			CHECK(!anyTask->IsComplete());
+			TaskSystem::SignalTask(signalledTask);
+			anyTask->Wait();
+			CHECK(anyTask->IsFinished());
+
+			// WhenAny is only canceled once every predecessor has been canceled.
+			auto firstCanceledTask = TaskSystem::CreateTaskWithPredecessorCount(1, []() { });
+			auto secondCanceledTask = TaskSystem::CreateTaskWithPredecessorCount(1, []() { });
+			std::shared_ptr<Task> canceledAnyTask = TaskSystem::WhenAny({ firstCanceledTask, secondCanceledTask });
+			firstCanceledTask->Cancel();
+			CHECK(!canceledAnyTask->IsComplete());
+			secondCanceledTask->Cancel();
+			CHECK(canceledAnyTask->IsCancled());
+			CHECK(TaskSystem::WhenAny({ firstCanceledTask })->IsCancled());
+
+			// WhenAll can never run once a predecessor is canceled.
+			auto allCanceledTask = TaskSystem::CreateTaskWithPredecessorCount(1, []() { });
+			auto allSignalledTask = TaskSystem::CreateTaskWithPredecessorCount(1, []() { });
+			std::shared_ptr<Task> allTask = TaskSystem::WhenAll({ allCanceledTask, allSignalledTask });
+			allCanceledTask->Cancel();
+			CHECK(allTask->IsCancled());
+			TaskSystem::SignalTask(allSignalledTask);
+			allSignalledTask->Wait();
+			CHECK(allTask->IsCancled());
+
+			// A canceled task is never run, even once its predecessors are done or it has already been queued.
+			std::atomic<u32> runCount = 0;
+			auto signalledCanceledTask = TaskSystem::CreateTaskWithPredecessorCount(1, [&runCount]() { ++runCount; });
+			signalledCanceledTask->Cancel();
+			TaskSystem::SignalTask(signalledCanceledTask);
+			CHECK(signalledCanceledTask->IsCancled());
+
+			std::atomic<bool> releaseWorker = false;
+			std::shared_ptr<Task> blockingTask = TaskSystem::CreateTask([&releaseWorker]()
+				{
+					while (!releaseWorker.load())
+					{
+						std::this_thread::yield();
+					}
+				});
+			std::shared_ptr<Task> queuedCanceledTask = TaskSystem::CreateTask([&runCount]() { ++runCount; });
+			queuedCanceledTask->Cancel();
+			std::shared_ptr<Task> afterTask = TaskSystem::CreateTask([]() { });
+			releaseWorker = true;
+			blockingTask->Wait();
+			afterTask->Wait();
+			CHECK(queuedCanceledTask->IsCancled());
+			CHECK(runCount.load() == 0);
+
+			taskSystem.Shutdown();
+		}
+
+		TEST_CASE("Priorities under background load")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+			taskSystem.Initialise(std::max(2u, std::thread::hardware_concurrency() - 1));
+
+			// Saturate the machine with long running background work.
+			std::atomic<bool> stopBackground = false;
+			std::vector<std::shared_ptr<Task>> backgroundTasks;
+			for (u32 i = 0; i < taskSystem.GetThreadCount() * 4; ++i)
+			{
+				backgroundTasks.push_back(TaskSystem::CreateTaskWithPriority(TaskPriority::Background, [&stopBackground]()
+					{
+						while (!stopBackground.load())
+						{
+							std::this_thread::sleep_for(std::chrono::milliseconds(1));
+						}
+					}));
+			}
+
+			// Blocking IO must not take a compute worker.
+			std::shared_ptr<Task> ioTask = TaskSystem::CreateIOTask([]()
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				});
+
+			taskSystem.ResetPriorityStats();
+			for (u32 i = 0; i < 1000; ++i)
+			{
+				TaskSystem::CreateTaskWithPriority(TaskPriority::FrameCritical, []() { })->Wait();
+			}
+			ioTask->Wait();
+
+			const TaskPriorityStats frameCriticalStats = taskSystem.GetPriorityStats(TaskPriority::FrameCritical);
+			const TaskPriorityStats backgroundStats = taskSystem.GetPriorityStats(TaskPriority::Background);
+			CHECK(frameCriticalStats.ExecutedCount == 1000);
+			CHECK(backgroundStats.QueueDepth > 0);
+
+			MESSAGE("FrameCritical avg dispatch latency: " << frameCriticalStats.AverageDispatchLatencyNs << "ns"
+				<< " | max: " << frameCriticalStats.MaxDispatchLatencyNs << "ns"
+				<< " | Background queue depth: " << backgroundStats.QueueDepth);
+
+			stopBackground = true;
+			TaskSystem::WhenAll(backgroundTasks)->Wait();
+			taskSystem.Shutdown();
+		}
+
+		TEST_CASE("Task create/execute/destroy cost")
+		{
+			if (TaskSystem::IsValidInstance())
+			{
+				return;
+			}
+			TaskSystem taskSystem;
+
+			constexpr u32 c_TaskCount = 1'000'000;
+			const auto runTasks = [&]()
+			{
+				Core::Timer timer;
+				timer.Start();
+				u64 sum = 0;
+				for (u32 i = 0; i < c_TaskCount; ++i)
+				{
+					auto task = TaskSystem::CreateTask([i]() { return static_cast<u64>(i); });
+					task->Wait();
+					sum += task->GetResult().GetResult();
+				}
+				timer.Stop();
+				CHECK(sum == (static_cast<u64>(c_TaskCount) * (c_TaskCount - 1)) / 2);
+				return static_cast<double>(timer.GetElapsedTimeNano().count()) / c_TaskCount;
+			};
+
+			// No workers, tasks run inline so this is purely the create/destroy overhead.
+			taskSystem.Initialise(0);
+			runTasks();
+			const u64 slabCount = TaskPool::GetSlabCount();
+			const double inlineNsPerTask = runTasks();
+			// Once warm, task memory should be fully recycled from the pool.
+			CHECK(TaskPool::GetSlabCount() == slabCount);
+
+			taskSystem.Initialise(4);
+			const double workerNsPerTask = runTasks();
+
+			MESSAGE("Inline ns/task: " << inlineNsPerTask << " | Round trip via workers ns/task: " << workerNsPerTask);
+			taskSystem.Shutdown();
 		}
 	}
-}
\ No newline at end of file
+}
+#endif
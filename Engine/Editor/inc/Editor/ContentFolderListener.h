@@ -1,8 +1,8 @@
 #pragma once
 
-#include <vector>
+#include "Threading/SPSCQueue.h"
+
 #include <functional>
-#include <mutex>
 
 #include <efsw/efsw.hpp>
 
@@ -29,8 +29,9 @@ namespace Insight
 
         private:
             Runtime::IAssetPackage* m_assetPackage;
-            std::vector<std::function<void()>> m_queuedActions;
-            std::mutex m_queuedActionsMuetx;
+            /// @brief Filled by the efsw watcher thread and drained on the main thread in Update.
+            /// The watcher thread waits if this is full rather than dropping file events.
+            Threading::SPSCQueue<std::function<void()>, 1024, true> m_queuedActions;
         };
     }
 }
\ No newline at end of file
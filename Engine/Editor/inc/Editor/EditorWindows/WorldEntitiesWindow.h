@@ -34,6 +34,8 @@ namespace Insight
 			EDITOR_WINDOW(WorldEntitiesWindow, EditorWindowCategories::Windows);
 
 			std::unordered_set<Core::GUID> const& GetSelectedEntities() const;
+			/// @brief Select 'entityGuid', replacing the current selection unless 'addToSelection' is set.
+			void SelectEntity(const Core::GUID& entityGuid, const bool addToSelection);
 
 		private:
 			void DrawSingleEntity(ECS::Entity* entity, u32 entityIndex);
@@ -10,10 +10,14 @@
 
 #include "Editor/EditorWindows/Generated/WorldViewWindow_reflect_generated.h"
 
+struct ImVec2;
+
 namespace Insight
 {
     namespace Editor
     {
+        class WorldEntitiesWindow;
+
         struct RenderData
         {
             RenderFrame RenderFrame;
@@ -40,6 +44,8 @@ namespace Insight
 
         private:
             void ContentWindowDragTarget();
+            /// @brief Select the entity under the mouse, using each world's spatial index.
+            void PickEntity(WorldEntitiesWindow* worldEntitiesWindow, const ImVec2& imageRectMin, const ImVec2& imageRectSize);
             
             void SetupRenderGraphPasses();
             void LightShadowPass();
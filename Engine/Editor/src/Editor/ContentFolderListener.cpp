@@ -16,8 +16,6 @@ namespace Insight::Editor
         std::string fullPath = dir + filename;
         FileSystem::PathToUnix(fullPath);
 
-        std::lock_guard queueedActionsLock(m_queuedActionsMuetx);
-
         switch (action)
         {
         case efsw::Actions::Add:
@@ -26,7 +24,7 @@ namespace Insight::Editor
             std::cout << "DIR (" << dir << ") FILE (" << filename << ") has event Added"
                 << std::endl;
 
-            m_queuedActions.push_back([this, fullPath]()
+            m_queuedActions.Push([this, fullPath]()
                 {
                     Runtime::AssetRegistry::Instance().AddAssetFromDisk(fullPath, m_assetPackage);
                 });
@@ -38,7 +36,7 @@ namespace Insight::Editor
             std::cout << "DIR (" << dir << ") FILE (" << filename << ") has event Delete"
                 << std::endl;
 
-            m_queuedActions.push_back([this, fullPath]()
+            m_queuedActions.Push([this, fullPath]()
                 {
                     //Runtime::AssetRegistry::Instance().UnloadAsset(fullPath);
                     Runtime::AssetRegistry::Instance().RemoveAsset(fullPath);
@@ -70,11 +68,10 @@ namespace Insight::Editor
     {
         IS_PROFILE_FUNCTION();
 
-        std::lock_guard queueedActionsLock(m_queuedActionsMuetx);
-        for (const auto& action : m_queuedActions)
+        std::function<void()> action;
+        while (m_queuedActions.TryPop(action))
         {
             action();
         }
-        m_queuedActions.clear();
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Core/Defines.h"
 #include "Core/Memory.h"
 #include "Core/Profiler.h"
+#include "Memory/MemoryBudget.h"
 
 #include "Input/InputSystem.h"
 #include "Input/InputDevices/InputDevice_KeyboardMouse.h"
@@ -82,6 +83,40 @@ namespace Insight
             ImGui::Text("Total number of allocations: %u.", Core::MemoryTracker::Instance().GetTotalNumberOfAllocations());
             ImGui::Text("Total allocated amount KB: %u.", Core::MemoryTracker::Instance().GetTotalAllocatedInBytes() / 1024);
 
+            u64 sampleRate = Core::MemoryTracker::Instance().GetSampleRate();
+            if (ImGui::InputScalar("Call stack sample rate (bytes)", ImGuiDataType_U64, &sampleRate))
+            {
+                Core::MemoryTracker::Instance().SetSampleRate(sampleRate);
+            }
+            ImGui::Text("Sampled allocations: %llu.", Core::MemoryTracker::Instance().GetTotalNumberOfSampledAllocations());
+
+            if (ImGui::BeginTable("Memory Budgets", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+            {
+                ImGui::TableSetupColumn("Category");
+                ImGui::TableSetupColumn("Usage KB");
+                ImGui::TableSetupColumn("Soft/Hard Limit KB");
+                ImGui::TableSetupColumn("Pressure");
+                ImGui::TableHeadersRow();
+
+                for (size_t i = 0; i < static_cast<u64>(Core::MemoryAllocCategory::Size); ++i)
+                {
+                    const Core::MemoryAllocCategory category = static_cast<Core::MemoryAllocCategory>(i);
+                    const Core::MemoryCategoryBudget budget = Core::MemoryBudget::Instance().GetBudget(category);
+                    const Core::MemoryPressureLevel pressureLevel = Core::MemoryBudget::Instance().GetPressureLevel(category);
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(Core::MemoryAllocCategoryToString[i]);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu", currentMemoryUsageForCategory[i]);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%llu/%llu", budget.SoftLimitBytes / 1024, budget.HardLimitBytes / 1024);
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(Core::MemoryPressureLevelToString[static_cast<u64>(pressureLevel)]);
+                }
+                ImGui::EndTable();
+            }
+
             m_memoryUsage.AdvanceFrame();
         }
     }
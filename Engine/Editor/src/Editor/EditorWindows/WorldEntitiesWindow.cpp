@@ -170,6 +170,15 @@ namespace Insight
 			return m_selectedEntities;
 		}
 
+		void WorldEntitiesWindow::SelectEntity(const Core::GUID& entityGuid, const bool addToSelection)
+		{
+			if (!addToSelection)
+			{
+				m_selectedEntities.clear();
+			}
+			m_selectedEntities.insert(entityGuid);
+		}
+
 		void WorldEntitiesWindow::DrawSingleEntity(ECS::Entity* entity, u32 entityIndex)
 		{
 			IS_PROFILE_FUNCTION();
@@ -5,10 +5,13 @@
 #include "Editor/EditorGUI.h"
 
 #include "Runtime/Engine.h"
+#include "World/WorldSystem.h"
 //#include "Resource/Model.h"
 #include "Asset/Assets/Model.h"
 
 #include "Graphics/GraphicsSystem.h"
+#include "Graphics/OcclusionCulling.h"
+#include "Graphics/RenderContext.h"
 #include "Graphics/RenderGraph/RenderGraph.h"
 #include "Graphics/RenderGraph/RenderGraphBuilder.h"
 #ifdef RENDERGRAPH_V2_ENABLED
@@ -92,6 +95,15 @@ namespace Insight
             ImGui::Checkbox("GPU Skinning", &gpuSkinningEnabled);
             Runtime::AnimationSystem::Instance().SetGPUSkinningEnabled(gpuSkinningEnabled);
 
+            bool occlusionCullingEnabled = OcclusionCulling::IsEnabled();
+            ImGui::Checkbox("Occlusion Culling", &occlusionCullingEnabled);
+            OcclusionCulling::SetEnabled(occlusionCullingEnabled);
+            ImGui::SameLine();
+            if (ImGui::Button("Dump Occlusion Scene"))
+            {
+                OcclusionCulling::RequestSceneDump("OcclusionScene.isoc");
+            }
+
             Graphics::RHI_Texture* worldViewTexture = Graphics::RenderGraph::Instance().GetRenderCompletedRHITexture(editorOutputItems[editorOutput]);
             if (worldViewTexture == nullptr)
             {
@@ -101,6 +113,9 @@ namespace Insight
             const ImVec2 imageCursorPos = ImGui::GetCursorPos();
             const ImVec2 windowSize = ImGui::GetContentRegionAvail();
             ImGui::Image(worldViewTexture, windowSize);
+            const ImVec2 imageRectMin = ImGui::GetItemRectMin();
+            const ImVec2 imageRectSize = ImGui::GetItemRectSize();
+            const bool imageClicked = ImGui::IsItemClicked(ImGuiMouseButton_Left) && !ImGuizmo::IsOver();
 
             static ImGuizmo::OPERATION imGuizmoOperation = ImGuizmo::TRANSLATE;
             {
@@ -155,6 +170,11 @@ namespace Insight
             {
                 // Set the transform gizmo for selected entities.
                 WorldEntitiesWindow* worldEntitiesWindow = static_cast<WorldEntitiesWindow*>(worldEntitiesWindowBase);
+                if (imageClicked)
+                {
+                    PickEntity(worldEntitiesWindow, imageRectMin, imageRectSize);
+                }
+
                 std::unordered_set<Core::GUID> selectedEntites = worldEntitiesWindow->GetSelectedEntities();
                 if (!selectedEntites.empty())
                 {
@@ -175,6 +195,50 @@ namespace Insight
             }
         }
 
+        void WorldViewWindow::PickEntity(WorldEntitiesWindow* worldEntitiesWindow, const ImVec2& imageRectMin, const ImVec2& imageRectSize)
+        {
+            IS_PROFILE_FUNCTION();
+
+            // Mouse position to clip space, Vulkan projections are flipped so the top of the image is -1.
+            const ImVec2 mousePos = ImGui::GetMousePos();
+            const float ndcX = (mousePos.x - imageRectMin.x) / imageRectSize.x * 2.0f - 1.0f;
+            float ndcY = (mousePos.y - imageRectMin.y) / imageRectSize.y * 2.0f - 1.0f;
+            if (Graphics::RenderContext::Instance().GetGraphicsAPI() != Graphics::GraphicsAPI::Vulkan)
+            {
+                ndcY = -ndcY;
+            }
+
+            // Unproject a point between the near and far planes, which works for both standard and reverse depth.
+            const Maths::Matrix4 inverseProjectionView = m_editorCameraComponent->GetProjectionViewMatrix().Inversed();
+            const Maths::Vector4 clipPoint = inverseProjectionView * Maths::Vector4(ndcX, ndcY, 0.5f, 1.0f);
+            const Maths::Vector3 worldPoint = Maths::Vector3(clipPoint) / clipPoint.w;
+            const Maths::Vector3 cameraPosition = Maths::Vector3(m_editorCameraComponent->GetViewMatrix()[3]);
+            const Graphics::Ray ray(cameraPosition, (worldPoint - cameraPosition).Normalised());
+
+            Core::GUID closestEntity = Core::GUID::s_InvalidGUID;
+            float closestDistance = m_editorCameraComponent->GetFarPlane();
+            for (const TObjectPtr<Runtime::World>& world : Runtime::WorldSystem::Instance().GetAllWorlds())
+            {
+                if (world->GetWorldType() == Runtime::WorldTypes::Tools)
+                {
+                    continue;
+                }
+
+                float hitDistance = closestDistance;
+                const Core::GUID hitEntity = world->RayCastEntity(ray, closestDistance, &hitDistance);
+                if (hitEntity.IsValid() && hitDistance < closestDistance)
+                {
+                    closestEntity = hitEntity;
+                    closestDistance = hitDistance;
+                }
+            }
+
+            if (closestEntity.IsValid())
+            {
+                worldEntitiesWindow->SelectEntity(closestEntity, ImGui::GetIO().KeyCtrl);
+            }
+        }
+
         void WorldViewWindow::ContentWindowDragTarget()
         {
             IS_PROFILE_FUNCTION();
@@ -217,6 +281,7 @@ namespace Insight
                 renderFrame = graphicsSystem->GetRenderFrame();
             }
             renderFrame.SetCameraForAllWorlds(camera, cameraTransform);
+            renderFrame.Cull();
             renderFrame.Sort();
 
             {
@@ -356,18 +421,12 @@ namespace Insight
                                     cmdList->SetUniform(0, 0, lightBuffer);
                                 }
 
-                                for (const u64 meshIndex : renderWorld.OpaqueMeshIndexs)
+                                for (const u32 meshIndex : renderWorld.PointLightVisibility.GetView(pointLightIdx * 6 + arrayIdx))
                                 {
-                                    bool isVisable = false; 
                                     const RenderMesh& mesh = renderWorld.Meshes[meshIndex];
+                                    if (mesh.IsTransparent())
                                     {
-                                        IS_PROFILE_SCOPE("Frustum Culling");
-                                        Graphics::Frustum pointLightFrustum(pointLight.View[arrayIdx], pointLight.Projection, pointLight.Radius);
-                                        isVisable = pointLightFrustum.IsVisible(Maths::Vector3(mesh.Transform[3]), mesh.BoudingBox.GetRadius());
-                                    }
-                                    if (!isVisable)
-                                    {
-                                        //continue;
+                                        continue;
                                     }
 
                                     struct alignas(16) Object
@@ -465,7 +524,7 @@ namespace Insight
                 for (const RenderWorld& world : renderFrame.RenderWorlds)
                 {
 
-                    for (const u64 meshIndex : world.OpaqueMeshIndexs)
+                    for (const u64 meshIndex : world.VisibleOpaqueMeshIndexs)
                     {
                         IS_PROFILE_SCOPE("Draw Entity");
                         const RenderMesh& mesh = world.Meshes[meshIndex];
@@ -598,7 +657,7 @@ namespace Insight
                     for (const RenderWorld& world : renderFrame.RenderWorlds)
                     {
                         const RenderCamera& mainCamera = world.MainCamera;
-                        for (const u64 meshIndex : world.OpaqueMeshIndexs)
+                        for (const u64 meshIndex : world.VisibleOpaqueMeshIndexs)
                         {
                             IS_PROFILE_SCOPE("Draw Entity");
                             const RenderMesh& mesh = world.Meshes[meshIndex];
@@ -759,7 +818,7 @@ namespace Insight
                     const RenderFrame& renderFrame = m_renderingData.GetCurrent().RenderFrame;
                     for (const RenderWorld& world : renderFrame.RenderWorlds)
                     {
-                        for (const u64 meshIndex : world.TransparentMeshIndexs)
+                        for (const u64 meshIndex : world.VisibleTransparentMeshIndexs)
                         {
                             IS_PROFILE_SCOPE("Draw Entity");
                             const RenderMesh& mesh = world.Meshes[meshIndex];
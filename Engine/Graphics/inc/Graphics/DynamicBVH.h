@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Graphics/Defines.h"
+#include "Graphics/BoundingBox.h"
+#include "Graphics/Frustum.h"
+
+#include "Core/TypeAlias.h"
+
+#include <vector>
+
+namespace Insight
+{
+	namespace Graphics
+	{
+		struct IS_GRAPHICS Ray
+		{
+			Ray() = default;
+			/// @brief 'direction' doesn't need to be normalised, distances are measured in multiples of it.
+			Ray(const Maths::Vector3& origin, const Maths::Vector3& direction);
+
+			/// @brief Distance along the ray where it enters 'box', 0 if the origin is inside it or a negative value
+			/// if the ray misses it.
+			float IntersectDistance(const BoundingBox& box) const;
+
+			Maths::Vector3 Origin;
+			Maths::Vector3 Direction;
+		};
+
+		/// @brief Bounding volume hierarchy of axis aligned boxes which can be changed one box at a time.
+		/// Each box is a leaf (proxy) holding a user value. Leaves store the box grown by a margin, so a proxy is only
+		/// reinserted when its box moves outside of that. Inserts pick the sibling with the lowest surface area cost and
+		/// the tree is rebalanced with rotations on the way back up, so queries stay O(log n) as proxies move.
+		/// Proxy ids are stable until the proxy is destroyed. Not thread safe, queries can run in parallel with each other.
+		class IS_GRAPHICS DynamicBVH
+		{
+		public:
+			static constexpr u32 c_NullProxy = 0xFFFFFFFF;
+			static constexpr float c_DefaultMargin = 0.1f;
+
+			DynamicBVH(const float margin = c_DefaultMargin);
+
+			u32 CreateProxy(const BoundingBox& box, const u64 userData);
+			void DestroyProxy(const u32 proxyId);
+			/// @brief Update the box of a proxy.
+			/// @return True if the proxy was reinserted, false if 'box' is still inside its fat box.
+			bool MoveProxy(const u32 proxyId, const BoundingBox& box);
+			void Clear();
+
+			u64 GetUserData(const u32 proxyId) const;
+			void SetUserData(const u32 proxyId, const u64 userData);
+			/// @brief Box of the proxy grown by the margin, this is what queries test against.
+			const BoundingBox& GetFatBox(const u32 proxyId) const;
+
+			u32 GetProxyCount() const { return m_proxyCount; }
+			/// @brief Height of the root, 0 for a single proxy.
+			u32 GetHeight() const;
+			/// @brief Sum of the surface areas of all internal nodes divided by the root's. Lower is a better tree.
+			float GetAreaRatio() const;
+			/// @brief Check parent links, heights and that every node contains its children.
+			bool Validate() const;
+
+			/// @brief Call 'func(proxyId, userData)' for every proxy overlapping 'box'. Return false from 'func' to stop.
+			template<typename Func>
+			void QueryAABB(const BoundingBox& box, Func&& func) const;
+			/// @brief Call 'func(proxyId, userData)' for every proxy overlapping the sphere. Return false from 'func' to stop.
+			template<typename Func>
+			void QuerySphere(const Maths::Vector3& center, const float radius, Func&& func) const;
+			/// @brief Call 'func(proxyId, userData)' for every proxy inside or intersecting 'frustum'. Subtrees fully inside
+			/// are reported without testing their children. Return false from 'func' to stop.
+			template<typename Func>
+			void QueryFrustum(const Frustum& frustum, Func&& func) const;
+			/// @brief Call 'func(proxyId, userData)' for every proxy the ray enters within 'maxDistance'. 'func' returns the new
+			/// max distance: the distance to a hit to only look for closer ones, 'maxDistance' to continue or 0 to stop.
+			template<typename Func>
+			void RayCast(const Ray& ray, const float maxDistance, Func&& func) const;
+
+		private:
+			struct Node
+			{
+				bool IsLeaf() const { return Child1 == c_NullProxy; }
+
+				BoundingBox Box;
+				u64 UserData = 0;
+				/// @brief Next free node while the node is in the free list.
+				u32 Parent = c_NullProxy;
+				u32 Child1 = c_NullProxy;
+				u32 Child2 = c_NullProxy;
+				/// @brief 0 for leaves, -1 for free nodes.
+				int Height = 0;
+			};
+
+			/// @brief Visit every node 'classify(box)' doesn't return 'Intersection::Outside' for and call 'func' for its
+			/// leaves. Children of nodes classified as 'Intersection::Inside' are not classified.
+			template<typename Classify, typename Func>
+			void Traverse(Classify&& classify, Func&& func) const;
+
+			u32 AllocateNode();
+			void FreeNode(const u32 nodeId);
+
+			void InsertLeaf(const u32 leafId);
+			void RemoveLeaf(const u32 leafId);
+			/// @brief Refit the boxes and heights from 'nodeId' to the root, rotating unbalanced nodes.
+			void RefitFrom(u32 nodeId);
+			/// @brief Rotate 'nodeId' if its children's heights differ by more than one.
+			/// @return Node now at the position of 'nodeId'.
+			u32 Balance(const u32 nodeId);
+
+			BoundingBox Fatten(const BoundingBox& box) const;
+			int ValidateNode(const u32 nodeId) const;
+
+		private:
+			/// @brief Depth first traversal keeps at most one pending node per level.
+			static constexpr u32 c_MaxStackSize = 256;
+			/// @brief Set on stack entries whose subtree is fully inside the query.
+			static constexpr u32 c_InsideFlag = 0x80000000;
+
+			std::vector<Node> m_nodes;
+			u32 m_root = c_NullProxy;
+			u32 m_freeList = c_NullProxy;
+			u32 m_proxyCount = 0;
+			float m_margin = c_DefaultMargin;
+		};
+	}
+}
+
+#include "Graphics/DynamicBVH.inl"
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Core/Asserts.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Insight
+{
+	namespace Graphics
+	{
+		template<typename Classify, typename Func>
+		void DynamicBVH::Traverse(Classify&& classify, Func&& func) const
+		{
+			if (m_root == c_NullProxy)
+			{
+				return;
+			}
+
+			u32 stack[c_MaxStackSize];
+			u32 stackSize = 0;
+			stack[stackSize++] = m_root;
+
+			while (stackSize > 0)
+			{
+				const u32 entry = stack[--stackSize];
+				const u32 nodeId = entry & ~c_InsideFlag;
+				const Node& node = m_nodes[nodeId];
+
+				u32 childFlag = entry & c_InsideFlag;
+				if (childFlag == 0)
+				{
+					const Intersection intersection = classify(node.Box);
+					if (intersection == Intersection::Outside)
+					{
+						continue;
+					}
+					childFlag = intersection == Intersection::Inside ? c_InsideFlag : 0;
+				}
+
+				if (node.IsLeaf())
+				{
+					if (!func(nodeId, node.UserData))
+					{
+						return;
+					}
+				}
+				else
+				{
+					ASSERT(stackSize + 2 <= c_MaxStackSize);
+					stack[stackSize++] = node.Child1 | childFlag;
+					stack[stackSize++] = node.Child2 | childFlag;
+				}
+			}
+		}
+
+		template<typename Func>
+		void DynamicBVH::QueryAABB(const BoundingBox& box, Func&& func) const
+		{
+			const Maths::Vector3& min = box.GetMin();
+			const Maths::Vector3& max = box.GetMax();
+			Traverse([&min, &max](const BoundingBox& nodeBox)
+				{
+					const Maths::Vector3& nodeMin = nodeBox.GetMin();
+					const Maths::Vector3& nodeMax = nodeBox.GetMax();
+					const bool overlaps = nodeMin.x <= max.x && nodeMax.x >= min.x
+						&& nodeMin.y <= max.y && nodeMax.y >= min.y
+						&& nodeMin.z <= max.z && nodeMax.z >= min.z;
+					return overlaps ? Intersection::Intersects : Intersection::Outside;
+				}, func);
+		}
+
+		template<typename Func>
+		void DynamicBVH::QuerySphere(const Maths::Vector3& center, const float radius, Func&& func) const
+		{
+			const float radiusSquared = radius * radius;
+			Traverse([&center, radiusSquared](const BoundingBox& nodeBox)
+				{
+					// Squared distance from the center to the closest point of the box.
+					const Maths::Vector3& nodeMin = nodeBox.GetMin();
+					const Maths::Vector3& nodeMax = nodeBox.GetMax();
+					const float dx = std::max(std::max(nodeMin.x - center.x, center.x - nodeMax.x), 0.0f);
+					const float dy = std::max(std::max(nodeMin.y - center.y, center.y - nodeMax.y), 0.0f);
+					const float dz = std::max(std::max(nodeMin.z - center.z, center.z - nodeMax.z), 0.0f);
+					return dx * dx + dy * dy + dz * dz <= radiusSquared ? Intersection::Intersects : Intersection::Outside;
+				}, func);
+		}
+
+		template<typename Func>
+		void DynamicBVH::QueryFrustum(const Frustum& frustum, Func&& func) const
+		{
+			Traverse([&frustum](const BoundingBox& nodeBox)
+				{
+					const Maths::Vector3 center = nodeBox.GetCenter();
+					const Maths::Vector3 extents = nodeBox.GetExtents();
+					Intersection result = Intersection::Inside;
+					for (u32 planeIdx = 0; planeIdx < Frustum::c_PlaneCount; ++planeIdx)
+					{
+						const Plane& plane = frustum.GetPlane(planeIdx);
+						const float distance = plane.Dot(center) + plane.d;
+						const float projectedExtent = std::abs(plane.normal.x) * extents.x
+							+ std::abs(plane.normal.y) * extents.y
+							+ std::abs(plane.normal.z) * extents.z;
+						if (distance + projectedExtent < 0.0f)
+						{
+							return Intersection::Outside;
+						}
+						if (distance - projectedExtent < 0.0f)
+						{
+							result = Intersection::Intersects;
+						}
+					}
+					return result;
+				}, func);
+		}
+
+		template<typename Func>
+		void DynamicBVH::RayCast(const Ray& ray, const float maxDistance, Func&& func) const
+		{
+			float distanceLimit = maxDistance;
+			Traverse([&ray, &distanceLimit](const BoundingBox& nodeBox)
+				{
+					const float distance = ray.IntersectDistance(nodeBox);
+					return distance >= 0.0f && distance <= distanceLimit ? Intersection::Intersects : Intersection::Outside;
+				},
+				[&func, &distanceLimit](const u32 proxyId, const u64 userData)
+				{
+					distanceLimit = std::min(distanceLimit, static_cast<float>(func(proxyId, userData)));
+					return distanceLimit > 0.0f;
+				});
+		}
+	}
+}
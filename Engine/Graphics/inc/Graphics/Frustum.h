@@ -61,11 +61,15 @@ namespace Insight
             bool IsVisible(const Graphics::BoundingBox& boundingbox) const;
             std::array<Maths::Vector3, 8> GetWorldPoints() const;
 
+            /// @brief Planes in the order near, far, left, right, top, bottom. Points inside have a positive distance.
+            const Plane& GetPlane(const uint32_t index) const { return m_planes[index]; }
+            static constexpr uint32_t c_PlaneCount = 6;
+
         private:
             Intersection CheckSphere(const Maths::Vector3& center, float radius) const;
             Intersection CheckCube(const Maths::Vector3& center, const Maths::Vector3& extent) const;
 
-            Plane m_planes[6];
+            Plane m_planes[c_PlaneCount];
 
             Maths::Matrix4 m_projectionMatrix;
             Maths::Matrix4 m_view;
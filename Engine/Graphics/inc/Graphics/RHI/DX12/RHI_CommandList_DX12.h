@@ -5,6 +5,7 @@
 #include "Graphics/RHI/RHI_CommandList.h"
 #include "Graphics/RHI/DX12/DX12Utils.h"
 #include "Graphics/RHI/DX12/RHI_PhysicalDevice_DX12.h"
+#include "Memory/FrameArenaAllocator.h"
 
 #include <nvtx3/nvtx3.hpp>
 
@@ -36,7 +37,7 @@ namespace Insight
 				void PipelineBarrierBuffer(std::vector<D3D12_BUFFER_BARRIER> const& bufferMemoryBarrier);
 				void PipelineBarrierImage(std::vector<D3D12_TEXTURE_BARRIER> const& imageMemoryBarrier);
 #endif
-				void PipelineResourceBarriers(std::vector<D3D12_RESOURCE_BARRIER> const& resourceBarriers);
+				void PipelineResourceBarriers(Core::FrameArenaVector<D3D12_RESOURCE_BARRIER> const& resourceBarriers);
 
 				void ClearRenderTargetView(D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle, const float* clearColour, int numRects, D3D12_RECT* rects);
 				void ClearDepthStencilView(D3D12_CPU_DESCRIPTOR_HANDLE DepthStencilView, D3D12_CLEAR_FLAGS ClearFlags, float Depth, int Stencil, int NumRects, D3D12_RECT* rects);
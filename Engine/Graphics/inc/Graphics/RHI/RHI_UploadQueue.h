@@ -41,6 +41,8 @@ namespace Insight
 		{
 			std::atomic<DeviceUploadStatus> Status = DeviceUploadStatus::NotUploaded;
 			RHI_Resource* Resource = nullptr;
+			/// @brief Set by RHI_UploadQueue::RemoveRequest, the upload is skipped if it has not been recorded yet.
+			std::atomic<bool> Cancelled = false;
 			Core::Delegate<RHI_UploadQueueRequest*> OnUploadCompleted;
 		};
 
@@ -52,7 +54,6 @@ namespace Insight
 			u64 SizeInBytes;
 			RPtr<RHI_UploadQueueRequest> Request;
 			RHI_CommandList* CommandList;
-			bool Cancelled = false;
 
 		private:
 			void OnWorkComplete();
@@ -95,11 +96,25 @@ namespace Insight
 			void RemoveRequest(RHI_UploadQueueRequest* request);
 
 		private:
+			/// <summary>
+			/// Copy 'data' into the staging buffer and queue 'uploadRequest'. Both happen under the same lock so requests
+			/// are queued in staging buffer order. Uploads larger than the staging buffer are done immediately and
+			/// 'uploadRequest' is reset.
+			/// </summary>
 			void UploadDataToStagingBuffer(const void* data, u64 sizeInBytes, RHI_UploadTypes uploadType, RPtr<RHI_UploadQueueRequestInternal>& uploadRequest);
+			/// <summary>
+			/// Record all queued uploads into 'cmdList'. 'm_mutex' must be held.
+			/// </summary>
+			void UploadToDeviceLocked(RHI_CommandList* cmdList);
+			/// <summary>
+			/// Upload and wait on everything queued so the staging buffer and queue can be reused. 'm_mutex' must be held.
+			/// </summary>
+			void FlushLocked();
 
 		private:
 			/// <summary>
-			/// All queued uploads to be completed.
+			/// All queued uploads to be completed, in staging buffer order. Guarded by 'm_mutex' with the staging buffer
+			/// offset, as each request is recorded at the offset of the ones queued before it.
 			/// </summary>
 			std::vector<RPtr<RHI_UploadQueueRequestInternal>> m_queuedUploads;
 			std::vector<RPtr<RHI_UploadQueueRequestInternal>> m_runningUploads;
@@ -28,6 +28,7 @@
 #endif
 
 #include "Threading/Semaphore.h"
+#include "Memory/FrameArenaAllocator.h"
 
 #include <mutex>
 
@@ -230,6 +231,8 @@ namespace Insight
 			RHI_UploadQueue& GetUploadQueue()							{ return m_uploadQueue; }
 
 			RHI_MemoryInfo GetVRamInfo() const							{ return m_rhiMemoryInfo.GetRenderCompeted(); }
+			/// @brief Linear allocator for data which only needs to live until the frame's fence retires.
+			Core::FrameArenaAllocator& GetFrameArenaAllocator()			{ return m_frameArenaAllocator; }
 
 #ifdef IS_RESOURCE_HANDLES_ENABLED
 			virtual RHI_Handle<Texture> CreateTexture(const Texture texture) { FAIL_ASSERT(); return {}; }
@@ -309,6 +312,7 @@ namespace Insight
 			FrameResource<RHI_MemoryInfo> m_rhiMemoryInfo;
 
 			FrameResource<DescriptorAllocator> m_frameDescriptorAllocator;
+			Core::FrameArenaAllocator m_frameArenaAllocator;
 
 			FrameResource<CommandListManager> m_commandListManager;
 			FrameResource<RHI_DescriptorSetManager> m_descriptorSetManager;
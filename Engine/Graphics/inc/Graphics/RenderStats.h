@@ -33,6 +33,15 @@ std::string _CONCAT(Stat, Formated)() { return StatDisplayText + Func; }
 
 			u64 MeshCount;
 
+			static constexpr u8 MaxShadowCascadeCount = 4;
+			/// @brief Meshes drawn into each directional light shadow cascade.
+			u64 ShadowCasterCounts[MaxShadowCascadeCount];
+
+			/// @brief Triangles of the meshes drawn if every mesh used its most detailed LOD.
+			u64 FullLodTriangleCount;
+			/// @brief Triangles of the meshes drawn with the LODs picked for them.
+			u64 SelectedLodTriangleCount;
+
 			u64 DrawCalls;
 			u64 DrawIndexedCalls;
 			u64 DispatchCalls;
@@ -56,6 +65,8 @@ std::string _CONCAT(Stat, Formated)() { return StatDisplayText + Func; }
 			u64 DescriptorTableSamplerReuse;
 
 			FORMAT_STAT(MeshCount, "Mesh Count: ");
+			FORMAT_STAT_FUNC(FullLodTriangleCount, FormatU64ToCommaString(FullLodTriangleCount), "Triangles Before LOD: ");
+			FORMAT_STAT_FUNC(SelectedLodTriangleCount, FormatU64ToCommaString(SelectedLodTriangleCount), "Triangles After LOD: ");
 			FORMAT_STAT(DrawCalls, "Draw Calls: ");
 			FORMAT_STAT(DrawIndexedCalls, "Draw Indexed Calls: ");
 			FORMAT_STAT(DispatchCalls, "Dispatch Calls: ");
@@ -0,0 +1,804 @@
+#include "Graphics/DynamicBVH.h"
+
+#include "Core/Profiler.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Insight
+{
+	namespace Graphics
+	{
+		namespace
+		{
+			BoundingBox Union(const BoundingBox& a, const BoundingBox& b)
+			{
+				return BoundingBox(
+					Maths::Vector3(std::min(a.GetMin().x, b.GetMin().x), std::min(a.GetMin().y, b.GetMin().y), std::min(a.GetMin().z, b.GetMin().z)),
+					Maths::Vector3(std::max(a.GetMax().x, b.GetMax().x), std::max(a.GetMax().y, b.GetMax().y), std::max(a.GetMax().z, b.GetMax().z)));
+			}
+
+			float SurfaceArea(const BoundingBox& box)
+			{
+				const Maths::Vector3 size = box.GetSize();
+				return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+			}
+
+			bool Contains(const BoundingBox& outer, const BoundingBox& inner)
+			{
+				return outer.GetMin().x <= inner.GetMin().x && outer.GetMin().y <= inner.GetMin().y && outer.GetMin().z <= inner.GetMin().z
+					&& outer.GetMax().x >= inner.GetMax().x && outer.GetMax().y >= inner.GetMax().y && outer.GetMax().z >= inner.GetMax().z;
+			}
+		}
+
+		//=====================================================
+		// Ray
+		//=====================================================
+		Ray::Ray(const Maths::Vector3& origin, const Maths::Vector3& direction)
+			: Origin(origin)
+			, Direction(direction)
+		{ }
+
+		float Ray::IntersectDistance(const BoundingBox& box) const
+		{
+			// Slab test, a zero direction component gives infinite distances so only the origin is compared on that axis.
+			float entry = 0.0f;
+			float exit = std::numeric_limits<float>::max();
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				const float origin = Origin[axis];
+				const float direction = Direction[axis];
+				const float min = box.GetMin()[axis];
+				const float max = box.GetMax()[axis];
+				if (direction == 0.0f)
+				{
+					if (origin < min || origin > max)
+					{
+						return -1.0f;
+					}
+					continue;
+				}
+
+				const float inverseDirection = 1.0f / direction;
+				float slabEntry = (min - origin) * inverseDirection;
+				float slabExit = (max - origin) * inverseDirection;
+				if (slabEntry > slabExit)
+				{
+					std::swap(slabEntry, slabExit);
+				}
+				entry = std::max(entry, slabEntry);
+				exit = std::min(exit, slabExit);
+				if (entry > exit)
+				{
+					return -1.0f;
+				}
+			}
+			return entry;
+		}
+
+		//=====================================================
+		// DynamicBVH
+		//=====================================================
+		DynamicBVH::DynamicBVH(const float margin)
+			: m_margin(margin)
+		{ }
+
+		u32 DynamicBVH::CreateProxy(const BoundingBox& box, const u64 userData)
+		{
+			IS_PROFILE_FUNCTION();
+
+			const u32 proxyId = AllocateNode();
+			Node& node = m_nodes[proxyId];
+			node.Box = Fatten(box);
+			node.UserData = userData;
+			node.Height = 0;
+
+			InsertLeaf(proxyId);
+			++m_proxyCount;
+			return proxyId;
+		}
+
+		void DynamicBVH::DestroyProxy(const u32 proxyId)
+		{
+			IS_PROFILE_FUNCTION();
+			ASSERT(proxyId < m_nodes.size() && m_nodes[proxyId].IsLeaf() && m_nodes[proxyId].Height == 0);
+
+			RemoveLeaf(proxyId);
+			FreeNode(proxyId);
+			--m_proxyCount;
+		}
+
+		bool DynamicBVH::MoveProxy(const u32 proxyId, const BoundingBox& box)
+		{
+			ASSERT(proxyId < m_nodes.size() && m_nodes[proxyId].IsLeaf() && m_nodes[proxyId].Height == 0);
+			if (Contains(m_nodes[proxyId].Box, box))
+			{
+				return false;
+			}
+
+			IS_PROFILE_FUNCTION();
+			RemoveLeaf(proxyId);
+			m_nodes[proxyId].Box = Fatten(box);
+			InsertLeaf(proxyId);
+			return true;
+		}
+
+		void DynamicBVH::Clear()
+		{
+			m_nodes.clear();
+			m_root = c_NullProxy;
+			m_freeList = c_NullProxy;
+			m_proxyCount = 0;
+		}
+
+		u64 DynamicBVH::GetUserData(const u32 proxyId) const
+		{
+			ASSERT(proxyId < m_nodes.size());
+			return m_nodes[proxyId].UserData;
+		}
+
+		void DynamicBVH::SetUserData(const u32 proxyId, const u64 userData)
+		{
+			ASSERT(proxyId < m_nodes.size());
+			m_nodes[proxyId].UserData = userData;
+		}
+
+		const BoundingBox& DynamicBVH::GetFatBox(const u32 proxyId) const
+		{
+			ASSERT(proxyId < m_nodes.size());
+			return m_nodes[proxyId].Box;
+		}
+
+		u32 DynamicBVH::GetHeight() const
+		{
+			return m_root == c_NullProxy ? 0 : static_cast<u32>(m_nodes[m_root].Height);
+		}
+
+		float DynamicBVH::GetAreaRatio() const
+		{
+			if (m_root == c_NullProxy)
+			{
+				return 0.0f;
+			}
+
+			const float rootArea = SurfaceArea(m_nodes[m_root].Box);
+			float totalArea = 0.0f;
+			for (const Node& node : m_nodes)
+			{
+				if (node.Height > 0)
+				{
+					totalArea += SurfaceArea(node.Box);
+				}
+			}
+			return rootArea > 0.0f ? totalArea / rootArea : 0.0f;
+		}
+
+		bool DynamicBVH::Validate() const
+		{
+			if (m_root == c_NullProxy)
+			{
+				return m_proxyCount == 0;
+			}
+			if (m_nodes[m_root].Parent != c_NullProxy)
+			{
+				return false;
+			}
+
+			u32 freeCount = 0;
+			for (u32 nodeId = m_freeList; nodeId != c_NullProxy; nodeId = m_nodes[nodeId].Parent)
+			{
+				++freeCount;
+			}
+			// A tree with n leaves has n - 1 internal nodes.
+			if (freeCount + m_proxyCount * 2 - 1 != m_nodes.size())
+			{
+				return false;
+			}
+			return ValidateNode(m_root) == m_nodes[m_root].Height;
+		}
+
+		u32 DynamicBVH::AllocateNode()
+		{
+			u32 nodeId = m_freeList;
+			if (nodeId == c_NullProxy)
+			{
+				nodeId = static_cast<u32>(m_nodes.size());
+				ASSERT(nodeId < c_InsideFlag);
+				m_nodes.push_back(Node());
+			}
+			else
+			{
+				m_freeList = m_nodes[nodeId].Parent;
+				m_nodes[nodeId] = Node();
+			}
+			return nodeId;
+		}
+
+		void DynamicBVH::FreeNode(const u32 nodeId)
+		{
+			Node& node = m_nodes[nodeId];
+			node.Parent = m_freeList;
+			node.Child1 = c_NullProxy;
+			node.Child2 = c_NullProxy;
+			node.Height = -1;
+			m_freeList = nodeId;
+		}
+
+		void DynamicBVH::InsertLeaf(const u32 leafId)
+		{
+			if (m_root == c_NullProxy)
+			{
+				m_root = leafId;
+				m_nodes[leafId].Parent = c_NullProxy;
+				return;
+			}
+
+			// Walk down to the sibling with the lowest cost. Making 'nodeId' the sibling costs the area of the new parent,
+			// descending adds the area every node on the way grows by.
+			const BoundingBox leafBox = m_nodes[leafId].Box;
+			u32 nodeId = m_root;
+			while (!m_nodes[nodeId].IsLeaf())
+			{
+				const Node& node = m_nodes[nodeId];
+				const float area = SurfaceArea(node.Box);
+				const float combinedArea = SurfaceArea(Union(node.Box, leafBox));
+
+				const float siblingCost = 2.0f * combinedArea;
+				const float inheritedCost = 2.0f * (combinedArea - area);
+
+				const auto childCost = [this, &leafBox, inheritedCost](const u32 childId)
+				{
+					const Node& child = m_nodes[childId];
+					const float childCombinedArea = SurfaceArea(Union(child.Box, leafBox));
+					return child.IsLeaf()
+						? childCombinedArea + inheritedCost
+						: childCombinedArea - SurfaceArea(child.Box) + inheritedCost;
+				};
+				const float cost1 = childCost(node.Child1);
+				const float cost2 = childCost(node.Child2);
+
+				if (siblingCost < cost1 && siblingCost < cost2)
+				{
+					break;
+				}
+				nodeId = cost1 < cost2 ? node.Child1 : node.Child2;
+			}
+
+			const u32 siblingId = nodeId;
+			const u32 oldParentId = m_nodes[siblingId].Parent;
+			// May reallocate 'm_nodes', no node references are held across this.
+			const u32 newParentId = AllocateNode();
+
+			Node& newParent = m_nodes[newParentId];
+			newParent.Parent = oldParentId;
+			newParent.Box = Union(leafBox, m_nodes[siblingId].Box);
+			newParent.Height = m_nodes[siblingId].Height + 1;
+			newParent.Child1 = siblingId;
+			newParent.Child2 = leafId;
+
+			if (oldParentId != c_NullProxy)
+			{
+				Node& oldParent = m_nodes[oldParentId];
+				if (oldParent.Child1 == siblingId)
+				{
+					oldParent.Child1 = newParentId;
+				}
+				else
+				{
+					oldParent.Child2 = newParentId;
+				}
+			}
+			else
+			{
+				m_root = newParentId;
+			}
+			m_nodes[siblingId].Parent = newParentId;
+			m_nodes[leafId].Parent = newParentId;
+
+			RefitFrom(oldParentId);
+		}
+
+		void DynamicBVH::RemoveLeaf(const u32 leafId)
+		{
+			if (leafId == m_root)
+			{
+				m_root = c_NullProxy;
+				return;
+			}
+
+			const u32 parentId = m_nodes[leafId].Parent;
+			const u32 grandParentId = m_nodes[parentId].Parent;
+			const u32 siblingId = m_nodes[parentId].Child1 == leafId ? m_nodes[parentId].Child2 : m_nodes[parentId].Child1;
+
+			// The sibling takes the parent's place.
+			if (grandParentId != c_NullProxy)
+			{
+				Node& grandParent = m_nodes[grandParentId];
+				if (grandParent.Child1 == parentId)
+				{
+					grandParent.Child1 = siblingId;
+				}
+				else
+				{
+					grandParent.Child2 = siblingId;
+				}
+			}
+			else
+			{
+				m_root = siblingId;
+			}
+			m_nodes[siblingId].Parent = grandParentId;
+			FreeNode(parentId);
+
+			RefitFrom(grandParentId);
+		}
+
+		void DynamicBVH::RefitFrom(u32 nodeId)
+		{
+			while (nodeId != c_NullProxy)
+			{
+				nodeId = Balance(nodeId);
+
+				Node& node = m_nodes[nodeId];
+				const Node& child1 = m_nodes[node.Child1];
+				const Node& child2 = m_nodes[node.Child2];
+				node.Height = 1 + std::max(child1.Height, child2.Height);
+				node.Box = Union(child1.Box, child2.Box);
+
+				nodeId = node.Parent;
+			}
+		}
+
+		u32 DynamicBVH::Balance(const u32 nodeId)
+		{
+			Node& a = m_nodes[nodeId];
+			if (a.IsLeaf() || a.Height < 2)
+			{
+				return nodeId;
+			}
+
+			const u32 bId = a.Child1;
+			const u32 cId = a.Child2;
+			Node& b = m_nodes[bId];
+			Node& c = m_nodes[cId];
+			const int balance = c.Height - b.Height;
+
+			// Rotate the taller child up into a's place, a keeps the shorter child and the shorter grandchild.
+			const auto rotateUp = [this, nodeId, &a](const u32 upId, Node& up, Node& other, const bool upIsChild1)
+			{
+				const u32 fId = up.Child1;
+				const u32 gId = up.Child2;
+				Node& f = m_nodes[fId];
+				Node& g = m_nodes[gId];
+
+				up.Child1 = nodeId;
+				up.Parent = a.Parent;
+				a.Parent = upId;
+
+				if (up.Parent != c_NullProxy)
+				{
+					Node& parent = m_nodes[up.Parent];
+					if (parent.Child1 == nodeId)
+					{
+						parent.Child1 = upId;
+					}
+					else
+					{
+						parent.Child2 = upId;
+					}
+				}
+				else
+				{
+					m_root = upId;
+				}
+
+				// The taller grandchild stays under 'up', the other moves under a in up's old slot.
+				const bool keepF = f.Height > g.Height;
+				const u32 keptId = keepF ? fId : gId;
+				const u32 movedId = keepF ? gId : fId;
+				Node& kept = m_nodes[keptId];
+				Node& moved = m_nodes[movedId];
+
+				up.Child2 = keptId;
+				if (upIsChild1)
+				{
+					a.Child1 = movedId;
+				}
+				else
+				{
+					a.Child2 = movedId;
+				}
+				moved.Parent = nodeId;
+
+				a.Box = Union(other.Box, moved.Box);
+				up.Box = Union(a.Box, kept.Box);
+				a.Height = 1 + std::max(other.Height, moved.Height);
+				up.Height = 1 + std::max(a.Height, kept.Height);
+			};
+
+			if (balance > 1)
+			{
+				rotateUp(cId, c, b, false);
+				return cId;
+			}
+			if (balance < -1)
+			{
+				rotateUp(bId, b, c, true);
+				return bId;
+			}
+			return nodeId;
+		}
+
+		BoundingBox DynamicBVH::Fatten(const BoundingBox& box) const
+		{
+			const Maths::Vector3 margin(m_margin, m_margin, m_margin);
+			return BoundingBox(box.GetMin() - margin, box.GetMax() + margin);
+		}
+
+		int DynamicBVH::ValidateNode(const u32 nodeId) const
+		{
+			const Node& node = m_nodes[nodeId];
+			if (node.IsLeaf())
+			{
+				return node.Height == 0 && node.Child2 == c_NullProxy ? 0 : -1;
+			}
+
+			const Node& child1 = m_nodes[node.Child1];
+			const Node& child2 = m_nodes[node.Child2];
+			if (child1.Parent != nodeId || child2.Parent != nodeId
+				|| !Contains(node.Box, child1.Box) || !Contains(node.Box, child2.Box))
+			{
+				return -1;
+			}
+
+			const int height1 = ValidateNode(node.Child1);
+			const int height2 = ValidateNode(node.Child2);
+			if (height1 < 0 || height2 < 0 || node.Height != 1 + std::max(height1, height2))
+			{
+				return -1;
+			}
+			return node.Height;
+		}
+	}
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+
+#include <chrono>
+#include <vector>
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Graphics;
+
+	TEST_SUITE("Graphics DynamicBVH")
+	{
+		float RandomFloat(unsigned int& state, const float range)
+		{
+			state = state * 1664525u + 1013904223u;
+			return (static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f) * range;
+		}
+		BoundingBox RandomBox(unsigned int& state, const float range)
+		{
+			const Maths::Vector3 center(RandomFloat(state, range), RandomFloat(state, range), RandomFloat(state, range));
+			const Maths::Vector3 extents(std::abs(RandomFloat(state, 1.0f)) + 0.1f, std::abs(RandomFloat(state, 1.0f)) + 0.1f, std::abs(RandomFloat(state, 1.0f)) + 0.1f);
+			return BoundingBox(center - extents, center + extents);
+		}
+		bool Overlaps(const BoundingBox& a, const BoundingBox& b)
+		{
+			return a.GetMin().x <= b.GetMax().x && a.GetMax().x >= b.GetMin().x
+				&& a.GetMin().y <= b.GetMax().y && a.GetMax().y >= b.GetMin().y
+				&& a.GetMin().z <= b.GetMax().z && a.GetMax().z >= b.GetMin().z;
+		}
+		bool InFrustum(const Frustum& frustum, const BoundingBox& box)
+		{
+			for (u32 planeIdx = 0; planeIdx < Frustum::c_PlaneCount; ++planeIdx)
+			{
+				const Plane& plane = frustum.GetPlane(planeIdx);
+				const Maths::Vector3 extents = box.GetExtents();
+				const float projectedExtent = std::abs(plane.normal.x) * extents.x + std::abs(plane.normal.y) * extents.y + std::abs(plane.normal.z) * extents.z;
+				if (plane.Dot(box.GetCenter()) + plane.d + projectedExtent < 0.0f)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+		Frustum TestFrustum()
+		{
+			// Camera at the origin looking down +z.
+			const Maths::Matrix4 cameraTransform = Maths::Matrix4::LookAt(Maths::Vector3(0.0f, 0.0f, 0.0f), Maths::Vector3(0.0f, 0.0f, 1.0f), Maths::Vector3(0.0f, 1.0f, 0.0f)).Inversed();
+			return Frustum(cameraTransform, Maths::Matrix4::CreatePerspective(1.0f, 1.0f, 0.1f, 50.0f), 50.0f);
+		}
+
+		struct TestTree
+		{
+			DynamicBVH Tree;
+			std::vector<BoundingBox> Boxes;
+			std::vector<u32> ProxyIds;
+
+			std::vector<u64> Query(const BoundingBox& box) const
+			{
+				std::vector<u64> result;
+				Tree.QueryAABB(box, [&result](const u32, const u64 userData) { result.push_back(userData); return true; });
+				std::sort(result.begin(), result.end());
+				return result;
+			}
+			std::vector<u64> LinearQuery(const BoundingBox& box) const
+			{
+				std::vector<u64> result;
+				for (u64 i = 0; i < ProxyIds.size(); ++i)
+				{
+					if (ProxyIds[i] != DynamicBVH::c_NullProxy && Overlaps(Tree.GetFatBox(ProxyIds[i]), box))
+					{
+						result.push_back(i);
+					}
+				}
+				return result;
+			}
+		};
+
+		TestTree BuildTree(unsigned int& state, const u32 count, const float range)
+		{
+			TestTree testTree;
+			for (u32 i = 0; i < count; ++i)
+			{
+				testTree.Boxes.push_back(RandomBox(state, range));
+				testTree.ProxyIds.push_back(testTree.Tree.CreateProxy(testTree.Boxes.back(), i));
+			}
+			return testTree;
+		}
+
+		TEST_CASE("Insert and remove")
+		{
+			unsigned int state = 1;
+			TestTree testTree = BuildTree(state, 1000, 100.0f);
+			CHECK(testTree.Tree.GetProxyCount() == 1000);
+			CHECK(testTree.Tree.Validate());
+			// A balanced tree of 1000 leaves is at least 10 high, rotations should keep it close to that.
+			CHECK(testTree.Tree.GetHeight() <= 20);
+
+			for (u32 i = 0; i < 1000; i += 2)
+			{
+				testTree.Tree.DestroyProxy(testTree.ProxyIds[i]);
+				testTree.ProxyIds[i] = DynamicBVH::c_NullProxy;
+			}
+			CHECK(testTree.Tree.GetProxyCount() == 500);
+			CHECK(testTree.Tree.Validate());
+
+			const BoundingBox all(Maths::Vector3(-1000.0f, -1000.0f, -1000.0f), Maths::Vector3(1000.0f, 1000.0f, 1000.0f));
+			CHECK(testTree.Query(all) == testTree.LinearQuery(all));
+
+			testTree.Tree.Clear();
+			CHECK(testTree.Tree.GetProxyCount() == 0);
+			CHECK(testTree.Tree.Validate());
+		}
+
+		TEST_CASE("Move")
+		{
+			unsigned int state = 2;
+			TestTree testTree = BuildTree(state, 500, 50.0f);
+
+			// Moves within the margin don't change the tree.
+			const Maths::Vector3 smallOffset(0.05f, 0.0f, 0.0f);
+			const BoundingBox nudged(testTree.Boxes[0].GetMin() + smallOffset, testTree.Boxes[0].GetMax() + smallOffset);
+			CHECK_FALSE(testTree.Tree.MoveProxy(testTree.ProxyIds[0], nudged));
+
+			for (int step = 0; step < 10; ++step)
+			{
+				for (u32 i = 0; i < testTree.Boxes.size(); ++i)
+				{
+					const Maths::Vector3 offset(RandomFloat(state, 2.0f), RandomFloat(state, 2.0f), RandomFloat(state, 2.0f));
+					testTree.Boxes[i] = BoundingBox(testTree.Boxes[i].GetMin() + offset, testTree.Boxes[i].GetMax() + offset);
+					testTree.Tree.MoveProxy(testTree.ProxyIds[i], testTree.Boxes[i]);
+				}
+				CHECK(testTree.Tree.Validate());
+			}
+			for (u32 i = 0; i < testTree.Boxes.size(); ++i)
+			{
+				const BoundingBox& fatBox = testTree.Tree.GetFatBox(testTree.ProxyIds[i]);
+				CHECK(fatBox.IsInside(testTree.Boxes[i]) == Intersection::Inside);
+			}
+		}
+
+		TEST_CASE("Queries")
+		{
+			unsigned int state = 3;
+			TestTree testTree = BuildTree(state, 2000, 100.0f);
+
+			for (int queryIdx = 0; queryIdx < 32; ++queryIdx)
+			{
+				const Maths::Vector3 center(RandomFloat(state, 100.0f), RandomFloat(state, 100.0f), RandomFloat(state, 100.0f));
+				const float halfSize = std::abs(RandomFloat(state, 30.0f));
+				const Maths::Vector3 extents(halfSize, halfSize, halfSize);
+				const BoundingBox queryBox(center - extents, center + extents);
+				CHECK(testTree.Query(queryBox) == testTree.LinearQuery(queryBox));
+			}
+
+			// Sphere.
+			const Maths::Vector3 center(10.0f, -5.0f, 20.0f);
+			const float radius = 30.0f;
+			std::vector<u64> sphereResult;
+			testTree.Tree.QuerySphere(center, radius, [&sphereResult](const u32, const u64 userData) { sphereResult.push_back(userData); return true; });
+			std::sort(sphereResult.begin(), sphereResult.end());
+			std::vector<u64> sphereExpected;
+			for (u64 i = 0; i < testTree.ProxyIds.size(); ++i)
+			{
+				const BoundingBox& box = testTree.Tree.GetFatBox(testTree.ProxyIds[i]);
+				float distanceSquared = 0.0f;
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					const float distance = std::max(std::max(box.GetMin()[axis] - center[axis], center[axis] - box.GetMax()[axis]), 0.0f);
+					distanceSquared += distance * distance;
+				}
+				if (distanceSquared <= radius * radius)
+				{
+					sphereExpected.push_back(i);
+				}
+			}
+			CHECK(sphereResult == sphereExpected);
+
+			// Frustum, subtrees fully inside are reported without testing each leaf so the results must still match.
+			const Frustum frustum = TestFrustum();
+			std::vector<u64> frustumResult;
+			testTree.Tree.QueryFrustum(frustum, [&frustumResult](const u32, const u64 userData) { frustumResult.push_back(userData); return true; });
+			std::sort(frustumResult.begin(), frustumResult.end());
+			std::vector<u64> frustumExpected;
+			for (u64 i = 0; i < testTree.ProxyIds.size(); ++i)
+			{
+				if (InFrustum(frustum, testTree.Tree.GetFatBox(testTree.ProxyIds[i])))
+				{
+					frustumExpected.push_back(i);
+				}
+			}
+			CHECK(!frustumExpected.empty());
+			CHECK(frustumResult == frustumExpected);
+
+			// Stopping early.
+			u32 reported = 0;
+			testTree.Tree.QueryAABB(BoundingBox(Maths::Vector3(-1000.0f, -1000.0f, -1000.0f), Maths::Vector3(1000.0f, 1000.0f, 1000.0f))
+				, [&reported](const u32, const u64) { ++reported; return reported < 10; });
+			CHECK(reported == 10);
+		}
+
+		TEST_CASE("Ray cast")
+		{
+			unsigned int state = 4;
+			TestTree testTree = BuildTree(state, 2000, 100.0f);
+
+			const Ray missRay(Maths::Vector3(0.0f, 1000.0f, 0.0f), Maths::Vector3(0.0f, 1.0f, 0.0f));
+			bool hitAny = false;
+			testTree.Tree.RayCast(missRay, 1000.0f, [&hitAny](const u32, const u64) { hitAny = true; return 0.0f; });
+			CHECK_FALSE(hitAny);
+
+			for (int rayIdx = 0; rayIdx < 32; ++rayIdx)
+			{
+				const Maths::Vector3 origin(RandomFloat(state, 150.0f), RandomFloat(state, 150.0f), RandomFloat(state, 150.0f));
+				const Maths::Vector3 target(RandomFloat(state, 50.0f), RandomFloat(state, 50.0f), RandomFloat(state, 50.0f));
+				const Ray ray(origin, (target - origin).Normalised());
+
+				float closest = 1000.0f;
+				u64 closestUserData = ~0ull;
+				testTree.Tree.RayCast(ray, closest, [&](const u32 proxyId, const u64 userData)
+					{
+						const float distance = ray.IntersectDistance(testTree.Tree.GetFatBox(proxyId));
+						if (distance >= 0.0f && distance < closest)
+						{
+							closest = distance;
+							closestUserData = userData;
+						}
+						return closest;
+					});
+
+				float expectedClosest = 1000.0f;
+				u64 expectedUserData = ~0ull;
+				for (u64 i = 0; i < testTree.ProxyIds.size(); ++i)
+				{
+					const float distance = ray.IntersectDistance(testTree.Tree.GetFatBox(testTree.ProxyIds[i]));
+					if (distance >= 0.0f && distance < expectedClosest)
+					{
+						expectedClosest = distance;
+						expectedUserData = i;
+					}
+				}
+				CHECK(closestUserData == expectedUserData);
+				CHECK(closest == expectedClosest);
+			}
+		}
+
+		TEST_CASE("Benchmark")
+		{
+			constexpr u32 c_ProxyCount = 100 * 1000;
+			constexpr u32 c_QueryCount = 1000;
+
+			unsigned int state = 5;
+			std::vector<BoundingBox> boxes(c_ProxyCount);
+			for (BoundingBox& box : boxes)
+			{
+				box = RandomBox(state, 1000.0f);
+			}
+			std::vector<BoundingBox> queries(c_QueryCount);
+			for (BoundingBox& query : queries)
+			{
+				const Maths::Vector3 center = RandomBox(state, 1000.0f).GetCenter();
+				query = BoundingBox(center - Maths::Vector3(20.0f, 20.0f, 20.0f), center + Maths::Vector3(20.0f, 20.0f, 20.0f));
+			}
+
+			const auto measure = [](auto&& func)
+			{
+				const auto start = std::chrono::high_resolution_clock::now();
+				func();
+				const auto end = std::chrono::high_resolution_clock::now();
+				return std::chrono::duration<double, std::milli>(end - start).count();
+			};
+
+			DynamicBVH tree;
+			std::vector<u32> proxyIds(c_ProxyCount);
+			const double insertMs = measure([&]()
+				{
+					for (u32 i = 0; i < c_ProxyCount; ++i)
+					{
+						proxyIds[i] = tree.CreateProxy(boxes[i], i);
+					}
+				});
+			MESSAGE("[Graphics DynamicBVH] Insert " << c_ProxyCount << " proxies: " << insertMs << "ms. Height " << tree.GetHeight()
+				<< ", area ratio " << tree.GetAreaRatio());
+
+			// Small moves, most stay inside their fat box.
+			u32 reinserted = 0;
+			const double updateMs = measure([&]()
+				{
+					for (u32 i = 0; i < c_ProxyCount; ++i)
+					{
+						const Maths::Vector3 offset(RandomFloat(state, 0.2f), RandomFloat(state, 0.2f), RandomFloat(state, 0.2f));
+						boxes[i] = BoundingBox(boxes[i].GetMin() + offset, boxes[i].GetMax() + offset);
+						reinserted += tree.MoveProxy(proxyIds[i], boxes[i]) ? 1 : 0;
+					}
+				});
+			MESSAGE("[Graphics DynamicBVH] Update " << c_ProxyCount << " proxies: " << updateMs << "ms, " << reinserted << " reinserted.");
+
+			u64 treeHits = 0;
+			const double queryMs = measure([&]()
+				{
+					for (const BoundingBox& query : queries)
+					{
+						tree.QueryAABB(query, [&treeHits](const u32, const u64) { ++treeHits; return true; });
+					}
+				});
+			u64 linearHits = 0;
+			const double linearMs = measure([&]()
+				{
+					for (const BoundingBox& query : queries)
+					{
+						for (u32 i = 0; i < c_ProxyCount; ++i)
+						{
+							linearHits += Overlaps(tree.GetFatBox(proxyIds[i]), query) ? 1 : 0;
+						}
+					}
+				});
+			CHECK(treeHits == linearHits);
+			MESSAGE("[Graphics DynamicBVH] " << c_QueryCount << " AABB queries: " << queryMs << "ms, linear scan: " << linearMs << "ms. "
+				<< treeHits << " hits.");
+
+			u64 frustumHits = 0;
+			const Frustum frustum = TestFrustum();
+			const double frustumMs = measure([&]()
+				{
+					tree.QueryFrustum(frustum, [&frustumHits](const u32, const u64) { ++frustumHits; return true; });
+				});
+			u64 linearFrustumHits = 0;
+			const double linearFrustumMs = measure([&]()
+				{
+					for (u32 i = 0; i < c_ProxyCount; ++i)
+					{
+						linearFrustumHits += InFrustum(frustum, tree.GetFatBox(proxyIds[i])) ? 1 : 0;
+					}
+				});
+			CHECK(frustumHits == linearFrustumHits);
+			MESSAGE("[Graphics DynamicBVH] Frustum query: " << frustumMs << "ms, linear scan: " << linearFrustumMs << "ms. " << frustumHits << " hits.");
+		}
+	}
+}
+#endif
@@ -105,7 +105,7 @@ namespace Insight
 				}
 				PipelineBarrier(bufferBarriers, imageBarriers);
 #else
-				std::vector<D3D12_RESOURCE_BARRIER> resouceBarriers;
+				Core::FrameArenaVector<D3D12_RESOURCE_BARRIER> resouceBarriers { Core::FrameArenaStlAllocator<D3D12_RESOURCE_BARRIER>(m_context->GetFrameArenaAllocator().GetCurrentArena()) };
 				for (const BufferBarrier& bufferBarrier : barrier.BufferBarriers)
 				{
 					RHI_Buffer_DX12* bufferDX12 = static_cast<RHI_Buffer_DX12*>(bufferBarrier.Buffer);
@@ -172,7 +172,7 @@ namespace Insight
 			}
 #endif
 
-			void RHI_CommandList_DX12::PipelineResourceBarriers(std::vector<D3D12_RESOURCE_BARRIER> const& resourceBarriers)
+			void RHI_CommandList_DX12::PipelineResourceBarriers(Core::FrameArenaVector<D3D12_RESOURCE_BARRIER> const& resourceBarriers)
 			{
 				if (resourceBarriers.size() > 0ull)
 				{
@@ -263,7 +263,7 @@ namespace Insight
 				RHI_Buffer_DX12* dstDX12 = static_cast<RHI_Buffer_DX12*>(dst);
 				RHI_Buffer_DX12* srcDX12 = static_cast<RHI_Buffer_DX12*>(src);
 
-				std::vector<D3D12_RESOURCE_BARRIER> barriers = {};
+				Core::FrameArenaVector<D3D12_RESOURCE_BARRIER> barriers { Core::FrameArenaStlAllocator<D3D12_RESOURCE_BARRIER>(m_context->GetFrameArenaAllocator().GetCurrentArena()) };
 				if (dstDX12->GetResourceState() != D3D12_RESOURCE_STATE_COPY_DEST)
 				{
 					barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(dstDX12->GetResource(), dstDX12->GetResourceState(), D3D12_RESOURCE_STATE_COPY_DEST));
@@ -278,7 +278,7 @@ namespace Insight
 
 				m_commandList->CopyBufferRegion(dstDX12->GetResource(), dstOffset, srcDX12->GetResource(), srcOffset, sizeInBytes);
 			
-				barriers = {};
+				barriers.clear();
 				if (dstDX12->GetResourceState() != BufferTypeToDX12ResourceState(dstDX12->GetType()))
 				{
 					barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(dstDX12->GetResource(), dstDX12->GetResourceState(), BufferTypeToDX12ResourceState(dstDX12->GetType())));
@@ -371,6 +371,7 @@ namespace Insight
 					m_graphicsQueue.Wait(m_submitFenceValues.Get());
 					m_submitFrameContexts->OnCompleted();
 					m_frameIndexCompleted.store(m_frameIndex.load());
+					m_frameArenaAllocator.RetireFrame(m_frameIndex.load());
 				}
 
 				{
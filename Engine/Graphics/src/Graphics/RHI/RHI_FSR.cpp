@@ -72,7 +72,7 @@ namespace Insight
         {
             Core::EventSystem::Instance().RemoveEventListener(this, Core::EventType::Graphics_Swapchain_Resize);
             ASSERT(ffxFsr2ContextDestroy(&m_ffx_fsr2_context) == FFX_OK);
-            free(m_scratchBuffer);
+            DeleteBytes(m_scratchBuffer);
         }
 
         void RHI_FSR::SetIsEnabled(const bool value) const
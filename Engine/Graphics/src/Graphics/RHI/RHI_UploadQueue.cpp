@@ -69,7 +69,7 @@ namespace Insight
 				RHI_UploadQueueRequestInternal>(
 					[=](const RHI_UploadQueueRequestInternal* request, RHI_CommandList* cmdList)
 					{
-						if (request->Cancelled)
+						if (request->Request->Cancelled)
 						{
 							return;
 						}
@@ -80,14 +80,7 @@ namespace Insight
 					}, buffer, sizeInBytes);
 
 			UploadDataToStagingBuffer(data, sizeInBytes, RHI_UploadTypes::Buffer, uploadRequest);
-
-			if (uploadRequest)
-			{
-				std::lock_guard lock(m_mutex);
-				m_queuedUploads.push_back(std::move(uploadRequest));
-			}
-
-			return m_queuedUploads.back()->Request;
+			return uploadRequest ? uploadRequest->Request : RPtr<RHI_UploadQueueRequest>();
 		}
 
 		RPtr<RHI_UploadQueueRequest> RHI_UploadQueue::UploadTexture(const void* data, u64 sizeInBytes, RHI_Texture* texture)
@@ -98,7 +91,7 @@ namespace Insight
 				RHI_UploadQueueRequestInternal>(
 					[=](const RHI_UploadQueueRequestInternal* request, RHI_CommandList* cmdList)
 					{
-						if (request->Cancelled)
+						if (request->Request->Cancelled)
 						{
 							return;
 						}
@@ -140,15 +133,7 @@ namespace Insight
 				}, texture, sizeInBytes);
 
 			UploadDataToStagingBuffer(data, sizeInBytes, RHI_UploadTypes::Texture, uploadRequest);
-
-			if (uploadRequest)
-			{
-				std::lock_guard lock(m_mutex);
-				m_queuedUploads.push_back(std::move(uploadRequest));
-				return m_queuedUploads.back()->Request;
-			}
-			return { };
-
+			return uploadRequest ? uploadRequest->Request : RPtr<RHI_UploadQueueRequest>();
 		}
 
 #ifdef IS_RESOURCE_HANDLES_ENABLED
@@ -156,14 +141,11 @@ namespace Insight
 		{
 			IS_PROFILE_FUNCTION();
 
-			UploadDataToStagingBuffer(data, sizeInBytes, RHI_UploadTypes::Texture);
-
-			std::lock_guard lock(m_mutex);
-			m_queuedUploads.push_back(MakeRPtr<
+			RPtr<RHI_UploadQueueRequestInternal> uploadRequest = MakeRPtr<
 				RHI_UploadQueueRequestInternal>(
 					[=](const RHI_UploadQueueRequestInternal* request, RHI_CommandList* cmdList)
 					{
-						if (request->Cancelled)
+						if (request->Request->Cancelled)
 						{
 							return;
 						}
@@ -203,7 +185,9 @@ namespace Insight
 						barreir.ImageBarriers.push_back(imageBarrier);
 						cmdList->PipelineBarrier(barreir);
 
-					}, nullptr, sizeInBytes));
+					}, nullptr, sizeInBytes);
+
+			UploadDataToStagingBuffer(data, sizeInBytes, RHI_UploadTypes::Texture, uploadRequest);
 		}
 #endif
 
@@ -214,6 +198,22 @@ namespace Insight
 			cmdList->BeginTimeBlock("UploadToDevice");
 
 			std::lock_guard lock(m_mutex);
+			UploadToDeviceLocked(cmdList);
+
+			cmdList->EndTimeBlock();
+		}
+
+		void RHI_UploadQueue::RemoveRequest(RHI_UploadQueueRequest* request)
+		{
+			if (request)
+			{
+				request->Cancelled = true;
+			}
+		}
+
+		void RHI_UploadQueue::UploadToDeviceLocked(RHI_CommandList* cmdList)
+		{
+			IS_PROFILE_FUNCTION();
 			m_frameUploadOffset = 0;
 
 			// Remove all completed requests from m_runningUploads.
@@ -241,35 +241,28 @@ namespace Insight
 			}
 
 			// Bind our work completed function.
-			for (size_t i = 0; i < m_queuedUploads.size(); ++i)
+			for (RPtr<RHI_UploadQueueRequestInternal>& queuedUpload : m_queuedUploads)
 			{
-				m_queuedUploads[i]->CommandList = cmdList;
-				m_queuedUploads[i]->CommandList->OnWorkCompleted.Bind<&RHI_UploadQueueRequestInternal::OnWorkComplete>(m_queuedUploads[i].Get());
-				//m_queuedUploads[i]->Request->Resource->m_uploadStatus = DeviceUploadStatus::Uploading;
+				queuedUpload->CommandList = cmdList;
+				queuedUpload->CommandList->OnWorkCompleted.Bind<&RHI_UploadQueueRequestInternal::OnWorkComplete>(queuedUpload.Get());
 				// Call the upload functions.
-				m_queuedUploads[i]->UploadFunction(m_queuedUploads.at(i).Get(), cmdList);
+				queuedUpload->UploadFunction(queuedUpload.Get(), cmdList);
 			}
-			// Move all  our requests to the running vector.
+			// Move all our requests to the running vector.
 			std::move(m_queuedUploads.begin(), m_queuedUploads.end(), std::back_inserter(m_runningUploads));
 			m_queuedUploads.clear();
 
 			m_stagingBufferOffset = 0;
-			cmdList->EndTimeBlock();
 		}
 
-		void RHI_UploadQueue::RemoveRequest(RHI_UploadQueueRequest* request)
+		void RHI_UploadQueue::FlushLocked()
 		{
-			IS_PROFILE_FUNCTION();
-			std::lock_guard lock(m_mutex);
-
-			for (const RPtr<RHI_UploadQueueRequestInternal>& internalRequest : m_queuedUploads)
-			{
-				if (request == internalRequest->Request.Get())
-				{
-					internalRequest->Cancelled = true;
-					break;
-				}
-			}
+			IS_PROFILE_SCOPE("Flush upload queue");
+			RHI_CommandList* cmdList = RenderContext::Instance().GetCommandListManager().GetCommandList();
+			UploadToDeviceLocked(cmdList);
+			cmdList->Close();
+			RenderContext::Instance().SubmitCommandListAndWait(cmdList);
+			RenderContext::Instance().GetCommandListManager().ReturnCommandList(cmdList);
 		}
 
 		void RHI_UploadQueue::UploadDataToStagingBuffer(const void* data, u64 sizeInBytes, RHI_UploadTypes uploadType, RPtr<RHI_UploadQueueRequestInternal>& uploadRequest)
@@ -313,21 +306,19 @@ namespace Insight
 			}
 			else
 			{
+				std::lock_guard lock(m_mutex);
 				if (m_stagingBufferOffset + sizeInBytes > m_uploadStagingBuffer->GetSize())
 				{
-					IS_PROFILE_SCOPE("Flush upload queue");
 					// First flush the current data waiting to be uploaded.
-					RHI_CommandList* cmdList = RenderContext::Instance().GetCommandListManager().GetCommandList();
-					UploadToDevice(cmdList);
-					cmdList->Close();
-					RenderContext::Instance().SubmitCommandListAndWait(cmdList);
-					RenderContext::Instance().GetCommandListManager().ReturnCommandList(cmdList);
+					FlushLocked();
 				}
 
-				std::lock_guard lock(m_mutex);
 				// Upload the data.
 				m_uploadStagingBuffer->Upload(data, sizeInBytes, m_stagingBufferOffset, 0);
 				m_stagingBufferOffset += sizeInBytes;
+				// Queue while still holding the lock so the request order matches the staging buffer order and
+				// UploadToDevice can't reset the staging buffer before this request has been queued.
+				m_queuedUploads.push_back(uploadRequest);
 			}
 		}
 	}
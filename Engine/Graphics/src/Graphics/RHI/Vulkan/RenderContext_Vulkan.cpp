@@ -80,7 +80,7 @@ namespace Insight
 			static void* VMAVulkanReallocate(void* pUserData, void* pOriginal, size_t size, size_t alignment, VkSystemAllocationScope allocationScope)
 			{
 				Core::MemoryTracker::Instance().UnTrack(pOriginal);
-				void* newBlock = std::realloc(pOriginal, size);
+				void* newBlock = ::Insight::Memory::HeapReallocate(pOriginal, size);
 				Core::MemoryTracker::Instance().Track(newBlock, size, Core::MemoryAllocCategory::Graphics, Core::MemoryTrackAllocationType::Single);
 				return newBlock;
 			}
@@ -535,7 +535,7 @@ namespace Insight
 						VkResult waitResult = vkWaitForFences(m_device, 1, &m_submitFrameContexts.Get().SubmitFences, 1, INFINITE);
 						ASSERT(waitResult == VK_SUCCESS);
 					}
-
+					m_frameArenaAllocator.RetireFrame(GetFrameIndex());
 				}
 
 				{
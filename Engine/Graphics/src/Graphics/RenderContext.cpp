@@ -78,6 +78,7 @@ namespace Insight
 			context->m_renderGraph = ::New<RenderGraph>();
 			context->m_renderGraph->Init(context);
 			context->m_frameDescriptorAllocator.Setup();
+			context->m_frameArenaAllocator.Initialise(context->GetFramesInFligtCount(), Core::FrameArenaAllocator::c_DefaultArenaSize, Core::MemoryAllocCategory::Graphics);
 
 			context->m_rhiMemoryInfo.Setup();
 			context->m_renderDocAPI.Initialise();
@@ -106,6 +107,7 @@ namespace Insight
 				{
 					IS_PROFILE_SCOPE("Swap");
 					m_renderGraph->Swap();
+					m_frameArenaAllocator.EndFrame(GetFrameIndex());
 				}
 
 				{
@@ -116,6 +118,7 @@ namespace Insight
 			else
 			{
 				m_renderGraph->Swap();
+				m_frameArenaAllocator.EndFrame(GetFrameIndex());
 				RenderUpdateLoop();
 			}
 		}
@@ -256,6 +259,7 @@ namespace Insight
 				{
 					allocator.Destroy();
 				});
+			m_frameArenaAllocator.Shutdown();
 
 			m_renderGraph->Release();
 			Delete(m_renderGraph);
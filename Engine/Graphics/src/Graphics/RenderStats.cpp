@@ -125,12 +125,29 @@ namespace Insight
                     ImGui::SetItemTooltip("Estimated amount of memory available to the program.");
 
                 }
+                if (ImGui::CollapsingHeader("Frame Arena"))
+                {
+                    const Core::FrameArenaStats frameArenaStats = RenderContext::Instance().GetFrameArenaAllocator().GetStats();
+                    ImGui::Text("   Arena Size: %llu KB",          frameArenaStats.Capacity / 1024);
+                    ImGui::Text("   Arena Count: %llu",            frameArenaStats.ArenaCount);
+                    ImGui::Text("   Last Frame Used: %llu KB",     frameArenaStats.LastFrameUsedBytes / 1024);
+                    ImGui::Text("   Last Frame Overflow: %llu KB", frameArenaStats.LastFrameOverflowBytes / 1024);
+                    ImGui::SetItemTooltip("Bytes which did not fit within the arena and came from the heap.");
+                    ImGui::Text("   Peak Used: %llu KB",           frameArenaStats.PeakUsedBytes / 1024);
+                    ImGui::SetItemTooltip("Most bytes a single frame has allocated. Use to size the arenas.");
+                }
 
                 ImGui::Text("Render Timer: %f", renderTime);
                 ImGui::Text("Average Render Timer: %f", averageRenderTimer);
                 ImGui::Text("Render Fps: %f", fps);
 
                 ImGui::Text(MeshCountFormated().c_str());
+                for (u8 cascadeIdx = 0; cascadeIdx < MaxShadowCascadeCount; ++cascadeIdx)
+                {
+                    ImGui::Text("Shadow Cascade %u Casters: %llu", cascadeIdx, ShadowCasterCounts[cascadeIdx]);
+                }
+                ImGui::Text(FullLodTriangleCountFormated().c_str());
+                ImGui::Text(SelectedLodTriangleCountFormated().c_str());
                 ImGui::Text(DrawCallsFormated().c_str());
                 ImGui::Text(DrawIndexedCallsFormated().c_str());
                 ImGui::Text(DispatchCallsFormated().c_str());
@@ -167,6 +184,14 @@ namespace Insight
             //MeshCount.Swap();
             MeshCount = 0;
 
+            for (u64& shadowCasterCount : ShadowCasterCounts)
+            {
+                shadowCasterCount = 0;
+            }
+
+            FullLodTriangleCount = 0;
+            SelectedLodTriangleCount = 0;
+
             //DrawCalls.Swap();
             DrawCalls = 0;
 
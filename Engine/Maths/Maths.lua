@@ -30,5 +30,6 @@ project "Insight_Maths"
 
     MathsConfig.FilterConfigurations()
     MathsConfig.FilterPlatforms()
+    MathsConfig.FilterFiles()
 
     CommonConfig.PostBuildCopyLibraryToOutput()
\ No newline at end of file
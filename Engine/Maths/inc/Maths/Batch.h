@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Maths/Defines.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Insight
+{
+	namespace Maths
+	{
+		class Matrix4;
+
+		/// @brief Structure of arrays views used by the 'Batch' functions. Each stream holds 'count' floats and is owned
+		/// by the caller. Streams don't need to be aligned but 32 byte aligned streams load faster.
+		struct IS_MATHS Vector3SoA
+		{
+			float* X = nullptr;
+			float* Y = nullptr;
+			float* Z = nullptr;
+
+			/// @brief View of the elements from 'begin' onwards.
+			Vector3SoA Offset(const size_t begin) const;
+
+			/// @brief Streams laid out one after another in 'buffer', which must hold 'c_StreamCount * capacity' floats.
+			static Vector3SoA FromBuffer(float* buffer, const size_t capacity);
+			static constexpr size_t c_StreamCount = 3;
+		};
+
+		struct IS_MATHS QuaternionSoA
+		{
+			float* W = nullptr;
+			float* X = nullptr;
+			float* Y = nullptr;
+			float* Z = nullptr;
+
+			static QuaternionSoA FromBuffer(float* buffer, const size_t capacity);
+			static constexpr size_t c_StreamCount = 4;
+		};
+
+		/// @brief Stream 'i * 4 + j' holds element [i][j] of each matrix, the same order as 'Matrix4'.
+		struct IS_MATHS Matrix4SoA
+		{
+			float* M[16] = { };
+
+			static Matrix4SoA FromBuffer(float* buffer, const size_t capacity);
+			static constexpr size_t c_StreamCount = 16;
+		};
+
+		/// @brief Axis aligned boxes as min and max corners.
+		struct IS_MATHS AABBSoA
+		{
+			Vector3SoA Min;
+			Vector3SoA Max;
+
+			AABBSoA Offset(const size_t begin) const;
+
+			static AABBSoA FromBuffer(float* buffer, const size_t capacity);
+			static constexpr size_t c_StreamCount = 6;
+		};
+
+		/// @brief Instruction sets the batch kernels are built for, in the same order as 'Core::CPUInstructionSet'.
+		enum class BatchInstructionSet : unsigned char
+		{
+			Scalar,
+			SSE42,
+			AVX2,
+			AVX512,
+
+			Count
+		};
+		IS_MATHS const char* BatchInstructionSetToString(const BatchInstructionSet instructionSet);
+
+		/// @brief Functions which apply the same operation to 'count' elements stored as structure of arrays.
+		/// Elements are processed 16 (AVX-512), 8 (AVX2) or 4 (SSE4.2) at a time with a scalar loop for the remainder,
+		/// the variant used is chosen at runtime with 'SetInstructionSet'.
+		/// Results match the per element 'Matrix4'/'Quaternion' operations they replace. Output streams may alias input
+		/// streams of the same type.
+		namespace Batch
+		{
+			/// @brief Use the kernels for 'instructionSet', or the closest lower one which is supported by the CPU and
+			/// was compiled in. Defaults to the highest supported.
+			/// @return The instruction set now in use.
+			IS_MATHS BatchInstructionSet SetInstructionSet(const BatchInstructionSet instructionSet);
+			IS_MATHS BatchInstructionSet GetInstructionSet();
+			/// @brief Highest instruction set the CPU and OS support.
+			IS_MATHS BatchInstructionSet GetSupportedInstructionSet();
+			/// @brief True if the kernels for 'instructionSet' were compiled in and the CPU supports them.
+			IS_MATHS bool IsInstructionSetAvailable(const BatchInstructionSet instructionSet);
+
+			/// @brief result[i] = lhs[i] * rhs[i].
+			IS_MATHS void Multiply(const Matrix4SoA& lhs, const Matrix4SoA& rhs, const Matrix4SoA& result, const size_t count);
+			/// @brief result[i] = parent * children[i].
+			IS_MATHS void MultiplyParent(const Matrix4& parent, const Matrix4SoA& children, const Matrix4SoA& result, const size_t count);
+			/// @brief Transform each box by its matrix and return the box enclosing it, like 'BoundingBox::Transform'.
+			IS_MATHS void TransformAABB(const Matrix4SoA& transforms, const AABBSoA& boxes, const AABBSoA& result, const size_t count);
+			/// @brief result[i] = from[i].Slerp(to[i], time[i]) for unit quaternions and time in [0, 1].
+			/// Uses polynomial acos/sin, results are within 1e-5 of 'Quaternion::Slerp'.
+			IS_MATHS void Slerp(const QuaternionSoA& from, const QuaternionSoA& to, const float* time, const QuaternionSoA& result, const size_t count);
+			/// @brief result[i] = Translation * Rotation * Scale.
+			IS_MATHS void ComposeTRS(const Vector3SoA& translation, const QuaternionSoA& rotation, const Vector3SoA& scale, const Matrix4SoA& result, const size_t count);
+			/// @brief Test each box against 'planeCount' planes stored as (x, y, z, w), a point is inside a plane if
+			/// dot(xyz, point) + w >= 0 (the same as 'Graphics::Plane'). Planes don't need to be normalised.
+			/// A box is culled if it is fully outside any plane, so boxes near the edges of a frustum may be kept.
+			/// Writes 'indexOffset + i' for each box kept to 'visibleIndices' in ascending order, which must have room
+			/// for 'count' indices.
+			/// @return The number of boxes kept.
+			IS_MATHS size_t CullAABB(const float* planes, const size_t planeCount, const AABBSoA& boxes, uint32_t* visibleIndices, const uint32_t indexOffset, const size_t count);
+
+			/// @brief Copy 'count' matrices into structure of arrays form.
+			IS_MATHS void ToSoA(const Matrix4* matrices, const Matrix4SoA& result, const size_t count);
+			/// @brief Copy 'count' matrices out of structure of arrays form.
+			IS_MATHS void ToAoS(const Matrix4SoA& matrices, Matrix4* result, const size_t count);
+
+			namespace Detail
+			{
+				/// @brief Kernels built for one instruction set by the 'Batch<InstructionSet>.cpp' files.
+				/// All entries are null if the compiler could not target that instruction set.
+				struct KernelTable
+				{
+					void(*Multiply)(const Matrix4SoA& lhs, const Matrix4SoA& rhs, const Matrix4SoA& result, const size_t count);
+					void(*MultiplyParent)(const float* parent, const Matrix4SoA& children, const Matrix4SoA& result, const size_t count);
+					void(*TransformAABB)(const Matrix4SoA& transforms, const AABBSoA& boxes, const AABBSoA& result, const size_t count);
+					void(*Slerp)(const QuaternionSoA& from, const QuaternionSoA& to, const float* time, const QuaternionSoA& result, const size_t count);
+					void(*ComposeTRS)(const Vector3SoA& translation, const QuaternionSoA& rotation, const Vector3SoA& scale, const Matrix4SoA& result, const size_t count);
+					size_t(*CullAABB)(const float* planes, const size_t planeCount, const AABBSoA& boxes, uint32_t* visibleIndices, const uint32_t indexOffset, const size_t count);
+				};
+
+				extern const KernelTable c_ScalarKernels;
+				extern const KernelTable c_SSE42Kernels;
+				extern const KernelTable c_AVX2Kernels;
+				extern const KernelTable c_AVX512Kernels;
+			}
+		}
+	}
+}
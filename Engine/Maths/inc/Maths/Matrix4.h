@@ -140,6 +140,9 @@ namespace Insight
 #endif
 #if defined(IS_MATHS_GLM) || defined(IS_MATHS_CONSTRUCTOR_GLM) || defined(IS_TESTING)
 				struct { glm::mat4 mat4; };
+#endif
+#ifdef IS_MATHS_SIMD
+				struct { __m128 m128[4]; };
 #endif
 				struct
 				{
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Maths/Defines.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace Insight
+{
+	namespace Maths
+	{
+		class Quaternion;
+
+		/// @brief IEEE 754 binary16 float. Round to nearest even, values above 'c_Max' become infinity.
+		struct IS_MATHS Half
+		{
+			Half() = default;
+			explicit Half(const float value);
+
+			float ToFloat() const;
+
+			static Half FromBits(const uint16_t bits);
+
+			/// @brief Largest finite value.
+			static constexpr float c_Max = 65504.0f;
+			/// @brief Smallest positive normal value, below this precision drops towards 'c_MinSubnormal'.
+			static constexpr float c_MinNormal = 6.103515625e-05f;
+			static constexpr float c_MinSubnormal = 5.9604644775390625e-08f;
+			/// @brief Max relative error of a round trip for values in [c_MinNormal, c_Max].
+			static constexpr float c_MaxRelativeError = 1.0f / 2048.0f;
+
+			uint16_t Value = 0;
+		};
+
+		/// @brief Float in [-1, 1] (signed) or [0, 1] (unsigned) stored as an integer scaled by the largest value of 'T',
+		/// the same as the SNORM/UNORM GPU formats. Encoding clamps and rounds to nearest.
+		template<typename T>
+		struct NormalisedInteger
+		{
+			static_assert(std::is_integral_v<T> && sizeof(T) <= 2, "NormalisedInteger only supports 8 and 16 bit integers.");
+
+			static constexpr bool c_Signed = std::is_signed_v<T>;
+			static constexpr float c_Scale = static_cast<float>(std::numeric_limits<T>::max());
+			static constexpr float c_Min = c_Signed ? -1.0f : 0.0f;
+			/// @brief Max absolute error of a round trip for values in range.
+			static constexpr float c_MaxError = 0.5f / c_Scale;
+
+			NormalisedInteger() = default;
+			explicit NormalisedInteger(const float value)
+				: Value(Encode(value))
+			{ }
+
+			float ToFloat() const { return Decode(Value); }
+
+			static T Encode(const float value)
+			{
+				const float clamped = std::min(std::max(value, c_Min), 1.0f);
+				return static_cast<T>(std::nearbyint(clamped * c_Scale));
+			}
+			/// @brief The most negative signed value decodes to -1 as well, like the GPU formats.
+			static float Decode(const T value)
+			{
+				return std::max(static_cast<float>(value) / c_Scale, c_Min);
+			}
+
+			T Value = 0;
+		};
+
+		using SNorm8 = NormalisedInteger<int8_t>;
+		using UNorm8 = NormalisedInteger<uint8_t>;
+		using SNorm16 = NormalisedInteger<int16_t>;
+		using UNorm16 = NormalisedInteger<uint16_t>;
+
+		/// @brief Unit vector mapped onto an octahedron and stored as two SNorm16 values, 4 bytes instead of 12.
+		struct IS_MATHS OctahedralNormal
+		{
+			OctahedralNormal() = default;
+			/// @brief 'normal' must be non zero, it doesn't need to be normalised.
+			explicit OctahedralNormal(const Vec<3, float>& normal);
+
+			Vec<3, float> ToVector3() const;
+
+			/// @brief Max absolute error of any component of a decoded unit vector, about 0.004 degrees.
+			static constexpr float c_MaxError = 7.0e-5f;
+
+			int16_t X = 0;
+			int16_t Y = 0;
+		};
+
+		/// @brief Unit quaternion stored as its three smallest components in 15 bits each and the index of the largest
+		/// in 2 bits, 6 bytes instead of 16. The largest component is rebuilt from the unit length, and the sign is
+		/// chosen so it's positive, which is the same rotation.
+		struct IS_MATHS PackedQuaternion
+		{
+			PackedQuaternion() = default;
+			/// @brief 'rotation' must be normalised.
+			explicit PackedQuaternion(const Quaternion& rotation);
+
+			Quaternion ToQuaternion() const;
+
+			/// @brief Max absolute error of any component of the decoded quaternion, or its negation. Half a 15 bit step
+			/// for the stored components, the rebuilt one can be up to three times that.
+			static constexpr float c_MaxError = 7.0e-5f;
+
+			/// @brief Bit 15 of Data[0] and Data[1] hold the largest component index, bits 0-14 the other components
+			/// in w, x, y, z order.
+			uint16_t Data[3] = { };
+		};
+
+		/// @brief Four UNorm values in 32 bits: x bits 0-9, y bits 10-19, z bits 20-29 and w bits 30-31, the same
+		/// layout as R10G10B10A2_UNORM.
+		struct IS_MATHS UNorm1010102
+		{
+			UNorm1010102() = default;
+			explicit UNorm1010102(const Vec<4, float>& value);
+
+			Vec<4, float> ToVector4() const;
+
+			/// @brief Max absolute error of x, y and z.
+			static constexpr float c_MaxErrorXYZ = 0.5f / 1023.0f;
+			/// @brief Max absolute error of w.
+			static constexpr float c_MaxErrorW = 0.5f / 3.0f;
+
+			uint32_t Value = 0;
+		};
+
+		/// @brief Encode and decode 'count' values at a time. Half, normalised integer and octahedral conversions process 4 values
+		/// per instruction with SSE2, results are identical to the single value types above.
+		/// Vectors and quaternions are tightly packed floats (x, y, z for normals, w, x, y, z for quaternions).
+		namespace Packing
+		{
+			IS_MATHS void EncodeHalf(const float* values, Half* result, const size_t count);
+			IS_MATHS void DecodeHalf(const Half* values, float* result, const size_t count);
+
+			IS_MATHS void EncodeSNorm8(const float* values, SNorm8* result, const size_t count);
+			IS_MATHS void DecodeSNorm8(const SNorm8* values, float* result, const size_t count);
+			IS_MATHS void EncodeUNorm8(const float* values, UNorm8* result, const size_t count);
+			IS_MATHS void DecodeUNorm8(const UNorm8* values, float* result, const size_t count);
+			IS_MATHS void EncodeSNorm16(const float* values, SNorm16* result, const size_t count);
+			IS_MATHS void DecodeSNorm16(const SNorm16* values, float* result, const size_t count);
+			IS_MATHS void EncodeUNorm16(const float* values, UNorm16* result, const size_t count);
+			IS_MATHS void DecodeUNorm16(const UNorm16* values, float* result, const size_t count);
+
+			IS_MATHS void EncodeOctahedral(const float* normals, OctahedralNormal* result, const size_t count);
+			IS_MATHS void DecodeOctahedral(const OctahedralNormal* values, float* normals, const size_t count);
+
+			IS_MATHS void EncodeQuaternions(const float* quaternions, PackedQuaternion* result, const size_t count);
+			IS_MATHS void DecodeQuaternions(const PackedQuaternion* values, float* quaternions, const size_t count);
+
+			IS_MATHS void EncodeUNorm1010102(const float* values, UNorm1010102* result, const size_t count);
+			IS_MATHS void DecodeUNorm1010102(const UNorm1010102* values, float* result, const size_t count);
+		}
+	}
+}
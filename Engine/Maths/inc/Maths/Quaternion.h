@@ -90,6 +90,9 @@ namespace Insight
         public:
             union 
             {
+#ifdef IS_MATHS_SIMD
+                struct { __m128 m128; };
+#endif
                 struct
                 {
                     float data[4];
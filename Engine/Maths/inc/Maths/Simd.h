@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Maths/Defines.h"
+
+#ifdef IS_MATHS_SIMD
+
+#if defined(IS_MATHS_DIRECTX_MATHS) || defined(IS_MATHS_GLM)
+#error "IS_MATHS_SIMD can't be used with IS_MATHS_DIRECTX_MATHS or IS_MATHS_GLM."
+#endif
+
+#include <smmintrin.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define IS_MATHS_SIMD_AVX2
+#endif
+
+/// @brief SSE4.1 kernels used by 'Vec<4, float>', 'Matrix4' and 'Quaternion' when IS_MATHS_SIMD is defined.
+/// AVX2 is used for matrix multiply when the compiler targets it (/arch:AVX2, -mavx2).
+/// Only plain multiply and add are used (no FMA) and in the same order as the scalar path, so results match it.
+namespace Insight::Maths::Simd
+{
+	/// @brief Shuffle the lanes of 'v', components are given in x, y, z, w order.
+	template<int X, int Y, int Z, int W>
+	FORCE_INLINE __m128 Swizzle(const __m128 v)
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+	}
+	/// @brief Take lanes X, Y from 'a' and Z, W from 'b'.
+	template<int X, int Y, int Z, int W>
+	FORCE_INLINE __m128 Shuffle(const __m128 a, const __m128 b)
+	{
+		return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+	}
+	template<int Lane>
+	FORCE_INLINE __m128 Splat(const __m128 v)
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+	}
+
+	/// @brief Sum of the products of all four lanes, in every lane.
+	FORCE_INLINE __m128 Dot4(const __m128 a, const __m128 b)
+	{
+		return _mm_dp_ps(a, b, 0xFF);
+	}
+
+	FORCE_INLINE __m128 Negate(const __m128 v)
+	{
+		return _mm_xor_ps(v, _mm_set1_ps(-0.0f));
+	}
+
+	/// @brief Cross product of the xyz lanes, w is 0.
+	FORCE_INLINE __m128 Cross3(const __m128 a, const __m128 b)
+	{
+		const __m128 lhs = _mm_mul_ps(Swizzle<1, 2, 0, 3>(a), Swizzle<2, 0, 1, 3>(b));
+		const __m128 rhs = _mm_mul_ps(Swizzle<2, 0, 1, 3>(a), Swizzle<1, 2, 0, 3>(b));
+		return _mm_blend_ps(_mm_sub_ps(lhs, rhs), _mm_setzero_ps(), 0x8);
+	}
+
+	/// @brief 'v.x * rows[0] + v.y * rows[1] + v.z * rows[2] + v.w * rows[3]'.
+	FORCE_INLINE __m128 Transform(const __m128 rows[4], const __m128 v)
+	{
+		__m128 result = _mm_mul_ps(Splat<0>(v), rows[0]);
+		result = _mm_add_ps(result, _mm_mul_ps(Splat<1>(v), rows[1]));
+		result = _mm_add_ps(result, _mm_mul_ps(Splat<2>(v), rows[2]));
+		result = _mm_add_ps(result, _mm_mul_ps(Splat<3>(v), rows[3]));
+		return result;
+	}
+
+	/// @brief Each row of 'result' is 'rhs' row transformed by 'lhs'. 'result' may alias either input.
+	FORCE_INLINE void Multiply(const __m128 lhs[4], const __m128 rhs[4], __m128 result[4])
+	{
+#ifdef IS_MATHS_SIMD_AVX2
+		const __m256 lhs0 = _mm256_broadcast_ps(&lhs[0]);
+		const __m256 lhs1 = _mm256_broadcast_ps(&lhs[1]);
+		const __m256 lhs2 = _mm256_broadcast_ps(&lhs[2]);
+		const __m256 lhs3 = _mm256_broadcast_ps(&lhs[3]);
+		const __m256 rhs01 = _mm256_insertf128_ps(_mm256_castps128_ps256(rhs[0]), rhs[1], 1);
+		const __m256 rhs23 = _mm256_insertf128_ps(_mm256_castps128_ps256(rhs[2]), rhs[3], 1);
+
+		__m256 row01 = _mm256_mul_ps(_mm256_shuffle_ps(rhs01, rhs01, 0x00), lhs0);
+		row01 = _mm256_add_ps(row01, _mm256_mul_ps(_mm256_shuffle_ps(rhs01, rhs01, 0x55), lhs1));
+		row01 = _mm256_add_ps(row01, _mm256_mul_ps(_mm256_shuffle_ps(rhs01, rhs01, 0xAA), lhs2));
+		row01 = _mm256_add_ps(row01, _mm256_mul_ps(_mm256_shuffle_ps(rhs01, rhs01, 0xFF), lhs3));
+
+		__m256 row23 = _mm256_mul_ps(_mm256_shuffle_ps(rhs23, rhs23, 0x00), lhs0);
+		row23 = _mm256_add_ps(row23, _mm256_mul_ps(_mm256_shuffle_ps(rhs23, rhs23, 0x55), lhs1));
+		row23 = _mm256_add_ps(row23, _mm256_mul_ps(_mm256_shuffle_ps(rhs23, rhs23, 0xAA), lhs2));
+		row23 = _mm256_add_ps(row23, _mm256_mul_ps(_mm256_shuffle_ps(rhs23, rhs23, 0xFF), lhs3));
+
+		result[0] = _mm256_castps256_ps128(row01);
+		result[1] = _mm256_extractf128_ps(row01, 1);
+		result[2] = _mm256_castps256_ps128(row23);
+		result[3] = _mm256_extractf128_ps(row23, 1);
+#else
+		const __m128 lhsRows[4] = { lhs[0], lhs[1], lhs[2], lhs[3] };
+		const __m128 rhsRows[4] = { rhs[0], rhs[1], rhs[2], rhs[3] };
+		result[0] = Transform(lhsRows, rhsRows[0]);
+		result[1] = Transform(lhsRows, rhsRows[1]);
+		result[2] = Transform(lhsRows, rhsRows[2]);
+		result[3] = Transform(lhsRows, rhsRows[3]);
+#endif
+	}
+
+	FORCE_INLINE void Transpose(const __m128 rows[4], __m128 result[4])
+	{
+		__m128 row0 = rows[0];
+		__m128 row1 = rows[1];
+		__m128 row2 = rows[2];
+		__m128 row3 = rows[3];
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+		result[0] = row0;
+		result[1] = row1;
+		result[2] = row2;
+		result[3] = row3;
+	}
+
+	/// @brief 2x2 matrix multiply 'a * b', each matrix stored row major in one register.
+	FORCE_INLINE __m128 Mat2Mul(const __m128 a, const __m128 b)
+	{
+		return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+	}
+	/// @brief 2x2 matrix multiply 'adjugate(a) * b'.
+	FORCE_INLINE __m128 Mat2AdjMul(const __m128 a, const __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+	}
+	/// @brief 2x2 matrix multiply 'a * adjugate(b)'.
+	FORCE_INLINE __m128 Mat2MulAdj(const __m128 a, const __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+	}
+
+	/// @brief General 4x4 inverse using the 2x2 block form of the adjugate. Like the scalar path the determinant is not
+	/// checked, a singular matrix gives non finite results. 'result' may alias 'rows'.
+	FORCE_INLINE void Inverse(const __m128 rows[4], __m128 result[4])
+	{
+		// 2x2 sub matrices.
+		const __m128 a = _mm_movelh_ps(rows[0], rows[1]);
+		const __m128 b = _mm_movehl_ps(rows[1], rows[0]);
+		const __m128 c = _mm_movelh_ps(rows[2], rows[3]);
+		const __m128 d = _mm_movehl_ps(rows[3], rows[2]);
+
+		// Determinants of the sub matrices as (|a|, |b|, |c|, |d|).
+		const __m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(Shuffle<0, 2, 0, 2>(rows[0], rows[2]), Shuffle<1, 3, 1, 3>(rows[1], rows[3])),
+			_mm_mul_ps(Shuffle<1, 3, 1, 3>(rows[0], rows[2]), Shuffle<0, 2, 0, 2>(rows[1], rows[3])));
+		const __m128 detA = Splat<0>(detSub);
+		const __m128 detB = Splat<1>(detSub);
+		const __m128 detC = Splat<2>(detSub);
+		const __m128 detD = Splat<3>(detSub);
+
+		const __m128 dc = Mat2AdjMul(d, c);
+		const __m128 ab = Mat2AdjMul(a, b);
+
+		__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Mul(b, dc));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Mul(c, ab));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MulAdj(d, ab));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MulAdj(a, dc));
+
+		// |m| = |a||d| + |b||c| - trace(adj(a)b * adj(d)c)
+		__m128 trace = _mm_mul_ps(ab, Swizzle<0, 2, 1, 3>(dc));
+		trace = _mm_hadd_ps(trace, trace);
+		trace = _mm_hadd_ps(trace, trace);
+		__m128 det = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+		det = _mm_sub_ps(det, trace);
+
+		const __m128 reciprocal = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+		x = _mm_mul_ps(x, reciprocal);
+		y = _mm_mul_ps(y, reciprocal);
+		z = _mm_mul_ps(z, reciprocal);
+		w = _mm_mul_ps(w, reciprocal);
+
+		// Apply the adjugate shuffle while writing the rows back.
+		result[0] = Shuffle<3, 1, 3, 1>(x, y);
+		result[1] = Shuffle<2, 0, 2, 0>(x, y);
+		result[2] = Shuffle<3, 1, 3, 1>(z, w);
+		result[3] = Shuffle<2, 0, 2, 0>(z, w);
+	}
+}
+
+#endif
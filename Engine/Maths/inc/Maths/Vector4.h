@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Maths/Defines.h"
+#include "Maths/Simd.h"
 #include "Maths/Vectors/Float4.h"
 #include "Maths/Vectors/Float3.h"
 #include "Maths/Vectors/Float2.h"
@@ -34,6 +35,9 @@ namespace Insight
 			Vec(const DirectX::XMVECTOR& other);
 			Vec(DirectX::XMVECTOR&& other);
 #endif
+#ifdef IS_MATHS_SIMD
+			Vec(const __m128& other);
+#endif
 #if defined(IS_MATHS_GLM) || defined(IS_MATHS_CONSTRUCTOR_GLM) || defined(IS_TESTING)
 			Vec(const glm::vec4& other);
 			Vec(glm::vec4&& other);
@@ -102,6 +106,10 @@ namespace Insight
 #ifdef IS_MATHS_DIRECTX_MATHS
 				struct { DirectX::XMVECTOR xmvector; };
 #endif
+#ifdef IS_MATHS_SIMD
+				// Keeps Vec<4, T> 16 byte aligned so rows can be loaded with aligned loads.
+				struct { __m128 m128; };
+#endif
 #if defined(IS_MATHS_GLM) || defined(IS_MATHS_CONSTRUCTOR_GLM) || defined(IS_TESTING)
 				struct { glm::vec<3, T, glm::defaultp> vec4; };
 #endif
@@ -5,6 +5,7 @@
 
 #include <cmath>
 #include <limits>
+#include <type_traits>
 
 #if defined(IS_MATHS_GLM)
 #include <glm/gtx/norm.hpp>
@@ -153,6 +154,13 @@ namespace Insight
 			xmvector = other;
 		}
 #endif
+#ifdef IS_MATHS_SIMD
+		template<typename T>
+		Vec<4, T>::Vec(const __m128& other)
+		{
+			m128 = other;
+		}
+#endif
 #if defined(IS_MATHS_GLM) || defined(IS_MATHS_CONSTRUCTOR_GLM) || defined(IS_TESTING)
 		template<typename T>
 		Vec<4, T>::Vec(const glm::vec4& other)
@@ -178,6 +186,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return glm::length(vec4);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return _mm_cvtss_f32(_mm_sqrt_ss(Simd::Dot4(m128, m128)));
+			}
+#endif
 			return static_cast<T>(std::sqrt(LengthSquared()));
 #endif
 		}
@@ -189,6 +203,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return glm::length2(vec4);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return _mm_cvtss_f32(Simd::Dot4(m128, m128));
+			}
+#endif
 			return (x * x) + (y * y) + (z * z) + (w * w);
 #endif
 		}
@@ -201,6 +221,18 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			vec4 = glm::normalize(vec4);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				const __m128 lengthSquared = Simd::Dot4(m128, m128);
+				const float lengthSquaredValue = _mm_cvtss_f32(lengthSquared);
+				if (!(lengthSquaredValue == 1.0f) && lengthSquaredValue > 0.0f)
+				{
+					m128 = _mm_mul_ps(m128, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared)));
+				}
+				return *this;
+			}
+#endif
 			const T length_squared = LengthSquared();
 			if (!(length_squared == 1.0f) && length_squared > 0.0f)
 			{
@@ -221,6 +253,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return glm::normalize(vec4);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(*this).Normalise();
+			}
+#endif
 			const auto length_squared = LengthSquared();
 			if (!(length_squared == 1.0f) && length_squared > 0.0f)
 			{
@@ -242,6 +280,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return glm::dot(vec4, other.vec4);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return _mm_cvtss_f32(Simd::Dot4(m128, other.m128));
+			}
+#endif
 			return (x * other.x) + (y * other.y) + (z * other.z) + (w * other.w);
 #endif
 		}
@@ -307,6 +351,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return glm::cross(vec3, vec.vec3);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(Simd::Cross3(m128, vec.m128));
+			}
+#endif
 			const T rX = (y * vec.z) - (z * vec.y);
 			const T rY = (z * vec.x) - (x * vec.z);
 			const T rZ = (x * vec.y) - (y * vec.x);
@@ -322,6 +372,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return -vec4;
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(Simd::Negate(m128));
+			}
+#endif
 			return Vec<4, T>(-x, -y, -z, -w);
 #endif
 		}
@@ -365,6 +421,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return Vec<4, T>(vec4 * scalar);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(_mm_mul_ps(m128, _mm_set1_ps(scalar)));
+			}
+#endif
 			return Vec<4, T>(x * scalar, y * scalar, z * scalar, w * scalar);
 #endif
 		}
@@ -376,6 +438,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return Vec<4, T>(vec4 * other.vec4);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(_mm_mul_ps(m128, other.m128));
+			}
+#endif
 			return Vec<4, T>(x * other.x, y * other.y, z * other.z, w * other.w);
 #endif
 		}
@@ -388,6 +456,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return Vec<4, T>(vec4 / scalar);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(_mm_div_ps(m128, _mm_set1_ps(scalar)));
+			}
+#endif
 			return Vec<4, T>(x / scalar, y / scalar, z / scalar, w / scalar);
 #endif
 		}
@@ -399,6 +473,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return Vec<4, T>(vec4 / other.vec4);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(_mm_div_ps(m128, other.m128));
+			}
+#endif
 			return Vec<4, T>(x / other.x, y / other.y, z / other.z, w / other.w);
 #endif
 		}
@@ -411,6 +491,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return Vec<4, T>(vec4 + scalar);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(_mm_add_ps(m128, _mm_set1_ps(scalar)));
+			}
+#endif
 			return Vec<4, T>(x + scalar, y + scalar, z + scalar, w + scalar);
 #endif
 		}
@@ -422,6 +508,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return Vec<4, T>(vec4 + other.vec4);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(_mm_add_ps(m128, other.m128));
+			}
+#endif
 			return Vec<4, T>(x + other.x, y + other.y, z + other.z, w + other.w);
 #endif
 		}
@@ -434,6 +526,12 @@ namespace Insight
 #elif defined(IS_MATHS_GLM)
 			return Vec<4, T>(vec4 - scalar);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(_mm_sub_ps(m128, _mm_set1_ps(scalar)));
+			}
+#endif
 			return Vec<4, T>(x - scalar, y - scalar, z - scalar, w - scalar);
 #endif
 		}
@@ -445,6 +543,12 @@ namespace Insight
 			#elif defined(IS_MATHS_GLM)
 			return Vec<4, T>(vec4 - other.vec4);
 #else
+#ifdef IS_MATHS_SIMD
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return Vec<4, T>(_mm_sub_ps(m128, other.m128));
+			}
+#endif
 			return Vec<4, T>(x - other.x, y - other.y, z - other.z, w - other.w);
 #endif
 		}
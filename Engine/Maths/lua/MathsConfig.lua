@@ -8,6 +8,7 @@ function MathsConfig.DefinesSharedLib()
         "IS_EXPORT_MATHS_DLL",
         --"IS_MATHS_DIRECTX_MATHS",
         --"IS_MATHS_GLM",
+        --"IS_MATHS_SIMD",
     }
 end
 
@@ -16,6 +17,7 @@ function MathsConfig.DefinesStaticLib()
     {
         --"IS_MATHS_DIRECTX_MATHS",
         --"IS_MATHS_GLM",
+        --"IS_MATHS_SIMD",
     }
 end
 
@@ -62,6 +64,16 @@ function MathsConfig.FilterConfigurations()
     }
 end
 
+-- The batch kernel variants are built for their own instruction set and only called when the CPU supports it,
+-- see Batch::SetInstructionSet.
+function MathsConfig.FilterFiles()
+    filter "files:**/BatchAVX2.cpp"
+        vectorextensions "AVX2"
+    filter "files:**/BatchAVX512.cpp"
+        buildoptions { "/arch:AVX512" }
+    filter { }
+end
+
 function MathsConfig.FilterPlatforms(AMD_Ryzen_Master_SDK, OutputDir)
     filter "platforms:Win64"
         links
@@ -0,0 +1,727 @@
+#include "Maths/Batch.h"
+#include "Maths/Matrix4.h"
+
+#include <algorithm>
+#include <atomic>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+namespace Insight
+{
+	namespace Maths
+	{
+		Vector3SoA Vector3SoA::FromBuffer(float* buffer, const size_t capacity)
+		{
+			Vector3SoA soa;
+			soa.X = buffer;
+			soa.Y = buffer + capacity;
+			soa.Z = buffer + capacity * 2;
+			return soa;
+		}
+
+		Vector3SoA Vector3SoA::Offset(const size_t begin) const
+		{
+			Vector3SoA soa;
+			soa.X = X + begin;
+			soa.Y = Y + begin;
+			soa.Z = Z + begin;
+			return soa;
+		}
+
+		QuaternionSoA QuaternionSoA::FromBuffer(float* buffer, const size_t capacity)
+		{
+			QuaternionSoA soa;
+			soa.W = buffer;
+			soa.X = buffer + capacity;
+			soa.Y = buffer + capacity * 2;
+			soa.Z = buffer + capacity * 3;
+			return soa;
+		}
+
+		Matrix4SoA Matrix4SoA::FromBuffer(float* buffer, const size_t capacity)
+		{
+			Matrix4SoA soa;
+			for (size_t i = 0; i < c_StreamCount; ++i)
+			{
+				soa.M[i] = buffer + capacity * i;
+			}
+			return soa;
+		}
+
+		AABBSoA AABBSoA::Offset(const size_t begin) const
+		{
+			AABBSoA soa;
+			soa.Min = Min.Offset(begin);
+			soa.Max = Max.Offset(begin);
+			return soa;
+		}
+
+		AABBSoA AABBSoA::FromBuffer(float* buffer, const size_t capacity)
+		{
+			AABBSoA soa;
+			soa.Min = Vector3SoA::FromBuffer(buffer, capacity);
+			soa.Max = Vector3SoA::FromBuffer(buffer + capacity * Vector3SoA::c_StreamCount, capacity);
+			return soa;
+		}
+
+		const char* BatchInstructionSetToString(const BatchInstructionSet instructionSet)
+		{
+			switch (instructionSet)
+			{
+			case BatchInstructionSet::Scalar: return "Scalar";
+			case BatchInstructionSet::SSE42:  return "SSE4.2";
+			case BatchInstructionSet::AVX2:   return "AVX2";
+			case BatchInstructionSet::AVX512: return "AVX512";
+			default:
+				break;
+			}
+			return "Unknown";
+		}
+
+		namespace
+		{
+			BatchInstructionSet DetectInstructionSet()
+			{
+#if defined(_M_X64) || defined(__x86_64__)
+				unsigned int leaf1[4] = { };
+				unsigned int leaf7[4] = { };
+#ifdef _MSC_VER
+				__cpuidex(reinterpret_cast<int*>(leaf1), 1, 0);
+				__cpuidex(reinterpret_cast<int*>(leaf7), 7, 0);
+#else
+				__cpuid_count(1, 0, leaf1[0], leaf1[1], leaf1[2], leaf1[3]);
+				__cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+#endif
+				const bool sse42 = (leaf1[2] & (1u << 20)) != 0;
+				const bool osxsave = (leaf1[2] & (1u << 27)) != 0;
+				const bool avx = (leaf1[2] & (1u << 28)) != 0;
+				const bool avx2 = (leaf7[1] & (1u << 5)) != 0;
+				const bool avx512f = (leaf7[1] & (1u << 16)) != 0;
+
+				// The OS must also save the YMM (and for AVX-512 the opmask and ZMM) registers.
+				unsigned long long xcr0 = 0;
+				if (osxsave)
+				{
+#ifdef _MSC_VER
+					xcr0 = _xgetbv(0);
+#else
+					unsigned int eax = 0;
+					unsigned int edx = 0;
+					__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+					xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+				}
+				const bool osYmm = (xcr0 & 0x6) == 0x6;
+				const bool osZmm = (xcr0 & 0xE6) == 0xE6;
+
+				if (avx512f && avx2 && osZmm)
+				{
+					return BatchInstructionSet::AVX512;
+				}
+				if (avx2 && avx && osYmm)
+				{
+					return BatchInstructionSet::AVX2;
+				}
+				if (sse42)
+				{
+					return BatchInstructionSet::SSE42;
+				}
+#endif
+				return BatchInstructionSet::Scalar;
+			}
+
+			const Batch::Detail::KernelTable* c_KernelTables[] =
+			{
+				&Batch::Detail::c_ScalarKernels,
+				&Batch::Detail::c_SSE42Kernels,
+				&Batch::Detail::c_AVX2Kernels,
+				&Batch::Detail::c_AVX512Kernels,
+			};
+			static_assert(ARRAY_COUNT(c_KernelTables) == static_cast<size_t>(BatchInstructionSet::Count));
+
+			/// @brief Walk down from 'requested' to the first instruction set which is supported and compiled in.
+			BatchInstructionSet ResolveInstructionSet(const BatchInstructionSet supported, const BatchInstructionSet requested)
+			{
+				int instructionSet = static_cast<int>(std::min(requested, supported));
+				while (instructionSet > 0
+					&& c_KernelTables[instructionSet]->Multiply == nullptr)
+				{
+					--instructionSet;
+				}
+				return static_cast<BatchInstructionSet>(instructionSet);
+			}
+
+			struct KernelSelection
+			{
+				KernelSelection()
+					: Supported(DetectInstructionSet())
+				{
+					Select(Supported);
+				}
+
+				BatchInstructionSet Select(const BatchInstructionSet requested)
+				{
+					const BatchInstructionSet active = ResolveInstructionSet(Supported, requested);
+					Kernels.store(c_KernelTables[static_cast<int>(active)], std::memory_order_relaxed);
+					Active.store(active, std::memory_order_relaxed);
+					return active;
+				}
+
+				const BatchInstructionSet Supported;
+				std::atomic<BatchInstructionSet> Active = BatchInstructionSet::Scalar;
+				std::atomic<const Batch::Detail::KernelTable*> Kernels = nullptr;
+			};
+
+			KernelSelection& GetKernelSelection()
+			{
+				static KernelSelection selection;
+				return selection;
+			}
+
+			const Batch::Detail::KernelTable& GetKernels()
+			{
+				return *GetKernelSelection().Kernels.load(std::memory_order_relaxed);
+			}
+		}
+
+		namespace Batch
+		{
+			BatchInstructionSet SetInstructionSet(const BatchInstructionSet instructionSet)
+			{
+				return GetKernelSelection().Select(instructionSet);
+			}
+
+			BatchInstructionSet GetInstructionSet()
+			{
+				return GetKernelSelection().Active.load(std::memory_order_relaxed);
+			}
+
+			BatchInstructionSet GetSupportedInstructionSet()
+			{
+				return GetKernelSelection().Supported;
+			}
+
+			bool IsInstructionSetAvailable(const BatchInstructionSet instructionSet)
+			{
+				return instructionSet <= GetSupportedInstructionSet()
+					&& c_KernelTables[static_cast<int>(instructionSet)]->Multiply != nullptr;
+			}
+
+			void Multiply(const Matrix4SoA& lhs, const Matrix4SoA& rhs, const Matrix4SoA& result, const size_t count)
+			{
+				GetKernels().Multiply(lhs, rhs, result, count);
+			}
+
+			void MultiplyParent(const Matrix4& parent, const Matrix4SoA& children, const Matrix4SoA& result, const size_t count)
+			{
+				GetKernels().MultiplyParent(parent.Data(), children, result, count);
+			}
+
+			void TransformAABB(const Matrix4SoA& transforms, const AABBSoA& boxes, const AABBSoA& result, const size_t count)
+			{
+				GetKernels().TransformAABB(transforms, boxes, result, count);
+			}
+
+			void Slerp(const QuaternionSoA& from, const QuaternionSoA& to, const float* time, const QuaternionSoA& result, const size_t count)
+			{
+				GetKernels().Slerp(from, to, time, result, count);
+			}
+
+			void ComposeTRS(const Vector3SoA& translation, const QuaternionSoA& rotation, const Vector3SoA& scale, const Matrix4SoA& result, const size_t count)
+			{
+				GetKernels().ComposeTRS(translation, rotation, scale, result, count);
+			}
+
+			size_t CullAABB(const float* planes, const size_t planeCount, const AABBSoA& boxes, uint32_t* visibleIndices, const uint32_t indexOffset, const size_t count)
+			{
+				return GetKernels().CullAABB(planes, planeCount, boxes, visibleIndices, indexOffset, count);
+			}
+
+			void ToSoA(const Matrix4* matrices, const Matrix4SoA& result, const size_t count)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					const float* data = matrices[i].Data();
+					for (size_t e = 0; e < Matrix4SoA::c_StreamCount; ++e)
+					{
+						result.M[e][i] = data[e];
+					}
+				}
+			}
+
+			void ToAoS(const Matrix4SoA& matrices, Matrix4* result, const size_t count)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					Matrix4& matrix = result[i];
+					for (int row = 0; row < 4; ++row)
+					{
+						for (int column = 0; column < 4; ++column)
+						{
+							matrix[row][column] = matrices.M[row * 4 + column][i];
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+#ifdef IS_TESTING
+#include "Maths/Quaternion.h"
+#include "Maths/MathsUtils.h"
+
+#include "doctest.h"
+
+#include <chrono>
+#include <vector>
+
+namespace test
+{
+	using namespace Insight::Maths;
+
+	TEST_SUITE("Maths Batch")
+	{
+		// Not a multiple of 16, 8 or 4 so every lane width and the scalar remainder are used.
+		constexpr size_t c_Count = 53;
+
+		std::vector<BatchInstructionSet> AvailableInstructionSets()
+		{
+			std::vector<BatchInstructionSet> instructionSets;
+			for (int i = 0; i < static_cast<int>(BatchInstructionSet::Count); ++i)
+			{
+				if (Batch::IsInstructionSetAvailable(static_cast<BatchInstructionSet>(i)))
+				{
+					instructionSets.push_back(static_cast<BatchInstructionSet>(i));
+				}
+			}
+			return instructionSets;
+		}
+
+		float RandomFloat(unsigned int& state, const float range)
+		{
+			state = state * 1664525u + 1013904223u;
+			return (static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f) * range;
+		}
+		Matrix4 RandomMatrix(unsigned int& state)
+		{
+			Matrix4 matrix;
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+				{
+					matrix[i][j] = RandomFloat(state, 10.0f);
+				}
+			}
+			return matrix;
+		}
+		Quaternion RandomQuaternion(unsigned int& state)
+		{
+			const float x = RandomFloat(state, 3.14f);
+			const float y = RandomFloat(state, 3.14f);
+			const float z = RandomFloat(state, 3.14f);
+			return Quaternion(x, y, z).Normalised();
+		}
+		/// @brief 'count' boxes with centers in [-range, range] and extents up to 'range / 20'.
+		void RandomBoxes(unsigned int& state, const AABBSoA& boxes, const size_t count, const float range)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Vector3 center(RandomFloat(state, range), RandomFloat(state, range), RandomFloat(state, range));
+				const Vector3 extent(std::abs(RandomFloat(state, range * 0.05f)), std::abs(RandomFloat(state, range * 0.05f)), std::abs(RandomFloat(state, range * 0.05f)));
+				boxes.Min.X[i] = center.x - extent.x;
+				boxes.Min.Y[i] = center.y - extent.y;
+				boxes.Min.Z[i] = center.z - extent.z;
+				boxes.Max.X[i] = center.x + extent.x;
+				boxes.Max.Y[i] = center.y + extent.y;
+				boxes.Max.Z[i] = center.z + extent.z;
+			}
+		}
+		/// @brief Six planes of a 90 degree frustum looking down +z from the origin, 1 to 'farPlane' units deep.
+		std::vector<float> FrustumPlanes(const float farPlane)
+		{
+			return
+			{
+				0.0f, 0.0f, 1.0f, -1.0f,
+				0.0f, 0.0f, -1.0f, farPlane,
+				1.0f, 0.0f, 1.0f, 0.0f,
+				-1.0f, 0.0f, 1.0f, 0.0f,
+				0.0f, 1.0f, 1.0f, 0.0f,
+				0.0f, -1.0f, 1.0f, 0.0f,
+			};
+		}
+		bool MatrixEqual(const Matrix4& lhs, const Matrix4& rhs, const float relativeError)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+				{
+					if (!Equals(lhs[i][j], rhs[i][j], relativeError * (1.0f + std::abs(rhs[i][j]))))
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		TEST_CASE("Instruction set selection")
+		{
+			const BatchInstructionSet previous = Batch::GetInstructionSet();
+			CHECK(Batch::IsInstructionSetAvailable(BatchInstructionSet::Scalar));
+			CHECK(Batch::SetInstructionSet(BatchInstructionSet::Scalar) == BatchInstructionSet::Scalar);
+			CHECK(Batch::SetInstructionSet(BatchInstructionSet::AVX512) <= Batch::GetSupportedInstructionSet());
+			Batch::SetInstructionSet(previous);
+			MESSAGE("[Maths Batch] Supported: " << BatchInstructionSetToString(Batch::GetSupportedInstructionSet())
+				<< ", active: " << BatchInstructionSetToString(Batch::GetInstructionSet()));
+		}
+
+		TEST_CASE("Multiply")
+		{
+			const BatchInstructionSet previous = Batch::GetInstructionSet();
+			unsigned int state = 1;
+			std::vector<Matrix4> lhs(c_Count);
+			std::vector<Matrix4> rhs(c_Count);
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				lhs[i] = RandomMatrix(state);
+				rhs[i] = RandomMatrix(state);
+			}
+			const Matrix4 parent = RandomMatrix(state);
+
+			std::vector<float> buffer(Matrix4SoA::c_StreamCount * c_Count * 2);
+			const Matrix4SoA lhsSoA = Matrix4SoA::FromBuffer(buffer.data(), c_Count);
+			const Matrix4SoA rhsSoA = Matrix4SoA::FromBuffer(buffer.data() + Matrix4SoA::c_StreamCount * c_Count, c_Count);
+			Batch::ToSoA(rhs.data(), rhsSoA, c_Count);
+
+			std::vector<Matrix4> products(c_Count);
+			Batch::ToSoA(lhs.data(), lhsSoA, c_Count);
+			Batch::ToAoS(lhsSoA, products.data(), c_Count);
+			CHECK(MatrixEqual(products[c_Count - 1], lhs[c_Count - 1], 0.0f));
+
+			for (const BatchInstructionSet instructionSet : AvailableInstructionSets())
+			{
+				Batch::SetInstructionSet(instructionSet);
+
+				int mismatchCount = 0;
+				Batch::MultiplyParent(parent, rhsSoA, lhsSoA, c_Count);
+				Batch::ToAoS(lhsSoA, products.data(), c_Count);
+				for (size_t i = 0; i < c_Count; ++i)
+				{
+					mismatchCount += !MatrixEqual(products[i], parent * rhs[i], 1e-5f);
+				}
+
+				// Output aliasing the input.
+				Batch::ToSoA(lhs.data(), lhsSoA, c_Count);
+				Batch::Multiply(lhsSoA, rhsSoA, lhsSoA, c_Count);
+				Batch::ToAoS(lhsSoA, products.data(), c_Count);
+				for (size_t i = 0; i < c_Count; ++i)
+				{
+					mismatchCount += !MatrixEqual(products[i], lhs[i] * rhs[i], 1e-5f);
+				}
+				CHECK_MESSAGE(mismatchCount == 0, BatchInstructionSetToString(instructionSet));
+			}
+			Batch::SetInstructionSet(previous);
+		}
+
+		TEST_CASE("TransformAABB")
+		{
+			const BatchInstructionSet previous = Batch::GetInstructionSet();
+			unsigned int state = 2;
+			std::vector<Matrix4> transforms(c_Count);
+			std::vector<float> matrixBuffer(Matrix4SoA::c_StreamCount * c_Count);
+			std::vector<float> boxBuffer(AABBSoA::c_StreamCount * c_Count * 2);
+			const Matrix4SoA transformSoA = Matrix4SoA::FromBuffer(matrixBuffer.data(), c_Count);
+			const AABBSoA boxSoA = AABBSoA::FromBuffer(boxBuffer.data(), c_Count);
+			const AABBSoA resultSoA = AABBSoA::FromBuffer(boxBuffer.data() + AABBSoA::c_StreamCount * c_Count, c_Count);
+
+			std::vector<Vector3> mins(c_Count);
+			std::vector<Vector3> maxs(c_Count);
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				transforms[i] = RandomMatrix(state);
+				const Vector3 center(RandomFloat(state, 100.0f), RandomFloat(state, 100.0f), RandomFloat(state, 100.0f));
+				const Vector3 extent(std::abs(RandomFloat(state, 5.0f)), std::abs(RandomFloat(state, 5.0f)), std::abs(RandomFloat(state, 5.0f)));
+				mins[i] = center - extent;
+				maxs[i] = center + extent;
+				boxSoA.Min.X[i] = mins[i].x;
+				boxSoA.Min.Y[i] = mins[i].y;
+				boxSoA.Min.Z[i] = mins[i].z;
+				boxSoA.Max.X[i] = maxs[i].x;
+				boxSoA.Max.Y[i] = maxs[i].y;
+				boxSoA.Max.Z[i] = maxs[i].z;
+			}
+			Batch::ToSoA(transforms.data(), transformSoA, c_Count);
+
+			for (const BatchInstructionSet instructionSet : AvailableInstructionSets())
+			{
+				Batch::SetInstructionSet(instructionSet);
+				Batch::TransformAABB(transformSoA, boxSoA, resultSoA, c_Count);
+
+				int mismatchCount = 0;
+				for (size_t i = 0; i < c_Count; ++i)
+				{
+					// Same as 'BoundingBox::Transform'.
+					const Matrix4& transform = transforms[i];
+					const Vector3 center = transform * Vector4((maxs[i] + mins[i]) * 0.5f, 1.0f);
+					const Vector3 extentOld = (maxs[i] - mins[i]) * 0.5f;
+					const Vector3 extent(
+						std::abs(transform[0][0]) * extentOld.x + std::abs(transform[1][0]) * extentOld.y + std::abs(transform[2][0]) * extentOld.z,
+						std::abs(transform[0][1]) * extentOld.x + std::abs(transform[1][1]) * extentOld.y + std::abs(transform[2][1]) * extentOld.z,
+						std::abs(transform[0][2]) * extentOld.x + std::abs(transform[1][2]) * extentOld.y + std::abs(transform[2][2]) * extentOld.z);
+					const Vector3 min = center - extent;
+					const Vector3 max = center + extent;
+
+					mismatchCount += !Equals(resultSoA.Min.X[i], min.x, 1e-2f) || !Equals(resultSoA.Min.Y[i], min.y, 1e-2f) || !Equals(resultSoA.Min.Z[i], min.z, 1e-2f);
+					mismatchCount += !Equals(resultSoA.Max.X[i], max.x, 1e-2f) || !Equals(resultSoA.Max.Y[i], max.y, 1e-2f) || !Equals(resultSoA.Max.Z[i], max.z, 1e-2f);
+				}
+				CHECK_MESSAGE(mismatchCount == 0, BatchInstructionSetToString(instructionSet));
+			}
+			Batch::SetInstructionSet(previous);
+		}
+
+		TEST_CASE("Slerp")
+		{
+			const BatchInstructionSet previous = Batch::GetInstructionSet();
+			unsigned int state = 3;
+			std::vector<float> buffer(QuaternionSoA::c_StreamCount * c_Count * 3);
+			const QuaternionSoA fromSoA = QuaternionSoA::FromBuffer(buffer.data(), c_Count);
+			const QuaternionSoA toSoA = QuaternionSoA::FromBuffer(buffer.data() + QuaternionSoA::c_StreamCount * c_Count, c_Count);
+			const QuaternionSoA resultSoA = QuaternionSoA::FromBuffer(buffer.data() + QuaternionSoA::c_StreamCount * c_Count * 2, c_Count);
+			std::vector<Quaternion> from(c_Count);
+			std::vector<Quaternion> to(c_Count);
+			std::vector<float> time(c_Count);
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				from[i] = RandomQuaternion(state);
+				// Every few elements interpolate to the same rotation to cover the lerp fallback.
+				to[i] = (i % 5) == 0 ? from[i] : RandomQuaternion(state);
+				time[i] = (RandomFloat(state, 1.0f) + 1.0f) * 0.5f;
+
+				fromSoA.W[i] = from[i].w;
+				fromSoA.X[i] = from[i].x;
+				fromSoA.Y[i] = from[i].y;
+				fromSoA.Z[i] = from[i].z;
+				toSoA.W[i] = to[i].w;
+				toSoA.X[i] = to[i].x;
+				toSoA.Y[i] = to[i].y;
+				toSoA.Z[i] = to[i].z;
+			}
+
+			for (const BatchInstructionSet instructionSet : AvailableInstructionSets())
+			{
+				Batch::SetInstructionSet(instructionSet);
+				Batch::Slerp(fromSoA, toSoA, time.data(), resultSoA, c_Count);
+
+				int mismatchCount = 0;
+				for (size_t i = 0; i < c_Count; ++i)
+				{
+					const Quaternion expected = from[i].Slerp(to[i], time[i]);
+					mismatchCount += !Equals(resultSoA.W[i], expected.w, 1e-5f) || !Equals(resultSoA.X[i], expected.x, 1e-5f)
+						|| !Equals(resultSoA.Y[i], expected.y, 1e-5f) || !Equals(resultSoA.Z[i], expected.z, 1e-5f);
+				}
+				CHECK_MESSAGE(mismatchCount == 0, BatchInstructionSetToString(instructionSet));
+			}
+			Batch::SetInstructionSet(previous);
+		}
+
+		TEST_CASE("ComposeTRS")
+		{
+			const BatchInstructionSet previous = Batch::GetInstructionSet();
+			unsigned int state = 4;
+			std::vector<float> buffer((Vector3SoA::c_StreamCount * 2 + QuaternionSoA::c_StreamCount + Matrix4SoA::c_StreamCount) * c_Count);
+			float* data = buffer.data();
+			const Vector3SoA translationSoA = Vector3SoA::FromBuffer(data, c_Count);
+			data += Vector3SoA::c_StreamCount * c_Count;
+			const QuaternionSoA rotationSoA = QuaternionSoA::FromBuffer(data, c_Count);
+			data += QuaternionSoA::c_StreamCount * c_Count;
+			const Vector3SoA scaleSoA = Vector3SoA::FromBuffer(data, c_Count);
+			data += Vector3SoA::c_StreamCount * c_Count;
+			const Matrix4SoA resultSoA = Matrix4SoA::FromBuffer(data, c_Count);
+
+			std::vector<Matrix4> expected(c_Count);
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				const Vector3 translation(RandomFloat(state, 100.0f), RandomFloat(state, 100.0f), RandomFloat(state, 100.0f));
+				const Quaternion rotation = RandomQuaternion(state);
+				const Vector3 scale(RandomFloat(state, 4.0f), RandomFloat(state, 4.0f), RandomFloat(state, 4.0f));
+
+				translationSoA.X[i] = translation.x;
+				translationSoA.Y[i] = translation.y;
+				translationSoA.Z[i] = translation.z;
+				rotationSoA.W[i] = rotation.w;
+				rotationSoA.X[i] = rotation.x;
+				rotationSoA.Y[i] = rotation.y;
+				rotationSoA.Z[i] = rotation.z;
+				scaleSoA.X[i] = scale.x;
+				scaleSoA.Y[i] = scale.y;
+				scaleSoA.Z[i] = scale.z;
+
+				expected[i] = Matrix4::Identity.Translated(Vector4(translation, 1.0f))
+					* Matrix4(rotation)
+					* Matrix4::Identity.Scaled(Vector4(scale, 1.0f));
+			}
+
+			std::vector<Matrix4> results(c_Count);
+			for (const BatchInstructionSet instructionSet : AvailableInstructionSets())
+			{
+				Batch::SetInstructionSet(instructionSet);
+				Batch::ComposeTRS(translationSoA, rotationSoA, scaleSoA, resultSoA, c_Count);
+				Batch::ToAoS(resultSoA, results.data(), c_Count);
+
+				int mismatchCount = 0;
+				for (size_t i = 0; i < c_Count; ++i)
+				{
+					mismatchCount += !MatrixEqual(results[i], expected[i], 1e-5f);
+				}
+				CHECK_MESSAGE(mismatchCount == 0, BatchInstructionSetToString(instructionSet));
+			}
+			Batch::SetInstructionSet(previous);
+		}
+
+		TEST_CASE("CullAABB")
+		{
+			const BatchInstructionSet previous = Batch::GetInstructionSet();
+			unsigned int state = 6;
+			std::vector<float> buffer(AABBSoA::c_StreamCount * c_Count);
+			const AABBSoA boxes = AABBSoA::FromBuffer(buffer.data(), c_Count);
+			RandomBoxes(state, boxes, c_Count, 20.0f);
+			const std::vector<float> planes = FrustumPlanes(15.0f);
+
+			// Furthest corner test per box and plane.
+			std::vector<uint32_t> expected;
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				bool visible = true;
+				for (size_t planeIdx = 0; planeIdx < 6; ++planeIdx)
+				{
+					const float* plane = &planes[planeIdx * 4];
+					const float x = plane[0] >= 0.0f ? boxes.Max.X[i] : boxes.Min.X[i];
+					const float y = plane[1] >= 0.0f ? boxes.Max.Y[i] : boxes.Min.Y[i];
+					const float z = plane[2] >= 0.0f ? boxes.Max.Z[i] : boxes.Min.Z[i];
+					visible &= plane[0] * x + plane[1] * y + plane[2] * z + plane[3] >= 0.0f;
+				}
+				if (visible)
+				{
+					expected.push_back(static_cast<uint32_t>(i) + 100);
+				}
+			}
+			CHECK(!expected.empty());
+			CHECK(expected.size() < c_Count);
+
+			for (const BatchInstructionSet instructionSet : AvailableInstructionSets())
+			{
+				Batch::SetInstructionSet(instructionSet);
+				std::vector<uint32_t> visible(c_Count);
+				const size_t visibleCount = Batch::CullAABB(planes.data(), 6, boxes, visible.data(), 100, c_Count);
+				visible.resize(visibleCount);
+
+				// The center/extent form can round differently to the corner test for boxes touching a plane.
+				int mismatchCount = 0;
+				for (size_t i = 0; i < c_Count; ++i)
+				{
+					const uint32_t index = static_cast<uint32_t>(i) + 100;
+					mismatchCount += std::binary_search(visible.begin(), visible.end(), index) != std::binary_search(expected.begin(), expected.end(), index);
+				}
+				CHECK_MESSAGE(mismatchCount <= 1, BatchInstructionSetToString(instructionSet));
+				CHECK(std::is_sorted(visible.begin(), visible.end()));
+
+				// Culling in chunks gives the same result as a single call.
+				std::vector<uint32_t> chunked(c_Count);
+				const size_t firstCount = Batch::CullAABB(planes.data(), 6, boxes, chunked.data(), 100, 20);
+				const size_t secondCount = Batch::CullAABB(planes.data(), 6, boxes.Offset(20), chunked.data() + firstCount, 120, c_Count - 20);
+				chunked.resize(firstCount + secondCount);
+				CHECK(chunked == visible);
+
+				// No planes keeps everything.
+				CHECK(Batch::CullAABB(planes.data(), 0, boxes, chunked.data(), 0, c_Count) == c_Count);
+			}
+			Batch::SetInstructionSet(previous);
+		}
+
+		TEST_CASE("Benchmark")
+		{
+			const BatchInstructionSet previous = Batch::GetInstructionSet();
+			constexpr size_t c_BenchmarkCount = 16 * 1024;
+			constexpr int c_Iterations = 32;
+
+			unsigned int state = 5;
+			std::vector<Matrix4> lhs(c_BenchmarkCount);
+			std::vector<Matrix4> rhs(c_BenchmarkCount);
+			std::vector<Matrix4> results(c_BenchmarkCount);
+			for (size_t i = 0; i < c_BenchmarkCount; ++i)
+			{
+				lhs[i] = RandomMatrix(state);
+				rhs[i] = RandomMatrix(state);
+			}
+			std::vector<float> buffer(Matrix4SoA::c_StreamCount * c_BenchmarkCount * 3);
+			const Matrix4SoA lhsSoA = Matrix4SoA::FromBuffer(buffer.data(), c_BenchmarkCount);
+			const Matrix4SoA rhsSoA = Matrix4SoA::FromBuffer(buffer.data() + Matrix4SoA::c_StreamCount * c_BenchmarkCount, c_BenchmarkCount);
+			const Matrix4SoA resultSoA = Matrix4SoA::FromBuffer(buffer.data() + Matrix4SoA::c_StreamCount * c_BenchmarkCount * 2, c_BenchmarkCount);
+			Batch::ToSoA(lhs.data(), lhsSoA, c_BenchmarkCount);
+			Batch::ToSoA(rhs.data(), rhsSoA, c_BenchmarkCount);
+
+			const auto measure = [](auto&& func)
+			{
+				const auto start = std::chrono::high_resolution_clock::now();
+				for (int iteration = 0; iteration < c_Iterations; ++iteration)
+				{
+					func();
+				}
+				const auto end = std::chrono::high_resolution_clock::now();
+				return std::chrono::duration<double, std::nano>(end - start).count() / (c_Iterations * c_BenchmarkCount);
+			};
+
+			const double perElementNs = measure([&]()
+				{
+					for (size_t i = 0; i < c_BenchmarkCount; ++i)
+					{
+						results[i] = lhs[i] * rhs[i];
+					}
+				});
+			MESSAGE("[Maths Batch] Matrix4 multiply per element: " << perElementNs << "ns. Checksum " << results[0][0][0]);
+
+			for (const BatchInstructionSet instructionSet : AvailableInstructionSets())
+			{
+				Batch::SetInstructionSet(instructionSet);
+				const double batchNs = measure([&]()
+					{
+						Batch::Multiply(lhsSoA, rhsSoA, resultSoA, c_BenchmarkCount);
+					});
+				MESSAGE("[Maths Batch] Matrix4 multiply batch " << BatchInstructionSetToString(instructionSet) << ": " << batchNs << "ns ("
+					<< (perElementNs / batchNs) << "x). Checksum " << resultSoA.M[0][0]);
+			}
+
+			const std::vector<float> planes = FrustumPlanes(1000.0f);
+			for (const size_t cullCount : { size_t(10'000), size_t(100'000), size_t(1'000'000) })
+			{
+				std::vector<float> boxBuffer(AABBSoA::c_StreamCount * cullCount);
+				const AABBSoA boxes = AABBSoA::FromBuffer(boxBuffer.data(), cullCount);
+				RandomBoxes(state, boxes, cullCount, 1000.0f);
+				std::vector<uint32_t> visible(cullCount);
+				const int cullIterations = static_cast<int>(std::max<size_t>(1, 4'000'000 / cullCount));
+
+				for (const BatchInstructionSet instructionSet : AvailableInstructionSets())
+				{
+					Batch::SetInstructionSet(instructionSet);
+					size_t visibleCount = 0;
+					const auto start = std::chrono::high_resolution_clock::now();
+					for (int iteration = 0; iteration < cullIterations; ++iteration)
+					{
+						visibleCount = Batch::CullAABB(planes.data(), 6, boxes, visible.data(), 0, cullCount);
+					}
+					const auto end = std::chrono::high_resolution_clock::now();
+					const double cullMs = std::chrono::duration<double, std::milli>(end - start).count() / cullIterations;
+					MESSAGE("[Maths Batch] CullAABB " << cullCount << " boxes " << BatchInstructionSetToString(instructionSet) << ": " << cullMs << "ms ("
+						<< (cullMs * 1'000'000.0 / cullCount) << "ns per box). Visible " << visibleCount);
+				}
+			}
+			Batch::SetInstructionSet(previous);
+		}
+	}
+}
+#endif
@@ -0,0 +1,16 @@
+#include "Maths/Batch.h"
+
+// Built with /arch:AVX2 (-mavx2), see MathsConfig.FilterFiles.
+#if (defined(_MSC_VER) && defined(_M_X64)) || defined(__AVX2__)
+#include <immintrin.h>
+
+#define IS_MATHS_BATCH_FLOAT4
+#define IS_MATHS_BATCH_FLOAT8
+#define IS_MATHS_BATCH_KERNEL_TABLE c_AVX2Kernels
+#include "BatchKernels.inl"
+#else
+namespace Insight::Maths::Batch::Detail
+{
+	const KernelTable c_AVX2Kernels = { };
+}
+#endif
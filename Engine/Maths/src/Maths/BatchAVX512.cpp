@@ -0,0 +1,17 @@
+#include "Maths/Batch.h"
+
+// Built with /arch:AVX512 (-mavx512f), see MathsConfig.FilterFiles.
+#if (defined(_MSC_VER) && defined(_M_X64)) || defined(__AVX512F__)
+#include <immintrin.h>
+
+#define IS_MATHS_BATCH_FLOAT4
+#define IS_MATHS_BATCH_FLOAT8
+#define IS_MATHS_BATCH_FLOAT16
+#define IS_MATHS_BATCH_KERNEL_TABLE c_AVX512Kernels
+#include "BatchKernels.inl"
+#else
+namespace Insight::Maths::Batch::Detail
+{
+	const KernelTable c_AVX512Kernels = { };
+}
+#endif
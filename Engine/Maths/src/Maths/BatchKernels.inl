@@ -0,0 +1,458 @@
+// Batch kernels shared by the 'Batch<InstructionSet>.cpp' files. Each of those defines the lane widths it is compiled
+// for (IS_MATHS_BATCH_FLOAT4, IS_MATHS_BATCH_FLOAT8, IS_MATHS_BATCH_FLOAT16) and the name of its kernel table
+// (IS_MATHS_BATCH_KERNEL_TABLE), then includes this file.
+// Everything except the table has internal linkage. Inline functions shared with other translation units (e.g. from
+// Matrix4.h) must not be used here, the linker could keep the copy built for a wider instruction set.
+
+#include "Maths/Batch.h"
+
+#include <xmmintrin.h>
+
+#include <limits>
+
+namespace Insight
+{
+	namespace Maths
+	{
+		namespace
+		{
+			constexpr float c_FloatEpsilon = std::numeric_limits<float>::epsilon();
+
+			/// @brief Scalar abs and sqrt through SSE intrinsics. std::abs and std::sqrt are inline functions shared with
+			/// other translation units (see the note at the top of this file).
+			float AbsScalar(const float value) { return _mm_cvtss_f32(_mm_andnot_ps(_mm_set_ss(-0.0f), _mm_set_ss(value))); }
+			float SqrtScalar(const float value) { return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(value))); }
+
+			/// @brief Lane types the kernels are written against. Each holds 'Width' floats and provides the same operations
+			/// so a kernel is written once and instantiated for every width.
+			/// 'MoveMask' returns one bit per lane of a mask, lane 0 in bit 0.
+			struct Float1
+			{
+				static constexpr size_t Width = 1;
+				using Mask = bool;
+
+				float V;
+
+				static Float1 Load(const float* ptr) { return { *ptr }; }
+				static Float1 Set(const float value) { return { value }; }
+				static unsigned int MoveMask(const Mask mask) { return mask ? 1u : 0u; }
+				void Store(float* ptr) const { *ptr = V; }
+
+				friend Float1 operator+(const Float1 a, const Float1 b) { return { a.V + b.V }; }
+				friend Float1 operator-(const Float1 a, const Float1 b) { return { a.V - b.V }; }
+				friend Float1 operator*(const Float1 a, const Float1 b) { return { a.V * b.V }; }
+				friend Float1 operator/(const Float1 a, const Float1 b) { return { a.V / b.V }; }
+				friend Mask operator<(const Float1 a, const Float1 b) { return a.V < b.V; }
+				friend Mask operator>(const Float1 a, const Float1 b) { return a.V > b.V; }
+
+				friend Float1 Abs(const Float1 a) { return { AbsScalar(a.V) }; }
+				friend Float1 Sqrt(const Float1 a) { return { SqrtScalar(a.V) }; }
+				friend Float1 Min(const Float1 a, const Float1 b) { return { a.V < b.V ? a.V : b.V }; }
+				friend Float1 Select(const Mask mask, const Float1 ifTrue, const Float1 ifFalse) { return mask ? ifTrue : ifFalse; }
+			};
+
+#ifdef IS_MATHS_BATCH_FLOAT4
+			struct Float4
+			{
+				static constexpr size_t Width = 4;
+				using Mask = Float4;
+
+				__m128 V;
+
+				static Float4 Load(const float* ptr) { return { _mm_loadu_ps(ptr) }; }
+				static Float4 Set(const float value) { return { _mm_set1_ps(value) }; }
+				static unsigned int MoveMask(const Mask mask) { return static_cast<unsigned int>(_mm_movemask_ps(mask.V)); }
+				void Store(float* ptr) const { _mm_storeu_ps(ptr, V); }
+
+				friend Float4 operator+(const Float4 a, const Float4 b) { return { _mm_add_ps(a.V, b.V) }; }
+				friend Float4 operator-(const Float4 a, const Float4 b) { return { _mm_sub_ps(a.V, b.V) }; }
+				friend Float4 operator*(const Float4 a, const Float4 b) { return { _mm_mul_ps(a.V, b.V) }; }
+				friend Float4 operator/(const Float4 a, const Float4 b) { return { _mm_div_ps(a.V, b.V) }; }
+				friend Mask operator<(const Float4 a, const Float4 b) { return { _mm_cmplt_ps(a.V, b.V) }; }
+				friend Mask operator>(const Float4 a, const Float4 b) { return { _mm_cmpgt_ps(a.V, b.V) }; }
+
+				friend Float4 Abs(const Float4 a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.V) }; }
+				friend Float4 Sqrt(const Float4 a) { return { _mm_sqrt_ps(a.V) }; }
+				friend Float4 Min(const Float4 a, const Float4 b) { return { _mm_min_ps(a.V, b.V) }; }
+				friend Float4 Select(const Mask mask, const Float4 ifTrue, const Float4 ifFalse) { return { _mm_blendv_ps(ifFalse.V, ifTrue.V, mask.V) }; }
+			};
+#endif
+
+#ifdef IS_MATHS_BATCH_FLOAT8
+			struct Float8
+			{
+				static constexpr size_t Width = 8;
+				using Mask = Float8;
+
+				__m256 V;
+
+				static Float8 Load(const float* ptr) { return { _mm256_loadu_ps(ptr) }; }
+				static Float8 Set(const float value) { return { _mm256_set1_ps(value) }; }
+				static unsigned int MoveMask(const Mask mask) { return static_cast<unsigned int>(_mm256_movemask_ps(mask.V)); }
+				void Store(float* ptr) const { _mm256_storeu_ps(ptr, V); }
+
+				friend Float8 operator+(const Float8 a, const Float8 b) { return { _mm256_add_ps(a.V, b.V) }; }
+				friend Float8 operator-(const Float8 a, const Float8 b) { return { _mm256_sub_ps(a.V, b.V) }; }
+				friend Float8 operator*(const Float8 a, const Float8 b) { return { _mm256_mul_ps(a.V, b.V) }; }
+				friend Float8 operator/(const Float8 a, const Float8 b) { return { _mm256_div_ps(a.V, b.V) }; }
+				friend Mask operator<(const Float8 a, const Float8 b) { return { _mm256_cmp_ps(a.V, b.V, _CMP_LT_OQ) }; }
+				friend Mask operator>(const Float8 a, const Float8 b) { return { _mm256_cmp_ps(a.V, b.V, _CMP_GT_OQ) }; }
+
+				friend Float8 Abs(const Float8 a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.V) }; }
+				friend Float8 Sqrt(const Float8 a) { return { _mm256_sqrt_ps(a.V) }; }
+				friend Float8 Min(const Float8 a, const Float8 b) { return { _mm256_min_ps(a.V, b.V) }; }
+				friend Float8 Select(const Mask mask, const Float8 ifTrue, const Float8 ifFalse) { return { _mm256_blendv_ps(ifFalse.V, ifTrue.V, mask.V) }; }
+			};
+#endif
+
+#ifdef IS_MATHS_BATCH_FLOAT16
+			struct Float16
+			{
+				static constexpr size_t Width = 16;
+				using Mask = __mmask16;
+
+				__m512 V;
+
+				static Float16 Load(const float* ptr) { return { _mm512_loadu_ps(ptr) }; }
+				static Float16 Set(const float value) { return { _mm512_set1_ps(value) }; }
+				static unsigned int MoveMask(const Mask mask) { return static_cast<unsigned int>(mask); }
+				void Store(float* ptr) const { _mm512_storeu_ps(ptr, V); }
+
+				friend Float16 operator+(const Float16 a, const Float16 b) { return { _mm512_add_ps(a.V, b.V) }; }
+				friend Float16 operator-(const Float16 a, const Float16 b) { return { _mm512_sub_ps(a.V, b.V) }; }
+				friend Float16 operator*(const Float16 a, const Float16 b) { return { _mm512_mul_ps(a.V, b.V) }; }
+				friend Float16 operator/(const Float16 a, const Float16 b) { return { _mm512_div_ps(a.V, b.V) }; }
+				friend Mask operator<(const Float16 a, const Float16 b) { return _mm512_cmp_ps_mask(a.V, b.V, _CMP_LT_OQ); }
+				friend Mask operator>(const Float16 a, const Float16 b) { return _mm512_cmp_ps_mask(a.V, b.V, _CMP_GT_OQ); }
+
+				friend Float16 Abs(const Float16 a) { return { _mm512_abs_ps(a.V) }; }
+				friend Float16 Sqrt(const Float16 a) { return { _mm512_sqrt_ps(a.V) }; }
+				friend Float16 Min(const Float16 a, const Float16 b) { return { _mm512_min_ps(a.V, b.V) }; }
+				friend Float16 Select(const Mask mask, const Float16 ifTrue, const Float16 ifFalse) { return { _mm512_mask_blend_ps(mask, ifFalse.V, ifTrue.V) }; }
+			};
+#endif
+
+			/// @brief sin(x) for x in [0, pi / 2], Taylor series to x^11. Error is below 6e-8.
+			template<typename F>
+			F SinQuadrant(const F x)
+			{
+				const F x2 = x * x;
+				F result = F::Set(-2.5052108385e-8f);
+				result = result * x2 + F::Set(2.7557319224e-6f);
+				result = result * x2 - F::Set(1.9841269841e-4f);
+				result = result * x2 + F::Set(8.3333333333e-3f);
+				result = result * x2 - F::Set(1.6666666667e-1f);
+				result = result * x2 + F::Set(1.0f);
+				return result * x;
+			}
+
+			/// @brief acos(x) for x in [0, 1], Abramowitz and Stegun 4.4.46. Error is below 2e-8.
+			template<typename F>
+			F AcosPositive(const F x)
+			{
+				F result = F::Set(-0.0012624911f);
+				result = result * x + F::Set(0.0066700901f);
+				result = result * x - F::Set(0.0170881256f);
+				result = result * x + F::Set(0.0308918810f);
+				result = result * x - F::Set(0.0501743046f);
+				result = result * x + F::Set(0.0889789874f);
+				result = result * x - F::Set(0.2145988016f);
+				result = result * x + F::Set(1.5707963050f);
+				return result * Sqrt(F::Set(1.0f) - x);
+			}
+
+			/// @brief Each kernel processes whole lanes from 'begin' and returns the index of the first element left over.
+			template<typename F>
+			size_t MultiplyKernel(const Matrix4SoA& lhs, const Matrix4SoA& rhs, const Matrix4SoA& result, size_t begin, const size_t count)
+			{
+				for (; begin + F::Width <= count; begin += F::Width)
+				{
+					F l[16];
+					F r[16];
+					for (int e = 0; e < 16; ++e)
+					{
+						l[e] = F::Load(lhs.M[e] + begin);
+						r[e] = F::Load(rhs.M[e] + begin);
+					}
+					for (int i = 0; i < 4; ++i)
+					{
+						for (int j = 0; j < 4; ++j)
+						{
+							const F value = (r[i * 4 + 0] * l[0 + j]) + (r[i * 4 + 1] * l[4 + j]) + (r[i * 4 + 2] * l[8 + j]) + (r[i * 4 + 3] * l[12 + j]);
+							value.Store(result.M[i * 4 + j] + begin);
+						}
+					}
+				}
+				return begin;
+			}
+
+			template<typename F>
+			size_t MultiplyParentKernel(const float* parent, const Matrix4SoA& children, const Matrix4SoA& result, size_t begin, const size_t count)
+			{
+				F l[16];
+				for (int e = 0; e < 16; ++e)
+				{
+					l[e] = F::Set(parent[e]);
+				}
+
+				for (; begin + F::Width <= count; begin += F::Width)
+				{
+					F r[16];
+					for (int e = 0; e < 16; ++e)
+					{
+						r[e] = F::Load(children.M[e] + begin);
+					}
+					for (int i = 0; i < 4; ++i)
+					{
+						for (int j = 0; j < 4; ++j)
+						{
+							const F value = (r[i * 4 + 0] * l[0 + j]) + (r[i * 4 + 1] * l[4 + j]) + (r[i * 4 + 2] * l[8 + j]) + (r[i * 4 + 3] * l[12 + j]);
+							value.Store(result.M[i * 4 + j] + begin);
+						}
+					}
+				}
+				return begin;
+			}
+
+			template<typename F>
+			size_t TransformAABBKernel(const Matrix4SoA& transforms, const AABBSoA& boxes, const AABBSoA& result, size_t begin, const size_t count)
+			{
+				const F half = F::Set(0.5f);
+				for (; begin + F::Width <= count; begin += F::Width)
+				{
+					const F minX = F::Load(boxes.Min.X + begin);
+					const F minY = F::Load(boxes.Min.Y + begin);
+					const F minZ = F::Load(boxes.Min.Z + begin);
+					const F maxX = F::Load(boxes.Max.X + begin);
+					const F maxY = F::Load(boxes.Max.Y + begin);
+					const F maxZ = F::Load(boxes.Max.Z + begin);
+
+					const F centerX = (maxX + minX) * half;
+					const F centerY = (maxY + minY) * half;
+					const F centerZ = (maxZ + minZ) * half;
+					const F extentX = (maxX - minX) * half;
+					const F extentY = (maxY - minY) * half;
+					const F extentZ = (maxZ - minZ) * half;
+
+					float* const outMin[3] = { result.Min.X + begin, result.Min.Y + begin, result.Min.Z + begin };
+					float* const outMax[3] = { result.Max.X + begin, result.Max.Y + begin, result.Max.Z + begin };
+					for (int j = 0; j < 3; ++j)
+					{
+						const F m0 = F::Load(transforms.M[0 + j] + begin);
+						const F m1 = F::Load(transforms.M[4 + j] + begin);
+						const F m2 = F::Load(transforms.M[8 + j] + begin);
+						const F m3 = F::Load(transforms.M[12 + j] + begin);
+
+						const F center = (m0 * centerX) + (m1 * centerY) + (m2 * centerZ) + m3;
+						const F extent = (Abs(m0) * extentX) + (Abs(m1) * extentY) + (Abs(m2) * extentZ);
+						(center - extent).Store(outMin[j]);
+						(center + extent).Store(outMax[j]);
+					}
+				}
+				return begin;
+			}
+
+			template<typename F>
+			size_t SlerpKernel(const QuaternionSoA& from, const QuaternionSoA& to, const float* time, const QuaternionSoA& result, size_t begin, const size_t count)
+			{
+				const F zero = F::Set(0.0f);
+				const F one = F::Set(1.0f);
+				const F lerpThreshold = F::Set(1.0f - c_FloatEpsilon);
+				for (; begin + F::Width <= count; begin += F::Width)
+				{
+					const F fromW = F::Load(from.W + begin);
+					const F fromX = F::Load(from.X + begin);
+					const F fromY = F::Load(from.Y + begin);
+					const F fromZ = F::Load(from.Z + begin);
+					F toW = F::Load(to.W + begin);
+					F toX = F::Load(to.X + begin);
+					F toY = F::Load(to.Y + begin);
+					F toZ = F::Load(to.Z + begin);
+					const F t = F::Load(time + begin);
+
+					F cosTheta = (fromW * toW + fromX * toX) + (fromY * toY + fromZ * toZ);
+
+					// Take the short way around the sphere.
+					const F sign = Select(cosTheta < zero, zero - one, one);
+					toW = toW * sign;
+					toX = toX * sign;
+					toY = toY * sign;
+					toZ = toZ * sign;
+					cosTheta = Min(cosTheta * sign, one);
+
+					const F angle = AcosPositive(cosTheta);
+					const F inverseSinAngle = one / SinQuadrant(angle);
+					const F oneMinusT = one - t;
+
+					// Lerp where sin(angle) gets close to 0, the same as 'Quaternion::Slerp'.
+					const typename F::Mask useLerp = cosTheta > lerpThreshold;
+					const F fromWeight = Select(useLerp, oneMinusT, SinQuadrant(oneMinusT * angle) * inverseSinAngle);
+					const F toWeight = Select(useLerp, t, SinQuadrant(t * angle) * inverseSinAngle);
+
+					(fromW * fromWeight + toW * toWeight).Store(result.W + begin);
+					(fromX * fromWeight + toX * toWeight).Store(result.X + begin);
+					(fromY * fromWeight + toY * toWeight).Store(result.Y + begin);
+					(fromZ * fromWeight + toZ * toWeight).Store(result.Z + begin);
+				}
+				return begin;
+			}
+
+			template<typename F>
+			size_t ComposeTRSKernel(const Vector3SoA& translation, const QuaternionSoA& rotation, const Vector3SoA& scale, const Matrix4SoA& result, size_t begin, const size_t count)
+			{
+				const F zero = F::Set(0.0f);
+				const F one = F::Set(1.0f);
+				const F two = F::Set(2.0f);
+				for (; begin + F::Width <= count; begin += F::Width)
+				{
+					const F qw = F::Load(rotation.W + begin);
+					const F qx = F::Load(rotation.X + begin);
+					const F qy = F::Load(rotation.Y + begin);
+					const F qz = F::Load(rotation.Z + begin);
+					const F sx = F::Load(scale.X + begin);
+					const F sy = F::Load(scale.Y + begin);
+					const F sz = F::Load(scale.Z + begin);
+
+					const F qxx = qx * qx;
+					const F qyy = qy * qy;
+					const F qzz = qz * qz;
+					const F qxz = qx * qz;
+					const F qxy = qx * qy;
+					const F qyz = qy * qz;
+					const F qwx = qw * qx;
+					const F qwy = qw * qy;
+					const F qwz = qw * qz;
+
+					// Rotation rows as built by 'Matrix3(const Quaternion&)', each scaled by its axis.
+					(sx * (one - two * (qyy + qzz))).Store(result.M[0] + begin);
+					(sx * (two * (qxy + qwz))).Store(result.M[1] + begin);
+					(sx * (two * (qxz - qwy))).Store(result.M[2] + begin);
+					zero.Store(result.M[3] + begin);
+
+					(sy * (two * (qxy - qwz))).Store(result.M[4] + begin);
+					(sy * (one - two * (qxx + qzz))).Store(result.M[5] + begin);
+					(sy * (two * (qyz + qwx))).Store(result.M[6] + begin);
+					zero.Store(result.M[7] + begin);
+
+					(sz * (two * (qxz + qwy))).Store(result.M[8] + begin);
+					(sz * (two * (qyz - qwx))).Store(result.M[9] + begin);
+					(sz * (one - two * (qxx + qyy))).Store(result.M[10] + begin);
+					zero.Store(result.M[11] + begin);
+
+					F::Load(translation.X + begin).Store(result.M[12] + begin);
+					F::Load(translation.Y + begin).Store(result.M[13] + begin);
+					F::Load(translation.Z + begin).Store(result.M[14] + begin);
+					one.Store(result.M[15] + begin);
+				}
+				return begin;
+			}
+
+			template<typename F>
+			size_t CullAABBKernel(const float* planes, const size_t planeCount, const AABBSoA& boxes, uint32_t* visibleIndices, const uint32_t indexOffset
+				, size_t& visibleCount, size_t begin, const size_t count)
+			{
+				const F zero = F::Set(0.0f);
+				const F half = F::Set(0.5f);
+				for (; begin + F::Width <= count; begin += F::Width)
+				{
+					const F minX = F::Load(boxes.Min.X + begin);
+					const F minY = F::Load(boxes.Min.Y + begin);
+					const F minZ = F::Load(boxes.Min.Z + begin);
+					const F maxX = F::Load(boxes.Max.X + begin);
+					const F maxY = F::Load(boxes.Max.Y + begin);
+					const F maxZ = F::Load(boxes.Max.Z + begin);
+
+					const F centerX = (maxX + minX) * half;
+					const F centerY = (maxY + minY) * half;
+					const F centerZ = (maxZ + minZ) * half;
+					const F extentX = (maxX - minX) * half;
+					const F extentY = (maxY - minY) * half;
+					const F extentZ = (maxZ - minZ) * half;
+
+					unsigned int outside = 0;
+					for (size_t planeIdx = 0; planeIdx < planeCount; ++planeIdx)
+					{
+						const float* plane = planes + planeIdx * 4;
+						// Signed distance of the corner furthest along the plane normal.
+						const F distance = (F::Set(plane[0]) * centerX + F::Set(plane[1]) * centerY + F::Set(plane[2]) * centerZ + F::Set(plane[3]))
+							+ (F::Set(AbsScalar(plane[0])) * extentX + F::Set(AbsScalar(plane[1])) * extentY + F::Set(AbsScalar(plane[2])) * extentZ);
+						outside |= F::MoveMask(distance < zero);
+					}
+
+					// Every lane writes its index but only kept lanes move the cursor, so there is no branch per box.
+					for (size_t lane = 0; lane < F::Width; ++lane)
+					{
+						visibleIndices[visibleCount] = indexOffset + static_cast<uint32_t>(begin + lane);
+						visibleCount += ((outside >> lane) & 1u) ^ 1u;
+					}
+				}
+				return begin;
+			}
+
+			/// @brief Call 'kernel' with the widest lanes compiled in, then narrower ones for what is left over.
+			template<typename Kernel>
+			void Run(const Kernel& kernel)
+			{
+				size_t next = 0;
+#ifdef IS_MATHS_BATCH_FLOAT16
+				next = kernel(Float16{ }, next);
+#endif
+#ifdef IS_MATHS_BATCH_FLOAT8
+				next = kernel(Float8{ }, next);
+#endif
+#ifdef IS_MATHS_BATCH_FLOAT4
+				next = kernel(Float4{ }, next);
+#endif
+				kernel(Float1{ }, next);
+			}
+
+			void BatchMultiply(const Matrix4SoA& lhs, const Matrix4SoA& rhs, const Matrix4SoA& result, const size_t count)
+			{
+				Run([&](auto lane, const size_t begin) { return MultiplyKernel<decltype(lane)>(lhs, rhs, result, begin, count); });
+			}
+
+			void BatchMultiplyParent(const float* parent, const Matrix4SoA& children, const Matrix4SoA& result, const size_t count)
+			{
+				Run([&](auto lane, const size_t begin) { return MultiplyParentKernel<decltype(lane)>(parent, children, result, begin, count); });
+			}
+
+			void BatchTransformAABB(const Matrix4SoA& transforms, const AABBSoA& boxes, const AABBSoA& result, const size_t count)
+			{
+				Run([&](auto lane, const size_t begin) { return TransformAABBKernel<decltype(lane)>(transforms, boxes, result, begin, count); });
+			}
+
+			void BatchSlerp(const QuaternionSoA& from, const QuaternionSoA& to, const float* time, const QuaternionSoA& result, const size_t count)
+			{
+				Run([&](auto lane, const size_t begin) { return SlerpKernel<decltype(lane)>(from, to, time, result, begin, count); });
+			}
+
+			void BatchComposeTRS(const Vector3SoA& translation, const QuaternionSoA& rotation, const Vector3SoA& scale, const Matrix4SoA& result, const size_t count)
+			{
+				Run([&](auto lane, const size_t begin) { return ComposeTRSKernel<decltype(lane)>(translation, rotation, scale, result, begin, count); });
+			}
+
+			size_t BatchCullAABB(const float* planes, const size_t planeCount, const AABBSoA& boxes, uint32_t* visibleIndices, const uint32_t indexOffset, const size_t count)
+			{
+				size_t visibleCount = 0;
+				Run([&](auto lane, const size_t begin) { return CullAABBKernel<decltype(lane)>(planes, planeCount, boxes, visibleIndices, indexOffset, visibleCount, begin, count); });
+				return visibleCount;
+			}
+		}
+
+		namespace Batch
+		{
+			namespace Detail
+			{
+				const KernelTable IS_MATHS_BATCH_KERNEL_TABLE =
+				{
+					&BatchMultiply,
+					&BatchMultiplyParent,
+					&BatchTransformAABB,
+					&BatchSlerp,
+					&BatchComposeTRS,
+					&BatchCullAABB,
+				};
+			}
+		}
+	}
+}
@@ -0,0 +1,15 @@
+#include "Maths/Batch.h"
+
+// MSVC allows SSE4.2 intrinsics on any x64 target, other compilers need it enabled for this file (-msse4.2).
+#if (defined(_MSC_VER) && defined(_M_X64)) || defined(__SSE4_2__)
+#include <nmmintrin.h>
+
+#define IS_MATHS_BATCH_FLOAT4
+#define IS_MATHS_BATCH_KERNEL_TABLE c_SSE42Kernels
+#include "BatchKernels.inl"
+#else
+namespace Insight::Maths::Batch::Detail
+{
+	const KernelTable c_SSE42Kernels = { };
+}
+#endif
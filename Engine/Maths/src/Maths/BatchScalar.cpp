@@ -0,0 +1,2 @@
+#define IS_MATHS_BATCH_KERNEL_TABLE c_ScalarKernels
+#include "BatchKernels.inl"
@@ -132,6 +132,8 @@ namespace Insight
 			xmmatrix = DirectX::XMMatrixInverse(&determinant, xmmatrix);
 #elif defined(IS_MATHS_GLM)
 			mat4 = glm::inverse(mat4);
+#elif defined(IS_MATHS_SIMD)
+			Simd::Inverse(m128, m128);
 #else
 			Matrix4 tran = Transposed();
 
@@ -237,6 +239,8 @@ namespace Insight
 			xmmatrix = DirectX::XMMatrixTranspose(xmmatrix);
 #elif defined(IS_MATHS_GLM)
 			mat4 = glm::transpose(mat4);
+#elif defined(IS_MATHS_SIMD)
+			Simd::Transpose(m128, m128);
 #else
 			Matrix4 tran(
 				m_00, m_10, m_20, m_30,
@@ -681,6 +685,10 @@ else                            \
 			return Matrix4(DirectX::XMMatrixMultiply(other.xmmatrix, xmmatrix));
 #elif defined(IS_MATHS_GLM)
 			return mat4 * other.mat4;
+#elif defined(IS_MATHS_SIMD)
+			Matrix4 m;
+			Simd::Multiply(m128, other.m128, m.m128);
+			return m;
 #else
 			Matrix4 m;
 
@@ -729,6 +737,8 @@ else                            \
 			return DirectX::XMVector4Transform(other.xmvector, xmmatrix);
 #elif defined(IS_MATHS_GLM)
 			return mat4 * other.vec4;
+#elif defined(IS_MATHS_SIMD)
+			return Vector4(Simd::Transform(m128, other.m128));
 #else
 			const float x = (m_00 * other.x) + (m_10 * other.y) + (m_20 * other.z) + (m_30 * other.w);
 			const float y = (m_01 * other.x) + (m_11 * other.y) + (m_21 * other.z) + (m_31 * other.w);
@@ -0,0 +1,862 @@
+#include "Maths/Packed.h"
+#include "Maths/Quaternion.h"
+#include "Maths/Vector3.h"
+#include "Maths/Vector4.h"
+
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define IS_MATHS_PACKING_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Insight
+{
+	namespace Maths
+	{
+		static_assert(sizeof(Half) == 2 && sizeof(SNorm8) == 1 && sizeof(SNorm16) == 2, "Packed types must be the size of their storage.");
+		static_assert(sizeof(OctahedralNormal) == 4 && sizeof(PackedQuaternion) == 6 && sizeof(UNorm1010102) == 4, "Packed types must be the size of their storage.");
+
+		namespace
+		{
+			uint32_t FloatBits(const float value)
+			{
+				uint32_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				return bits;
+			}
+
+			float BitsToFloat(const uint32_t bits)
+			{
+				float value;
+				std::memcpy(&value, &bits, sizeof(value));
+				return value;
+			}
+
+			// Float/half conversions after Fabian Giesen's branchless versions, the SSE2 paths below use the same
+			// steps so both give identical results.
+			constexpr uint32_t c_HalfMaxAsFloat = (127 + 16) << 23;
+			constexpr uint32_t c_HalfMinNormalAsFloat = (127 - 14) << 23;
+			constexpr uint32_t c_HalfSubnormalMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+			constexpr uint32_t c_HalfNormalBias = 0xFFF - ((127 - 15) << 23);
+			constexpr uint32_t c_FloatInfinity = 255 << 23;
+			/// @brief 2^112, moves a half exponent into float range.
+			constexpr uint32_t c_HalfToFloatMagic = (254 - 15) << 23;
+
+			uint16_t FloatToHalf(const float value)
+			{
+				const uint32_t bits = FloatBits(value);
+				const uint32_t sign = bits & 0x80000000u;
+				const uint32_t absolute = bits ^ sign;
+
+				uint32_t result;
+				if (absolute >= c_HalfMaxAsFloat)
+				{
+					// Too large, infinity or NaN.
+					result = absolute > c_FloatInfinity ? 0x7E00 : 0x7C00;
+				}
+				else if (absolute < c_HalfMinNormalAsFloat)
+				{
+					// Subnormal half, let the float add do the rounding.
+					result = FloatBits(BitsToFloat(absolute) + BitsToFloat(c_HalfSubnormalMagic)) - c_HalfSubnormalMagic;
+				}
+				else
+				{
+					const uint32_t mantissaOdd = (absolute >> 13) & 1;
+					result = (absolute + c_HalfNormalBias + mantissaOdd) >> 13;
+				}
+				return static_cast<uint16_t>(result | (sign >> 16));
+			}
+
+			float HalfToFloat(const uint16_t value)
+			{
+				const uint32_t exponentMantissa = value & 0x7FFFu;
+				uint32_t bits = FloatBits(BitsToFloat(exponentMantissa << 13) * BitsToFloat(c_HalfToFloatMagic));
+				if (exponentMantissa > 0x7BFF)
+				{
+					bits |= c_FloatInfinity;
+				}
+				return BitsToFloat(bits | (static_cast<uint32_t>(value & 0x8000u) << 16));
+			}
+
+			void EncodeOctahedral(const float x, const float y, const float z, OctahedralNormal& result)
+			{
+				const float inverseLength = 1.0f / (std::abs(x) + std::abs(y) + std::abs(z));
+				float octX = x * inverseLength;
+				float octY = y * inverseLength;
+				if (z < 0.0f)
+				{
+					// Fold the lower hemisphere over the diagonals.
+					const float foldedX = (1.0f - std::abs(octY)) * std::copysign(1.0f, octX);
+					octY = (1.0f - std::abs(octX)) * std::copysign(1.0f, octY);
+					octX = foldedX;
+				}
+				result.X = SNorm16::Encode(octX);
+				result.Y = SNorm16::Encode(octY);
+			}
+
+			void DecodeOctahedral(const OctahedralNormal& value, float* result)
+			{
+				float x = SNorm16::Decode(value.X);
+				float y = SNorm16::Decode(value.Y);
+				const float z = (1.0f - std::abs(x)) - std::abs(y);
+				const float unfold = std::max(-z, 0.0f);
+				x -= std::copysign(unfold, x);
+				y -= std::copysign(unfold, y);
+
+				const float length = std::sqrt((x * x + y * y) + z * z);
+				result[0] = x / length;
+				result[1] = y / length;
+				result[2] = z / length;
+			}
+
+			/// @brief The three smallest components of a unit quaternion are within +-1/sqrt(2).
+			constexpr float c_QuaternionRange = 0.707106781f;
+			constexpr float c_QuaternionScale = 32767.0f;
+
+			void EncodeQuaternion(const float* q, PackedQuaternion& result)
+			{
+				int largest = 0;
+				for (int i = 1; i < 4; ++i)
+				{
+					if (std::abs(q[i]) > std::abs(q[largest]))
+					{
+						largest = i;
+					}
+				}
+				const float sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+				uint16_t components[3];
+				for (int i = 0, component = 0; i < 4; ++i)
+				{
+					if (i == largest)
+					{
+						continue;
+					}
+					const float normalised = std::min(std::max(q[i] * sign / c_QuaternionRange, -1.0f), 1.0f);
+					components[component++] = static_cast<uint16_t>(std::nearbyint((normalised * 0.5f + 0.5f) * c_QuaternionScale));
+				}
+
+				result.Data[0] = static_cast<uint16_t>(components[0] | ((largest & 1) << 15));
+				result.Data[1] = static_cast<uint16_t>(components[1] | ((largest >> 1) << 15));
+				result.Data[2] = components[2];
+			}
+
+			void DecodeQuaternion(const PackedQuaternion& value, float* q)
+			{
+				const int largest = (value.Data[0] >> 15) | ((value.Data[1] >> 15) << 1);
+
+				float sumSquared = 0.0f;
+				for (int i = 0, component = 0; i < 4; ++i)
+				{
+					if (i == largest)
+					{
+						continue;
+					}
+					const float normalised = static_cast<float>(value.Data[component++] & 0x7FFF) / c_QuaternionScale;
+					q[i] = (normalised * 2.0f - 1.0f) * c_QuaternionRange;
+					sumSquared += q[i] * q[i];
+				}
+				q[largest] = std::sqrt(std::max(1.0f - sumSquared, 0.0f));
+			}
+
+			uint32_t EncodeUNorm1010102(const float* value)
+			{
+				const auto encode = [](const float v, const float scale)
+				{
+					return static_cast<uint32_t>(std::nearbyint(std::min(std::max(v, 0.0f), 1.0f) * scale));
+				};
+				return encode(value[0], 1023.0f)
+					| (encode(value[1], 1023.0f) << 10)
+					| (encode(value[2], 1023.0f) << 20)
+					| (encode(value[3], 3.0f) << 30);
+			}
+
+			void DecodeUNorm1010102(const uint32_t value, float* result)
+			{
+				result[0] = static_cast<float>(value & 0x3FF) / 1023.0f;
+				result[1] = static_cast<float>((value >> 10) & 0x3FF) / 1023.0f;
+				result[2] = static_cast<float>((value >> 20) & 0x3FF) / 1023.0f;
+				result[3] = static_cast<float>(value >> 30) / 3.0f;
+			}
+
+#ifdef IS_MATHS_PACKING_SSE2
+			__m128i Select(const __m128i mask, const __m128i a, const __m128i b)
+			{
+				return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+			}
+
+			/// @brief Four floats to halves in the low 16 bits of each lane.
+			__m128i FloatToHalf4(const __m128 value)
+			{
+				const __m128i sign = _mm_and_si128(_mm_castps_si128(value), _mm_set1_epi32(static_cast<int>(0x80000000u)));
+				const __m128i absolute = _mm_xor_si128(_mm_castps_si128(value), sign);
+
+				const __m128i isNaN = _mm_cmpgt_epi32(absolute, _mm_set1_epi32(c_FloatInfinity));
+				const __m128i isRegular = _mm_cmpgt_epi32(_mm_set1_epi32(c_HalfMaxAsFloat), absolute);
+				const __m128i isSubnormal = _mm_cmpgt_epi32(_mm_set1_epi32(c_HalfMinNormalAsFloat), absolute);
+				const __m128i infinityOrNaN = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+
+				const __m128i magic = _mm_set1_epi32(c_HalfSubnormalMagic);
+				const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(absolute), _mm_castsi128_ps(magic))), magic);
+
+				const __m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(absolute, 13), _mm_set1_epi32(1));
+				const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(absolute, _mm_set1_epi32(c_HalfNormalBias)), mantissaOdd), 13);
+
+				const __m128i finite = Select(isSubnormal, subnormal, normal);
+				return _mm_or_si128(Select(isRegular, finite, infinityOrNaN), _mm_srli_epi32(sign, 16));
+			}
+
+			/// @brief Halves in the low 16 bits of each lane to four floats.
+			__m128 HalfToFloat4(const __m128i value)
+			{
+				const __m128i exponentMantissa = _mm_and_si128(value, _mm_set1_epi32(0x7FFF));
+				const __m128i sign = _mm_slli_epi32(_mm_xor_si128(value, exponentMantissa), 16);
+				const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), _mm_castsi128_ps(_mm_set1_epi32(c_HalfToFloatMagic)));
+				const __m128i infinityOrNaN = _mm_and_si128(_mm_cmpgt_epi32(exponentMantissa, _mm_set1_epi32(0x7BFF)), _mm_set1_epi32(c_FloatInfinity));
+				return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(sign, infinityOrNaN)));
+			}
+
+			/// @brief Clamp, scale and round four floats like 'NormalisedInteger<T>::Encode'.
+			template<typename T>
+			__m128i EncodeNormalised4(const __m128 value)
+			{
+				using Norm = NormalisedInteger<T>;
+				const __m128 clamped = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(Norm::c_Min)), _mm_set1_ps(1.0f));
+				// Rounds to nearest even with the default MXCSR, the same as std::nearbyint.
+				return _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(Norm::c_Scale)));
+			}
+
+			template<typename T>
+			__m128 DecodeNormalised4(const __m128i value)
+			{
+				using Norm = NormalisedInteger<T>;
+				return _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(Norm::c_Scale)), _mm_set1_ps(Norm::c_Min));
+			}
+
+			/// @brief Copy the sign of 'sign' onto 'value'.
+			__m128 CopySign(const __m128 value, const __m128 sign)
+			{
+				const __m128 signMask = _mm_set1_ps(-0.0f);
+				return _mm_or_ps(_mm_andnot_ps(signMask, value), _mm_and_ps(signMask, sign));
+			}
+
+			__m128 Abs(const __m128 value)
+			{
+				return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+			}
+#endif
+
+			template<typename T>
+			void EncodeNormalised(const float* values, NormalisedInteger<T>* result, const size_t count)
+			{
+				size_t i = 0;
+#ifdef IS_MATHS_PACKING_SSE2
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128i encoded = EncodeNormalised4<T>(_mm_loadu_ps(values + i));
+					if constexpr (std::is_same_v<T, int16_t>)
+					{
+						_mm_storel_epi64(reinterpret_cast<__m128i*>(result + i), _mm_packs_epi32(encoded, encoded));
+					}
+					else if constexpr (std::is_same_v<T, uint16_t>)
+					{
+						// No unsigned 32 to 16 bit pack in SSE2, bias into signed range and back.
+						const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(encoded, _mm_set1_epi32(0x8000)), _mm_setzero_si128());
+						_mm_storel_epi64(reinterpret_cast<__m128i*>(result + i), _mm_xor_si128(packed, _mm_set1_epi16(static_cast<short>(0x8000))));
+					}
+					else
+					{
+						const __m128i packed16 = _mm_packs_epi32(encoded, encoded);
+						const __m128i packed8 = std::is_signed_v<T> ? _mm_packs_epi16(packed16, packed16) : _mm_packus_epi16(packed16, packed16);
+						const int bytes = _mm_cvtsi128_si32(packed8);
+						std::memcpy(static_cast<void*>(result + i), &bytes, 4);
+					}
+				}
+#endif
+				for (; i < count; ++i)
+				{
+					result[i].Value = NormalisedInteger<T>::Encode(values[i]);
+				}
+			}
+
+			template<typename T>
+			void DecodeNormalised(const NormalisedInteger<T>* values, float* result, const size_t count)
+			{
+				size_t i = 0;
+#ifdef IS_MATHS_PACKING_SSE2
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128i widened;
+					if constexpr (sizeof(T) == 2)
+					{
+						const __m128i loaded = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values + i));
+						widened = std::is_signed_v<T>
+							? _mm_srai_epi32(_mm_unpacklo_epi16(loaded, loaded), 16)
+							: _mm_unpacklo_epi16(loaded, _mm_setzero_si128());
+					}
+					else
+					{
+						int bytes;
+						std::memcpy(&bytes, values + i, 4);
+						const __m128i loaded = _mm_cvtsi32_si128(bytes);
+						if constexpr (std::is_signed_v<T>)
+						{
+							const __m128i duplicated = _mm_unpacklo_epi8(loaded, loaded);
+							widened = _mm_srai_epi32(_mm_unpacklo_epi16(duplicated, duplicated), 24);
+						}
+						else
+						{
+							widened = _mm_unpacklo_epi16(_mm_unpacklo_epi8(loaded, _mm_setzero_si128()), _mm_setzero_si128());
+						}
+					}
+					_mm_storeu_ps(result + i, DecodeNormalised4<T>(widened));
+				}
+#endif
+				for (; i < count; ++i)
+				{
+					result[i] = values[i].ToFloat();
+				}
+			}
+		}
+
+		Half::Half(const float value)
+			: Value(FloatToHalf(value))
+		{ }
+
+		float Half::ToFloat() const
+		{
+			return HalfToFloat(Value);
+		}
+
+		Half Half::FromBits(const uint16_t bits)
+		{
+			Half half;
+			half.Value = bits;
+			return half;
+		}
+
+		OctahedralNormal::OctahedralNormal(const Vector3& normal)
+		{
+			EncodeOctahedral(normal.x, normal.y, normal.z, *this);
+		}
+
+		Vector3 OctahedralNormal::ToVector3() const
+		{
+			float result[3];
+			DecodeOctahedral(*this, result);
+			return Vector3(result[0], result[1], result[2]);
+		}
+
+		PackedQuaternion::PackedQuaternion(const Quaternion& rotation)
+		{
+			const float q[4] = { rotation.w, rotation.x, rotation.y, rotation.z };
+			EncodeQuaternion(q, *this);
+		}
+
+		Quaternion PackedQuaternion::ToQuaternion() const
+		{
+			float q[4];
+			DecodeQuaternion(*this, q);
+			return Quaternion(q[0], q[1], q[2], q[3]);
+		}
+
+		UNorm1010102::UNorm1010102(const Vector4& value)
+		{
+			const float values[4] = { value.x, value.y, value.z, value.w };
+			Value = EncodeUNorm1010102(values);
+		}
+
+		Vector4 UNorm1010102::ToVector4() const
+		{
+			float result[4];
+			DecodeUNorm1010102(Value, result);
+			return Vector4(result[0], result[1], result[2], result[3]);
+		}
+
+		namespace Packing
+		{
+			void EncodeHalf(const float* values, Half* result, const size_t count)
+			{
+				size_t i = 0;
+#ifdef IS_MATHS_PACKING_SSE2
+				for (; i + 8 <= count; i += 8)
+				{
+					// Sign extend so the signed saturating pack keeps all 16 bits.
+					const __m128i low = _mm_srai_epi32(_mm_slli_epi32(FloatToHalf4(_mm_loadu_ps(values + i)), 16), 16);
+					const __m128i high = _mm_srai_epi32(_mm_slli_epi32(FloatToHalf4(_mm_loadu_ps(values + i + 4)), 16), 16);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), _mm_packs_epi32(low, high));
+				}
+#endif
+				for (; i < count; ++i)
+				{
+					result[i].Value = FloatToHalf(values[i]);
+				}
+			}
+
+			void DecodeHalf(const Half* values, float* result, const size_t count)
+			{
+				size_t i = 0;
+#ifdef IS_MATHS_PACKING_SSE2
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m128i loaded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+					_mm_storeu_ps(result + i, HalfToFloat4(_mm_unpacklo_epi16(loaded, _mm_setzero_si128())));
+					_mm_storeu_ps(result + i + 4, HalfToFloat4(_mm_unpackhi_epi16(loaded, _mm_setzero_si128())));
+				}
+#endif
+				for (; i < count; ++i)
+				{
+					result[i] = HalfToFloat(values[i].Value);
+				}
+			}
+
+			void EncodeSNorm8(const float* values, SNorm8* result, const size_t count) { EncodeNormalised(values, result, count); }
+			void DecodeSNorm8(const SNorm8* values, float* result, const size_t count) { DecodeNormalised(values, result, count); }
+			void EncodeUNorm8(const float* values, UNorm8* result, const size_t count) { EncodeNormalised(values, result, count); }
+			void DecodeUNorm8(const UNorm8* values, float* result, const size_t count) { DecodeNormalised(values, result, count); }
+			void EncodeSNorm16(const float* values, SNorm16* result, const size_t count) { EncodeNormalised(values, result, count); }
+			void DecodeSNorm16(const SNorm16* values, float* result, const size_t count) { DecodeNormalised(values, result, count); }
+			void EncodeUNorm16(const float* values, UNorm16* result, const size_t count) { EncodeNormalised(values, result, count); }
+			void DecodeUNorm16(const UNorm16* values, float* result, const size_t count) { DecodeNormalised(values, result, count); }
+
+			void EncodeOctahedral(const float* normals, OctahedralNormal* result, const size_t count)
+			{
+				size_t i = 0;
+#ifdef IS_MATHS_PACKING_SSE2
+				for (; i + 4 <= count; i += 4)
+				{
+					const float* n = normals + i * 3;
+					const __m128 x = _mm_setr_ps(n[0], n[3], n[6], n[9]);
+					const __m128 y = _mm_setr_ps(n[1], n[4], n[7], n[10]);
+					const __m128 z = _mm_setr_ps(n[2], n[5], n[8], n[11]);
+
+					const __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(_mm_add_ps(Abs(x), Abs(y)), Abs(z)));
+					const __m128 octX = _mm_mul_ps(x, inverseLength);
+					const __m128 octY = _mm_mul_ps(y, inverseLength);
+					const __m128 one = _mm_set1_ps(1.0f);
+					const __m128 foldedX = _mm_mul_ps(_mm_sub_ps(one, Abs(octY)), CopySign(one, octX));
+					const __m128 foldedY = _mm_mul_ps(_mm_sub_ps(one, Abs(octX)), CopySign(one, octY));
+
+					const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+					const __m128i encodedX = EncodeNormalised4<int16_t>(_mm_or_ps(_mm_and_ps(lower, foldedX), _mm_andnot_ps(lower, octX)));
+					const __m128i encodedY = EncodeNormalised4<int16_t>(_mm_or_ps(_mm_and_ps(lower, foldedY), _mm_andnot_ps(lower, octY)));
+					const __m128i packed = _mm_packs_epi32(_mm_unpacklo_epi32(encodedX, encodedY), _mm_unpackhi_epi32(encodedX, encodedY));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), packed);
+				}
+#endif
+				for (; i < count; ++i)
+				{
+					Maths::EncodeOctahedral(normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2], result[i]);
+				}
+			}
+
+			void DecodeOctahedral(const OctahedralNormal* values, float* normals, const size_t count)
+			{
+				size_t i = 0;
+#ifdef IS_MATHS_PACKING_SSE2
+				for (; i + 4 <= count; i += 4)
+				{
+					const __m128i loaded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+					const __m128 low = DecodeNormalised4<int16_t>(_mm_srai_epi32(_mm_unpacklo_epi16(loaded, loaded), 16));
+					const __m128 high = DecodeNormalised4<int16_t>(_mm_srai_epi32(_mm_unpackhi_epi16(loaded, loaded), 16));
+					__m128 x = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+					__m128 y = _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+
+					const __m128 z = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), Abs(x)), Abs(y));
+					const __m128 unfold = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+					x = _mm_sub_ps(x, CopySign(unfold, x));
+					y = _mm_sub_ps(y, CopySign(unfold, y));
+
+					const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+					alignas(16) float decoded[3][4];
+					_mm_store_ps(decoded[0], _mm_div_ps(x, length));
+					_mm_store_ps(decoded[1], _mm_div_ps(y, length));
+					_mm_store_ps(decoded[2], _mm_div_ps(z, length));
+					for (int lane = 0; lane < 4; ++lane)
+					{
+						normals[(i + lane) * 3] = decoded[0][lane];
+						normals[(i + lane) * 3 + 1] = decoded[1][lane];
+						normals[(i + lane) * 3 + 2] = decoded[2][lane];
+					}
+				}
+#endif
+				for (; i < count; ++i)
+				{
+					Maths::DecodeOctahedral(values[i], normals + i * 3);
+				}
+			}
+
+			void EncodeQuaternions(const float* quaternions, PackedQuaternion* result, const size_t count)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					EncodeQuaternion(quaternions + i * 4, result[i]);
+				}
+			}
+
+			void DecodeQuaternions(const PackedQuaternion* values, float* quaternions, const size_t count)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					DecodeQuaternion(values[i], quaternions + i * 4);
+				}
+			}
+
+			void EncodeUNorm1010102(const float* values, UNorm1010102* result, const size_t count)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					result[i].Value = Maths::EncodeUNorm1010102(values + i * 4);
+				}
+			}
+
+			void DecodeUNorm1010102(const UNorm1010102* values, float* result, const size_t count)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					Maths::DecodeUNorm1010102(values[i].Value, result + i * 4);
+				}
+			}
+		}
+	}
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+
+#include <chrono>
+#include <vector>
+
+namespace test
+{
+	using namespace Insight::Maths;
+
+	TEST_SUITE("Maths Packed")
+	{
+		// Not a multiple of 8 or 4 so the SSE2 loops and the scalar remainder are both used.
+		constexpr size_t c_Count = 1027;
+
+		float RandomFloat(unsigned int& state, const float range)
+		{
+			state = state * 1664525u + 1013904223u;
+			return (static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f) * range;
+		}
+		std::vector<float> RandomUnitVectors(unsigned int& state, const size_t count, const int components)
+		{
+			std::vector<float> values(count * components);
+			for (size_t i = 0; i < count; ++i)
+			{
+				float lengthSquared = 0.0f;
+				for (int k = 0; k < components; ++k)
+				{
+					values[i * components + k] = RandomFloat(state, 1.0f);
+					lengthSquared += values[i * components + k] * values[i * components + k];
+				}
+				const float length = std::sqrt(lengthSquared);
+				for (int k = 0; k < components; ++k)
+				{
+					values[i * components + k] /= length;
+				}
+			}
+			return values;
+		}
+		bool BitsEqual(const float lhs, const float rhs)
+		{
+			return std::memcmp(&lhs, &rhs, sizeof(float)) == 0;
+		}
+
+		TEST_CASE("Half")
+		{
+			CHECK(Half(1.0f).Value == 0x3C00);
+			CHECK(Half(-2.0f).Value == 0xC000);
+			CHECK(Half(Half::c_Max).Value == 0x7BFF);
+			CHECK(Half(65519.0f).Value == 0x7BFF);
+			CHECK(Half(65520.0f).Value == 0x7C00);
+			CHECK(Half(std::numeric_limits<float>::infinity()).Value == 0x7C00);
+			CHECK(Half(Half::c_MinSubnormal).Value == 0x0001);
+			CHECK(Half(Half::c_MinSubnormal * 0.25f).Value == 0x0000);
+			CHECK(Half(-0.0f).Value == 0x8000);
+			CHECK(std::isnan(Half(std::numeric_limits<float>::quiet_NaN()).ToFloat()));
+			CHECK(Half::FromBits(0x3555).ToFloat() == 0.333251953125f);
+			// Halfway between 1 and the next half rounds to even.
+			CHECK(Half(1.0f + 1.0f / 2048.0f).Value == 0x3C00);
+			CHECK(Half(1.0f + 3.0f / 2048.0f).Value == 0x3C02);
+
+			// Every half survives a round trip through float.
+			bool allExact = true;
+			for (uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+			{
+				const Half half = Half::FromBits(static_cast<uint16_t>(bits));
+				const float value = half.ToFloat();
+				if (!std::isnan(value) && Half(value).Value != half.Value)
+				{
+					allExact = false;
+				}
+			}
+			CHECK(allExact);
+
+			unsigned int state = 1;
+			float maxRelativeError = 0.0f;
+			for (int i = 0; i < 10000; ++i)
+			{
+				const float value = std::ldexp(RandomFloat(state, 1.0f), static_cast<int>(RandomFloat(state, 14.0f)));
+				if (std::abs(value) >= Half::c_MinNormal)
+				{
+					maxRelativeError = std::max(maxRelativeError, std::abs(Half(value).ToFloat() - value) / std::abs(value));
+				}
+			}
+			CHECK(maxRelativeError <= Half::c_MaxRelativeError);
+		}
+
+		TEST_CASE("Half bulk matches single values")
+		{
+			unsigned int state = 2;
+			std::vector<float> values(c_Count);
+			for (float& value : values)
+			{
+				value = std::ldexp(RandomFloat(state, 1.0f), static_cast<int>(RandomFloat(state, 20.0f)));
+			}
+			values[0] = std::numeric_limits<float>::infinity();
+			values[1] = -std::numeric_limits<float>::quiet_NaN();
+			values[2] = 65520.0f;
+			values[3] = Half::c_MinSubnormal * 3.5f;
+			values[4] = -0.0f;
+
+			std::vector<Half> encoded(c_Count);
+			std::vector<float> decoded(c_Count);
+			Packing::EncodeHalf(values.data(), encoded.data(), c_Count);
+			Packing::DecodeHalf(encoded.data(), decoded.data(), c_Count);
+
+			bool allMatch = true;
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				const Half single(values[i]);
+				allMatch &= encoded[i].Value == single.Value && BitsEqual(decoded[i], single.ToFloat());
+			}
+			CHECK(allMatch);
+		}
+
+		template<typename T>
+		void CheckNormalised(const float rangeMin)
+		{
+			using Norm = NormalisedInteger<T>;
+			CHECK(Norm(1.0f).ToFloat() == 1.0f);
+			CHECK(Norm(2.0f).ToFloat() == 1.0f);
+			CHECK(Norm(-2.0f).ToFloat() == rangeMin);
+			CHECK(Norm(0.0f).ToFloat() == 0.0f);
+			CHECK(Norm::Decode(std::numeric_limits<T>::min()) == rangeMin);
+
+			unsigned int state = 3;
+			std::vector<float> values(c_Count);
+			for (float& value : values)
+			{
+				value = rangeMin < 0.0f ? RandomFloat(state, 1.1f) : RandomFloat(state, 0.55f) + 0.5f;
+			}
+
+			std::vector<Norm> encoded(c_Count);
+			std::vector<float> decoded(c_Count);
+			if constexpr (std::is_same_v<T, int8_t>)
+			{
+				Packing::EncodeSNorm8(values.data(), encoded.data(), c_Count);
+				Packing::DecodeSNorm8(encoded.data(), decoded.data(), c_Count);
+			}
+			else if constexpr (std::is_same_v<T, uint8_t>)
+			{
+				Packing::EncodeUNorm8(values.data(), encoded.data(), c_Count);
+				Packing::DecodeUNorm8(encoded.data(), decoded.data(), c_Count);
+			}
+			else if constexpr (std::is_same_v<T, int16_t>)
+			{
+				Packing::EncodeSNorm16(values.data(), encoded.data(), c_Count);
+				Packing::DecodeSNorm16(encoded.data(), decoded.data(), c_Count);
+			}
+			else
+			{
+				Packing::EncodeUNorm16(values.data(), encoded.data(), c_Count);
+				Packing::DecodeUNorm16(encoded.data(), decoded.data(), c_Count);
+			}
+
+			bool allMatch = true;
+			float maxError = 0.0f;
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				const Norm single(values[i]);
+				allMatch &= encoded[i].Value == single.Value && BitsEqual(decoded[i], single.ToFloat());
+				const float clamped = std::min(std::max(values[i], rangeMin), 1.0f);
+				maxError = std::max(maxError, std::abs(decoded[i] - clamped));
+			}
+			CHECK(allMatch);
+			CHECK(maxError <= Norm::c_MaxError * 1.0001f);
+		}
+
+		TEST_CASE("Normalised integers")
+		{
+			CheckNormalised<int8_t>(-1.0f);
+			CheckNormalised<uint8_t>(0.0f);
+			CheckNormalised<int16_t>(-1.0f);
+			CheckNormalised<uint16_t>(0.0f);
+		}
+
+		TEST_CASE("Octahedral normals")
+		{
+			const Vector3 axes[] = { Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(0, 1, 0), Vector3(0, -1, 0), Vector3(0, 0, 1), Vector3(0, 0, -1) };
+			for (const Vector3& axis : axes)
+			{
+				const Vector3 decoded = OctahedralNormal(axis).ToVector3();
+				CHECK(decoded.x == axis.x);
+				CHECK(decoded.y == axis.y);
+				CHECK(decoded.z == axis.z);
+			}
+
+			unsigned int state = 4;
+			const std::vector<float> normals = RandomUnitVectors(state, c_Count, 3);
+			std::vector<OctahedralNormal> encoded(c_Count);
+			std::vector<float> decoded(c_Count * 3);
+			Packing::EncodeOctahedral(normals.data(), encoded.data(), c_Count);
+			Packing::DecodeOctahedral(encoded.data(), decoded.data(), c_Count);
+
+			bool allMatch = true;
+			float maxError = 0.0f;
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				const OctahedralNormal single(Vector3(normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2]));
+				const Vector3 singleDecoded = single.ToVector3();
+				allMatch &= encoded[i].X == single.X && encoded[i].Y == single.Y;
+				for (int k = 0; k < 3; ++k)
+				{
+					allMatch &= BitsEqual(decoded[i * 3 + k], singleDecoded[k]);
+					maxError = std::max(maxError, std::abs(decoded[i * 3 + k] - normals[i * 3 + k]));
+				}
+			}
+			CHECK(allMatch);
+			CHECK(maxError <= OctahedralNormal::c_MaxError);
+			MESSAGE("[Maths Packed] Octahedral max component error " << maxError);
+		}
+
+		TEST_CASE("Smallest three quaternions")
+		{
+			const Quaternion identity = PackedQuaternion(Quaternion(1.0f, 0.0f, 0.0f, 0.0f)).ToQuaternion();
+			CHECK(identity.w == 1.0f);
+			CHECK(std::abs(identity.x) <= PackedQuaternion::c_MaxError);
+
+			unsigned int state = 5;
+			const std::vector<float> quaternions = RandomUnitVectors(state, c_Count, 4);
+			std::vector<PackedQuaternion> encoded(c_Count);
+			std::vector<float> decoded(c_Count * 4);
+			Packing::EncodeQuaternions(quaternions.data(), encoded.data(), c_Count);
+			Packing::DecodeQuaternions(encoded.data(), decoded.data(), c_Count);
+
+			bool allMatch = true;
+			float maxError = 0.0f;
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				const float* q = &quaternions[i * 4];
+				const Quaternion single = PackedQuaternion(Quaternion(q[0], q[1], q[2], q[3])).ToQuaternion();
+				allMatch &= BitsEqual(decoded[i * 4], single.w) && BitsEqual(decoded[i * 4 + 1], single.x)
+					&& BitsEqual(decoded[i * 4 + 2], single.y) && BitsEqual(decoded[i * 4 + 3], single.z);
+
+				// The decoded quaternion may be the negation of the original, which is the same rotation.
+				const float dot = decoded[i * 4] * q[0] + decoded[i * 4 + 1] * q[1] + decoded[i * 4 + 2] * q[2] + decoded[i * 4 + 3] * q[3];
+				const float sign = dot < 0.0f ? -1.0f : 1.0f;
+				for (int k = 0; k < 4; ++k)
+				{
+					maxError = std::max(maxError, std::abs(decoded[i * 4 + k] * sign - q[k]));
+				}
+			}
+			CHECK(allMatch);
+			CHECK(maxError <= PackedQuaternion::c_MaxError);
+			MESSAGE("[Maths Packed] Smallest three quaternion max component error " << maxError);
+		}
+
+		TEST_CASE("UNorm1010102")
+		{
+			const Vector4 decoded = UNorm1010102(Vector4(0.25f, 1.5f, -1.0f, 1.0f)).ToVector4();
+			CHECK(std::abs(decoded.x - 0.25f) <= UNorm1010102::c_MaxErrorXYZ);
+			CHECK(decoded.y == 1.0f);
+			CHECK(decoded.z == 0.0f);
+			CHECK(decoded.w == 1.0f);
+			CHECK(UNorm1010102(Vector4(1.0f, 0.0f, 0.0f, 0.0f)).Value == 0x3FFu);
+			CHECK(UNorm1010102(Vector4(0.0f, 0.0f, 0.0f, 1.0f)).Value == 0xC0000000u);
+
+			unsigned int state = 6;
+			std::vector<float> values(c_Count * 4);
+			for (float& value : values)
+			{
+				value = RandomFloat(state, 0.5f) + 0.5f;
+			}
+			std::vector<UNorm1010102> encoded(c_Count);
+			std::vector<float> results(c_Count * 4);
+			Packing::EncodeUNorm1010102(values.data(), encoded.data(), c_Count);
+			Packing::DecodeUNorm1010102(encoded.data(), results.data(), c_Count);
+
+			float maxErrorXYZ = 0.0f;
+			float maxErrorW = 0.0f;
+			for (size_t i = 0; i < c_Count; ++i)
+			{
+				for (int k = 0; k < 3; ++k)
+				{
+					maxErrorXYZ = std::max(maxErrorXYZ, std::abs(results[i * 4 + k] - values[i * 4 + k]));
+				}
+				maxErrorW = std::max(maxErrorW, std::abs(results[i * 4 + 3] - values[i * 4 + 3]));
+			}
+			CHECK(maxErrorXYZ <= UNorm1010102::c_MaxErrorXYZ * 1.0001f);
+			CHECK(maxErrorW <= UNorm1010102::c_MaxErrorW * 1.0001f);
+		}
+
+		TEST_CASE("Benchmark")
+		{
+			constexpr size_t c_BenchmarkCount = 64 * 1024;
+			constexpr int c_Iterations = 32;
+
+			unsigned int state = 7;
+			std::vector<float> values(c_BenchmarkCount * 3);
+			for (float& value : values)
+			{
+				value = RandomFloat(state, 100.0f);
+			}
+			std::vector<Half> halves(c_BenchmarkCount * 3);
+			std::vector<OctahedralNormal> normals(c_BenchmarkCount);
+
+			const auto measure = [](auto&& func)
+			{
+				const auto start = std::chrono::high_resolution_clock::now();
+				for (int iteration = 0; iteration < c_Iterations; ++iteration)
+				{
+					func();
+				}
+				const auto end = std::chrono::high_resolution_clock::now();
+				return std::chrono::duration<double, std::nano>(end - start).count() / (c_Iterations * c_BenchmarkCount);
+			};
+
+			const double singleHalfNs = measure([&]()
+				{
+					for (size_t i = 0; i < c_BenchmarkCount * 3; ++i)
+					{
+						halves[i] = Half(values[i]);
+					}
+				});
+			const double bulkHalfNs = measure([&]()
+				{
+					Packing::EncodeHalf(values.data(), halves.data(), c_BenchmarkCount * 3);
+				});
+			MESSAGE("[Maths Packed] Encode Vector3 as halves single: " << singleHalfNs << "ns, bulk: " << bulkHalfNs << "ns ("
+				<< (singleHalfNs / bulkHalfNs) << "x). Checksum " << halves[0].Value);
+
+			const double singleOctahedralNs = measure([&]()
+				{
+					for (size_t i = 0; i < c_BenchmarkCount; ++i)
+					{
+						normals[i] = OctahedralNormal(Vector3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]));
+					}
+				});
+			const double bulkOctahedralNs = measure([&]()
+				{
+					Packing::EncodeOctahedral(values.data(), normals.data(), c_BenchmarkCount);
+				});
+			MESSAGE("[Maths Packed] Encode octahedral normal single: " << singleOctahedralNs << "ns, bulk: " << bulkOctahedralNs << "ns ("
+				<< (singleOctahedralNs / bulkOctahedralNs) << "x). Checksum " << normals[0].X);
+		}
+	}
+}
+#endif
@@ -132,6 +132,29 @@ namespace Insight
         }
         Quaternion Quaternion::Slerp(const Quaternion& q, const float time) const
         {
+#ifdef IS_MATHS_SIMD
+            __m128 to = q.m128;
+            float cosTheta = _mm_cvtss_f32(Simd::Dot4(m128, to));
+            if (cosTheta < 0.0f)
+            {
+                to = Simd::Negate(to);
+                cosTheta = -cosTheta;
+            }
+
+            Quaternion result;
+            if (cosTheta > 1.0f - std::numeric_limits<float>().epsilon())
+            {
+                result.m128 = _mm_add_ps(_mm_mul_ps(m128, _mm_set1_ps(1.0f - time)), _mm_mul_ps(to, _mm_set1_ps(time)));
+            }
+            else
+            {
+                const float angle = std::acos(cosTheta);
+                const __m128 from = _mm_mul_ps(_mm_set1_ps(static_cast<float>(sin((1.0f - time) * angle))), m128);
+                to = _mm_mul_ps(_mm_set1_ps(std::sin(time * angle)), to);
+                result.m128 = _mm_div_ps(_mm_add_ps(from, to), _mm_set1_ps(static_cast<float>(sin(angle))));
+            }
+            return result;
+#else
             Quaternion z = q;
             float cosTheta = Dot(q);
 
@@ -159,6 +182,7 @@ namespace Insight
                 float angle = std::acos(cosTheta);
                 return (sin((1.0f - time) * angle) * *this + std::sin(time * angle) * z) / sin(angle);
             }
+#endif
         }
 
         Quaternion& Quaternion::operator=(const Quaternion& q)
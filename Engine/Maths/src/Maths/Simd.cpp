@@ -0,0 +1,317 @@
+#include "Maths/Simd.h"
+
+#ifdef IS_TESTING
+#include "Maths/Matrix4.h"
+#include "Maths/Quaternion.h"
+#include "Maths/MathsUtils.h"
+#include "Maths/Utils.h"
+
+#include "doctest.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace test
+{
+	using namespace Insight::Maths;
+
+	/// @brief Scalar versions of the operations which have a SIMD path, written the same way as the scalar backend.
+	/// The SIMD path only uses multiply and add in the same order so most results are expected to match exactly.
+	namespace Reference
+	{
+		Matrix4 Multiply(const Matrix4& lhs, const Matrix4& rhs)
+		{
+			Matrix4 result;
+			for (int row = 0; row < 4; ++row)
+			{
+				for (int column = 0; column < 4; ++column)
+				{
+					result[row][column] = (rhs[row][0] * lhs[0][column]) + (rhs[row][1] * lhs[1][column])
+						+ (rhs[row][2] * lhs[2][column]) + (rhs[row][3] * lhs[3][column]);
+				}
+			}
+			return result;
+		}
+
+		Vector4 Transform(const Matrix4& lhs, const Vector4& rhs)
+		{
+			Vector4 result;
+			for (int column = 0; column < 4; ++column)
+			{
+				result[column] = (lhs[0][column] * rhs.x) + (lhs[1][column] * rhs.y) + (lhs[2][column] * rhs.z) + (lhs[3][column] * rhs.w);
+			}
+			return result;
+		}
+
+		Quaternion Slerp(const Quaternion& from, const Quaternion& q, const float time)
+		{
+			Quaternion to = q;
+			float cosTheta = (from.w * q.w + from.x * q.x) + (from.y * q.y + from.z * q.z);
+			if (cosTheta < 0.0f)
+			{
+				to = -q;
+				cosTheta = -cosTheta;
+			}
+			if (cosTheta > 1.0f - std::numeric_limits<float>().epsilon())
+			{
+				return Quaternion(Lerp(from.w, to.w, time), Lerp(from.x, to.x, time), Lerp(from.y, to.y, time), Lerp(from.z, to.z, time));
+			}
+			const float angle = std::acos(cosTheta);
+			return (static_cast<float>(sin((1.0f - time) * angle)) * from + std::sin(time * angle) * to) / static_cast<float>(sin(angle));
+		}
+	}
+
+	/// @brief Deterministic values in [-range, range].
+	struct TestRandom
+	{
+		unsigned int State = 0x12345678u;
+
+		float Next(const float range)
+		{
+			State = State * 1664525u + 1013904223u;
+			return (static_cast<float>(State >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f) * range;
+		}
+		Vector4 NextVector(const float range)
+		{
+			const float x = Next(range);
+			const float y = Next(range);
+			const float z = Next(range);
+			const float w = Next(range);
+			return Vector4(x, y, z, w);
+		}
+		Matrix4 NextMatrix(const float range)
+		{
+			const Vector4 v0 = NextVector(range);
+			const Vector4 v1 = NextVector(range);
+			const Vector4 v2 = NextVector(range);
+			const Vector4 v3 = NextVector(range);
+			return Matrix4(v0, v1, v2, v3);
+		}
+		Quaternion NextQuaternion()
+		{
+			const float x = Next(3.14f);
+			const float y = Next(3.14f);
+			const float z = Next(3.14f);
+			return Quaternion(x, y, z).Normalised();
+		}
+	};
+
+	TEST_SUITE("Maths Simd")
+	{
+		constexpr int c_CrossCheckCount = 4096;
+#if defined(IS_MATHS_DIRECTX_MATHS) || defined(IS_MATHS_GLM)
+		// Other backends reorder or fuse operations so can differ from the scalar path by a few ulp.
+		constexpr float c_RelativeTolerance = 1e-5f;
+#else
+		constexpr float c_RelativeTolerance = 0.0f;
+#endif
+		bool Matches(const float value, const float reference)
+		{
+			return std::abs(value - reference) <= c_RelativeTolerance * (1.0f + std::abs(reference));
+		}
+
+		TEST_CASE("Alignment")
+		{
+#ifdef IS_MATHS_SIMD
+			CHECK(alignof(Vector4) == 16);
+			CHECK(alignof(Matrix4) == 16);
+			CHECK(alignof(Quaternion) == 16);
+#endif
+			CHECK(sizeof(Vector4) == 16);
+			CHECK(sizeof(Matrix4) == 64);
+			CHECK(sizeof(Quaternion) == 16);
+		}
+
+		TEST_CASE("Vector4 matches scalar")
+		{
+			TestRandom random;
+			int mismatchCount = 0;
+			for (int i = 0; i < c_CrossCheckCount; ++i)
+			{
+				const Vector4 a = random.NextVector(100.0f);
+				const Vector4 b = random.NextVector(100.0f);
+				const float s = random.Next(10.0f);
+
+				const Vector4 sum = a + b;
+				const Vector4 difference = a - b;
+				const Vector4 product = a * b;
+				const Vector4 scaled = a * s;
+				const Vector4 negated = -a;
+				for (int c = 0; c < 4; ++c)
+				{
+					mismatchCount += !Matches(sum[c], a[c] + b[c]);
+					mismatchCount += !Matches(difference[c], a[c] - b[c]);
+					mismatchCount += !Matches(product[c], a[c] * b[c]);
+					mismatchCount += !Matches(scaled[c], a[c] * s);
+					mismatchCount += !Matches(negated[c], -a[c]);
+				}
+
+				const float dot = (a.x * b.x + a.y * b.y) + (a.z * b.z + a.w * b.w);
+				CHECK(Equals(a.Dot(b), dot, std::abs(dot) * 1e-6f + 1e-3f));
+
+				const Vector4 cross = a.Cross(b);
+				mismatchCount += !Matches(cross.x, (a.y * b.z) - (a.z * b.y));
+				mismatchCount += !Matches(cross.y, (a.z * b.x) - (a.x * b.z));
+				mismatchCount += !Matches(cross.z, (a.x * b.y) - (a.y * b.x));
+				mismatchCount += !Matches(cross.w, 0.0f);
+
+				CHECK(Equals(a.Normalised().Length(), 1.0f, 1e-5f));
+			}
+			CHECK(mismatchCount == 0);
+		}
+
+		TEST_CASE("Matrix4 matches scalar")
+		{
+			TestRandom random;
+			int mismatchCount = 0;
+			for (int i = 0; i < c_CrossCheckCount; ++i)
+			{
+				const Matrix4 a = random.NextMatrix(10.0f);
+				const Matrix4 b = random.NextMatrix(10.0f);
+				const Vector4 v = random.NextVector(100.0f);
+
+				const Matrix4 product = a * b;
+				const Matrix4 referenceProduct = Reference::Multiply(a, b);
+				const Vector4 transformed = a * v;
+				const Vector4 referenceTransformed = Reference::Transform(a, v);
+				const Matrix4 transposed = a.Transposed();
+				for (int row = 0; row < 4; ++row)
+				{
+					mismatchCount += !Matches(transformed[row], referenceTransformed[row]);
+					for (int column = 0; column < 4; ++column)
+					{
+						mismatchCount += !Matches(product[row][column], referenceProduct[row][column]);
+						mismatchCount += !Matches(transposed[row][column], a[column][row]);
+					}
+				}
+
+				// The inverse is computed differently (2x2 blocks against cofactors), check it against the identity and glm.
+				const Matrix4 inverse = a.Inversed();
+				CHECK((a * inverse).Equal(Matrix4::Identity, 1e-3f));
+				const glm::mat4 glmInverse = glm::inverse(a.mat4);
+				const float inverseScale = std::abs(glmInverse[0][0]) + std::abs(glmInverse[1][1]) + std::abs(glmInverse[2][2]) + std::abs(glmInverse[3][3]);
+				CHECK(inverse.Equal(glmInverse, inverseScale * 1e-4f + 1e-5f));
+			}
+			CHECK(mismatchCount == 0);
+		}
+
+		TEST_CASE("Quaternion Slerp matches scalar")
+		{
+			TestRandom random;
+			for (int i = 0; i < c_CrossCheckCount; ++i)
+			{
+				const Quaternion a = random.NextQuaternion();
+				const Quaternion b = (i % 8) == 0 ? a : random.NextQuaternion();
+				const float t = (random.Next(1.0f) + 1.0f) * 0.5f;
+
+				const Quaternion slerp = a.Slerp(b, t);
+				const Quaternion reference = Reference::Slerp(a, b, t);
+				CHECK(Equals(slerp.w, reference.w, 1e-6f));
+				CHECK(Equals(slerp.x, reference.x, 1e-6f));
+				CHECK(Equals(slerp.y, reference.y, 1e-6f));
+				CHECK(Equals(slerp.z, reference.z, 1e-6f));
+			}
+		}
+
+		template<typename Func>
+		double MeasureNanoseconds(const int count, Func&& func)
+		{
+			const auto start = std::chrono::high_resolution_clock::now();
+			func();
+			const auto end = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration<double, std::nano>(end - start).count() / count;
+		}
+
+		TEST_CASE("Benchmark")
+		{
+#ifdef IS_MATHS_SIMD_AVX2
+			const char* backend = "SIMD (AVX2)";
+#elif defined(IS_MATHS_SIMD)
+			const char* backend = "SIMD (SSE4.1)";
+#elif defined(IS_MATHS_DIRECTX_MATHS)
+			const char* backend = "DirectXMath";
+#elif defined(IS_MATHS_GLM)
+			const char* backend = "GLM";
+#else
+			const char* backend = "Scalar";
+#endif
+			constexpr int c_ElementCount = 1024;
+			constexpr int c_Iterations = 256;
+			constexpr int c_OperationCount = c_ElementCount * c_Iterations;
+
+			TestRandom random;
+			std::vector<Matrix4> matrices(c_ElementCount);
+			std::vector<Vector4> points(c_ElementCount);
+			std::vector<Quaternion> rotations(c_ElementCount);
+			for (int i = 0; i < c_ElementCount; ++i)
+			{
+				matrices[i] = random.NextMatrix(10.0f);
+				points[i] = random.NextVector(100.0f);
+				rotations[i] = random.NextQuaternion();
+			}
+			std::vector<Matrix4> matrixResults(c_ElementCount);
+			std::vector<Vector4> pointResults(c_ElementCount);
+			std::vector<Quaternion> rotationResults(c_ElementCount);
+
+			const double multiplyNs = MeasureNanoseconds(c_OperationCount, [&]()
+				{
+					for (int iteration = 0; iteration < c_Iterations; ++iteration)
+					{
+						for (int i = 0; i < c_ElementCount; ++i)
+						{
+							matrixResults[i] = matrices[i] * matrices[(i + iteration) % c_ElementCount];
+						}
+					}
+				});
+			const double inverseNs = MeasureNanoseconds(c_OperationCount, [&]()
+				{
+					for (int iteration = 0; iteration < c_Iterations; ++iteration)
+					{
+						for (int i = 0; i < c_ElementCount; ++i)
+						{
+							matrixResults[i] = matrices[(i + iteration) % c_ElementCount].Inversed();
+						}
+					}
+				});
+			const double transformNs = MeasureNanoseconds(c_OperationCount, [&]()
+				{
+					for (int iteration = 0; iteration < c_Iterations; ++iteration)
+					{
+						const Matrix4& matrix = matrices[iteration % c_ElementCount];
+						for (int i = 0; i < c_ElementCount; ++i)
+						{
+							pointResults[i] = matrix * points[i];
+						}
+					}
+				});
+			const double slerpNs = MeasureNanoseconds(c_OperationCount, [&]()
+				{
+					for (int iteration = 0; iteration < c_Iterations; ++iteration)
+					{
+						const float t = static_cast<float>(iteration) / c_Iterations;
+						for (int i = 0; i < c_ElementCount; ++i)
+						{
+							rotationResults[i] = rotations[i].Slerp(rotations[(i + iteration + 1) % c_ElementCount], t);
+						}
+					}
+				});
+
+			// Keep the results alive so the loops aren't removed.
+			float checksum = 0.0f;
+			for (int i = 0; i < c_ElementCount; ++i)
+			{
+				checksum += matrixResults[i].m_00 + pointResults[i].x + rotationResults[i].w;
+			}
+
+			MESSAGE("[Maths Simd] Backend: " << backend << ", " << c_OperationCount << " operations each.");
+			MESSAGE("[Maths Simd] Matrix4 multiply: " << multiplyNs << "ns per op, " << (1000.0 / multiplyNs) << " Mops/s.");
+			MESSAGE("[Maths Simd] Matrix4 inverse: " << inverseNs << "ns per op, " << (1000.0 / inverseNs) << " Mops/s.");
+			MESSAGE("[Maths Simd] Matrix4 transform point: " << transformNs << "ns per op, " << (1000.0 / transformNs) << " Mops/s.");
+			MESSAGE("[Maths Simd] Quaternion slerp: " << slerpNs << "ns per op, " << (1000.0 / slerpNs) << " Mops/s.");
+			MESSAGE("[Maths Simd] Checksum: " << checksum);
+		}
+	}
+}
+#endif
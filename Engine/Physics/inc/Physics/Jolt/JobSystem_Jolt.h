@@ -0,0 +1,40 @@
+#pragma once
+#ifdef IS_PHYSICS_JOLT
+
+#include "Core/TypeAlias.h"
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+
+namespace Insight::Physics::Jolt
+{
+	/// @brief Jolt job system which runs every physics job as a FrameCritical task on the engine TaskSystem,
+	/// so physics shares the engine workers instead of spinning up its own thread pool.
+	/// Barriers are handled by JPH::JobSystemWithBarrier, the thread waiting on a barrier also executes jobs.
+	class JobSystem_Jolt : public JPH::JobSystemWithBarrier
+	{
+	public:
+		JobSystem_Jolt() = default;
+		JobSystem_Jolt(const u32 maxJobs, const u32 maxBarriers);
+		virtual ~JobSystem_Jolt() override = default;
+
+		/// @brief Must be called before any jobs are created.
+		void Init(const u32 maxJobs, const u32 maxBarriers);
+
+		// See: JobSystem
+		virtual int GetMaxConcurrency() const override;
+		virtual JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies = 0) override;
+
+	protected:
+		// See: JobSystem
+		virtual void QueueJob(Job* inJob) override;
+		virtual void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override;
+		virtual void FreeJob(Job* inJob) override;
+
+	private:
+		using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+		AvailableJobs m_jobs;
+	};
+}
+#endif
@@ -6,6 +6,7 @@
 
 #include "Physics/Jolt/ObjectLayerFilters_Jolt.h"
 #include "Physics/Jolt/Listeners_Jolt.h"
+#include "Physics/Jolt/JobSystem_Jolt.h"
 #include "Physics/MotionType.h"
 
 #include "Core/Asserts.h"
@@ -21,7 +22,6 @@
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Collision/Shape/Shape.h>
@@ -104,7 +104,8 @@ namespace Insight::Physics::Jolt
 
     private:
         JPH::PhysicsSystem m_physicsSystem;
-        JPH::JobSystemThreadPool m_jobSystem;
+        /// @brief Runs physics jobs on the engine TaskSystem.
+        JobSystem_Jolt m_jobSystem;
         JPH::TempAllocatorMalloc m_tempAllocatorMalloc;
         std::vector<JPH::BodyID> m_bodyIds;
 
@@ -0,0 +1,187 @@
+#ifdef IS_PHYSICS_JOLT
+#include "Physics/Jolt/JobSystem_Jolt.h"
+
+#include "Threading/TaskSystem.h"
+#include "Core/Profiler.h"
+
+#include <thread>
+
+namespace Insight::Physics::Jolt
+{
+	JobSystem_Jolt::JobSystem_Jolt(const u32 maxJobs, const u32 maxBarriers)
+	{
+		Init(maxJobs, maxBarriers);
+	}
+
+	void JobSystem_Jolt::Init(const u32 maxJobs, const u32 maxBarriers)
+	{
+		JobSystemWithBarrier::Init(maxBarriers);
+		m_jobs.Init(maxJobs, maxJobs);
+	}
+
+	int JobSystem_Jolt::GetMaxConcurrency() const
+	{
+		// Workers plus the thread waiting on the barrier, which also executes jobs.
+		const u32 threadCount = Threading::TaskSystem::IsValidInstance() ? Threading::TaskSystem::Instance().GetThreadCount() : 0;
+		return static_cast<int>(threadCount + 1);
+	}
+
+	JPH::JobHandle JobSystem_Jolt::CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction, JPH::uint32 inNumDependencies)
+	{
+		u32 index = AvailableJobs::cInvalidObjectIndex;
+		while (true)
+		{
+			index = m_jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+			if (index != AvailableJobs::cInvalidObjectIndex)
+			{
+				break;
+			}
+			// All jobs are in use, let the workers retire some. 'maxJobs' should be increased if this is hit.
+			JPH_ASSERT(false, "[JobSystem_Jolt::CreateJob] No jobs available.");
+			std::this_thread::yield();
+		}
+
+		Job* job = &m_jobs.Get(index);
+		// The handle must be created before queueing as the job could be executed and freed straight away.
+		JobHandle handle(job);
+		if (inNumDependencies == 0)
+		{
+			QueueJob(job);
+		}
+		return handle;
+	}
+
+	void JobSystem_Jolt::QueueJob(Job* inJob)
+	{
+		// Keep the job alive until the task has run it.
+		inJob->AddRef();
+		Threading::TaskSystem::CreateTaskWithPriority(Threading::TaskPriority::FrameCritical, [inJob]()
+			{
+				IS_PROFILE_SCOPE("JoltJob");
+				inJob->Execute();
+				inJob->Release();
+			});
+	}
+
+	void JobSystem_Jolt::QueueJobs(Job** inJobs, JPH::uint inNumJobs)
+	{
+		for (JPH::uint jobIdx = 0; jobIdx < inNumJobs; ++jobIdx)
+		{
+			QueueJob(inJobs[jobIdx]);
+		}
+	}
+
+	void JobSystem_Jolt::FreeJob(Job* inJob)
+	{
+		m_jobs.DestructObject(inJob);
+	}
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+#include "Core/Memory.h"
+#include "Physics/Jolt/ObjectLayerFilters_Jolt.h"
+
+#include <Jolt/RegisterTypes.h>
+#include <Jolt/Core/Factory.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Physics/PhysicsSettings.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+
+namespace test
+{
+	using namespace Insight;
+	using namespace Insight::Physics;
+
+	/// @brief Step a stack of boxes falling onto a floor and return the average step time in milliseconds.
+	static float RunStressScene(JPH::JobSystem& jobSystem, const u32 boxCount, const u32 stepCount)
+	{
+		ObjectLayerPairFilter objectLayerPairFilter;
+		ObjectVsBroadPhaseLayerFilter objectVsBroadPhaseLayerFilter;
+		BPLayerInterface bpLayerInterface;
+		JPH::TempAllocatorMalloc tempAllocator;
+
+		JPH::PhysicsSystem physicsSystem;
+		physicsSystem.Init(65536, 0, 65536, 65536, bpLayerInterface, objectVsBroadPhaseLayerFilter, objectLayerPairFilter);
+		JPH::BodyInterface& bodyInterface = physicsSystem.GetBodyInterface();
+
+		JPH::BodyCreationSettings floorSettings(new JPH::BoxShape(JPH::Vec3(500.0f, 1.0f, 500.0f)), JPH::RVec3::sZero(), JPH::Quat::sIdentity()
+			, JPH::EMotionType::Static, ObjectLayers::NON_MOVING);
+		bodyInterface.CreateAndAddBody(floorSettings, JPH::EActivation::DontActivate);
+
+		const JPH::RefConst<JPH::Shape> boxShape = new JPH::BoxShape(JPH::Vec3(0.5f, 0.5f, 0.5f));
+		const u32 boxesPerRow = 32;
+		for (u32 boxIdx = 0; boxIdx < boxCount; ++boxIdx)
+		{
+			const float x = static_cast<float>(boxIdx % boxesPerRow) * 1.5f - boxesPerRow * 0.75f;
+			const float z = static_cast<float>((boxIdx / boxesPerRow) % boxesPerRow) * 1.5f - boxesPerRow * 0.75f;
+			const float y = 2.0f + static_cast<float>(boxIdx / (boxesPerRow * boxesPerRow)) * 1.5f;
+			JPH::BodyCreationSettings boxSettings(boxShape, JPH::RVec3(x, y, z), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, ObjectLayers::MOVING);
+			bodyInterface.CreateAndAddBody(boxSettings, JPH::EActivation::Activate);
+		}
+		physicsSystem.OptimizeBroadPhase();
+
+		Core::Timer timer;
+		timer.Start();
+		for (u32 stepIdx = 0; stepIdx < stepCount; ++stepIdx)
+		{
+			physicsSystem.Update(1.0f / 60.0f, 1, &tempAllocator, &jobSystem);
+		}
+		timer.Stop();
+		return static_cast<float>(timer.GetElapsedTimeNano().count() / 1'000'000.0) / stepCount;
+	}
+
+	TEST_SUITE("JobSystem_Jolt")
+	{
+		TEST_CASE("Stress scene TaskSystem vs thread pool")
+		{
+			const bool ownsJolt = JPH::Factory::sInstance == nullptr;
+			if (ownsJolt)
+			{
+				JPH::RegisterDefaultAllocator();
+				JPH::Factory::sInstance = ::New<JPH::Factory>();
+				JPH::RegisterTypes();
+			}
+
+			Threading::TaskSystem* taskSystem = nullptr;
+			if (!Threading::TaskSystem::IsValidInstance())
+			{
+				taskSystem = ::New<Threading::TaskSystem>();
+				taskSystem->Initialise();
+			}
+			const u32 workerCount = Threading::TaskSystem::Instance().GetThreadCount();
+
+			constexpr u32 c_BoxCount = 8192;
+			constexpr u32 c_StepCount = 120;
+
+			JobSystem_Jolt taskSystemJobs(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+			const float taskSystemStepMs = RunStressScene(taskSystemJobs, c_BoxCount, c_StepCount);
+
+			JPH::JobSystemThreadPool threadPoolJobs(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, static_cast<int>(workerCount));
+			const float threadPoolStepMs = RunStressScene(threadPoolJobs, c_BoxCount, c_StepCount);
+
+			MESSAGE("Bodies: " << c_BoxCount << " | Workers: " << workerCount
+				<< " | TaskSystem step (ms): " << taskSystemStepMs
+				<< " | JobSystemThreadPool step (ms): " << threadPoolStepMs);
+			CHECK(taskSystemStepMs > 0.0f);
+
+			if (taskSystem)
+			{
+				taskSystem->Shutdown();
+				Delete(taskSystem);
+			}
+			if (ownsJolt)
+			{
+				JPH::UnregisterTypes();
+				Delete(JPH::Factory::sInstance);
+				JPH::Factory::sInstance = nullptr;
+			}
+		}
+	}
+}
+#endif
+#endif
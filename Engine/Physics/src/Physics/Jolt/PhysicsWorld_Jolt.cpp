@@ -81,10 +81,9 @@ namespace Insight::Physics::Jolt
 		//JPH::TempAllocatorMalloc tempAllocatorMalloc;
 		m_tempAllocatorMalloc.Allocate(0);
 
-		// We need a job system that will execute physics jobs on multiple threads. Typically
-		// you would implement the JobSystem interface yourself and let Jolt Physics run on top
-		// of your own job scheduler. JobSystemThreadPool is an example implementation.
-		m_jobSystem.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+		// Physics jobs run on the engine TaskSystem workers instead of a private thread pool so
+		// physics doesn't oversubscribe the CPU while the rest of the frame is running.
+		m_jobSystem.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
 
 		// This is the max amount of rigid bodies that you can add to the physics system. If you try to add more you'll get an error.
 		// Note: This value is low because this is a simple test. For a real project use something in the order of 65536.
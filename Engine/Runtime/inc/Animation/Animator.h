@@ -27,6 +27,8 @@ namespace Insight
             const std::vector<Maths::Matrix4>& GetBoneTransforms() const;
 
         private:
+            /// @brief Interpolate every bone's keyframes and compose their local transforms in one batch.
+            void CalculateLocalBoneTransforms();
             void CalculateBoneTransform(const u32 boneId, const Maths::Vector3 parentPosition, const Maths::Quaternion parentQuaternion, const Maths::Vector3 parentScale);
             void CalculateBoneTransform(const u32 boneId, const Maths::Matrix4 parentTransform);
 #if ANIMATION_NODE_TRANSFORMS
@@ -56,6 +58,11 @@ namespace Insight
 
             /// @brief Final transforms for all bones.
             std::vector<Maths::Matrix4> m_boneMatrices;
+            /// @brief Local (parent relative) transforms for all bones for the current animation time.
+            std::vector<Maths::Matrix4> m_localBoneMatrices;
+            /// @brief Structure of arrays storage for the translation, rotation, scale and matrix streams
+            /// used by 'CalculateLocalBoneTransforms'.
+            std::vector<float> m_localBoneStreams;
         
             double m_currentAnimationTime = 0.0f;
             float m_deltaTime = 0.0f;
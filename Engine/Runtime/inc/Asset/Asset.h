@@ -9,6 +9,13 @@
 
 #include "Generated/Asset_reflect_generated.h"
 
+#ifdef IS_TESTING
+namespace test
+{
+    struct AssetRegistryTestAccess;
+}
+#endif
+
 namespace Insight
 {
     namespace Runtime
@@ -51,6 +58,9 @@ namespace Insight
 
         protected:
             virtual void OnUnload() = 0;
+            /// @brief True if anything other than the AssetRegistry still references this asset or
+            /// anything the asset owns. Assets which are in use are never unloaded by the registry.
+            virtual bool IsInUse() const;
 
         protected:
             std::string m_name;
@@ -59,6 +69,9 @@ namespace Insight
             bool m_isMemoryAsset = false;
 
             friend class AssetRegistry;
+#ifdef IS_TESTING
+            friend struct ::test::AssetRegistryTestAccess;
+#endif
         };
     }
 
@@ -95,6 +95,10 @@ namespace Insight
             std::vector<IObject*> GetObjectsFromAsset(const Core::GUID& guid) const;
 
             std::string ValidatePath(const std::string& path) const;
+
+            /// @brief Unload every loaded asset which nothing outside the registry uses (see 'Asset::IsInUse').
+            /// @return Number of assets unloaded.
+            u64 UnloadUnusedAssets();
         private:
             IAssetPackage* CreateAssetPackageInternal(std::string_view name, std::string_view path, AssetPackageType packageType);
 
@@ -126,6 +130,10 @@ namespace Insight
 
             std::string m_debugMetaFileDirectory;
             std::string m_assetReativeBaseDirectory;
+
+#ifdef IS_TESTING
+            friend struct ::test::AssetRegistryTestAccess;
+#endif
         };
     }
 }
\ No newline at end of file
@@ -50,6 +50,7 @@ namespace Insight
             // BEGIN Asset
         protected:
             virtual void OnUnload() override;
+            virtual bool IsInUse() const override;
             // END Asset
 
         private:
@@ -64,6 +65,9 @@ namespace Insight
             Graphics::RHI_Buffer* m_index_buffer = nullptr;
 
             friend class ModelImporter;
+#ifdef IS_TESTING
+            friend struct ::test::AssetRegistryTestAccess;
+#endif
         };
     }
 }
\ No newline at end of file
@@ -11,6 +11,8 @@
 #include "Maths/Matrix4.h"
 #include "Maths/Quaternion.h"
 
+#include "Memory/ScratchAllocator.h"
+
 #include <assimp/matrix4x4.h>
 #include <assimp/quaternion.h>
 #include <vector>
@@ -56,9 +58,11 @@ namespace Insight
                 u32 Index_count = 0;
             };
 
-            std::vector<Graphics::Vertex> Vertices;
-            std::vector<Graphics::VertexBoneInfluence> VerticesBoneInfluence;
-            std::vector<u32> Indices;
+            /// @brief Only needed until uploaded, so come from the importing thread's scratch allocator.
+            /// MeshData must not outlive the 'Core::ScratchScope' it was created in.
+            Core::ScratchVector<Graphics::Vertex> Vertices;
+            Core::ScratchVector<Graphics::VertexBoneInfluence> VerticesBoneInfluence;
+            Core::ScratchVector<u32> Indices;
             std::vector<LOD> LODs;
 
             Graphics::RHI_Buffer* RHI_VertexBuffer = nullptr;
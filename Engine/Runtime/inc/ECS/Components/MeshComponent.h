@@ -3,6 +3,7 @@
 #include "ECS/Entity.h"
 
 #include "Resource/Mesh.h"
+#include "Graphics/RenderLod.h"
 
 #include "Generated/MeshComponent_reflect_generated.h"
 
@@ -24,12 +25,22 @@ namespace Insight
 			Ref<Runtime::Mesh>			GetMesh()						const		{ return m_mesh; }
 			void						SetMaterial(Ref<Runtime::MaterialAsset> material);
 			Ref<Runtime::MaterialAsset>	GetMaterial()					const		{ return m_material; }
+			/// @brief Rasterise this mesh into the occlusion buffer to hide the meshes behind it.
+			/// Large meshes near the camera are used as occluders without being flagged.
+			void						SetOccluder(const bool isOccluder)			{ m_isOccluder = isOccluder; }
+			bool						IsOccluder()					const		{ return m_isOccluder; }
+			/// @brief LOD picked for the main camera last frame, used for hysteresis. Not serialised.
+			void						SetLastLod(const u8 lod)					{ m_lastLod = lod; }
+			u8							GetLastLod()					const		{ return m_lastLod; }
 
 			IS_SERIALISABLE_H(MeshComponent)
 
 		private:
 			Ref<Runtime::Mesh> m_mesh;
 			Ref<Runtime::MaterialAsset> m_material;
+			REFLECT_PROPERTY(EditorVisible)
+			bool m_isOccluder = false;
+			u8 m_lastLod = RenderLod::c_NoPreviousLod;
 		};
 	}
 
@@ -49,9 +60,10 @@ namespace Insight
 		};
 	}
 
-	OBJECT_SERIALISER(ECS::MeshComponent, 4,
+	OBJECT_SERIALISER(ECS::MeshComponent, 5,
 		SERIALISE_BASE(ECS::Component, 2, 0)
 		SERIALISE_COMPLEX(Serialisation::MeshToGuid, m_mesh, 3, 0)
 		SERIALISE_COMPLEX(Serialisation::MaterialToGuid, m_material, 4, 0)
+		SERIALISE_PROPERTY(bool, m_isOccluder, 5, 0)
 	);
 }
\ No newline at end of file
@@ -153,6 +153,7 @@ namespace Insight
 		};
 
 #define IS_COMPONENT(Component) \
+		IS_POOLED_OBJECT(Component) \
 		static constexpr const char* Type_Name = #Component; \
 		virtual const char* GetTypeName() override { return Type_Name; }
 
@@ -174,6 +175,8 @@ namespace Insight
 		class IS_RUNTIME Entity : public Serialisation::ISerialisable
 		{
 		public:
+			IS_POOLED_OBJECT(Entity);
+
 #ifdef ECS_ENABLED
 			Entity(ECSWorld* ecs_world);
 			Entity(ECSWorld* ecs_world, std::string name);
@@ -7,6 +7,8 @@
 #include "Graphics/Window.h"
 #include "Graphics/RenderFrame.h"
 
+#include <memory>
+
 namespace Insight
 {
 	namespace Input
@@ -14,6 +16,11 @@ namespace Insight
 		class InputSystem;
 	};
 
+	namespace Threading
+	{
+		class Task;
+	}
+
 	namespace Runtime
 	{
 		/// <summary>
@@ -34,17 +41,48 @@ namespace Insight
 			void Update();
 			void Render();
 
+			/// <summary>
+			/// Extract and prepare the render frame on the calling thread.
+			/// </summary>
 			void CreateRenderFrame();
+			/// <summary>
+			/// Gather the render frame from the world system without sorting it. Main thread only.
+			/// </summary>
+			void ExtractRenderFrame();
+			/// <summary>
+			/// Sort the extracted render frame on the calling thread.
+			/// </summary>
+			void PrepareRenderFrame();
+			/// <summary>
+			/// Sort the extracted render frame on a worker thread. The world system is not read so this can
+			/// overlap the next simulation update.
+			/// </summary>
+			void PrepareRenderFrameAsync();
+			/// <summary>
+			/// Block until the render frame queued by 'PrepareRenderFrameAsync' has been prepared.
+			/// </summary>
+			void WaitForRenderFramePreparation() const;
+			/// <summary>
+			/// Time in milliseconds the last render frame preparation took.
+			/// </summary>
+			float GetRenderFramePreparationTime() const { return m_renderFramePreparationTime; }
+			/// <summary>
+			/// Get the current render frame. Waits for any outstanding preparation first.
+			/// </summary>
 			const RenderFrame& GetRenderFrame() const;
 
 		private:
 			void InitialiseRenderContext(Graphics::GraphicsAPI graphicsAPI);
+			void PrepareRenderFrame(RenderFrame& renderFrame);
 
 		private:
 			Graphics::RenderContext* m_context = nullptr;
 			Graphics::Window m_window;
 
 			DoubleBufferVector<RenderFrame> m_renderFrame;
+			std::shared_ptr<Threading::Task> m_renderFramePreparationTask;
+			/// Written by the preparation task, only read once the task has been waited on.
+			float m_renderFramePreparationTime = 0.0f;
 			Input::InputSystem* m_inputSystem = nullptr;
 		};
 	}
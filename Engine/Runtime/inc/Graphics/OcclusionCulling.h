@@ -0,0 +1,172 @@
+#pragma once
+
+#include "Core/TypeAlias.h"
+#include "Runtime/Defines.h"
+
+#include "Graphics/BoundingBox.h"
+
+#include "Maths/Matrix4.h"
+#include "Maths/Vector3.h"
+#include "Maths/Vector4.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Insight
+{
+    struct RenderCullingBounds;
+
+    /// @brief Object space triangles of a mesh, rasterised when the mesh is used as an occluder.
+    struct IS_RUNTIME OccluderGeometry
+    {
+        /// @brief Meshes with more triangles cost more to rasterise than they save and are never occluders.
+        static constexpr u32 c_MaxTriangleCount = 8192;
+
+        u32 GetTriangleCount() const { return static_cast<u32>(Indices.size() / 3); }
+        bool IsEmpty() const { return Indices.empty(); }
+
+        std::vector<Maths::Vector3> Positions;
+        std::vector<u32> Indices;
+    };
+
+    struct OccluderInstance
+    {
+        const OccluderGeometry* Geometry = nullptr;
+        Maths::Matrix4 Transform;
+    };
+
+    /// @brief Low resolution masked depth buffer for CPU occlusion culling, based on "Masked Software Occlusion
+    /// Culling" (Andersson et al. 2016). Pixels are grouped in 8x4 tiles. Each tile stores a coverage mask and two
+    /// depths instead of per pixel depth: a reference depth which every pixel in the tile is at least as near as, and
+    /// the farthest depth of the working layer covered by the mask. When the mask is full the working layer becomes
+    /// the new reference. Depth is 1/w, larger is nearer, so the buffer clears to 0.
+    /// Blocks of 4x4 tiles keep the farthest reference depth of their tiles so most occluded boxes are rejected
+    /// without visiting each tile.
+    /// Occluders are set up in parallel per occluder and rasterised in parallel per band of tile rows, 4 pixels at a
+    /// time with SSE2.
+    class IS_RUNTIME OcclusionBuffer
+    {
+    public:
+        static constexpr u32 c_TileWidth = 8;
+        static constexpr u32 c_TileHeight = 4;
+        static constexpr u32 c_DefaultWidth = 320;
+        static constexpr u32 c_DefaultHeight = 192;
+        /// @brief Tiles per side of a block in the coarse level.
+        static constexpr u32 c_BlockSize = 4;
+
+        OcclusionBuffer(const u32 width = c_DefaultWidth, const u32 height = c_DefaultHeight);
+
+        /// @brief Sizes are rounded up to whole tiles.
+        void Resize(const u32 width, const u32 height);
+        /// @brief Clear the buffer and set the camera used by the following calls.
+        /// @param projectionView World to clip space.
+        /// @param nearPlane Distance to the near plane, occluders are clipped at w = nearPlane.
+        void Begin(const Maths::Matrix4& projectionView, const float nearPlane);
+        void RenderOccluders(const OccluderInstance* occluders, const u64 count);
+
+        /// @brief False if 'worldBounds' is behind the occluders rendered since 'Begin'. Boxes crossing the near
+        /// plane are always visible.
+        bool IsVisible(const Graphics::BoundingBox& worldBounds) const;
+        /// @brief Remove the indices of occluded boxes from 'meshIndexs', keeping the order. Chunks are tested in parallel.
+        /// @return Number of indices left.
+        u64 RemoveOccluded(const RenderCullingBounds& bounds, u32* meshIndexs, const u64 count) const;
+
+        u32 GetWidth() const { return m_width; }
+        u32 GetHeight() const { return m_height; }
+        /// @brief Triangles rasterised since 'Begin', after clipping and removing off screen triangles.
+        u64 GetTriangleCount() const;
+        /// @brief Reference depth of each pixel's tile, row major, for debug views.
+        std::vector<float> GetTileDepths() const;
+
+    private:
+        struct ScreenTriangle
+        {
+            /// @brief Edge functions A * x + B * y + C, positive inside.
+            float EdgeA[3];
+            float EdgeB[3];
+            float EdgeC[3];
+            /// @brief Depth plane DepthA * x + DepthB * y + DepthC.
+            float DepthA;
+            float DepthB;
+            float DepthC;
+            /// @brief Depth of the farthest vertex.
+            float MinDepth;
+            /// @brief Inclusive pixel bounds, clamped to the buffer.
+            int MinX;
+            int MinY;
+            int MaxX;
+            int MaxY;
+        };
+
+        void SetupOccluder(const OccluderInstance& occluder, std::vector<ScreenTriangle>& triangles) const;
+        void SetupTriangle(const Maths::Vector4* clipVertices, std::vector<ScreenTriangle>& triangles) const;
+        /// @brief Rasterise the triangles of chunks from 'firstChunk' onwards into the tile rows [beginRow, endRow).
+        void RasteriseTileRows(const u32 beginRow, const u32 endRow, const u64 firstChunk);
+        void UpdateTile(const u32 tileIndex, const u32 coverage, const float triangleDepth);
+        void UpdateBlocks();
+
+    private:
+        static constexpr u64 c_OccluderGrainSize = 8;
+        /// @brief Each task walks every triangle once for a band of rows, so bands trade triangle walks for tasks.
+        static constexpr u64 c_TileRowGrainSize = 4;
+        static constexpr u64 c_OccludeeGrainSize = 1024;
+
+        u32 m_width = 0;
+        u32 m_height = 0;
+        u32 m_tilesX = 0;
+        u32 m_tilesY = 0;
+        u32 m_blocksX = 0;
+        u32 m_blocksY = 0;
+
+        Maths::Matrix4 m_projectionView;
+        float m_nearPlane = 0.1f;
+
+        std::vector<u32> m_tileMasks;
+        std::vector<float> m_tileReferenceDepths;
+        std::vector<float> m_tileLayerDepths;
+        /// @brief Farthest reference depth of the tiles in each block.
+        std::vector<float> m_blockReferenceDepths;
+
+        /// @brief Set up triangles, one list per chunk of occluders. Lists are kept between frames to reuse their memory,
+        /// only the first 'm_triangleChunkCount' are in use.
+        std::vector<std::vector<ScreenTriangle>> m_triangleChunks;
+        u64 m_triangleChunkCount = 0;
+    };
+
+    /// @brief Everything the occlusion culler used for one view, written by 'RenderWorld::Cull' when a dump is
+    /// requested so the culler can be run and timed without the engine.
+    struct IS_RUNTIME OcclusionScene
+    {
+        struct Occluder
+        {
+            u32 GeometryIndex = 0;
+            Maths::Matrix4 Transform;
+        };
+
+        bool Save(std::string_view filePath) const;
+        bool Load(std::string_view filePath);
+
+        Maths::Matrix4 ProjectionView;
+        float NearPlane = 0.1f;
+        std::vector<OccluderGeometry> Geometries;
+        std::vector<Occluder> Occluders;
+        /// @brief World bounds of the meshes inside the view frustum.
+        std::vector<Graphics::BoundingBox> Occludees;
+    };
+
+    namespace OcclusionCulling
+    {
+        /// @brief Opaque meshes with occluder geometry whose bounding sphere covers at least this fraction of the
+        /// distance to the camera are used as occluders even if they aren't flagged.
+        constexpr float c_AutoOccluderMinScreenSize = 0.2f;
+
+        IS_RUNTIME void SetEnabled(const bool enabled);
+        IS_RUNTIME bool IsEnabled();
+
+        /// @brief Save the main camera's occlusion scene of the next culled world to 'filePath'.
+        IS_RUNTIME void RequestSceneDump(std::string filePath);
+        /// @brief Take the requested dump path, empty if there isn't one.
+        IS_RUNTIME std::string ConsumeSceneDumpRequest();
+    }
+}
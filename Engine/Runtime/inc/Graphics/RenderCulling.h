@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Core/TypeAlias.h"
+#include "Runtime/Defines.h"
+
+#include "Graphics/BoundingBox.h"
+
+#include "Maths/Batch.h"
+#include "Maths/Matrix4.h"
+
+#include "Memory/FrameArenaAllocator.h"
+
+namespace Insight
+{
+    /// @brief World space bounds of the meshes in a 'RenderWorld', in the same order as 'RenderWorld::Meshes'.
+    /// Stored as structure of arrays so views can be culled 4 to 16 meshes at a time with 'Maths::Batch::CullAABB'.
+    struct IS_RUNTIME RenderCullingBounds
+    {
+        RenderCullingBounds() = default;
+        explicit RenderCullingBounds(Core::FrameArena* frameArena);
+
+        void Reserve(const u64 count);
+        void Add(const Graphics::BoundingBox& worldBounds);
+        void Clear();
+
+        u64 Size() const { return MinX.size(); }
+        /// @brief View of the streams, only valid until the bounds are changed.
+        Maths::AABBSoA GetBoxes() const;
+
+        Core::FrameArenaVector<float> MinX;
+        Core::FrameArenaVector<float> MinY;
+        Core::FrameArenaVector<float> MinZ;
+        Core::FrameArenaVector<float> MaxX;
+        Core::FrameArenaVector<float> MaxY;
+        Core::FrameArenaVector<float> MaxZ;
+    };
+
+    /// @brief Meshes visible from one or more views. Each view is a compact list of mesh indices in ascending order,
+    /// all views are stored back to back.
+    struct IS_RUNTIME RenderVisibility
+    {
+        struct View
+        {
+            const u32* begin() const { return Begin; }
+            const u32* end() const { return End; }
+            u64 Size() const { return static_cast<u64>(End - Begin); }
+
+            const u32* Begin = nullptr;
+            const u32* End = nullptr;
+        };
+
+        RenderVisibility() = default;
+        explicit RenderVisibility(Core::FrameArena* frameArena);
+
+        /// @brief Cull 'bounds' against the frustum of 'projectionView' (world to clip space) and add the meshes
+        /// inside it as a new view. Chunks of meshes are culled in parallel.
+        /// @return Index of the new view.
+        u64 AddView(const RenderCullingBounds& bounds, const Maths::Matrix4& projectionView);
+        /// @brief Cull 'bounds' against 'planeCount' planes from 'RenderCulling' and add the meshes inside them as a new view.
+        /// @return Index of the new view.
+        u64 AddView(const RenderCullingBounds& bounds, const float* planes, const u64 planeCount);
+        void Reserve(const u64 meshIndexCount, const u64 viewCount);
+        void Clear();
+
+        u64 GetViewCount() const { return ViewEnds.size(); }
+        View GetView(const u64 viewIdx) const;
+
+        Core::FrameArenaVector<u32> MeshIndexs;
+        /// @brief View 'i' is MeshIndexs[ViewEnds[i - 1], ViewEnds[i]), the first view starts at 0.
+        Core::FrameArenaVector<u64> ViewEnds;
+    };
+
+    namespace RenderCulling
+    {
+        constexpr u64 c_FrustumPlaneCount = 6;
+        /// @brief Meshes culled per task, a multiple of every batch lane width.
+        constexpr u64 c_GrainSize = 4096;
+
+        /// @brief Frustum planes of 'projectionView' as (x, y, z, w) for 'Maths::Batch::CullAABB', not normalised.
+        /// Near and far are taken from -w <= z <= w, which contains the [0, w] and reverse depth ranges as well, so the
+        /// planes are conservative for every projection the renderer uses.
+        IS_RUNTIME void GetFrustumPlanes(const Maths::Matrix4& projectionView, float planes[c_FrustumPlaneCount * 4]);
+
+        /// @brief Frustum planes without the near plane.
+        constexpr u64 c_ShadowCasterPlaneCount = c_FrustumPlaneCount - 1;
+
+        /// @brief Planes of a shadow cascade's volume extended towards the light, so meshes between the light and the
+        /// cascade which cast shadows into it are kept. 'lightProjectionView' is the cascade's world to clip space.
+        IS_RUNTIME void GetShadowCasterPlanes(const Maths::Matrix4& lightProjectionView, float planes[c_ShadowCasterPlaneCount * 4]);
+        /// @brief Direction light travels through a cascade, the inward normal of the near plane 'GetShadowCasterPlanes'
+        /// drops. Not normalised.
+        IS_RUNTIME Maths::Vector3 GetShadowDirection(const Maths::Matrix4& lightProjectionView);
+
+        /// @brief Frustum planes followed by planes at 'nearDistance' and 'farDistance' from the camera.
+        constexpr u64 c_ViewSlicePlaneCount = c_FrustumPlaneCount + 2;
+
+        /// @brief Planes of the part of a perspective camera's frustum between two view depths, the slice a shadow
+        /// cascade is sampled in. Distances are measured as the projection's w, the view depth.
+        IS_RUNTIME void GetViewSlicePlanes(const Maths::Matrix4& projectionView, const float nearDistance, const float farDistance
+            , float planes[c_ViewSlicePlaneCount * 4]);
+
+        /// @brief Whether 'bounds' swept without end along 'direction' is entirely outside one of 'planes'.
+        /// Conservative, a volume which only misses the planes' intersection past one of its edges is not reported.
+        IS_RUNTIME bool IsSweptAABBOutside(const Graphics::BoundingBox& bounds, const Maths::Vector3& direction, const float* planes
+            , const u64 planeCount);
+    }
+}
@@ -2,6 +2,10 @@
 
 #include "Core/TypeAlias.h"
 
+#include "Graphics/RenderCulling.h"
+#include "Graphics/OcclusionCulling.h"
+#include "Graphics/RenderLod.h"
+
 #include "Resource/Mesh.h"
 #include "Asset/Assets/Texture.h"
 #include "Asset/Assets/Material.h"
@@ -11,6 +15,8 @@
 #include "Maths/Vector3.h"
 #include "Maths/Matrix4.h"
 
+#include "Memory/FrameArenaAllocator.h"
+
 #include <array>
 #include <vector>
 
@@ -46,11 +52,19 @@ namespace Insight
         std::vector<Runtime::MeshLOD> MeshLods;
         RenderMaterial Material;
 
-        std::vector<Maths::Matrix4> BoneTransforms;
+        Core::FrameArenaVector<Maths::Matrix4> BoneTransforms;
         Core::GUID SkinnedMeshGuid;
         bool SkinnedMesh = false;
 
+        /// @brief Triangles drawn into the occlusion buffer, null if the mesh has none.
+        const OccluderGeometry* Occluder = nullptr;
+        /// @brief Always an occluder when visible, see 'ECS::MeshComponent::IsOccluder'.
+        bool IsFlaggedOccluder = false;
+        /// @brief LOD for the main camera, picked from its screen size when the frame is extracted.
+        u8 Lod = 0;
+
         const Runtime::MeshLOD& GetLOD(u32 lodIndex) const;
+        bool IsTransparent() const;
 
         void SetMesh(Runtime::Mesh* mesh);
         void SetMaterial(const Ref<Runtime::MaterialAsset> material);
@@ -130,6 +144,16 @@ namespace Insight
         }
     };
 
+    struct RenderOcclusionStats
+    {
+        u64 OccluderCount = 0;
+        u64 OccluderTriangleCount = 0;
+        /// @brief Meshes inside the main camera frustum which were tested.
+        u64 OccludeeCount = 0;
+        u64 OccludedCount = 0;
+        float TimeMs = 0.0f;
+    };
+
     struct IS_RUNTIME RenderCamera
     {
         ECS::Camera Camera; 
@@ -141,27 +165,67 @@ namespace Insight
     struct IS_RUNTIME RenderWorld
     {
         RenderWorld() = default;
-        
+        /// @brief Allocate the per frame vectors from 'frameArena'. Copies of the world use the heap.
+        explicit RenderWorld(Core::FrameArena* frameArena);
+
         void SetMainCamera(ECS::Camera mainCamera, const Maths::Matrix4 transform);
         void AddCamrea(ECS::Camera camera, const Maths::Matrix4 transform);
 
+        /// @brief Fill the visibility lists from 'MeshBounds' for the main camera and each point light face.
+        /// Meshes hidden behind occluders are removed from the main camera's list when occlusion culling is enabled.
+        void Cull();
+        /// @brief Fill 'ShadowCasterVisibility' with the opaque meshes inside each cascade's volume extended towards
+        /// the light. Receivers pick their cascade by view depth, so a mesh is skipped in a cascade when its bounds
+        /// extruded away from the light don't reach the part of the view between the splits either side of it. The
+        /// cascades overlap past their splits, so a caster inside a closer cascade can still shadow a farther one.
+        /// Each caster's LOD is picked from its size in the cascade, never finer than its main camera LOD.
+        /// Cascades are culled in parallel.
+        /// @param cascadeProjectionViews World to clip space of each cascade, nearest to the camera first.
+        /// @param cascadeSplitDistances View depth each cascade ends at.
+        /// @param cameraProjectionView World to clip space of the camera the cascades were fitted to.
+        void CullShadowCasters(const Maths::Matrix4* cascadeProjectionViews, const float* cascadeSplitDistances
+            , const u64 cascadeCount, const Maths::Matrix4& cameraProjectionView);
+
         /// @brief The main rendering camera for this world.
         RenderCamera MainCamera;
         /// @brief Addition cameras within the world.
-        std::vector<RenderCamera> Cameras;
+        Core::FrameArenaVector<RenderCamera> Cameras;
 
         /// @brief All meshes within the world.
-        std::vector<RenderMesh> Meshes;
+        Core::FrameArenaVector<RenderMesh> Meshes;
+
+        Core::FrameArenaVector<RenderPointLight> PointLights;
 
-        std::vector<RenderPointLight> PointLights;
+        /// @brief World space bounds of 'Meshes'.
+        RenderCullingBounds MeshBounds;
+        /// @brief Meshes inside the main camera frustum and not occluded, a single view. Empty if there is no main camera.
+        RenderVisibility MainCameraVisibility;
+        /// @brief Meshes inside each point light face, view 'pointLightIdx * 6 + face'.
+        RenderVisibility PointLightVisibility;
+        /// @brief Opaque meshes drawn into each directional light shadow cascade, view 'cascadeIdx'.
+        RenderVisibility ShadowCasterVisibility;
+        /// @brief LOD of each entry in 'ShadowCasterVisibility.MeshIndexs'.
+        Core::FrameArenaVector<u8> ShadowCasterLods;
 
-        std::vector<u64> OpaqueMeshIndexs;
-        std::vector<u64> TransparentMeshIndexs;
+        /// @brief All opaque and transparent meshes, for views which are culled later (e.g. shadow cascades).
+        Core::FrameArenaVector<u64> OpaqueMeshIndexs;
+        Core::FrameArenaVector<u64> TransparentMeshIndexs;
+        /// @brief Opaque and transparent meshes visible to the main camera, sorted by distance to it.
+        /// All meshes if there is no main camera.
+        Core::FrameArenaVector<u64> VisibleOpaqueMeshIndexs;
+        Core::FrameArenaVector<u64> VisibleTransparentMeshIndexs;
 
-        std::vector<RenderMaterailBatch> MaterialBatch;
+        Core::FrameArenaVector<RenderMaterailBatch> MaterialBatch;
         std::unordered_map<Core::GUID, u64> MaterialBatchLookup;
 
         Maths::Vector3 DirectionalLight = Maths::Vector3(0, 0, 0);
+
+        RenderOcclusionStats OcclusionStats;
+
+    private:
+        /// @brief Draw the occluders in the main camera view into an occlusion buffer and remove the meshes behind them
+        /// from the view.
+        void CullOccludedMeshes();
     };
 
     /// @brief Contain a vector of worlds for rendering.
@@ -176,8 +240,12 @@ namespace Insight
 
         /// @brief Create our render frame from the world system.
         /// @param world 
+        /// @param sort Cull and sort the opaque and transparent meshes. Pass false to call 'Cull' and 'Sort' later from another thread.
         /// @return RenderWorld
-        void CreateRenderFrameFromWorldSystem(Runtime::WorldSystem* worldSystem);
+        void CreateRenderFrameFromWorldSystem(Runtime::WorldSystem* worldSystem, const bool sort = true);
+        /// @brief Cull every world against its main camera and point lights. Call again after changing the camera.
+        void Cull();
+        /// @brief Sort the visible meshes, call after 'Cull'.
         void Sort();
         void SetCameraForAllWorlds(ECS::Camera mainCamera, const Maths::Matrix4 transform);
 
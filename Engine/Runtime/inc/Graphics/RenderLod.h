@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Core/TypeAlias.h"
+#include "Runtime/Defines.h"
+
+#include "Graphics/BoundingBox.h"
+
+#include "Maths/Matrix4.h"
+
+namespace Insight
+{
+    /// @brief Picks the LOD each mesh is drawn with from how much of a view its bounding sphere covers.
+    /// Screen size is the projected sphere radius divided by half the view height, so a sphere just filling the
+    /// height of the view has a screen size of 1.
+    namespace RenderLod
+    {
+        constexpr u32 c_MaxLodCount = 4;
+        /// @brief LOD 'i + 1' is used below 'c_ScreenSizes[i]'.
+        constexpr float c_ScreenSizes[c_MaxLodCount - 1] = { 0.3f, 0.12f, 0.05f };
+        /// @brief Fraction of a threshold the screen size has to move past it before the LOD changes, so meshes
+        /// sitting on a threshold don't switch every frame.
+        constexpr float c_Hysteresis = 0.15f;
+        /// @brief Extra bias for shadow cascades, their texels are rarely close enough to see the detail.
+        constexpr float c_ShadowLodBias = 1.0f;
+        /// @brief Previous LOD to pass when there isn't one, the LOD is picked without hysteresis.
+        constexpr u8 c_NoPreviousLod = 0xFF;
+
+        /// @brief Screen size of the sphere around 'worldBounds' in the view of 'projectionView' (world to clip space).
+        /// Works for perspective and orthographic views. Spheres containing the eye return a very large size.
+        IS_RUNTIME float GetScreenSize(const Maths::Matrix4& projectionView, const Graphics::BoundingBox& worldBounds);
+        /// @brief LOD for 'screenSize' scaled by 2^-bias, so each step of bias halves the screen size. Only moves away
+        /// from 'previousLod' once the screen size is past the threshold by 'c_Hysteresis'.
+        IS_RUNTIME u8 SelectLod(const float screenSize, const u32 lodCount, const u8 previousLod, const float bias);
+
+        /// @brief Added to the bias of every view. Positive values pick coarser LODs.
+        IS_RUNTIME void SetBias(const float bias);
+        IS_RUNTIME float GetBias();
+    }
+}
@@ -81,6 +81,7 @@ namespace Insight
             const AnimationBoneTrack* GetBoneTrack(const u32 boneId) const;
             double GetDuration() const;
             double GetTickPerSecond() const;
+            const Skeleton* GetSkeleton() const { return m_skeleton.Ptr(); }
 
 #if ANIMATION_NODE_TRANSFORMS
             const AnimationNode& GetRootNode() const { return m_rootNode; }
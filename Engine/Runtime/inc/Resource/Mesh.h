@@ -2,6 +2,7 @@
 
 #include "Graphics/RHI/RHI_Buffer.h"
 #include "Graphics/BoundingBox.h"
+#include "Graphics/OcclusionCulling.h"
 
 #include "Asset/Assets/Material.h"
 
@@ -71,10 +72,19 @@ namespace Insight
 			u32 GetLODCount() const;
 			static const u32 s_MAX_LOD_COUNT = 4;
 
+			/// @brief CPU copy of the triangles used when this mesh is an occluder, empty if the mesh has too many.
+			const OccluderGeometry& GetOccluderGeometry() const;
+
+		private:
+			/// @brief Copy the positions and indices of the most detailed LOD with at most 'OccluderGeometry::c_MaxTriangleCount'
+			/// triangles. Must be called after 'm_lods' is filled.
+			void SetOccluderGeometry(const Graphics::Vertex* vertices, const u32* indices);
+
 		private:
 			std::vector<MeshLOD> m_lods;
 			Ref<MaterialAsset> m_materialAsset = nullptr;
 			Graphics::BoundingBox m_boundingBox;
+			OccluderGeometry m_occluderGeometry;
 
 			std::string m_mesh_name;
 			/// @brief Transform offset from the imported model.
@@ -7,3 +7,11 @@ constexpr const char* CMD_WINDOW_SIZE_WIDTH  = "window_size_width";
 constexpr const char* CMD_WINDOW_SIZE_HEIGHT = "window_size_height";
 constexpr const char* CMD_GPU_VALIDATION     = "gpu_validation";
 constexpr const char* CMD_PROJECT_PATH       = "project_path";
+constexpr const char* CMD_PIPELINED_FRAME    = "pipelined_frame";
+constexpr const char* CMD_MEMORY_SAMPLE_RATE = "memory_sample_rate";
+constexpr const char* CMD_RECORD_ALLOCATION_TRACE = "record_allocation_trace";
+/// Prefix of a category's budget, e.g. 'memory_budget_graphics=512,768' for a soft and hard limit in MB.
+constexpr const char* CMD_MEMORY_BUDGET_PREFIX = "memory_budget_";
+constexpr const char* CMD_MEMORY_BUDGET_CSV = "memory_budget_csv";
+/// Lower the instruction set vectorised kernels run with, e.g. 'cpu_instruction_set=sse4.2'. See Core::CPUInstructionSet.
+constexpr const char* CMD_CPU_INSTRUCTION_SET = "cpu_instruction_set";
@@ -39,6 +39,25 @@ namespace Insight
 {
 	namespace App
 	{
+		/// @brief Time in milliseconds spent in each stage of the last frame.
+		struct FrameStageTimings
+		{
+			/// @brief Input, events, physics and world updates.
+			float Simulation = 0.0f;
+			/// @brief Gathering the render frame from the world on the main thread.
+			float Extraction = 0.0f;
+			/// @brief Sorting the render frame. Runs on a worker when pipelined.
+			float Preparation = 0.0f;
+			/// @brief Time the main thread blocked waiting for preparation to finish.
+			float PreparationWait = 0.0f;
+			/// @brief Recording render passes and handing the frame to the render thread.
+			float Submit = 0.0f;
+			/// @brief Whole main thread frame.
+			float Frame = 0.0f;
+			/// @brief Time between a frame's simulation finishing and it being submitted.
+			float Latency = 0.0f;
+		};
+
 		/*
 			Main engine class.
 		*/
@@ -67,11 +86,35 @@ namespace Insight
 			static std::string EngineVersionToString();
 			static bool IsUpdateThread();
 
+			/// @brief When enabled the render frame for frame N is prepared on workers while frame N+1 simulates,
+			/// and frame N is submitted after frame N+1's simulation. Adds one frame of latency.
+			void SetPipelinedFrame(const bool enabled) { m_pipelinedFrame = enabled; }
+			bool IsPipelinedFrame() const { return m_pipelinedFrame; }
+			const FrameStageTimings& GetFrameStageTimings() const { return m_frameStageTimings; }
+
 			static Core::Timer s_FrameTimer;
 			u64 FrameCount = 0;
+		private:
+			void UpdateSimulation(const float deltaTime);
+			void RenderSerial();
+			void RenderPipelined();
+			void DrawFrameStageTimings();
+			void ParseMemoryBudgets();
+			void InitialiseCPUDispatch();
+
 		private:
 			bool m_shouldClose = false;
 
+			bool m_pipelinedFrame = false;
+			/// @brief Frame to record an allocation trace for, 0 if none.
+			u64 m_recordAllocationTraceFrame = 0;
+			/// @brief File to save the memory budget history to on shutdown, empty if none.
+			std::string m_memoryBudgetCsvPath;
+			FrameStageTimings m_frameStageTimings;
+			/// @brief Started when the simulation for the frame waiting to be submitted finished.
+			Core::Timer m_pendingFrameLatencyTimer;
+			Core::Timer m_simulationEndTimer;
+
 			std::thread::id m_updateThread;
 
 			Core::Console m_console;
@@ -8,11 +8,14 @@
 #include "ECS/Entity.h"
 #include "ECS/EntityManager.h"
 
+#include "Graphics/DynamicBVH.h"
+
 #include "World/Generated/World_reflect_generated.h"
 
 #include <Reflect/Reflect.h>
 
 #include <string>
+#include <unordered_map>
 
 namespace Insight
 {
@@ -89,6 +92,16 @@ namespace Insight
 			u32 GetEntityCount() const;
 
 			ECS::Entity* GetEntityByGUID(const Core::GUID& guid) const;
+
+			/// @brief Entities with an enabled mesh whose world bounds overlap the query. The spatial index is refit at the
+			/// end of 'Update', so results are from the last update and are tested against slightly enlarged bounds.
+			std::vector<Core::GUID> QueryEntitiesInBox(const Graphics::BoundingBox& box) const;
+			std::vector<Core::GUID> QueryEntitiesInSphere(const Maths::Vector3& center, const float radius) const;
+			std::vector<Core::GUID> QueryEntitiesInFrustum(const Graphics::Frustum& frustum) const;
+			/// @brief Closest entity with an enabled mesh whose world bounds 'ray' hits within 'maxDistance'.
+			/// @return An invalid GUID if nothing was hit.
+			Core::GUID RayCastEntity(const Graphics::Ray& ray, const float maxDistance, float* hitDistance = nullptr) const;
+			const Graphics::DynamicBVH& GetSpatialIndex() const { return m_spatialIndex; }
 			
 			void SaveWorld(std::string_view filePath) const;
 			/// @brief Save the world to a file in a debug format (json) for readability.
@@ -103,6 +116,9 @@ namespace Insight
 
 		private:
 			void AddEntityAndChildrenToVector(Ptr<ECS::Entity> const& entity, std::vector<Ptr<ECS::Entity>>& vector) const;
+			/// @brief Add, move and remove spatial index proxies for entities whose mesh or transform changed.
+			void UpdateSpatialIndex();
+			void ClearSpatialIndex();
 
 		private:
 			/// Store all entites 
@@ -113,6 +129,21 @@ namespace Insight
 			std::vector<Core::GUID> m_root_entities_guids;
 			ECS::EntityManager m_entityManager;
 
+			/// @brief Entity in 'm_spatialIndex', each proxy's user data is its index in 'm_spatialEntities'.
+			struct SpatialEntity
+			{
+				Core::GUID EntityGuid = Core::GUID::s_InvalidGUID;
+				u32 ProxyId = Graphics::DynamicBVH::c_NullProxy;
+				const void* Mesh = nullptr;
+				Maths::Matrix4 Transform;
+				Graphics::BoundingBox WorldBounds;
+				u64 UpdateStamp = 0;
+			};
+			Graphics::DynamicBVH m_spatialIndex;
+			std::vector<SpatialEntity> m_spatialEntities;
+			std::unordered_map<Core::GUID, u32> m_spatialEntityLookup;
+			u64 m_spatialIndexStamp = 0;
+
 			// Is this scene persistent. If 'true' then the scene can not be unloaded even if asked. The scene must be deleted to be removed. 
 			bool m_persistentScene = false;
 			// Can this scene only be found if searched for. This stops 'GetActiveScene' returning the scenes which might want to stay "hidden".
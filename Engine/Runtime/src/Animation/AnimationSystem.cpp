@@ -10,6 +10,8 @@
 #include "Core/Profiler.h"
 #include "Core/Logger.h"
 
+#include "Threading/Parallel.h"
+
 namespace Insight
 {
     namespace Runtime
@@ -2,6 +2,8 @@
 #include "Core/Profiler.h"
 #include "Core/Asserts.h"
 
+#include "Maths/Batch.h"
+
 namespace Insight
 {
     namespace Runtime
@@ -22,6 +24,9 @@ namespace Insight
             {
                 m_skelton = skeleton;
                 m_boneMatrices.resize(m_skelton->GetNumberOfBones(), Maths::Matrix4::Identity);
+                m_localBoneMatrices.resize(m_skelton->GetNumberOfBones(), Maths::Matrix4::Identity);
+                m_localBoneStreams.resize(m_skelton->GetNumberOfBones()
+                    * (Maths::Vector3SoA::c_StreamCount * 2 + Maths::QuaternionSoA::c_StreamCount + Maths::Matrix4SoA::c_StreamCount));
                 Reset();
                 SetBindPose();
             }
@@ -49,6 +54,7 @@ namespace Insight
             {
                 m_currentAnimationTime += m_animationClip->GetTickPerSecond() * static_cast<double>(deltaTime);
                 m_currentAnimationTime = fmod(m_currentAnimationTime, m_animationClip->GetDuration());
+                CalculateLocalBoneTransforms();
                 CalculateBoneTransform(m_skelton->GetRootBone().Id, Maths::Matrix4::Identity);
 #if ANIMATION_NODE_TRANSFORMS
                 //CalculateBoneTransform(&m_animationClip->GetRootNode(), Maths::Matrix4::Identity);
@@ -61,6 +67,42 @@ namespace Insight
             return m_boneMatrices;
         }
 
+        void Animator::CalculateLocalBoneTransforms()
+        {
+            IS_PROFILE_FUNCTION();
+
+            const size_t boneCount = m_skelton->GetNumberOfBones();
+            float* streams = m_localBoneStreams.data();
+            const Maths::Vector3SoA positions = Maths::Vector3SoA::FromBuffer(streams, boneCount);
+            streams += Maths::Vector3SoA::c_StreamCount * boneCount;
+            const Maths::QuaternionSoA rotations = Maths::QuaternionSoA::FromBuffer(streams, boneCount);
+            streams += Maths::QuaternionSoA::c_StreamCount * boneCount;
+            const Maths::Vector3SoA scales = Maths::Vector3SoA::FromBuffer(streams, boneCount);
+            streams += Maths::Vector3SoA::c_StreamCount * boneCount;
+            const Maths::Matrix4SoA transforms = Maths::Matrix4SoA::FromBuffer(streams, boneCount);
+
+            for (u32 boneId = 0; boneId < boneCount; ++boneId)
+            {
+                const Maths::Vector3 position = InterpolatePositionVec(boneId);
+                const Maths::Quaternion rotation = InterpolateRotationQuat(boneId);
+                const Maths::Vector3 scale = InterpolateScaleVec(boneId);
+
+                positions.X[boneId] = position.x;
+                positions.Y[boneId] = position.y;
+                positions.Z[boneId] = position.z;
+                rotations.W[boneId] = rotation.w;
+                rotations.X[boneId] = rotation.x;
+                rotations.Y[boneId] = rotation.y;
+                rotations.Z[boneId] = rotation.z;
+                scales.X[boneId] = scale.x;
+                scales.Y[boneId] = scale.y;
+                scales.Z[boneId] = scale.z;
+            }
+
+            Maths::Batch::ComposeTRS(positions, rotations, scales, transforms, boneCount);
+            Maths::Batch::ToAoS(transforms, m_localBoneMatrices.data(), boneCount);
+        }
+
         void Animator::CalculateBoneTransform(const u32 boneId, const Maths::Vector3 parentPosition, const Maths::Quaternion parentQuaternion, const Maths::Vector3 parentScale)
         {
             IS_PROFILE_FUNCTION();
@@ -98,12 +140,8 @@ namespace Insight
             const SkeletonBone& bone = m_skelton->GetBone(boneId);
             ASSERT(bone);
 
-            const Maths::Matrix4 bonePositionMatrix = InterpolatePosition(boneId);
-            const Maths::Matrix4 boneRotationMatrix = InterpolateRotation(boneId);
-            const Maths::Matrix4 boneScaleMatrix = InterpolateScale(boneId);
-            const Maths::Matrix4 boneTransform = bonePositionMatrix * boneRotationMatrix * boneScaleMatrix;
-
-            const Maths::Matrix4 globalTransform = parentTransform * boneTransform;
+            // Local transforms are composed up front by 'CalculateLocalBoneTransforms'.
+            const Maths::Matrix4 globalTransform = parentTransform * m_localBoneMatrices[boneId];
 
             const Maths::Matrix4 boneOffsetTransform = m_skelton->GetGlobalInverseTransform() * globalTransform * bone.Offset;
             m_boneMatrices[boneId] = boneOffsetTransform;
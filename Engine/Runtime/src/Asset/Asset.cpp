@@ -33,6 +33,12 @@ namespace Insight::Runtime
         return m_isMemoryAsset;
     }
 
+    bool Asset::IsInUse() const
+    {
+        // The registry holds one reference.
+        return GetReferenceCount() > 1;
+    }
+
     void Asset::SetName(const std::string& name)
     {
         m_name = name;
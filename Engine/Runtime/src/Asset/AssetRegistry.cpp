@@ -21,6 +21,8 @@
 #include "Core/Profiler.h"
 #include "Core/MemoryTracker.h"
 
+#include "Event/EventSystem.h"
+
 #include "Algorithm/Vector.h"
 
 namespace Insight::Runtime
@@ -32,6 +34,24 @@ namespace Insight::Runtime
         m_importers.push_back(New<ShaderImporter>());
         m_importers.push_back(New<AudioClipImporter>());
 
+        // Assets are the easiest memory to give back, drop anything nothing else is using.
+        if (Core::EventSystem::IsValidInstance())
+        {
+            Core::EventSystem::Instance().AddEventListener(this, Core::EventType::MemoryPressure, [this](const Core::Event& event)
+                {
+                    const Core::MemoryPressureEvent& pressureEvent = static_cast<const Core::MemoryPressureEvent&>(event);
+                    if (pressureEvent.Level == Core::MemoryPressureLevel::None
+                        || (pressureEvent.Category != Core::MemoryAllocCategory::Resources && pressureEvent.Category != Core::MemoryAllocCategory::Graphics))
+                    {
+                        return;
+                    }
+
+                    const u64 unloadedAssetCount = UnloadUnusedAssets();
+                    IS_LOG_CORE_INFO("[AssetRegistry] '{}' memory pressure, unloaded {} unused assets.",
+                        Core::MemoryAllocCategoryToString[static_cast<u64>(pressureEvent.Category)], unloadedAssetCount);
+                });
+        }
+
         m_state = Core::SystemStates::Initialised;
     }
 
@@ -39,6 +59,11 @@ namespace Insight::Runtime
     {
         IS_PROFILE_FUNCTION();
 
+        if (Core::EventSystem::IsValidInstance())
+        {
+            Core::EventSystem::Instance().RemoveEventListener(this, Core::EventType::MemoryPressure);
+        }
+
         for (IAssetPackage*& package : m_assetPackages)
         {
             package->Destroy();
@@ -327,6 +352,31 @@ namespace Insight::Runtime
         return asset;
     }
 
+    u64 AssetRegistry::UnloadUnusedAssets()
+    {
+        IS_PROFILE_FUNCTION();
+
+        u64 unloadedAssetCount = 0;
+        std::lock_guard loadedAssetLock(m_loadedAssetLock);
+        for (auto iter = m_loadedAssets.begin(); iter != m_loadedAssets.end();)
+        {
+            Ref<Asset>& asset = iter->second;
+            // Nothing outside the registry uses the asset and nothing is still importing into it.
+            if (asset->GetAssetState() == AssetState::Loaded
+                && !asset->IsInUse())
+            {
+                asset->OnUnload();
+                iter = m_loadedAssets.erase(iter);
+                ++unloadedAssetCount;
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+        return unloadedAssetCount;
+    }
+
     Ref<Asset> AssetRegistry::LoadAsset(const Core::GUID guid)
     {
         if (!guid.IsValid())
@@ -722,4 +772,72 @@ namespace Insight::Runtime
             return newPath;
         }
     }
-}
\ No newline at end of file
+}
+
+#ifdef IS_TESTING
+#include "Asset/Assets/Model.h"
+#include "ECS/Components/MeshComponent.h"
+
+#include "doctest.h"
+
+namespace test
+{
+    using namespace Insight;
+
+    struct AssetRegistryTestAccess
+    {
+        static void AddLoadedAsset(Runtime::AssetRegistry& registry, const std::string& path, Ref<Runtime::Asset> asset)
+        {
+            asset->m_assetState = Runtime::AssetState::Loaded;
+            registry.m_loadedAssets[path] = asset;
+        }
+
+        static bool IsLoaded(Runtime::AssetRegistry& registry, const std::string& path)
+        {
+            return registry.m_loadedAssets.find(path) != registry.m_loadedAssets.end();
+        }
+
+        static void AddMesh(Runtime::ModelAsset& model, Ref<Runtime::Mesh> mesh, Ref<Runtime::MaterialAsset> material)
+        {
+            mesh->SetMaterial(material);
+            model.m_meshes.push_back(mesh);
+            model.m_materials.push_back(material);
+        }
+    };
+
+    TEST_SUITE("AssetRegistry")
+    {
+        TEST_CASE("Unload unused assets keeps models used by mesh components")
+        {
+            if (Runtime::AssetRegistry::IsValidInstance())
+            {
+                return;
+            }
+            Runtime::AssetRegistry registry;
+
+            const std::string modelPath = "Model.fbx";
+            Ref<Runtime::ModelAsset> model(::New<Runtime::ModelAsset>(nullptr));
+            AssetRegistryTestAccess::AddMesh(*model.Ptr(), ::New<Runtime::Mesh>(), ::New<Runtime::MaterialAsset>(nullptr));
+            model->GetMaterial()->SetProperty(Runtime::MaterialAssetProperty::Opacity, 0.5f);
+            AssetRegistryTestAccess::AddLoadedAsset(registry, modelPath, model);
+
+            {
+                // Components reference the model's mesh and material, never the model itself.
+                ECS::MeshComponent meshComponent;
+                meshComponent.SetMesh(model->GetMesh());
+                meshComponent.SetMaterial(model->GetMaterial());
+                model.Reset();
+
+                CHECK(registry.UnloadUnusedAssets() == 0);
+                CHECK(AssetRegistryTestAccess::IsLoaded(registry, modelPath));
+                CHECK(meshComponent.GetMesh()->GetMaterialAsset() == meshComponent.GetMaterial());
+                CHECK(meshComponent.GetMaterial()->GetProperty(Runtime::MaterialAssetProperty::Opacity) == 0.5f);
+            }
+
+            // Nothing uses the model once the component is gone.
+            CHECK(registry.UnloadUnusedAssets() == 1);
+            CHECK_FALSE(AssetRegistryTestAccess::IsLoaded(registry, modelPath));
+        }
+    }
+}
+#endif
@@ -168,4 +168,84 @@ namespace Insight::Runtime
 
 		m_assetState = AssetState::Unloaded;
 	}
+
+	bool ModelAsset::IsInUse() const
+	{
+		if (Asset::IsInUse())
+		{
+			return true;
+		}
+
+		// Components reference the model's meshes, materials, skeletons and clips directly rather than the model.
+		for (const Ref<Mesh>& mesh : m_meshes)
+		{
+			if (mesh->GetReferenceCount() > 1)
+			{
+				return true;
+			}
+		}
+
+		for (const Ref<MaterialAsset>& material : m_materials)
+		{
+			// Referenced by the model and by each of the model's meshes which use it.
+			u32 ownedReferenceCount = 1;
+			for (const Ref<Mesh>& mesh : m_meshes)
+			{
+				if (mesh->GetMaterialAsset() == material)
+				{
+					++ownedReferenceCount;
+				}
+			}
+			if (material->GetReferenceCount() > ownedReferenceCount)
+			{
+				return true;
+			}
+		}
+
+		for (const Ref<TextureAsset>& texture : m_embeddedTextures)
+		{
+			// Referenced by the model and by each of the model's materials which use it.
+			u32 ownedReferenceCount = 1;
+			for (const Ref<MaterialAsset>& material : m_materials)
+			{
+				for (const Ref<TextureAsset>& materialTexture : material->m_textures)
+				{
+					if (materialTexture == texture)
+					{
+						++ownedReferenceCount;
+					}
+				}
+			}
+			if (texture->GetReferenceCount() > ownedReferenceCount)
+			{
+				return true;
+			}
+		}
+
+		for (const Ref<Skeleton>& skeleton : m_skeletons)
+		{
+			// Referenced by the model and by each of the model's animation clips for it.
+			u32 ownedReferenceCount = 1;
+			for (const Ref<AnimationClip>& animationClip : m_animationClips)
+			{
+				if (animationClip->GetSkeleton() == skeleton.Ptr())
+				{
+					++ownedReferenceCount;
+				}
+			}
+			if (skeleton->GetReferenceCount() > ownedReferenceCount)
+			{
+				return true;
+			}
+		}
+
+		for (const Ref<AnimationClip>& animationClip : m_animationClips)
+		{
+			if (animationClip->GetReferenceCount() > 1)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
 }
\ No newline at end of file
@@ -168,7 +168,8 @@ namespace Insight
 			const u32 indexCount = LODs[0].Index_count;
 			const u32 vertexSize = sizeof(Vertices[0]);
 
-			std::vector<u32> remap(indexCount);
+			Core::ScratchScope scratchScope;
+			Core::ScratchVector<u32> remap(indexCount);
 			const u64 optimisedVertexCount = meshopt_generateVertexRemap(remap.data(), 
 				Indices.data(),
 				indexCount, 
@@ -176,10 +177,10 @@ namespace Insight
 				vertexCount,
 				vertexSize);
 
-			std::vector<u32> optimisedIndices;
+			Core::ScratchVector<u32> optimisedIndices;
 			optimisedIndices.resize(indexCount);
 
-			std::vector<Graphics::Vertex> optimisedVertices;
+			Core::ScratchVector<Graphics::Vertex> optimisedVertices;
 			optimisedVertices.resize(optimisedVertexCount);
 
 			// Optimisation 1: Remove all duplicate vertices
@@ -231,8 +232,8 @@ namespace Insight
 				const float lodSplit = 1.0f - (lodSplitPercentage * lodIdx);
 				const u32 target_index_count = static_cast<u32>(static_cast<float>(LODs.at(0).Index_count) * lodSplit);
 
-				std::vector<u32>::iterator indices_begin = Indices.begin() + LOD0_IndicesStart;
-				std::vector<u32> result_lod;
+				Core::ScratchVector<u32>::iterator indices_begin = Indices.begin() + LOD0_IndicesStart;
+				Core::ScratchVector<u32> result_lod;
 				result_lod.resize(LOD0_IndicesCount);
 
 				// Try and simplify the mesh, try and preserve mesh topology.
@@ -304,6 +305,9 @@ namespace Insight
 		{
 			IS_PROFILE_FUNCTION();
 
+			// Everything allocated from scratch memory while importing is released once the import is done.
+			Core::ScratchScope scratchScope;
+
 			MaterialCache.clear();
 
 			Ref<ModelAsset> modelAsset = asset.As<ModelAsset>();
@@ -475,6 +479,7 @@ namespace Insight
 
 		void ModelImporter::ProcessMeshUfbx(const ufbx_scene* fbxScene, const ufbx_node* fbxNode, const ufbx_mesh* fbxMesh, ModelAsset* modelAsset) const
 		{
+			Core::ScratchScope scratchScope;
 			MeshData meshData;
 			ParseMeshDataUfbx(fbxScene, fbxNode, fbxMesh, meshData, modelAsset);
 			ProcessMesh(meshData, modelAsset);
@@ -489,7 +494,7 @@ namespace Insight
 
 		void ModelImporter::ParseMeshDataUfbx(const ufbx_scene* fbxScene, const ufbx_node* fbxNode, const ufbx_mesh* fbxMesh, MeshData& meshData, ModelAsset* modelAsset) const
 		{
-			std::vector<uint32_t> tri_indices;
+			Core::ScratchVector<uint32_t> tri_indices;
 			tri_indices.resize(fbxMesh->max_face_triangles * 3);
 
 			for (size_t matPartIdx = 0; matPartIdx < fbxMesh->material_parts.count; ++matPartIdx)
@@ -688,6 +693,8 @@ namespace Insight
 			Mesh* mesh = ::New<Mesh>();
 			modelAsset->m_meshes.push_back(mesh);
 
+			// Mesh data is released once uploaded so each mesh reuses the same scratch memory.
+			Core::ScratchScope scratchScope;
 			MeshData meshData = { };
 			ParseMeshData(aiScene, aiNode, aiMesh, meshData, modelAsset);
 
@@ -753,6 +760,8 @@ namespace Insight
 					meshLod.Vertex_buffer->SetName(vertexBufferName);
 					meshLod.Index_buffer->SetName(indexBufferName);
 				}
+
+				mesh->SetOccluderGeometry(meshData.Vertices.data(), meshData.Indices.data());
 			}
 
 			if (aiScene->HasMaterials())
@@ -769,7 +778,8 @@ namespace Insight
 		{
 			IS_PROFILE_FUNCTION();
 
-			//meshData.Vertices.reserve(meshData.Vertices.size() + static_cast<u64>(aiMesh->mNumVertices));
+			meshData.Vertices.reserve(meshData.Vertices.size() + static_cast<u64>(aiMesh->mNumVertices));
+			meshData.VerticesBoneInfluence.reserve(meshData.VerticesBoneInfluence.size() + static_cast<u64>(aiMesh->mNumVertices));
 			/// walk through each of the mesh's vertices
 			for (unsigned int i = 0; i < aiMesh->mNumVertices; ++i)
 			{
@@ -839,7 +849,7 @@ namespace Insight
 				meshData.VerticesBoneInfluence.push_back(Graphics::VertexBoneInfluence());
 			}
 
-			//meshData.Indices.reserve(meshData.Indices.size() + (static_cast<u64>(aiMesh->mNumFaces) * 3));
+			meshData.Indices.reserve(meshData.Indices.size() + (static_cast<u64>(aiMesh->mNumFaces) * 3));
 			/// Now walk through each of the mesh's faces (a face is a mesh its triangle) and retrieve the corresponding vertex indices.
 			for (unsigned int i = 0; i < aiMesh->mNumFaces; ++i)
 			{
@@ -1428,6 +1438,8 @@ namespace Insight
 					meshLod.Vertex_buffer->SetName(vertexBufferName);
 					meshLod.Index_buffer->SetName(indexBufferName);
 				}
+
+				mesh->SetOccluderGeometry(meshData->Vertices.data(), meshData->Indices.data());
 			}
 		}
 
@@ -1632,6 +1644,8 @@ namespace Insight
 					meshLod.Vertex_buffer->SetName(vertexBufferName);
 					meshLod.Index_buffer->SetName(indexBufferName);
 				}
+
+				mesh->SetOccluderGeometry(meshData.Vertices.data(), meshData.Indices.data());
 			}
 		}
 
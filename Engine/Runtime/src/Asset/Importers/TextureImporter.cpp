@@ -7,10 +7,16 @@
 #include "Core/Logger.h"
 #include "Core/Profiler.h"
 #include "Platforms/Platform.h"
+#include "Memory/ScratchAllocator.h"
 
 
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_STATIC
+// Decoded images are copied to the GPU upload buffer straight away, so stbi's buffers come from scratch memory
+// released at the end of 'ImportFromMemory'.
+#define STBI_MALLOC(size)                           ::Insight::Core::ScratchAllocator::GetThreadAllocator().Allocate(size)
+#define STBI_REALLOC_SIZED(ptr, oldSize, newSize)   ::Insight::Core::ScratchAllocator::GetThreadAllocator().Reallocate(ptr, oldSize, newSize)
+#define STBI_FREE(ptr)                              ((void)(ptr))
 #include <stb_image.h>
 
 //#define QOI_IMPLEMENTATION
@@ -48,6 +54,8 @@ namespace Insight
 
         void TextureImporter::ImportFromMemory(Ref<Asset> asset, const void* data, const u64 dataSize) const
         {
+            Core::ScratchScope scratchScope;
+
             std::string_view path = asset->GetAssetInfo()->FilePath;
             if (data == nullptr || dataSize == 0)
             {
@@ -7,6 +7,8 @@
 #include "ECS/Components/TagComponent.h"
 #include "ECS/RegisterComponents.gen.h"
 
+#include <algorithm>
+
 namespace Insight
 {
 	namespace ECS
@@ -219,18 +221,15 @@ namespace Insight
 			{
 				std::lock_guard lock(m_lock);
 
-				u32 index = 0;
-				for (UPtr<Entity>& e : m_entities)
-				{
-					if (e == entity)
+				// Search from the back, recently spawned entities are the most likely to be removed and erasing
+				// near the end moves the fewest entities.
+				auto iter = std::find_if(m_entities.rbegin(), m_entities.rend(), [entity](const UPtr<Entity>& e)
 					{
-						entityToDelete = std::move(e);
-						break;
-					}
-					++index;
-				}
-				ASSERT(entityToDelete.IsValid());
-				m_entities.erase(m_entities.begin() + index);
+						return e == entity;
+					});
+				ASSERT(iter != m_entities.rend());
+				entityToDelete = std::move(*iter);
+				m_entities.erase(std::next(iter).base());
 			}
 
 			entityToDelete->Destroy();
@@ -412,4 +411,54 @@ TEST_SUITE("Entity Manager")
 		CHECK(!e.IsVaild());
 	}
 }
-#endif
\ No newline at end of file
+#endif
+
+#if defined(IS_TESTING) && !defined(IS_ECS_ENABLED)
+#include "doctest.h"
+#include "Core/Timer.h"
+
+namespace test
+{
+	using namespace Insight;
+
+	TEST_SUITE("EntityManager")
+	{
+		TEST_CASE("Spawn and despawn 100k entities")
+		{
+			constexpr u32 c_EntityCount = 100'000;
+			ECS::EntityManager entityManager;
+
+			std::vector<ECS::Entity*> entities;
+			entities.reserve(c_EntityCount);
+
+			Core::Timer spawnTimer;
+			spawnTimer.Start();
+			for (u32 entityIdx = 0; entityIdx < c_EntityCount; ++entityIdx)
+			{
+				entities.push_back(entityManager.AddNewEntity());
+			}
+			spawnTimer.Stop();
+			CHECK(entityManager.GetEntityCount() == c_EntityCount);
+
+			Core::Timer despawnTimer;
+			despawnTimer.Start();
+			for (u32 entityIdx = c_EntityCount; entityIdx > 0; --entityIdx)
+			{
+				ECS::Entity* entity = entities[entityIdx - 1];
+				entityManager.RemoveEntity(entity);
+			}
+			despawnTimer.Stop();
+			CHECK(entityManager.GetEntityCount() == 0);
+
+#ifdef IS_OBJECT_POOLS
+			const char* objectPools = "on";
+#else
+			const char* objectPools = "off";
+#endif
+			MESSAGE("Object pools: " << objectPools
+				<< " | Spawn entities/s: " << c_EntityCount / (spawnTimer.GetElapsedTimeNano().count() / 1'000'000'000.0)
+				<< " | Despawn entities/s: " << c_EntityCount / (despawnTimer.GetElapsedTimeNano().count() / 1'000'000'000.0));
+		}
+	}
+}
+#endif
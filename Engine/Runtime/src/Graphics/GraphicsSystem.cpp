@@ -9,6 +9,9 @@
 
 #include "Core/CommandLineArgs.h"
 #include "Core/Profiler.h"
+#include "Core/Timer.h"
+
+#include "Threading/TaskSystem.h"
 
 namespace Insight
 {
@@ -54,6 +57,8 @@ namespace Insight
 		{
 			IS_PROFILE_FUNCTION();
 
+			WaitForRenderFramePreparation();
+			m_renderFramePreparationTask.reset();
 			m_renderFrame.Clear();
 
 			if (m_context)
@@ -76,6 +81,8 @@ namespace Insight
 
 		void GraphicsSystem::Render()
 		{
+			WaitForRenderFramePreparation();
+
 			const u32 width = Graphics::Window::Instance().GetWidth();
 			const u32 height = Graphics::Window::Instance().GetHeight();
 			Graphics::RenderGraph::Instance().SetOutputResolution(Maths::Vector2(width, height));
@@ -89,18 +96,69 @@ namespace Insight
 
 		void GraphicsSystem::CreateRenderFrame()
 		{
+			ExtractRenderFrame();
+			PrepareRenderFrame();
+		}
+
+		void GraphicsSystem::ExtractRenderFrame()
+		{
+			IS_PROFILE_FUNCTION();
+			WaitForRenderFramePreparation();
+
 			WorldSystem* worldSystem = App::Engine::Instance().GetSystemRegistry().GetSystem<WorldSystem>();
 			if (worldSystem)
 			{
-				m_renderFrame.GetCurrent().CreateRenderFrameFromWorldSystem(worldSystem);
+				m_renderFrame.GetCurrent().CreateRenderFrameFromWorldSystem(worldSystem, false);
+			}
+		}
+
+		void GraphicsSystem::PrepareRenderFrame()
+		{
+			WaitForRenderFramePreparation();
+			PrepareRenderFrame(m_renderFrame.GetCurrent());
+		}
+
+		void GraphicsSystem::PrepareRenderFrameAsync()
+		{
+			IS_PROFILE_FUNCTION();
+			ASSERT(Platform::IsMainThread());
+			WaitForRenderFramePreparation();
+
+			// The render frame is only swapped from 'Render' on the main thread, so the current frame
+			// can't change under the task.
+			RenderFrame* renderFrame = &m_renderFrame.GetCurrent();
+			m_renderFramePreparationTask = Threading::TaskSystem::CreateTaskWithPriority(Threading::TaskPriority::FrameCritical, [this, renderFrame]()
+				{
+					PrepareRenderFrame(*renderFrame);
+				});
+		}
+
+		void GraphicsSystem::WaitForRenderFramePreparation() const
+		{
+			if (m_renderFramePreparationTask)
+			{
+				IS_PROFILE_FUNCTION();
+				m_renderFramePreparationTask->Wait();
 			}
 		}
 
 		const RenderFrame& GraphicsSystem::GetRenderFrame() const
 		{
+			WaitForRenderFramePreparation();
 			return m_renderFrame.GetCurrent();
 		}
 
+		void GraphicsSystem::PrepareRenderFrame(RenderFrame& renderFrame)
+		{
+			IS_PROFILE_FUNCTION();
+			Core::Timer preparationTimer;
+			preparationTimer.Start();
+			renderFrame.Cull();
+			renderFrame.Sort();
+			preparationTimer.Stop();
+			m_renderFramePreparationTime = static_cast<float>(preparationTimer.GetElapsedTimeNano().count() / 1'000'000.0);
+		}
+
 		void GraphicsSystem::InitialiseRenderContext(Graphics::GraphicsAPI graphicsAPI)
 		{
 			m_context = Graphics::RenderContext::New(graphicsAPI);
@@ -0,0 +1,1002 @@
+#include "Graphics/OcclusionCulling.h"
+#include "Graphics/RenderCulling.h"
+
+#include "Core/Profiler.h"
+#include "Threading/Parallel.h"
+
+#include "Maths/Vector4.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define IS_OCCLUSION_CULLING_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Insight
+{
+    namespace
+    {
+        /// @brief Working layer depth when the layer is empty, 'min' with any triangle depth gives the triangle's.
+        constexpr float c_LayerCleared = std::numeric_limits<float>::max();
+        constexpr u32 c_FullCoverage = 0xFFFFFFFF;
+        /// @brief Triangles with less screen area than this (in pixels) can't cover a pixel centre reliably.
+        constexpr float c_MinTriangleArea = 1.0e-4f;
+
+        std::atomic<bool> s_occlusionCullingEnabled = true;
+        std::mutex s_sceneDumpLock;
+        std::string s_sceneDumpPath;
+
+        /// @brief Bit 'row * 8 + column' is set for each pixel centre of the tile at (tileX, tileY) inside all three edges.
+        u32 GetTileCoverage(const float* edgeA, const float* edgeB, const float* edgeC, const float tileX, const float tileY)
+        {
+            u32 coverage = c_FullCoverage;
+            for (int edge = 0; edge < 3 && coverage != 0; ++edge)
+            {
+                const float a = edgeA[edge];
+                const float b = edgeB[edge];
+                const float rowStart = a * tileX + b * (tileY + 0.5f) + edgeC[edge];
+                u32 edgeMask = 0;
+#ifdef IS_OCCLUSION_CULLING_SSE2
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 columnOffsets = _mm_mul_ps(_mm_set1_ps(a), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+                const __m128 halfTileStep = _mm_set1_ps(a * 4.0f);
+                for (u32 row = 0; row < OcclusionBuffer::c_TileHeight; ++row)
+                {
+                    const __m128 left = _mm_add_ps(_mm_set1_ps(rowStart + b * static_cast<float>(row)), columnOffsets);
+                    const __m128 right = _mm_add_ps(left, halfTileStep);
+                    const u32 rowMask = static_cast<u32>(_mm_movemask_ps(_mm_cmpge_ps(left, zero)))
+                        | (static_cast<u32>(_mm_movemask_ps(_mm_cmpge_ps(right, zero))) << 4);
+                    edgeMask |= rowMask << (row * OcclusionBuffer::c_TileWidth);
+                }
+#else
+                for (u32 row = 0; row < OcclusionBuffer::c_TileHeight; ++row)
+                {
+                    const float rowValue = rowStart + b * static_cast<float>(row);
+                    for (u32 column = 0; column < OcclusionBuffer::c_TileWidth; ++column)
+                    {
+                        const bool inside = rowValue + a * (static_cast<float>(column) + 0.5f) >= 0.0f;
+                        edgeMask |= static_cast<u32>(inside) << (row * OcclusionBuffer::c_TileWidth + column);
+                    }
+                }
+#endif
+                coverage &= edgeMask;
+            }
+            return coverage;
+        }
+
+#ifdef IS_OCCLUSION_CULLING_SSE2
+        float HorizontalMin(const __m128 value)
+        {
+            const __m128 pairs = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(_mm_min_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(2, 3, 0, 1))));
+        }
+        float HorizontalMax(const __m128 value)
+        {
+            const __m128 pairs = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(_mm_max_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(2, 3, 0, 1))));
+        }
+#endif
+
+        template<typename T>
+        void WriteValue(std::ofstream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+        template<typename T>
+        bool ReadValue(std::ifstream& stream, T& value)
+        {
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+        void WriteMatrix(std::ofstream& stream, const Maths::Matrix4& matrix)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                for (int row = 0; row < 4; ++row)
+                {
+                    WriteValue(stream, matrix[column][row]);
+                }
+            }
+        }
+        bool ReadMatrix(std::ifstream& stream, Maths::Matrix4& matrix)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                for (int row = 0; row < 4; ++row)
+                {
+                    float value = 0.0f;
+                    if (!ReadValue(stream, value))
+                    {
+                        return false;
+                    }
+                    matrix[column][row] = value;
+                }
+            }
+            return true;
+        }
+
+        void WriteVector3(std::ofstream& stream, const Maths::Vector3& vector)
+        {
+            WriteValue(stream, vector.x);
+            WriteValue(stream, vector.y);
+            WriteValue(stream, vector.z);
+        }
+        bool ReadVector3(std::ifstream& stream, Maths::Vector3& vector)
+        {
+            float x = 0.0f, y = 0.0f, z = 0.0f;
+            if (!ReadValue(stream, x) || !ReadValue(stream, y) || !ReadValue(stream, z))
+            {
+                return false;
+            }
+            vector = Maths::Vector3(x, y, z);
+            return true;
+        }
+
+        constexpr u32 c_SceneFileMagic = 0x434F5349; // "ISOC"
+        constexpr u32 c_SceneFileVersion = 1;
+    }
+
+    //=====================================================
+    // OcclusionBuffer
+    //=====================================================
+    OcclusionBuffer::OcclusionBuffer(const u32 width, const u32 height)
+    {
+        Resize(width, height);
+    }
+
+    void OcclusionBuffer::Resize(const u32 width, const u32 height)
+    {
+        m_tilesX = std::max<u32>(1, static_cast<u32>(IntDivideRoundUp(width, c_TileWidth)));
+        m_tilesY = std::max<u32>(1, static_cast<u32>(IntDivideRoundUp(height, c_TileHeight)));
+        m_width = m_tilesX * c_TileWidth;
+        m_height = m_tilesY * c_TileHeight;
+        m_blocksX = static_cast<u32>(IntDivideRoundUp(m_tilesX, c_BlockSize));
+        m_blocksY = static_cast<u32>(IntDivideRoundUp(m_tilesY, c_BlockSize));
+
+        const u64 tileCount = static_cast<u64>(m_tilesX) * m_tilesY;
+        m_tileMasks.assign(tileCount, 0);
+        m_tileReferenceDepths.assign(tileCount, 0.0f);
+        m_tileLayerDepths.assign(tileCount, c_LayerCleared);
+        m_blockReferenceDepths.assign(static_cast<u64>(m_blocksX) * m_blocksY, 0.0f);
+    }
+
+    void OcclusionBuffer::Begin(const Maths::Matrix4& projectionView, const float nearPlane)
+    {
+        m_projectionView = projectionView;
+        m_nearPlane = std::max(nearPlane, 1.0e-4f);
+
+        std::fill(m_tileMasks.begin(), m_tileMasks.end(), 0);
+        std::fill(m_tileReferenceDepths.begin(), m_tileReferenceDepths.end(), 0.0f);
+        std::fill(m_tileLayerDepths.begin(), m_tileLayerDepths.end(), c_LayerCleared);
+        std::fill(m_blockReferenceDepths.begin(), m_blockReferenceDepths.end(), 0.0f);
+        for (u64 chunkIdx = 0; chunkIdx < m_triangleChunkCount; ++chunkIdx)
+        {
+            m_triangleChunks[chunkIdx].clear();
+        }
+        m_triangleChunkCount = 0;
+    }
+
+    void OcclusionBuffer::RenderOccluders(const OccluderInstance* occluders, const u64 count)
+    {
+        IS_PROFILE_FUNCTION();
+
+        const u64 firstChunk = m_triangleChunkCount;
+        m_triangleChunkCount += IntDivideRoundUp(count, c_OccluderGrainSize);
+        if (m_triangleChunks.size() < m_triangleChunkCount)
+        {
+            m_triangleChunks.resize(m_triangleChunkCount);
+        }
+        {
+            IS_PROFILE_SCOPE("Setup");
+            Threading::ParallelForRange(count, c_OccluderGrainSize, [this, occluders, firstChunk](const u64 begin, const u64 end)
+                {
+                    std::vector<ScreenTriangle>& triangles = m_triangleChunks[firstChunk + begin / c_OccluderGrainSize];
+                    for (u64 occluderIdx = begin; occluderIdx < end; ++occluderIdx)
+                    {
+                        SetupOccluder(occluders[occluderIdx], triangles);
+                    }
+                });
+        }
+        {
+            // Each row of tiles is only written by one task.
+            IS_PROFILE_SCOPE("Rasterise");
+            Threading::ParallelForRange(m_tilesY, c_TileRowGrainSize, [this, firstChunk](const u64 begin, const u64 end)
+                {
+                    RasteriseTileRows(static_cast<u32>(begin), static_cast<u32>(end), firstChunk);
+                });
+        }
+        UpdateBlocks();
+    }
+
+    bool OcclusionBuffer::IsVisible(const Graphics::BoundingBox& worldBounds) const
+    {
+        // Corners are the clip space min corner plus any combination of the clip space axes.
+        const Maths::Vector3 size = worldBounds.GetSize();
+        const Maths::Vector4 origin = m_projectionView * Maths::Vector4(worldBounds.GetMin(), 1.0f);
+        const Maths::Vector4 axisX = m_projectionView[0] * size.x;
+        const Maths::Vector4 axisY = m_projectionView[1] * size.y;
+        const Maths::Vector4 axisZ = m_projectionView[2] * size.z;
+
+        float minX, minY, maxX, maxY, nearestDepth;
+#ifdef IS_OCCLUSION_CULLING_SSE2
+        {
+            // Corners 0-3 in 'low', 4-7 (plus axisZ) in 'high'.
+            const auto cornerComponent = [](const float origin, const float axisX, const float axisY, const float axisZ, __m128& low, __m128& high)
+            {
+                low = _mm_add_ps(_mm_set1_ps(origin), _mm_setr_ps(0.0f, axisX, axisY, axisX + axisY));
+                high = _mm_add_ps(low, _mm_set1_ps(axisZ));
+            };
+            __m128 xLow, xHigh, yLow, yHigh, wLow, wHigh;
+            cornerComponent(origin.x, axisX.x, axisY.x, axisZ.x, xLow, xHigh);
+            cornerComponent(origin.y, axisX.y, axisY.y, axisZ.y, yLow, yHigh);
+            cornerComponent(origin.w, axisX.w, axisY.w, axisZ.w, wLow, wHigh);
+
+            const __m128 nearPlane = _mm_set1_ps(m_nearPlane);
+            if (_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(wLow, nearPlane), _mm_cmplt_ps(wHigh, nearPlane))) != 0)
+            {
+                return true;
+            }
+
+            const __m128 half = _mm_set1_ps(0.5f);
+            const __m128 width = _mm_set1_ps(static_cast<float>(m_width));
+            const __m128 height = _mm_set1_ps(static_cast<float>(m_height));
+            const __m128 inverseWLow = _mm_div_ps(_mm_set1_ps(1.0f), wLow);
+            const __m128 inverseWHigh = _mm_div_ps(_mm_set1_ps(1.0f), wHigh);
+            const __m128 screenXLow = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(xLow, inverseWLow), half), half), width);
+            const __m128 screenXHigh = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(xHigh, inverseWHigh), half), half), width);
+            const __m128 screenYLow = _mm_mul_ps(_mm_sub_ps(half, _mm_mul_ps(_mm_mul_ps(yLow, inverseWLow), half)), height);
+            const __m128 screenYHigh = _mm_mul_ps(_mm_sub_ps(half, _mm_mul_ps(_mm_mul_ps(yHigh, inverseWHigh), half)), height);
+
+            minX = HorizontalMin(_mm_min_ps(screenXLow, screenXHigh));
+            maxX = HorizontalMax(_mm_max_ps(screenXLow, screenXHigh));
+            minY = HorizontalMin(_mm_min_ps(screenYLow, screenYHigh));
+            maxY = HorizontalMax(_mm_max_ps(screenYLow, screenYHigh));
+            nearestDepth = HorizontalMax(_mm_max_ps(inverseWLow, inverseWHigh));
+        }
+#else
+        minX = std::numeric_limits<float>::max();
+        minY = std::numeric_limits<float>::max();
+        maxX = std::numeric_limits<float>::lowest();
+        maxY = std::numeric_limits<float>::lowest();
+        nearestDepth = 0.0f;
+        for (u32 corner = 0; corner < 8; ++corner)
+        {
+            Maths::Vector4 clip = origin;
+            if (corner & 1) { clip = clip + axisX; }
+            if (corner & 2) { clip = clip + axisY; }
+            if (corner & 4) { clip = clip + axisZ; }
+            if (clip.w < m_nearPlane)
+            {
+                return true;
+            }
+
+            const float inverseW = 1.0f / clip.w;
+            const float screenX = (clip.x * inverseW * 0.5f + 0.5f) * static_cast<float>(m_width);
+            const float screenY = (0.5f - clip.y * inverseW * 0.5f) * static_cast<float>(m_height);
+            minX = std::min(minX, screenX);
+            maxX = std::max(maxX, screenX);
+            minY = std::min(minY, screenY);
+            maxY = std::max(maxY, screenY);
+            nearestDepth = std::max(nearestDepth, inverseW);
+        }
+#endif
+
+        if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(m_width) || minY >= static_cast<float>(m_height))
+        {
+            return false;
+        }
+
+        const u32 tileMinX = static_cast<u32>(std::max(minX, 0.0f)) / c_TileWidth;
+        const u32 tileMinY = static_cast<u32>(std::max(minY, 0.0f)) / c_TileHeight;
+        const u32 tileMaxX = static_cast<u32>(std::min(maxX, static_cast<float>(m_width - 1))) / c_TileWidth;
+        const u32 tileMaxY = static_cast<u32>(std::min(maxY, static_cast<float>(m_height - 1))) / c_TileHeight;
+
+        // Hidden if it is behind every block it touches, the blocks cover at least the tiles it touches.
+        float blockFarthestDepth = std::numeric_limits<float>::max();
+        for (u32 blockY = tileMinY / c_BlockSize; blockY <= tileMaxY / c_BlockSize; ++blockY)
+        {
+            const float* blockDepths = m_blockReferenceDepths.data() + static_cast<u64>(blockY) * m_blocksX;
+            for (u32 blockX = tileMinX / c_BlockSize; blockX <= tileMaxX / c_BlockSize; ++blockX)
+            {
+                blockFarthestDepth = std::min(blockFarthestDepth, blockDepths[blockX]);
+            }
+        }
+        if (nearestDepth < blockFarthestDepth)
+        {
+            return false;
+        }
+
+        for (u32 tileY = tileMinY; tileY <= tileMaxY; ++tileY)
+        {
+            const float* referenceDepths = m_tileReferenceDepths.data() + static_cast<u64>(tileY) * m_tilesX;
+            for (u32 tileX = tileMinX; tileX <= tileMaxX; ++tileX)
+            {
+                if (referenceDepths[tileX] <= nearestDepth)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    u64 OcclusionBuffer::RemoveOccluded(const RenderCullingBounds& bounds, u32* meshIndexs, const u64 count) const
+    {
+        IS_PROFILE_FUNCTION();
+
+        // Each chunk compacts its own range, then the ranges are packed together.
+        std::vector<u64> chunkVisibleCounts(IntDivideRoundUp(count, c_OccludeeGrainSize), 0);
+        Threading::ParallelForRange(count, c_OccludeeGrainSize, [&](const u64 begin, const u64 end)
+            {
+                u64 visibleCount = begin;
+                for (u64 i = begin; i < end; ++i)
+                {
+                    const u32 meshIndex = meshIndexs[i];
+                    const Graphics::BoundingBox worldBounds(
+                        Maths::Vector3(bounds.MinX[meshIndex], bounds.MinY[meshIndex], bounds.MinZ[meshIndex]),
+                        Maths::Vector3(bounds.MaxX[meshIndex], bounds.MaxY[meshIndex], bounds.MaxZ[meshIndex]));
+                    if (IsVisible(worldBounds))
+                    {
+                        meshIndexs[visibleCount++] = meshIndex;
+                    }
+                }
+                chunkVisibleCounts[begin / c_OccludeeGrainSize] = visibleCount - begin;
+            });
+
+        u64 visibleCount = 0;
+        for (u64 chunkIdx = 0; chunkIdx < chunkVisibleCounts.size(); ++chunkIdx)
+        {
+            const u64 chunkBegin = chunkIdx * c_OccludeeGrainSize;
+            if (chunkBegin != visibleCount)
+            {
+                std::memmove(meshIndexs + visibleCount, meshIndexs + chunkBegin, sizeof(u32) * chunkVisibleCounts[chunkIdx]);
+            }
+            visibleCount += chunkVisibleCounts[chunkIdx];
+        }
+        return visibleCount;
+    }
+
+    u64 OcclusionBuffer::GetTriangleCount() const
+    {
+        u64 triangleCount = 0;
+        for (u64 chunkIdx = 0; chunkIdx < m_triangleChunkCount; ++chunkIdx)
+        {
+            triangleCount += m_triangleChunks[chunkIdx].size();
+        }
+        return triangleCount;
+    }
+
+    std::vector<float> OcclusionBuffer::GetTileDepths() const
+    {
+        std::vector<float> depths(static_cast<u64>(m_width) * m_height);
+        for (u32 y = 0; y < m_height; ++y)
+        {
+            for (u32 x = 0; x < m_width; ++x)
+            {
+                depths[static_cast<u64>(y) * m_width + x] = m_tileReferenceDepths[static_cast<u64>(y / c_TileHeight) * m_tilesX + x / c_TileWidth];
+            }
+        }
+        return depths;
+    }
+
+    void OcclusionBuffer::SetupOccluder(const OccluderInstance& occluder, std::vector<ScreenTriangle>& triangles) const
+    {
+        const OccluderGeometry& geometry = *occluder.Geometry;
+        const Maths::Matrix4 objectToClip = m_projectionView * occluder.Transform;
+
+        // Reused by every occluder set up on this thread.
+        thread_local std::vector<Maths::Vector4> clipPositions;
+        clipPositions.resize(geometry.Positions.size());
+        for (u64 vertexIdx = 0; vertexIdx < geometry.Positions.size(); ++vertexIdx)
+        {
+            clipPositions[vertexIdx] = objectToClip * Maths::Vector4(geometry.Positions[vertexIdx], 1.0f);
+        }
+
+        for (u64 index = 0; index + 2 < geometry.Indices.size(); index += 3)
+        {
+            const Maths::Vector4 clipVertices[3] =
+            {
+                clipPositions[geometry.Indices[index]],
+                clipPositions[geometry.Indices[index + 1]],
+                clipPositions[geometry.Indices[index + 2]],
+            };
+            SetupTriangle(clipVertices, triangles);
+        }
+    }
+
+    void OcclusionBuffer::SetupTriangle(const Maths::Vector4* clipVertices, std::vector<ScreenTriangle>& triangles) const
+    {
+        // Clip to w >= near, the part in front of the near plane isn't drawn so it can't hide anything.
+        Maths::Vector4 polygon[4];
+        u32 polygonSize = 0;
+        for (u32 vertexIdx = 0; vertexIdx < 3; ++vertexIdx)
+        {
+            const Maths::Vector4& current = clipVertices[vertexIdx];
+            const Maths::Vector4& next = clipVertices[(vertexIdx + 1) % 3];
+            const bool currentInside = current.w >= m_nearPlane;
+            const bool nextInside = next.w >= m_nearPlane;
+            if (currentInside)
+            {
+                polygon[polygonSize++] = current;
+            }
+            if (currentInside != nextInside)
+            {
+                const float t = (m_nearPlane - current.w) / (next.w - current.w);
+                polygon[polygonSize++] = current + (next - current) * t;
+            }
+        }
+        if (polygonSize < 3)
+        {
+            return;
+        }
+
+        float screenX[4];
+        float screenY[4];
+        float depth[4];
+        for (u32 vertexIdx = 0; vertexIdx < polygonSize; ++vertexIdx)
+        {
+            const float inverseW = 1.0f / polygon[vertexIdx].w;
+            screenX[vertexIdx] = (polygon[vertexIdx].x * inverseW * 0.5f + 0.5f) * static_cast<float>(m_width);
+            screenY[vertexIdx] = (0.5f - polygon[vertexIdx].y * inverseW * 0.5f) * static_cast<float>(m_height);
+            depth[vertexIdx] = inverseW;
+        }
+
+        for (u32 fanIdx = 1; fanIdx + 1 < polygonSize; ++fanIdx)
+        {
+            u32 v0 = 0;
+            u32 v1 = fanIdx;
+            u32 v2 = fanIdx + 1;
+
+            float area = (screenX[v1] - screenX[v0]) * (screenY[v2] - screenY[v0]) - (screenX[v2] - screenX[v0]) * (screenY[v1] - screenY[v0]);
+            if (!(std::abs(area) >= c_MinTriangleArea))
+            {
+                continue;
+            }
+            // Both windings are occluders, flip to make the edge functions positive inside.
+            if (area < 0.0f)
+            {
+                std::swap(v1, v2);
+                area = -area;
+            }
+
+            const float minX = std::min({ screenX[v0], screenX[v1], screenX[v2] });
+            const float maxX = std::max({ screenX[v0], screenX[v1], screenX[v2] });
+            const float minY = std::min({ screenY[v0], screenY[v1], screenY[v2] });
+            const float maxY = std::max({ screenY[v0], screenY[v1], screenY[v2] });
+            if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(m_width) || minY >= static_cast<float>(m_height))
+            {
+                continue;
+            }
+
+            ScreenTriangle triangle;
+            triangle.MinX = static_cast<int>(std::max(minX, 0.0f));
+            triangle.MinY = static_cast<int>(std::max(minY, 0.0f));
+            triangle.MaxX = static_cast<int>(std::min(maxX, static_cast<float>(m_width - 1)));
+            triangle.MaxY = static_cast<int>(std::min(maxY, static_cast<float>(m_height - 1)));
+
+            const u32 vertexIndexs[3] = { v0, v1, v2 };
+            for (u32 edge = 0; edge < 3; ++edge)
+            {
+                const u32 from = vertexIndexs[edge];
+                const u32 to = vertexIndexs[(edge + 1) % 3];
+                triangle.EdgeA[edge] = screenY[from] - screenY[to];
+                triangle.EdgeB[edge] = screenX[to] - screenX[from];
+                triangle.EdgeC[edge] = -(triangle.EdgeA[edge] * screenX[from] + triangle.EdgeB[edge] * screenY[from]);
+            }
+
+            // 1/w is linear in screen space.
+            const float dx1 = screenX[v1] - screenX[v0];
+            const float dy1 = screenY[v1] - screenY[v0];
+            const float dx2 = screenX[v2] - screenX[v0];
+            const float dy2 = screenY[v2] - screenY[v0];
+            const float dz1 = depth[v1] - depth[v0];
+            const float dz2 = depth[v2] - depth[v0];
+            triangle.DepthA = (dz1 * dy2 - dz2 * dy1) / area;
+            triangle.DepthB = (dz2 * dx1 - dz1 * dx2) / area;
+            triangle.DepthC = depth[v0] - triangle.DepthA * screenX[v0] - triangle.DepthB * screenY[v0];
+            triangle.MinDepth = std::min({ depth[v0], depth[v1], depth[v2] });
+
+            triangles.push_back(triangle);
+        }
+    }
+
+    void OcclusionBuffer::RasteriseTileRows(const u32 beginRow, const u32 endRow, const u64 firstChunk)
+    {
+        const int bandMinY = static_cast<int>(beginRow * c_TileHeight);
+        const int bandMaxY = static_cast<int>(endRow * c_TileHeight) - 1;
+
+        for (u64 chunkIdx = firstChunk; chunkIdx < m_triangleChunkCount; ++chunkIdx)
+        {
+            for (const ScreenTriangle& triangle : m_triangleChunks[chunkIdx])
+            {
+                if (triangle.MaxY < bandMinY || triangle.MinY > bandMaxY)
+                {
+                    continue;
+                }
+
+                const u32 tileMinX = static_cast<u32>(triangle.MinX) / c_TileWidth;
+                const u32 tileMaxX = static_cast<u32>(triangle.MaxX) / c_TileWidth;
+                const u32 tileMinY = std::max(static_cast<u32>(triangle.MinY) / c_TileHeight, beginRow);
+                const u32 tileMaxY = std::min(static_cast<u32>(triangle.MaxY) / c_TileHeight, endRow - 1);
+                for (u32 tileRow = tileMinY; tileRow <= tileMaxY; ++tileRow)
+                {
+                    const float tileY = static_cast<float>(tileRow * c_TileHeight);
+                    for (u32 tileX = tileMinX; tileX <= tileMaxX; ++tileX)
+                    {
+                        const u32 tileIndex = tileRow * m_tilesX + tileX;
+                        const float x = static_cast<float>(tileX * c_TileWidth);
+
+                        // Farthest depth of the triangle inside the tile, from the plane at the farthest tile corner.
+                        const float planeX = triangle.DepthA < 0.0f ? x + c_TileWidth : x;
+                        const float planeY = triangle.DepthB < 0.0f ? tileY + c_TileHeight : tileY;
+                        const float planeDepth = triangle.DepthA * planeX + triangle.DepthB * planeY + triangle.DepthC;
+                        const float triangleDepth = std::max(planeDepth, triangle.MinDepth);
+                        if (triangleDepth <= m_tileReferenceDepths[tileIndex])
+                        {
+                            continue;
+                        }
+
+                        const u32 coverage = GetTileCoverage(triangle.EdgeA, triangle.EdgeB, triangle.EdgeC, x, tileY);
+                        if (coverage != 0)
+                        {
+                            UpdateTile(tileIndex, coverage, triangleDepth);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void OcclusionBuffer::UpdateTile(const u32 tileIndex, const u32 coverage, const float triangleDepth)
+    {
+        float& referenceDepth = m_tileReferenceDepths[tileIndex];
+        if (coverage == c_FullCoverage)
+        {
+            // Covers every pixel on its own, the working layer is still valid for its pixels.
+            referenceDepth = std::max(referenceDepth, triangleDepth);
+            return;
+        }
+
+        float& layerDepth = m_tileLayerDepths[tileIndex];
+        u32& mask = m_tileMasks[tileIndex];
+        layerDepth = std::min(layerDepth, triangleDepth);
+        mask |= coverage;
+        if (mask == c_FullCoverage)
+        {
+            referenceDepth = std::max(referenceDepth, layerDepth);
+            layerDepth = c_LayerCleared;
+            mask = 0;
+        }
+    }
+
+    void OcclusionBuffer::UpdateBlocks()
+    {
+        for (u32 blockY = 0; blockY < m_blocksY; ++blockY)
+        {
+            for (u32 blockX = 0; blockX < m_blocksX; ++blockX)
+            {
+                float farthestDepth = std::numeric_limits<float>::max();
+                const u32 tileEndY = std::min((blockY + 1) * c_BlockSize, m_tilesY);
+                const u32 tileEndX = std::min((blockX + 1) * c_BlockSize, m_tilesX);
+                for (u32 tileY = blockY * c_BlockSize; tileY < tileEndY; ++tileY)
+                {
+                    for (u32 tileX = blockX * c_BlockSize; tileX < tileEndX; ++tileX)
+                    {
+                        farthestDepth = std::min(farthestDepth, m_tileReferenceDepths[static_cast<u64>(tileY) * m_tilesX + tileX]);
+                    }
+                }
+                m_blockReferenceDepths[static_cast<u64>(blockY) * m_blocksX + blockX] = farthestDepth;
+            }
+        }
+    }
+
+    //=====================================================
+    // OcclusionScene
+    //=====================================================
+    bool OcclusionScene::Save(std::string_view filePath) const
+    {
+        std::ofstream stream(std::string(filePath), std::ios::binary | std::ios::trunc);
+        if (!stream.is_open())
+        {
+            return false;
+        }
+
+        WriteValue(stream, c_SceneFileMagic);
+        WriteValue(stream, c_SceneFileVersion);
+        WriteMatrix(stream, ProjectionView);
+        WriteValue(stream, NearPlane);
+
+        WriteValue(stream, static_cast<u64>(Geometries.size()));
+        for (const OccluderGeometry& geometry : Geometries)
+        {
+            WriteValue(stream, static_cast<u64>(geometry.Positions.size()));
+            for (const Maths::Vector3& position : geometry.Positions)
+            {
+                WriteVector3(stream, position);
+            }
+            WriteValue(stream, static_cast<u64>(geometry.Indices.size()));
+            stream.write(reinterpret_cast<const char*>(geometry.Indices.data()), sizeof(u32) * geometry.Indices.size());
+        }
+
+        WriteValue(stream, static_cast<u64>(Occluders.size()));
+        for (const Occluder& occluder : Occluders)
+        {
+            WriteValue(stream, occluder.GeometryIndex);
+            WriteMatrix(stream, occluder.Transform);
+        }
+
+        WriteValue(stream, static_cast<u64>(Occludees.size()));
+        for (const Graphics::BoundingBox& occludee : Occludees)
+        {
+            WriteVector3(stream, occludee.GetMin());
+            WriteVector3(stream, occludee.GetMax());
+        }
+        return static_cast<bool>(stream);
+    }
+
+    bool OcclusionScene::Load(std::string_view filePath)
+    {
+        std::ifstream stream(std::string(filePath), std::ios::binary);
+        if (!stream.is_open())
+        {
+            return false;
+        }
+
+        u32 magic = 0;
+        u32 version = 0;
+        if (!ReadValue(stream, magic) || magic != c_SceneFileMagic
+            || !ReadValue(stream, version) || version != c_SceneFileVersion
+            || !ReadMatrix(stream, ProjectionView)
+            || !ReadValue(stream, NearPlane))
+        {
+            return false;
+        }
+
+        u64 geometryCount = 0;
+        if (!ReadValue(stream, geometryCount))
+        {
+            return false;
+        }
+        Geometries.assign(geometryCount, OccluderGeometry());
+        for (OccluderGeometry& geometry : Geometries)
+        {
+            u64 positionCount = 0;
+            if (!ReadValue(stream, positionCount))
+            {
+                return false;
+            }
+            geometry.Positions.resize(positionCount);
+            for (Maths::Vector3& position : geometry.Positions)
+            {
+                if (!ReadVector3(stream, position))
+                {
+                    return false;
+                }
+            }
+
+            u64 indexCount = 0;
+            if (!ReadValue(stream, indexCount))
+            {
+                return false;
+            }
+            geometry.Indices.resize(indexCount);
+            if (!stream.read(reinterpret_cast<char*>(geometry.Indices.data()), sizeof(u32) * indexCount))
+            {
+                return false;
+            }
+            for (const u32 index : geometry.Indices)
+            {
+                if (index >= positionCount)
+                {
+                    return false;
+                }
+            }
+        }
+
+        u64 occluderCount = 0;
+        if (!ReadValue(stream, occluderCount))
+        {
+            return false;
+        }
+        Occluders.assign(occluderCount, Occluder());
+        for (Occluder& occluder : Occluders)
+        {
+            if (!ReadValue(stream, occluder.GeometryIndex) || occluder.GeometryIndex >= geometryCount
+                || !ReadMatrix(stream, occluder.Transform))
+            {
+                return false;
+            }
+        }
+
+        u64 occludeeCount = 0;
+        if (!ReadValue(stream, occludeeCount))
+        {
+            return false;
+        }
+        Occludees.clear();
+        Occludees.reserve(occludeeCount);
+        for (u64 occludeeIdx = 0; occludeeIdx < occludeeCount; ++occludeeIdx)
+        {
+            Maths::Vector3 min;
+            Maths::Vector3 max;
+            if (!ReadVector3(stream, min) || !ReadVector3(stream, max))
+            {
+                return false;
+            }
+            Occludees.push_back(Graphics::BoundingBox(min, max));
+        }
+        return true;
+    }
+
+    //=====================================================
+    // OcclusionCulling
+    //=====================================================
+    namespace OcclusionCulling
+    {
+        void SetEnabled(const bool enabled)
+        {
+            s_occlusionCullingEnabled = enabled;
+        }
+
+        bool IsEnabled()
+        {
+            return s_occlusionCullingEnabled;
+        }
+
+        void RequestSceneDump(std::string filePath)
+        {
+            std::lock_guard lock(s_sceneDumpLock);
+            s_sceneDumpPath = std::move(filePath);
+        }
+
+        std::string ConsumeSceneDumpRequest()
+        {
+            std::lock_guard lock(s_sceneDumpLock);
+            std::string filePath = std::move(s_sceneDumpPath);
+            s_sceneDumpPath.clear();
+            return filePath;
+        }
+    }
+}
+
+#ifdef IS_TESTING
+#include "doctest.h"
+#include "Core/Timer.h"
+
+#include <random>
+
+namespace test
+{
+    using namespace Insight;
+
+    /// @brief Camera at the origin looking down +z with a 90 degree field of view, w is the view depth.
+    Maths::Matrix4 CreateTestProjectionView(const float nearPlane)
+    {
+        Maths::Matrix4 projectionView = Maths::Matrix4::Identity;
+        projectionView[2][3] = 1.0f;
+        projectionView[3][2] = -nearPlane;
+        projectionView[3][3] = 0.0f;
+        return projectionView;
+    }
+
+    /// @brief Quad facing the camera at 'depth' covering [-halfSize, halfSize] in x and y.
+    OccluderGeometry CreateTestQuad(const float halfSize, const float depth)
+    {
+        OccluderGeometry geometry;
+        geometry.Positions =
+        {
+            Maths::Vector3(-halfSize, -halfSize, depth),
+            Maths::Vector3(halfSize, -halfSize, depth),
+            Maths::Vector3(halfSize, halfSize, depth),
+            Maths::Vector3(-halfSize, halfSize, depth),
+        };
+        geometry.Indices = { 0, 1, 2, 0, 2, 3 };
+        return geometry;
+    }
+
+    Graphics::BoundingBox CreateTestBox(const Maths::Vector3& center, const float halfSize)
+    {
+        const Maths::Vector3 extents(halfSize, halfSize, halfSize);
+        return Graphics::BoundingBox(center - extents, center + extents);
+    }
+
+    TEST_SUITE("OcclusionCulling")
+    {
+        TEST_CASE("Quad occluder")
+        {
+            constexpr float c_NearPlane = 0.1f;
+            const OccluderGeometry quad = CreateTestQuad(2.0f, 5.0f);
+            const OccluderInstance occluder = { &quad, Maths::Matrix4::Identity };
+
+            OcclusionBuffer buffer;
+            buffer.Begin(CreateTestProjectionView(c_NearPlane), c_NearPlane);
+            CHECK(buffer.IsVisible(CreateTestBox(Maths::Vector3(0.0f, 0.0f, 10.0f), 1.0f)));
+
+            buffer.RenderOccluders(&occluder, 1);
+            CHECK(buffer.GetTriangleCount() == 2);
+
+            // Behind the quad.
+            CHECK_FALSE(buffer.IsVisible(CreateTestBox(Maths::Vector3(0.0f, 0.0f, 10.0f), 1.0f)));
+            // In front of the quad.
+            CHECK(buffer.IsVisible(CreateTestBox(Maths::Vector3(0.0f, 0.0f, 2.0f), 0.5f)));
+            // Behind, but to the side of the quad.
+            CHECK(buffer.IsVisible(CreateTestBox(Maths::Vector3(7.0f, 0.0f, 10.0f), 1.0f)));
+            // Partly behind the quad.
+            CHECK(buffer.IsVisible(CreateTestBox(Maths::Vector3(4.0f, 0.0f, 10.0f), 1.0f)));
+            // Crossing the near plane.
+            CHECK(buffer.IsVisible(CreateTestBox(Maths::Vector3(0.0f, 0.0f, 0.0f), 1.0f)));
+            // Outside the view.
+            CHECK_FALSE(buffer.IsVisible(CreateTestBox(Maths::Vector3(20.0f, 0.0f, 10.0f), 1.0f)));
+        }
+
+        TEST_CASE("Occluder crossing the near plane")
+        {
+            constexpr float c_NearPlane = 0.1f;
+            // Floor under the camera from behind it to far in front, only the clipped part is rasterised.
+            OccluderGeometry floor;
+            floor.Positions =
+            {
+                Maths::Vector3(-50.0f, -1.0f, -10.0f),
+                Maths::Vector3(50.0f, -1.0f, -10.0f),
+                Maths::Vector3(50.0f, -1.0f, 100.0f),
+                Maths::Vector3(-50.0f, -1.0f, 100.0f),
+            };
+            floor.Indices = { 0, 1, 2, 0, 2, 3 };
+            const OccluderInstance occluder = { &floor, Maths::Matrix4::Identity };
+
+            OcclusionBuffer buffer;
+            buffer.Begin(CreateTestProjectionView(c_NearPlane), c_NearPlane);
+            buffer.RenderOccluders(&occluder, 1);
+
+            CHECK_FALSE(buffer.IsVisible(CreateTestBox(Maths::Vector3(0.0f, -5.0f, 10.0f), 1.0f)));
+            CHECK(buffer.IsVisible(CreateTestBox(Maths::Vector3(0.0f, 2.0f, 10.0f), 1.0f)));
+        }
+
+        TEST_CASE("Partial tile coverage")
+        {
+            constexpr float c_NearPlane = 0.1f;
+            // Two quads which only hide the box together, their edges don't line up with tiles.
+            const OccluderGeometry quad = CreateTestQuad(1.0f, 5.0f);
+            Maths::Matrix4 left = Maths::Matrix4::Identity;
+            left[3][0] = -0.97f;
+            Maths::Matrix4 right = Maths::Matrix4::Identity;
+            right[3][0] = 0.97f;
+            right[3][2] = 1.0f;
+            const OccluderInstance occluders[] = { { &quad, left }, { &quad, right } };
+
+            OcclusionBuffer buffer;
+            buffer.Begin(CreateTestProjectionView(c_NearPlane), c_NearPlane);
+            buffer.RenderOccluders(occluders, 1);
+            CHECK(buffer.IsVisible(CreateTestBox(Maths::Vector3(0.0f, 0.0f, 20.0f), 1.0f)));
+            buffer.RenderOccluders(occluders + 1, 1);
+            CHECK_FALSE(buffer.IsVisible(CreateTestBox(Maths::Vector3(0.0f, 0.0f, 20.0f), 1.0f)));
+            // Between the two quads' depths.
+            CHECK(buffer.IsVisible(CreateTestBox(Maths::Vector3(0.5f, 0.0f, 5.5f), 0.1f)));
+        }
+
+        TEST_CASE("Remove occluded")
+        {
+            constexpr float c_NearPlane = 0.1f;
+            constexpr u32 c_BoxCount = 5000;
+            const OccluderGeometry quad = CreateTestQuad(2.0f, 5.0f);
+            const OccluderInstance occluder = { &quad, Maths::Matrix4::Identity };
+
+            OcclusionBuffer buffer;
+            buffer.Begin(CreateTestProjectionView(c_NearPlane), c_NearPlane);
+            buffer.RenderOccluders(&occluder, 1);
+
+            std::mt19937 generator(7);
+            std::uniform_real_distribution<float> distribution(-6.0f, 6.0f);
+            RenderCullingBounds bounds;
+            std::vector<Graphics::BoundingBox> boxes;
+            std::vector<u32> meshIndexs;
+            for (u32 boxIdx = 0; boxIdx < c_BoxCount; ++boxIdx)
+            {
+                const Graphics::BoundingBox box = CreateTestBox(Maths::Vector3(distribution(generator), distribution(generator), 10.0f), 0.25f);
+                bounds.Add(box);
+                boxes.push_back(box);
+                meshIndexs.push_back(boxIdx);
+            }
+
+            std::vector<u32> expected;
+            for (u32 boxIdx = 0; boxIdx < c_BoxCount; ++boxIdx)
+            {
+                if (buffer.IsVisible(boxes[boxIdx]))
+                {
+                    expected.push_back(boxIdx);
+                }
+            }
+            CHECK(expected.size() < c_BoxCount);
+            CHECK(expected.size() > c_BoxCount / 2);
+
+            const u64 visibleCount = buffer.RemoveOccluded(bounds, meshIndexs.data(), meshIndexs.size());
+            meshIndexs.resize(visibleCount);
+            CHECK(meshIndexs == expected);
+        }
+
+        TEST_CASE("Scene save and load")
+        {
+            OcclusionScene scene;
+            scene.ProjectionView = CreateTestProjectionView(0.5f);
+            scene.NearPlane = 0.5f;
+            scene.Geometries.push_back(CreateTestQuad(2.0f, 5.0f));
+            scene.Occluders.push_back({ 0, Maths::Matrix4::Identity });
+            scene.Occludees.push_back(CreateTestBox(Maths::Vector3(1.0f, 2.0f, 3.0f), 1.0f));
+
+            const std::string filePath = "OcclusionSceneTest.isoc";
+            CHECK(scene.Save(filePath));
+
+            OcclusionScene loaded;
+            CHECK(loaded.Load(filePath));
+            CHECK(loaded.ProjectionView == scene.ProjectionView);
+            CHECK(loaded.NearPlane == scene.NearPlane);
+            CHECK(loaded.Geometries.size() == 1);
+            CHECK(loaded.Geometries[0].Indices == scene.Geometries[0].Indices);
+            CHECK(loaded.Geometries[0].Positions.size() == scene.Geometries[0].Positions.size());
+            CHECK(loaded.Occluders.size() == 1);
+            CHECK(loaded.Occludees.size() == 1);
+            CHECK(loaded.Occludees[0].GetMin().x == scene.Occludees[0].GetMin().x);
+            CHECK(loaded.Occludees[0].GetMax().z == scene.Occludees[0].GetMax().z);
+            std::remove(filePath.c_str());
+
+            CHECK_FALSE(loaded.Load("OcclusionSceneTest_Missing.isoc"));
+        }
+
+        TEST_CASE("Benchmark")
+        {
+            constexpr float c_NearPlane = 0.1f;
+            constexpr u32 c_OccluderCount = 200;
+            constexpr u32 c_OccludeeCount = 50'000;
+
+            const OccluderGeometry quad = CreateTestQuad(1.0f, 0.0f);
+            std::mt19937 generator(3);
+            std::uniform_real_distribution<float> spread(-30.0f, 30.0f);
+            std::uniform_real_distribution<float> depth(5.0f, 60.0f);
+
+            std::vector<OccluderInstance> occluders;
+            for (u32 occluderIdx = 0; occluderIdx < c_OccluderCount; ++occluderIdx)
+            {
+                Maths::Matrix4 transform = Maths::Matrix4::Identity;
+                transform[0][0] = 4.0f;
+                transform[1][1] = 4.0f;
+                transform[3] = Maths::Vector4(spread(generator), spread(generator), depth(generator), 1.0f);
+                occluders.push_back({ &quad, transform });
+            }
+
+            RenderCullingBounds bounds;
+            std::vector<u32> meshIndexs;
+            for (u32 occludeeIdx = 0; occludeeIdx < c_OccludeeCount; ++occludeeIdx)
+            {
+                const Graphics::BoundingBox box = CreateTestBox(Maths::Vector3(spread(generator), spread(generator), depth(generator)), 0.5f);
+                bounds.Add(box);
+                meshIndexs.push_back(occludeeIdx);
+            }
+
+            OcclusionBuffer buffer;
+            Core::Timer timer;
+            timer.Start();
+            buffer.Begin(CreateTestProjectionView(c_NearPlane), c_NearPlane);
+            buffer.RenderOccluders(occluders.data(), occluders.size());
+            timer.Stop();
+            const double rasteriseMs = timer.GetElapsedTimeNano().count() / 1'000'000.0;
+
+            timer.Start();
+            const u64 visibleCount = buffer.RemoveOccluded(bounds, meshIndexs.data(), meshIndexs.size());
+            timer.Stop();
+            const double testMs = timer.GetElapsedTimeNano().count() / 1'000'000.0;
+
+            MESSAGE("Rasterise " << c_OccluderCount << " occluders: " << rasteriseMs << "ms");
+            MESSAGE("Test " << c_OccludeeCount << " occludees: " << testMs << "ms, "
+                << (100.0f * static_cast<float>(c_OccludeeCount - visibleCount) / c_OccludeeCount) << "% culled");
+            CHECK(visibleCount < c_OccludeeCount);
+        }
+    }
+}
+#endif
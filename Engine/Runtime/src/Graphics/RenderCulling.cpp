@@ -0,0 +1,214 @@
+#include "Graphics/RenderCulling.h"
+
+#include "Core/Profiler.h"
+#include "Threading/Parallel.h"
+
+#include <cstring>
+
+namespace Insight
+{
+    //=====================================================
+    // RenderCullingBounds
+    //=====================================================
+    RenderCullingBounds::RenderCullingBounds(Core::FrameArena* frameArena)
+        : MinX(Core::FrameArenaStlAllocator<float>(frameArena))
+        , MinY(Core::FrameArenaStlAllocator<float>(frameArena))
+        , MinZ(Core::FrameArenaStlAllocator<float>(frameArena))
+        , MaxX(Core::FrameArenaStlAllocator<float>(frameArena))
+        , MaxY(Core::FrameArenaStlAllocator<float>(frameArena))
+        , MaxZ(Core::FrameArenaStlAllocator<float>(frameArena))
+    { }
+
+    void RenderCullingBounds::Reserve(const u64 count)
+    {
+        MinX.reserve(count);
+        MinY.reserve(count);
+        MinZ.reserve(count);
+        MaxX.reserve(count);
+        MaxY.reserve(count);
+        MaxZ.reserve(count);
+    }
+
+    void RenderCullingBounds::Add(const Graphics::BoundingBox& worldBounds)
+    {
+        const Maths::Vector3& min = worldBounds.GetMin();
+        const Maths::Vector3& max = worldBounds.GetMax();
+        MinX.push_back(min.x);
+        MinY.push_back(min.y);
+        MinZ.push_back(min.z);
+        MaxX.push_back(max.x);
+        MaxY.push_back(max.y);
+        MaxZ.push_back(max.z);
+    }
+
+    void RenderCullingBounds::Clear()
+    {
+        MinX.clear();
+        MinY.clear();
+        MinZ.clear();
+        MaxX.clear();
+        MaxY.clear();
+        MaxZ.clear();
+    }
+
+    Maths::AABBSoA RenderCullingBounds::GetBoxes() const
+    {
+        // The batch views are not const, 'CullAABB' only reads from them.
+        Maths::AABBSoA boxes;
+        boxes.Min.X = RemoveConst(MinX.data());
+        boxes.Min.Y = RemoveConst(MinY.data());
+        boxes.Min.Z = RemoveConst(MinZ.data());
+        boxes.Max.X = RemoveConst(MaxX.data());
+        boxes.Max.Y = RemoveConst(MaxY.data());
+        boxes.Max.Z = RemoveConst(MaxZ.data());
+        return boxes;
+    }
+
+    //=====================================================
+    // RenderVisibility
+    //=====================================================
+    RenderVisibility::RenderVisibility(Core::FrameArena* frameArena)
+        : MeshIndexs(Core::FrameArenaStlAllocator<u32>(frameArena))
+        , ViewEnds(Core::FrameArenaStlAllocator<u64>(frameArena))
+    { }
+
+    u64 RenderVisibility::AddView(const RenderCullingBounds& bounds, const Maths::Matrix4& projectionView)
+    {
+        float planes[RenderCulling::c_FrustumPlaneCount * 4];
+        RenderCulling::GetFrustumPlanes(projectionView, planes);
+        return AddView(bounds, planes, RenderCulling::c_FrustumPlaneCount);
+    }
+
+    u64 RenderVisibility::AddView(const RenderCullingBounds& bounds, const float* planes, const u64 planeCount)
+    {
+        IS_PROFILE_FUNCTION();
+
+        const u64 meshCount = bounds.Size();
+        const u64 viewBegin = MeshIndexs.size();
+        MeshIndexs.resize(viewBegin + meshCount);
+        u32* viewMeshIndexs = MeshIndexs.data() + viewBegin;
+        const Maths::AABBSoA boxes = bounds.GetBoxes();
+
+        // Each chunk writes its visible meshes to the start of its own range, then the ranges are packed together.
+        Core::FrameArenaVector<u64> chunkVisibleCounts(IntDivideRoundUp(meshCount, RenderCulling::c_GrainSize), 0, ViewEnds.get_allocator());
+        Threading::ParallelForRange(meshCount, RenderCulling::c_GrainSize, [&](const u64 begin, const u64 end)
+            {
+                chunkVisibleCounts[begin / RenderCulling::c_GrainSize] = Maths::Batch::CullAABB(planes, planeCount
+                    , boxes.Offset(begin), viewMeshIndexs + begin, static_cast<u32>(begin), end - begin);
+            });
+
+        u64 visibleCount = 0;
+        for (u64 chunkIdx = 0; chunkIdx < chunkVisibleCounts.size(); ++chunkIdx)
+        {
+            const u64 chunkBegin = chunkIdx * RenderCulling::c_GrainSize;
+            if (chunkBegin != visibleCount)
+            {
+                std::memmove(viewMeshIndexs + visibleCount, viewMeshIndexs + chunkBegin, sizeof(u32) * chunkVisibleCounts[chunkIdx]);
+            }
+            visibleCount += chunkVisibleCounts[chunkIdx];
+        }
+
+        MeshIndexs.resize(viewBegin + visibleCount);
+        ViewEnds.push_back(MeshIndexs.size());
+        return ViewEnds.size() - 1;
+    }
+
+    void RenderVisibility::Reserve(const u64 meshIndexCount, const u64 viewCount)
+    {
+        MeshIndexs.reserve(meshIndexCount);
+        ViewEnds.reserve(viewCount);
+    }
+
+    void RenderVisibility::Clear()
+    {
+        MeshIndexs.clear();
+        ViewEnds.clear();
+    }
+
+    RenderVisibility::View RenderVisibility::GetView(const u64 viewIdx) const
+    {
+        ASSERT(viewIdx < ViewEnds.size());
+        const u64 viewBegin = viewIdx == 0 ? 0 : ViewEnds[viewIdx - 1];
+        return View{ MeshIndexs.data() + viewBegin, MeshIndexs.data() + ViewEnds[viewIdx] };
+    }
+
+    //=====================================================
+    // RenderCulling
+    //=====================================================
+    namespace RenderCulling
+    {
+        void GetFrustumPlanes(const Maths::Matrix4& projectionView, float planes[c_FrustumPlaneCount * 4])
+        {
+            // Rows of the matrix combined the same way as 'Graphics::Frustum': near, far, left, right, top, bottom.
+            const int rows[c_FrustumPlaneCount] = { 2, 2, 0, 0, 1, 1 };
+            const float signs[c_FrustumPlaneCount] = { 1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f };
+            for (u64 planeIdx = 0; planeIdx < c_FrustumPlaneCount; ++planeIdx)
+            {
+                for (int column = 0; column < 4; ++column)
+                {
+                    planes[planeIdx * 4 + column] = projectionView[column][3] + signs[planeIdx] * projectionView[column][rows[planeIdx]];
+                }
+            }
+        }
+
+        void GetShadowCasterPlanes(const Maths::Matrix4& lightProjectionView, float planes[c_ShadowCasterPlaneCount * 4])
+        {
+            // Drop the near plane, the first one. Casters in front of it are still kept when they overlap the cascade
+            // in light space x and y.
+            float frustumPlanes[c_FrustumPlaneCount * 4];
+            GetFrustumPlanes(lightProjectionView, frustumPlanes);
+            std::memcpy(planes, frustumPlanes + 4, sizeof(float) * c_ShadowCasterPlaneCount * 4);
+        }
+
+        Maths::Vector3 GetShadowDirection(const Maths::Matrix4& lightProjectionView)
+        {
+            float frustumPlanes[c_FrustumPlaneCount * 4];
+            GetFrustumPlanes(lightProjectionView, frustumPlanes);
+            return Maths::Vector3(frustumPlanes[0], frustumPlanes[1], frustumPlanes[2]);
+        }
+
+        void GetViewSlicePlanes(const Maths::Matrix4& projectionView, const float nearDistance, const float farDistance
+            , float planes[c_ViewSlicePlaneCount * 4])
+        {
+            GetFrustumPlanes(projectionView, planes);
+
+            // w >= nearDistance and w <= farDistance.
+            float* nearPlane = planes + c_FrustumPlaneCount * 4;
+            float* farPlane = nearPlane + 4;
+            for (int column = 0; column < 4; ++column)
+            {
+                nearPlane[column] = projectionView[column][3];
+                farPlane[column] = -projectionView[column][3];
+            }
+            nearPlane[3] -= nearDistance;
+            farPlane[3] += farDistance;
+        }
+
+        bool IsSweptAABBOutside(const Graphics::BoundingBox& bounds, const Maths::Vector3& direction, const float* planes
+            , const u64 planeCount)
+        {
+            const Maths::Vector3& min = bounds.GetMin();
+            const Maths::Vector3& max = bounds.GetMax();
+            for (u64 planeIdx = 0; planeIdx < planeCount; ++planeIdx)
+            {
+                const float* plane = planes + planeIdx * 4;
+                // Sweeping towards the inside of the plane crosses it eventually.
+                if (plane[0] * direction.x + plane[1] * direction.y + plane[2] * direction.z > 0.0f)
+                {
+                    continue;
+                }
+
+                // The corner furthest inside the plane, the swept volume never gets further in.
+                const float distance = plane[0] * (plane[0] > 0.0f ? max.x : min.x)
+                    + plane[1] * (plane[1] > 0.0f ? max.y : min.y)
+                    + plane[2] * (plane[2] > 0.0f ? max.z : min.z)
+                    + plane[3];
+                if (distance < 0.0f)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+}
@@ -4,6 +4,7 @@
 #include "World/WorldSystem.h"
 
 #include "Graphics/Window.h"
+#include "Graphics/RenderContext.h"
 
 #include "ECS/Components/TransformComponent.h"
 #include "ECS/Components/MeshComponent.h"
@@ -14,8 +15,12 @@
 #include "Maths/Utils.h"
 #include "Maths/Vector3.h"
 
+#include "Core/Logger.h"
 #include "Core/Profiler.h"
-#include "Threading/TaskSystem.h"
+#include "Core/Timer.h"
+#include "Threading/Parallel.h"
+
+#include <unordered_map>
 
 namespace Insight
 {
@@ -44,6 +49,11 @@ namespace Insight
         return MeshLods[lodIndex];
     }
 
+    bool RenderMesh::IsTransparent() const
+    {
+        return Material.Properties[static_cast<u64>(Runtime::MaterialAssetProperty::Opacity)] < 1.0f;
+    }
+
     //=====================================================
     // RenderMesh
     //=====================================================
@@ -52,6 +62,7 @@ namespace Insight
         IS_PROFILE_FUNCTION();
         BoudingBox = mesh->GetBoundingBox();
         MeshLods = mesh->m_lods;
+        Occluder = mesh->GetOccluderGeometry().IsEmpty() ? nullptr : &mesh->GetOccluderGeometry();
     }
 
     void RenderMesh::SetMaterial(const Ref<Runtime::MaterialAsset> material)
@@ -64,6 +75,22 @@ namespace Insight
     //=====================================================
     // RenderWorld
     //=====================================================
+    RenderWorld::RenderWorld(Core::FrameArena* frameArena)
+        : Cameras(Core::FrameArenaStlAllocator<RenderCamera>(frameArena))
+        , Meshes(Core::FrameArenaStlAllocator<RenderMesh>(frameArena))
+        , PointLights(Core::FrameArenaStlAllocator<RenderPointLight>(frameArena))
+        , MeshBounds(frameArena)
+        , MainCameraVisibility(frameArena)
+        , PointLightVisibility(frameArena)
+        , ShadowCasterVisibility(frameArena)
+        , ShadowCasterLods(Core::FrameArenaStlAllocator<u8>(frameArena))
+        , OpaqueMeshIndexs(Core::FrameArenaStlAllocator<u64>(frameArena))
+        , TransparentMeshIndexs(Core::FrameArenaStlAllocator<u64>(frameArena))
+        , VisibleOpaqueMeshIndexs(Core::FrameArenaStlAllocator<u64>(frameArena))
+        , VisibleTransparentMeshIndexs(Core::FrameArenaStlAllocator<u64>(frameArena))
+        , MaterialBatch(Core::FrameArenaStlAllocator<RenderMaterailBatch>(frameArena))
+    { }
+
     void RenderWorld::SetMainCamera(ECS::Camera mainCamera, const Maths::Matrix4 transform)
     {
         MainCamera = RenderCamera{ std::move(mainCamera), std::move(transform), true};
@@ -74,6 +101,252 @@ namespace Insight
         Cameras.push_back(RenderCamera{ std::move(camera), std::move(transform), true });
     }
 
+    void RenderWorld::Cull()
+    {
+        IS_PROFILE_FUNCTION();
+        constexpr u64 c_PointLightFaceCount = 6;
+
+        MainCameraVisibility.Clear();
+        PointLightVisibility.Clear();
+        VisibleOpaqueMeshIndexs.clear();
+        VisibleTransparentMeshIndexs.clear();
+        OcclusionStats = {};
+
+        if (MainCamera.IsSet)
+        {
+            MainCameraVisibility.Reserve(Meshes.size(), 1);
+            const u64 viewIdx = MainCameraVisibility.AddView(MeshBounds, MainCamera.Camera.GetProjectionViewMatrix());
+            if (OcclusionCulling::IsEnabled())
+            {
+                CullOccludedMeshes();
+            }
+            const RenderVisibility::View view = MainCameraVisibility.GetView(viewIdx);
+
+            // Keep the opaque and transparent split by walking both lists against a per mesh flag.
+            Core::FrameArenaVector<u8> isVisible(Meshes.size(), 0, Core::FrameArenaStlAllocator<u8>(Meshes.get_allocator()));
+            for (const u32 meshIndex : view)
+            {
+                isVisible[meshIndex] = 1;
+            }
+            for (const u64 meshIndex : OpaqueMeshIndexs)
+            {
+                if (isVisible[meshIndex])
+                {
+                    VisibleOpaqueMeshIndexs.push_back(meshIndex);
+                }
+            }
+            for (const u64 meshIndex : TransparentMeshIndexs)
+            {
+                if (isVisible[meshIndex])
+                {
+                    VisibleTransparentMeshIndexs.push_back(meshIndex);
+                }
+            }
+        }
+        else
+        {
+            VisibleOpaqueMeshIndexs.assign(OpaqueMeshIndexs.begin(), OpaqueMeshIndexs.end());
+            VisibleTransparentMeshIndexs.assign(TransparentMeshIndexs.begin(), TransparentMeshIndexs.end());
+        }
+
+        PointLightVisibility.Reserve(0, PointLights.size() * c_PointLightFaceCount);
+        for (const RenderPointLight& pointLight : PointLights)
+        {
+            for (u64 face = 0; face < c_PointLightFaceCount; ++face)
+            {
+                PointLightVisibility.AddView(MeshBounds, pointLight.Projection * pointLight.View[face]);
+            }
+        }
+    }
+
+    void RenderWorld::CullShadowCasters(const Maths::Matrix4* cascadeProjectionViews, const float* cascadeSplitDistances
+        , const u64 cascadeCount, const Maths::Matrix4& cameraProjectionView)
+    {
+        IS_PROFILE_FUNCTION();
+
+        ShadowCasterVisibility.Clear();
+        ShadowCasterLods.clear();
+
+        const u64 meshCount = Meshes.size();
+        const Maths::AABBSoA boxes = MeshBounds.GetBoxes();
+        const float lodBias = RenderLod::GetBias() + RenderLod::c_ShadowLodBias;
+
+        // Each cascade fills its own lists, sized for every mesh up front so the tasks don't allocate.
+        // Copying a frame arena vector drops its arena, so each list is constructed in place.
+        const Core::FrameArenaStlAllocator<u32> arenaAllocator(Meshes.get_allocator());
+        Core::FrameArenaVector<Core::FrameArenaVector<u32>> cascadeMeshIndexs(arenaAllocator);
+        Core::FrameArenaVector<Core::FrameArenaVector<u8>> cascadeLods(arenaAllocator);
+        cascadeMeshIndexs.reserve(cascadeCount);
+        cascadeLods.reserve(cascadeCount);
+        for (u64 cascadeIdx = 0; cascadeIdx < cascadeCount; ++cascadeIdx)
+        {
+            cascadeMeshIndexs.emplace_back(meshCount, arenaAllocator);
+            cascadeLods.emplace_back(meshCount, arenaAllocator);
+        }
+        Threading::ParallelForRange(cascadeCount, 1, [&](const u64 begin, const u64 end)
+            {
+                for (u64 cascadeIdx = begin; cascadeIdx < end; ++cascadeIdx)
+                {
+                    float planes[RenderCulling::c_ShadowCasterPlaneCount * 4];
+                    RenderCulling::GetShadowCasterPlanes(cascadeProjectionViews[cascadeIdx], planes);
+
+                    // Receivers only sample this cascade between the splits either side of it. A caster whose shadow
+                    // can't reach that slice of the view, such as one entirely within a closer cascade, is skipped.
+                    float slicePlanes[RenderCulling::c_ViewSlicePlaneCount * 4];
+                    const float sliceNearDistance = cascadeIdx == 0 ? 0.0f : cascadeSplitDistances[cascadeIdx - 1];
+                    RenderCulling::GetViewSlicePlanes(cameraProjectionView, sliceNearDistance, cascadeSplitDistances[cascadeIdx], slicePlanes);
+                    const Maths::Vector3 shadowDirection = RenderCulling::GetShadowDirection(cascadeProjectionViews[cascadeIdx]);
+
+                    Core::FrameArenaVector<u32>& meshIndexs = cascadeMeshIndexs[cascadeIdx];
+                    Core::FrameArenaVector<u8>& lods = cascadeLods[cascadeIdx];
+                    const u64 insideCount = Maths::Batch::CullAABB(planes, RenderCulling::c_ShadowCasterPlaneCount, boxes, meshIndexs.data(), 0, meshCount);
+
+                    u64 casterCount = 0;
+                    for (u64 i = 0; i < insideCount; ++i)
+                    {
+                        const u32 meshIndex = meshIndexs[i];
+                        const RenderMesh& renderMesh = Meshes[meshIndex];
+                        if (renderMesh.IsTransparent())
+                        {
+                            continue;
+                        }
+
+                        const Graphics::BoundingBox worldBounds(
+                            Maths::Vector3(MeshBounds.MinX[meshIndex], MeshBounds.MinY[meshIndex], MeshBounds.MinZ[meshIndex]),
+                            Maths::Vector3(MeshBounds.MaxX[meshIndex], MeshBounds.MaxY[meshIndex], MeshBounds.MaxZ[meshIndex]));
+                        if (RenderCulling::IsSweptAABBOutside(worldBounds, shadowDirection, slicePlanes, RenderCulling::c_ViewSlicePlaneCount))
+                        {
+                            continue;
+                        }
+
+                        u8 lod = renderMesh.Lod;
+                        if (!renderMesh.SkinnedMesh)
+                        {
+                            const float screenSize = RenderLod::GetScreenSize(cascadeProjectionViews[cascadeIdx], worldBounds);
+                            lod = std::max(lod, RenderLod::SelectLod(screenSize, static_cast<u32>(renderMesh.MeshLods.size()), RenderLod::c_NoPreviousLod, lodBias));
+                        }
+                        lods[casterCount] = lod;
+                        meshIndexs[casterCount] = meshIndex;
+                        ++casterCount;
+                    }
+                    meshIndexs.resize(casterCount);
+                    lods.resize(casterCount);
+                }
+            });
+
+        u64 casterCount = 0;
+        for (const Core::FrameArenaVector<u32>& meshIndexs : cascadeMeshIndexs)
+        {
+            casterCount += meshIndexs.size();
+        }
+        ShadowCasterVisibility.Reserve(casterCount, cascadeCount);
+        ShadowCasterLods.reserve(casterCount);
+        for (u64 cascadeIdx = 0; cascadeIdx < cascadeCount; ++cascadeIdx)
+        {
+            const Core::FrameArenaVector<u32>& meshIndexs = cascadeMeshIndexs[cascadeIdx];
+            ShadowCasterVisibility.MeshIndexs.insert(ShadowCasterVisibility.MeshIndexs.end(), meshIndexs.begin(), meshIndexs.end());
+            ShadowCasterVisibility.ViewEnds.push_back(ShadowCasterVisibility.MeshIndexs.size());
+            ShadowCasterLods.insert(ShadowCasterLods.end(), cascadeLods[cascadeIdx].begin(), cascadeLods[cascadeIdx].end());
+        }
+    }
+
+    void RenderWorld::CullOccludedMeshes()
+    {
+        IS_PROFILE_FUNCTION();
+
+        Core::Timer timer;
+        timer.Start();
+
+        // The main camera view is the only view, so it is all of 'MeshIndexs'.
+        ASSERT(MainCameraVisibility.GetViewCount() == 1);
+        u32* meshIndexs = MainCameraVisibility.MeshIndexs.data();
+        const u64 meshCount = MainCameraVisibility.MeshIndexs.size();
+
+        // Skinned meshes are posed on the GPU so their CPU triangles don't match what is drawn.
+        const Maths::Vector3 cameraPosition(MainCamera.Transform[3]);
+        Core::FrameArenaVector<OccluderInstance> occluders(Core::FrameArenaStlAllocator<OccluderInstance>(Meshes.get_allocator()));
+        for (u64 i = 0; i < meshCount; ++i)
+        {
+            const u32 meshIndex = meshIndexs[i];
+            const RenderMesh& renderMesh = Meshes[meshIndex];
+            if (!renderMesh.Occluder || renderMesh.SkinnedMesh || renderMesh.IsTransparent())
+            {
+                continue;
+            }
+
+            if (!renderMesh.IsFlaggedOccluder)
+            {
+                const Maths::Vector3 min(MeshBounds.MinX[meshIndex], MeshBounds.MinY[meshIndex], MeshBounds.MinZ[meshIndex]);
+                const Maths::Vector3 max(MeshBounds.MaxX[meshIndex], MeshBounds.MaxY[meshIndex], MeshBounds.MaxZ[meshIndex]);
+                const float radius = (max - min).Length() * 0.5f;
+                const float distance = ((min + max) * 0.5f - cameraPosition).Length();
+                if (radius < distance * OcclusionCulling::c_AutoOccluderMinScreenSize)
+                {
+                    continue;
+                }
+            }
+            occluders.push_back(OccluderInstance{ renderMesh.Occluder, renderMesh.Transform });
+        }
+
+        OcclusionStats.OccluderCount = occluders.size();
+        OcclusionStats.OccludeeCount = meshCount;
+
+        const std::string sceneDumpPath = OcclusionCulling::ConsumeSceneDumpRequest();
+        if (!sceneDumpPath.empty())
+        {
+            OcclusionScene scene;
+            scene.ProjectionView = MainCamera.Camera.GetProjectionViewMatrix();
+            scene.NearPlane = MainCamera.Camera.GetNearPlane();
+
+            std::unordered_map<const OccluderGeometry*, u32> geometryIndexs;
+            for (const OccluderInstance& occluder : occluders)
+            {
+                auto [iter, inserted] = geometryIndexs.try_emplace(occluder.Geometry, static_cast<u32>(scene.Geometries.size()));
+                if (inserted)
+                {
+                    scene.Geometries.push_back(*occluder.Geometry);
+                }
+                scene.Occluders.push_back(OcclusionScene::Occluder{ iter->second, occluder.Transform });
+            }
+            for (u64 i = 0; i < meshCount; ++i)
+            {
+                const u32 meshIndex = meshIndexs[i];
+                scene.Occludees.push_back(Graphics::BoundingBox(
+                    Maths::Vector3(MeshBounds.MinX[meshIndex], MeshBounds.MinY[meshIndex], MeshBounds.MinZ[meshIndex]),
+                    Maths::Vector3(MeshBounds.MaxX[meshIndex], MeshBounds.MaxY[meshIndex], MeshBounds.MaxZ[meshIndex])));
+            }
+
+            if (scene.Save(sceneDumpPath))
+            {
+                IS_LOG_CORE_INFO("[RenderWorld::CullOccludedMeshes] Occlusion scene saved to '{}'.", sceneDumpPath);
+            }
+            else
+            {
+                IS_LOG_CORE_ERROR("[RenderWorld::CullOccludedMeshes] Unable to save occlusion scene to '{}'.", sceneDumpPath);
+            }
+        }
+
+        if (occluders.empty())
+        {
+            return;
+        }
+
+        // Kept per thread so its tiles and triangle lists are reused between frames. Worlds can be culled on several
+        // threads at once.
+        thread_local OcclusionBuffer occlusionBuffer;
+        occlusionBuffer.Begin(MainCamera.Camera.GetProjectionViewMatrix(), MainCamera.Camera.GetNearPlane());
+        occlusionBuffer.RenderOccluders(occluders.data(), occluders.size());
+        const u64 visibleCount = occlusionBuffer.RemoveOccluded(MeshBounds, meshIndexs, meshCount);
+
+        MainCameraVisibility.MeshIndexs.resize(visibleCount);
+        MainCameraVisibility.ViewEnds.back() = visibleCount;
+
+        timer.Stop();
+        OcclusionStats.OccluderTriangleCount = occlusionBuffer.GetTriangleCount();
+        OcclusionStats.OccludedCount = meshCount - visibleCount;
+        OcclusionStats.TimeMs = static_cast<float>(timer.GetElapsedTimeNano().count() / 1'000'000.0);
+    }
+
     //=====================================================
     // RenderFrame
     //=====================================================
@@ -85,7 +358,7 @@ namespace Insight
     {
     }
 
-    void RenderFrame::CreateRenderFrameFromWorldSystem(Runtime::WorldSystem* worldSystem)
+    void RenderFrame::CreateRenderFrameFromWorldSystem(Runtime::WorldSystem* worldSystem, const bool sort)
     {
         IS_PROFILE_FUNCTION();
         ASSERT(Platform::IsMainThread());
@@ -100,9 +373,11 @@ namespace Insight
                 continue;
             }
 
-            RenderWorld renderWorld;
+            // Released once the frame this is rendered in has retired on the GPU.
+            RenderWorld renderWorld(Graphics::RenderContext::Instance().GetFrameArenaAllocator().GetCurrentArena());
             std::vector<Ptr<ECS::Entity>> entities = world->GetAllEntitiesFlatten();
             renderWorld.Meshes.reserve(entities.size());
+            renderWorld.MeshBounds.Reserve(entities.size());
 
             std::vector<Ptr<ECS::Entity>> cameraEntities = world->GetAllEntitiesWithComponentByName(ECS::CameraComponent::Type_Name);
             for (Ptr<ECS::Entity>& entity : cameraEntities)
@@ -125,6 +400,11 @@ namespace Insight
                 }
             }
 
+            // LODs are picked for the camera the frame is rendered from, worlds without one use the frame's.
+            const RenderCamera& lodCamera = renderWorld.MainCamera.IsSet ? renderWorld.MainCamera : MainCamera;
+            const Maths::Matrix4 lodProjectionView = lodCamera.Camera.GetProjectionViewMatrix();
+            const float lodBias = RenderLod::GetBias();
+
             std::mutex renderWorldMutex;
 #define PARALLEL_FOR 0
 #if PARALLEL_FOR
@@ -179,26 +459,16 @@ namespace Insight
                             renderMesh.PreviousTransform = transformComponent->GetPreviousTransform();
                         }
 
-                        Graphics::BoundingBox boundingBox = mesh->GetBoundingBox();
-                        bool isVisible = true;
+                        // Culled in 'RenderWorld::Cull' once the camera is known, the editor replaces it after extraction.
+                        Graphics::BoundingBox worldBoundingBox;
                         {
-                            IS_PROFILE_SCOPE("Visible check");
-                            boundingBox = boundingBox.Transform(renderMesh.Transform);
-                        }
-                        {
-                            std::lock_guard l(renderWorldMutex);
-                            //isVisible = renderWorld.MainCamera.Camera.IsVisible(boundingBox);
-                            if (!renderWorld.MainCamera.IsSet || !isVisible)
-                            {
-                                // TODO Mid: Setup seperate scene and game worlds and then re-enable this.
-                                // The "EditorWorld" should be it's own world then when play is pressed a runtime world 
-                                // should be created.
-                                //continue;
-                            }
+                            IS_PROFILE_SCOPE("World bounds");
+                            worldBoundingBox = mesh->GetBoundingBox().Transform(renderMesh.Transform);
                         }
 
                         renderMesh.SetMesh(mesh.Ptr());
                         renderMesh.SetMaterial(material);
+                        renderMesh.IsFlaggedOccluder = meshComponent && meshComponent->IsOccluder();
                         {
                             IS_PROFILE_SCOPE("Set SkinnedMesh");
                             renderMesh.SkinnedMesh = skinnedMeshComponent && skinnedMeshComponent->GetSkeleton();
@@ -221,18 +491,34 @@ namespace Insight
                                     }
 #else
                                     // This should just be a RHI_BufferView instead of copying all this data.
-                                    renderMesh.BoneTransforms = animationClipComponent->GetAnimator()->GetBoneTransforms();
+                                    const std::vector<Maths::Matrix4>& boneTransforms = animationClipComponent->GetAnimator()->GetBoneTransforms();
+                                    renderMesh.BoneTransforms = Core::FrameArenaVector<Maths::Matrix4>(boneTransforms.begin(), boneTransforms.end()
+                                        , Core::FrameArenaStlAllocator<Maths::Matrix4>(renderWorld.Meshes.get_allocator()));
 #endif
                                 }
                             }
                         }
 
-                        const bool meshIsTransparent = renderMesh.Material.Properties[static_cast<u64>(Runtime::MaterialAssetProperty::Opacity)] < 1.0f;
+                        // Only the first LOD of a skinned mesh is skinned.
+                        if (lodCamera.IsSet && !renderMesh.SkinnedMesh)
+                        {
+                            IS_PROFILE_SCOPE("Select LOD");
+                            const u8 previousLod = meshComponent ? meshComponent->GetLastLod() : RenderLod::c_NoPreviousLod;
+                            const float screenSize = RenderLod::GetScreenSize(lodProjectionView, worldBoundingBox);
+                            renderMesh.Lod = RenderLod::SelectLod(screenSize, static_cast<u32>(renderMesh.MeshLods.size()), previousLod, lodBias);
+                            if (meshComponent)
+                            {
+                                meshComponent->SetLastLod(renderMesh.Lod);
+                            }
+                        }
+
+                        const bool meshIsTransparent = renderMesh.IsTransparent();
 
                         {
                             std::lock_guard l(renderWorldMutex);
                             u64 meshIndex = meshIndex = renderWorld.Meshes.size();
                             renderWorld.Meshes.push_back(std::move(renderMesh));
+                            renderWorld.MeshBounds.Add(worldBoundingBox);
 
                             if (auto materialBatchIter = renderWorld.MaterialBatchLookup.find(material->GetGuid());
                                 materialBatchIter != renderWorld.MaterialBatchLookup.end())
@@ -296,8 +582,20 @@ namespace Insight
             RenderWorlds.push_back(std::move(renderWorld));
         }
 
-        SortOpaqueMeshes();
-        SortTransparentMeshes();
+        if (sort)
+        {
+            Cull();
+            Sort();
+        }
+    }
+
+    void RenderFrame::Cull()
+    {
+        IS_PROFILE_FUNCTION();
+        for (RenderWorld& world : RenderWorlds)
+        {
+            world.Cull();
+        }
     }
 
     void RenderFrame::Sort()
@@ -320,7 +618,7 @@ namespace Insight
         {
             if (world.MainCamera.IsSet)
             {
-                std::sort(world.OpaqueMeshIndexs.begin(), world.OpaqueMeshIndexs.end(), [&world](u64 a, u64 b)
+                std::sort(world.VisibleOpaqueMeshIndexs.begin(), world.VisibleOpaqueMeshIndexs.end(), [&world](u64 a, u64 b)
                     {
                         const RenderMesh& meshA = world.Meshes[a];
                         const RenderMesh& meshB = world.Meshes[b];
@@ -342,7 +640,7 @@ namespace Insight
             if (world.MainCamera.IsSet)
             {
                 IS_PROFILE_SCOPE("Sort transparent meshes");
-                std::sort(world.TransparentMeshIndexs.begin(), world.TransparentMeshIndexs.end(), [&world](u64 a, u64 b)
+                std::sort(world.VisibleTransparentMeshIndexs.begin(), world.VisibleTransparentMeshIndexs.end(), [&world](u64 a, u64 b)
                     {
                         const RenderMesh& meshA = world.Meshes[a];
                         const RenderMesh& meshB = world.Meshes[b];
@@ -385,4 +683,125 @@ namespace Insight
         }
         FAIL_ASSERT();
     }
-}
\ No newline at end of file
+}
+#ifdef IS_TESTING
+#include "doctest.h"
+
+#include <algorithm>
+
+namespace test
+{
+    using namespace Insight;
+
+    TEST_SUITE("RenderFrame")
+    {
+        // Camera at the origin looking down +z with a 90 degree field of view, w is the view depth.
+        Maths::Matrix4 CreateCameraProjectionView()
+        {
+            const float nearPlane = 0.1f;
+            const float farPlane = 100.0f;
+            Maths::Matrix4 projectionView = Maths::Matrix4::Identity;
+            projectionView[2][2] = farPlane / (farPlane - nearPlane);
+            projectionView[3][2] = -nearPlane * farPlane / (farPlane - nearPlane);
+            projectionView[2][3] = 1.0f;
+            projectionView[3][3] = 0.0f;
+            return projectionView;
+        }
+
+        void AddMesh(RenderWorld& renderWorld, const Graphics::BoundingBox& worldBounds)
+        {
+            RenderMesh renderMesh;
+            renderMesh.Material.Properties[static_cast<u64>(Runtime::MaterialAssetProperty::Opacity)] = 1.0f;
+            renderWorld.Meshes.push_back(std::move(renderMesh));
+            renderWorld.MeshBounds.Add(worldBounds);
+        }
+
+        bool Contains(const RenderVisibility::View view, const u32 meshIndex)
+        {
+            return std::find(view.begin(), view.end(), meshIndex) != view.end();
+        }
+
+        TEST_CASE("Shadow casters inside a closer cascade")
+        {
+            // Light straight above looking down -y, light space x is world x and light space y is world z.
+            // Depth runs from y = 20 down to y = -20.
+            const auto createCascade = [](const float centreZ, const float radius)
+            {
+                Maths::Matrix4 lightProjectionView = Maths::Matrix4::Identity;
+                lightProjectionView[0][0] = 1.0f / radius;
+                lightProjectionView[1][1] = 0.0f;
+                lightProjectionView[2][1] = 1.0f / radius;
+                lightProjectionView[3][1] = -centreZ / radius;
+                lightProjectionView[1][2] = -1.0f / 40.0f;
+                lightProjectionView[2][2] = 0.0f;
+                lightProjectionView[3][2] = 20.0f / 40.0f;
+                return lightProjectionView;
+            };
+            // Split 0 is at a view depth of 10. Cascade 0 is fitted to the sphere around its slice, so it reaches a
+            // depth of 13 and overlaps cascade 1.
+            const Maths::Matrix4 cascadeProjectionViews[] = { createCascade(5.0f, 8.0f), createCascade(25.0f, 25.0f) };
+            const float cascadeSplitDistances[] = { 10.0f, 100.0f };
+
+            Core::FrameArena frameArena(64_KB, Core::MemoryAllocCategory::Graphics);
+            RenderWorld renderWorld(&frameArena);
+            // Inside cascade 0's volume past split 0, its shadow lands where cascade 1 is sampled.
+            AddMesh(renderWorld, Graphics::BoundingBox(Maths::Vector3(-1.0f, 2.0f, 10.5f), Maths::Vector3(1.0f, 4.0f, 11.5f)));
+            // Receiver under it past split 0.
+            AddMesh(renderWorld, Graphics::BoundingBox(Maths::Vector3(-5.0f, -0.1f, 11.0f), Maths::Vector3(5.0f, 0.0f, 12.0f)));
+            // Only inside cascade 1.
+            AddMesh(renderWorld, Graphics::BoundingBox(Maths::Vector3(-1.0f, 0.0f, 40.0f), Maths::Vector3(1.0f, 2.0f, 42.0f)));
+            // Inside both cascades' volumes, its shadow falls entirely before split 0.
+            AddMesh(renderWorld, Graphics::BoundingBox(Maths::Vector3(-1.0f, 2.0f, 8.0f), Maths::Vector3(1.0f, 4.0f, 9.0f)));
+            // Across split 0, its shadow lands either side of it.
+            AddMesh(renderWorld, Graphics::BoundingBox(Maths::Vector3(-1.0f, 2.0f, 9.0f), Maths::Vector3(1.0f, 4.0f, 11.0f)));
+
+            renderWorld.CullShadowCasters(cascadeProjectionViews, cascadeSplitDistances, 2, CreateCameraProjectionView());
+            CHECK(renderWorld.ShadowCasterVisibility.GetViewCount() == 2);
+            CHECK(renderWorld.ShadowCasterLods.size() == renderWorld.ShadowCasterVisibility.MeshIndexs.size());
+
+            const RenderVisibility::View cascade0 = renderWorld.ShadowCasterVisibility.GetView(0);
+            const RenderVisibility::View cascade1 = renderWorld.ShadowCasterVisibility.GetView(1);
+            CHECK_FALSE(Contains(cascade0, 0));
+            CHECK(Contains(cascade1, 0));
+            CHECK_FALSE(Contains(cascade0, 1));
+            CHECK(Contains(cascade1, 1));
+            CHECK_FALSE(Contains(cascade0, 2));
+            CHECK(Contains(cascade1, 2));
+            CHECK(Contains(cascade0, 3));
+            CHECK_FALSE(Contains(cascade1, 3));
+            CHECK(Contains(cascade0, 4));
+            CHECK(Contains(cascade1, 4));
+        }
+
+        TEST_CASE("Shadow casters whose shadow reaches a farther cascade")
+        {
+            // Light travelling down and towards +z at 45 degrees, light space x is world x and light space y runs
+            // along (0, 1, 1). Depth runs 20 either side of the origin along the light direction.
+            const float halfSqrt2 = 0.70710678f;
+            const auto createCascade = [halfSqrt2](const float centre, const float radius)
+            {
+                Maths::Matrix4 lightProjectionView = Maths::Matrix4::Identity;
+                lightProjectionView[0][0] = 1.0f / radius;
+                lightProjectionView[1][1] = halfSqrt2 / radius;
+                lightProjectionView[2][1] = halfSqrt2 / radius;
+                lightProjectionView[3][1] = -centre / radius;
+                lightProjectionView[1][2] = -halfSqrt2 / 40.0f;
+                lightProjectionView[2][2] = halfSqrt2 / 40.0f;
+                lightProjectionView[3][2] = 20.0f / 40.0f;
+                return lightProjectionView;
+            };
+            const Maths::Matrix4 cascadeProjectionViews[] = { createCascade(5.0f, 8.0f), createCascade(20.0f, 25.0f) };
+            const float cascadeSplitDistances[] = { 10.0f, 100.0f };
+
+            Core::FrameArena frameArena(64_KB, Core::MemoryAllocCategory::Graphics);
+            RenderWorld renderWorld(&frameArena);
+            // Entirely before split 0, but its shadow is cast forwards past it.
+            AddMesh(renderWorld, Graphics::BoundingBox(Maths::Vector3(-1.0f, 2.0f, 8.0f), Maths::Vector3(1.0f, 4.0f, 9.0f)));
+
+            renderWorld.CullShadowCasters(cascadeProjectionViews, cascadeSplitDistances, 2, CreateCameraProjectionView());
+            CHECK(Contains(renderWorld.ShadowCasterVisibility.GetView(0), 0));
+            CHECK(Contains(renderWorld.ShadowCasterVisibility.GetView(1), 0));
+        }
+    }
+}
+#endif
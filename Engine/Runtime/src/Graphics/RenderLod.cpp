@@ -0,0 +1,142 @@
+#include "Graphics/RenderLod.h"
+
+#include "Maths/Vector3.h"
+#include "Maths/Vector4.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace Insight
+{
+    namespace
+    {
+        std::atomic<float> s_lodBias = 0.0f;
+    }
+
+    namespace RenderLod
+    {
+        float GetScreenSize(const Maths::Matrix4& projectionView, const Graphics::BoundingBox& worldBounds)
+        {
+            const Maths::Vector3 center = (worldBounds.GetMin() + worldBounds.GetMax()) * 0.5f;
+            const float radius = (worldBounds.GetMax() - worldBounds.GetMin()).Length() * 0.5f;
+
+            // The view matrix doesn't scale, so the length of the y row is the projection's y scale.
+            const Maths::Vector3 yRow(projectionView[0][1], projectionView[1][1], projectionView[2][1]);
+            const float w = (projectionView * Maths::Vector4(center, 1.0f)).w;
+            if (w <= std::numeric_limits<float>::epsilon())
+            {
+                return std::numeric_limits<float>::max();
+            }
+            return radius * yRow.Length() / w;
+        }
+
+        u8 SelectLod(const float screenSize, const u32 lodCount, const u8 previousLod, const float bias)
+        {
+            const u32 maxLod = std::min(std::max(lodCount, 1u), c_MaxLodCount) - 1;
+            const float biasedScreenSize = screenSize * std::exp2(-bias);
+
+            u32 lod = 0;
+            if (previousLod == c_NoPreviousLod)
+            {
+                while (lod < maxLod && biasedScreenSize < c_ScreenSizes[lod])
+                {
+                    ++lod;
+                }
+                return static_cast<u8>(lod);
+            }
+
+            lod = std::min<u32>(previousLod, maxLod);
+            while (lod > 0 && biasedScreenSize >= c_ScreenSizes[lod - 1] * (1.0f + c_Hysteresis))
+            {
+                --lod;
+            }
+            while (lod < maxLod && biasedScreenSize < c_ScreenSizes[lod] * (1.0f - c_Hysteresis))
+            {
+                ++lod;
+            }
+            return static_cast<u8>(lod);
+        }
+
+        void SetBias(const float bias)
+        {
+            s_lodBias = bias;
+        }
+
+        float GetBias()
+        {
+            return s_lodBias;
+        }
+    }
+}
+
+#ifdef IS_TESTING
+#include "Maths/MathsUtils.h"
+
+#include "doctest.h"
+
+namespace test
+{
+    using namespace Insight;
+
+    TEST_SUITE("RenderLod")
+    {
+        TEST_CASE("Screen size")
+        {
+            // Camera at the origin looking down +z with a 90 degree field of view, w is the view depth.
+            Maths::Matrix4 projectionView = Maths::Matrix4::Identity;
+            projectionView[2][3] = 1.0f;
+            projectionView[3][3] = 0.0f;
+
+            const Graphics::BoundingBox nearBox(Maths::Vector3(-1.0f, -1.0f, 9.0f), Maths::Vector3(1.0f, 1.0f, 11.0f));
+            const Graphics::BoundingBox farBox(Maths::Vector3(-1.0f, -1.0f, 19.0f), Maths::Vector3(1.0f, 1.0f, 21.0f));
+            const float nearSize = RenderLod::GetScreenSize(projectionView, nearBox);
+            CHECK(Maths::Equals(nearSize, std::sqrt(3.0f) / 10.0f, 0.0001f));
+            CHECK(Maths::Equals(RenderLod::GetScreenSize(projectionView, farBox), nearSize * 0.5f, 0.0001f));
+
+            // Behind the camera.
+            const Graphics::BoundingBox behindBox(Maths::Vector3(-1.0f, -1.0f, -11.0f), Maths::Vector3(1.0f, 1.0f, -9.0f));
+            CHECK(RenderLod::GetScreenSize(projectionView, behindBox) == std::numeric_limits<float>::max());
+
+            // Orthographic views don't depend on distance.
+            Maths::Matrix4 orthographic = Maths::Matrix4::Identity;
+            orthographic[0][0] = 0.1f;
+            orthographic[1][1] = -0.1f;
+            CHECK(Maths::Equals(RenderLod::GetScreenSize(orthographic, nearBox), RenderLod::GetScreenSize(orthographic, farBox), 0.0001f));
+        }
+
+        TEST_CASE("Select LOD")
+        {
+            constexpr u8 c_NoPrevious = RenderLod::c_NoPreviousLod;
+            CHECK(RenderLod::SelectLod(1.0f, 4, c_NoPrevious, 0.0f) == 0);
+            CHECK(RenderLod::SelectLod(0.2f, 4, c_NoPrevious, 0.0f) == 1);
+            CHECK(RenderLod::SelectLod(0.08f, 4, c_NoPrevious, 0.0f) == 2);
+            CHECK(RenderLod::SelectLod(0.01f, 4, c_NoPrevious, 0.0f) == 3);
+            // Clamped to the LODs the mesh has.
+            CHECK(RenderLod::SelectLod(0.01f, 2, c_NoPrevious, 0.0f) == 1);
+            CHECK(RenderLod::SelectLod(0.01f, 0, c_NoPrevious, 0.0f) == 0);
+            // Each step of bias halves the screen size.
+            CHECK(RenderLod::SelectLod(0.2f, 4, c_NoPrevious, 1.0f) == 2);
+            CHECK(RenderLod::SelectLod(0.2f, 4, c_NoPrevious, -1.0f) == 0);
+        }
+
+        TEST_CASE("Hysteresis")
+        {
+            const float threshold = RenderLod::c_ScreenSizes[0];
+            const float justBelow = threshold * (1.0f - RenderLod::c_Hysteresis * 0.5f);
+            const float justAbove = threshold * (1.0f + RenderLod::c_Hysteresis * 0.5f);
+
+            // Inside the band the previous LOD is kept.
+            CHECK(RenderLod::SelectLod(justBelow, 4, 0, 0.0f) == 0);
+            CHECK(RenderLod::SelectLod(justAbove, 4, 1, 0.0f) == 1);
+            // Past the band the LOD changes.
+            CHECK(RenderLod::SelectLod(threshold * (1.0f - RenderLod::c_Hysteresis * 2.0f), 4, 0, 0.0f) == 1);
+            CHECK(RenderLod::SelectLod(threshold * (1.0f + RenderLod::c_Hysteresis * 2.0f), 4, 1, 0.0f) == 0);
+            // Large changes move several LODs in one go.
+            CHECK(RenderLod::SelectLod(0.001f, 4, 0, 0.0f) == 3);
+            CHECK(RenderLod::SelectLod(1.0f, 4, 3, 0.0f) == 0);
+        }
+    }
+}
+#endif
@@ -7,6 +7,7 @@
 #include "Graphics/RenderGraph/RenderGraphBuilder.h"
 #include "Graphics/RenderGraphV2/RenderGraphV2.h"
 #include "Graphics/Frustum.h"
+#include "Graphics/RenderLod.h"
 #include "Graphics/Window.h"
 #include "Graphics/GFXHelper.h"
 
@@ -24,6 +25,8 @@
 #include "Asset/Assets/Model.h"
 #include "Resource/Mesh.h"
 
+#include <cstring>
+
 namespace Insight
 {
 //#define SHADOW_PASS_SCENE_OBEJCTS
@@ -53,7 +56,8 @@ namespace Insight
 	static bool enableFSR = false;
 	static float fsrSharpness = 1.0f;
 
-	static int MeshLod = 0;
+	/// @brief Draw every mesh with this LOD instead of the one picked for it, -1 to pick automatically.
+	static int ForcedMeshLod = -1;
 	static bool RenderMaterialBatching = false;
 
 	RenderFrame renderFrame;
@@ -78,6 +82,20 @@ namespace Insight
 		};
 		GlobalResources g_global_resources = {};
 
+		/// @brief Draw 'mesh' with 'lodIndex', or with 'ForcedMeshLod' if it is set.
+		void DrawRenderMesh(RHI_CommandList* cmdList, const RenderMesh& mesh, const u32 lodIndex)
+		{
+			const Runtime::MeshLOD& renderMeshLod = mesh.GetLOD(ForcedMeshLod >= 0 ? static_cast<u32>(ForcedMeshLod) : lodIndex);
+			cmdList->SetVertexBuffer(renderMeshLod.Vertex_buffer);
+			cmdList->SetIndexBuffer(renderMeshLod.Index_buffer, Graphics::IndexType::Uint32);
+			cmdList->DrawIndexed(renderMeshLod.Index_count, 1, renderMeshLod.First_index, renderMeshLod.Vertex_offset, 0);
+
+			RenderStats& renderStats = RenderStats::Instance();
+			++renderStats.MeshCount;
+			renderStats.FullLodTriangleCount += mesh.GetLOD(0).Index_count / 3;
+			renderStats.SelectedLodTriangleCount += renderMeshLod.Index_count / 3;
+		}
+
 		BufferFrame::BufferFrame()
 		{
 			SetGPUSkinningEnabled(Runtime::AnimationSystem::Instance().IsGPUSkinningEnabled());
@@ -169,7 +187,12 @@ namespace Insight
 			IS_PROFILE_FUNCTION();
 
 			ImGui::Begin("Renderpass options:");
-			ImGui::SliderInt("Mesh Lods", &MeshLod, 0, Runtime::Mesh::s_MAX_LOD_COUNT - 1);
+			ImGui::SliderInt("Force Mesh Lod", &ForcedMeshLod, -1, Runtime::Mesh::s_MAX_LOD_COUNT - 1);
+			float lodBias = RenderLod::GetBias();
+			if (ImGui::DragFloat("Mesh Lod Bias", &lodBias, 0.01f, -4.0f, 4.0f))
+			{
+				RenderLod::SetBias(lodBias);
+			}
 			ImGui::Checkbox("Use Material Batching", &RenderMaterialBatching);
 			ImGui::End();
 
@@ -306,7 +329,12 @@ namespace Insight
 			IS_PROFILE_FUNCTION();
 
 			ImGui::Begin("Renderpass options:");
-			ImGui::SliderInt("Mesh Lods", &MeshLod, 0, Runtime::Mesh::s_MAX_LOD_COUNT - 1);
+			ImGui::SliderInt("Force Mesh Lod", &ForcedMeshLod, -1, Runtime::Mesh::s_MAX_LOD_COUNT - 1);
+			float lodBias = RenderLod::GetBias();
+			if (ImGui::DragFloat("Mesh Lod Bias", &lodBias, 0.01f, -4.0f, 4.0f))
+			{
+				RenderLod::SetBias(lodBias);
+			}
 			ImGui::Checkbox("Use Material Batching", &RenderMaterialBatching);
 			ImGui::End();
 
@@ -491,6 +519,19 @@ namespace Insight
 			{
 				IS_PROFILE_SCOPE("pass data setup");
 				data.Depth_Tex = -1;
+			}
+			{
+				IS_PROFILE_SCOPE("Cull shadow casters");
+				// 'SplitDepth' is stored negated for the composite shader.
+				float splitDistances[s_Cascade_Count];
+				for (u64 cascadeIdx = 0; cascadeIdx < s_Cascade_Count; ++cascadeIdx)
+				{
+					splitDistances[cascadeIdx] = -m_directional_light.SplitDepth[cascadeIdx];
+				}
+				for (RenderWorld& world : renderFrame.RenderWorlds)
+				{
+					world.CullShadowCasters(m_directional_light.ProjView, splitDistances, s_Cascade_Count, m_buffer_frame.Proj_View);
+				}
 				data.RenderFrame = renderFrame;
 			}
 
@@ -561,44 +602,64 @@ namespace Insight
 
 					cmdList->SetUniform(1, 0, g_global_resources.Buffer_Directional_Light_View);
 
+					struct alignas(16) Object
+					{
+						Maths::Matrix4 Transform;
+						int CascadeIndex;
+					};
+					// Each cascade's casters are uploaded as one block, a draw binds its caster's entry by offset.
+					// Entries are padded so every offset is a valid uniform buffer offset.
+					const u64 objectStride = AlignUp(sizeof(Object), PhysicalDeviceInformation::Instance().MinUniformBufferAlignment);
+					std::vector<Byte> casterObjects;
+
 					RHI_Texture* depth_tex = render_graph.GetRHITexture(data.Depth_Tex);
 					for (u32 i = 0; i < depth_tex->GetInfo().Layer_Count; ++i)
 					{
 						IS_PROFILE_SCOPE("Slice");
-						Graphics::Frustum camera_frustum(m_directional_light.View[i], m_directional_light.Projection[i], ShadowZFar);
 
 						RenderpassDescription renderpass_description = render_graph.GetRenderpassDescription("Cascade shadow pass");
 						renderpass_description.DepthStencilAttachment.Layer_Array_Index = static_cast<u32>(i);
 						cmdList->BeginRenderpass(renderpass_description);
 
-						const float CasacdeMinRaius[s_Cascade_Count] = { 0.0f, 2.5f, 5.0f, 8.5f };
 						for (RenderWorld const& world : data.RenderFrame.RenderWorlds)
 						{
-							for (const u64 meshIndex : world.OpaqueMeshIndexs)
+							if (i >= world.ShadowCasterVisibility.GetViewCount())
 							{
-								const RenderMesh& mesh = world.Meshes.at(meshIndex);
-								if (mesh.BoudingBox.GetRadius() < CasacdeMinRaius[i])
-								{
-									continue;
-								}
+								continue;
+							}
 
-								struct alignas(16) Object
-								{
-									Maths::Matrix4 Transform;
-									int CascadeIndex;
-								};
-								Object object =
-								{
-									mesh.Transform,
-									static_cast<int>(i)
-								};
-								cmdList->SetUniform(2, 1, object);
-
-								const Runtime::MeshLOD& renderMeshLod = mesh.GetLOD(MeshLod);
-								cmdList->SetVertexBuffer(renderMeshLod.Vertex_buffer);
-								cmdList->SetIndexBuffer(renderMeshLod.Index_buffer, Graphics::IndexType::Uint32);
-								cmdList->DrawIndexed(renderMeshLod.Index_count, 1, renderMeshLod.First_index, renderMeshLod.Vertex_offset, 0);
-								++RenderStats::Instance().MeshCount;
+							const RenderVisibility::View casters = world.ShadowCasterVisibility.GetView(i);
+							if (i < RenderStats::MaxShadowCascadeCount)
+							{
+								RenderStats::Instance().ShadowCasterCounts[i] += casters.Size();
+							}
+
+							if (casters.Size() == 0)
+							{
+								continue;
+							}
+							// 'ShadowCasterLods' runs parallel to all the views' mesh indices.
+							const u8* casterLods = world.ShadowCasterLods.data() + (casters.Begin - world.ShadowCasterVisibility.MeshIndexs.data());
+
+							Object object = { };
+							object.CascadeIndex = static_cast<int>(i);
+							casterObjects.assign(casters.Size() * objectStride, 0);
+							for (u64 casterIdx = 0; casterIdx < casters.Size(); ++casterIdx)
+							{
+								object.Transform = world.Meshes[casters.Begin[casterIdx]].Transform;
+								std::memcpy(casterObjects.data() + casterIdx * objectStride, &object, sizeof(Object));
+							}
+							const RHI_BufferView casterObjectsView = cmdList->UploadUniform(casterObjects.data(), static_cast<u32>(casterObjects.size()));
+							if (!casterObjectsView.IsValid())
+							{
+								continue;
+							}
+
+							for (u64 casterIdx = 0; casterIdx < casters.Size(); ++casterIdx)
+							{
+								const RenderMesh& mesh = world.Meshes[casters.Begin[casterIdx]];
+								cmdList->SetUniform(2, 1, RHI_BufferView(casterObjectsView.GetBuffer(), casterObjectsView.GetOffset() + casterIdx * objectStride, sizeof(Object)));
+								DrawRenderMesh(cmdList, mesh, casterLods[casterIdx]);
 							}
 						}
 						cmdList->EndRenderpass();
@@ -837,17 +898,13 @@ namespace Insight
 									object.Previous_Transform = mesh.Transform;
 									cmdList->SetUniform(2, 0, object);
 
-									const Runtime::MeshLOD& renderMeshLod = mesh.GetLOD(MeshLod);
-									cmdList->SetVertexBuffer(renderMeshLod.Vertex_buffer);
-									cmdList->SetIndexBuffer(renderMeshLod.Index_buffer, Graphics::IndexType::Uint32);
-									cmdList->DrawIndexed(renderMeshLod.Index_count, 1, renderMeshLod.First_index, renderMeshLod.Vertex_offset, 0);
-									++RenderStats::Instance().MeshCount;
+									DrawRenderMesh(cmdList, mesh, mesh.Lod);
 								}
 							}
 						}
 						else
 						{
-							for (const u64 meshIndex : world.OpaqueMeshIndexs)
+							for (const u64 meshIndex : world.VisibleOpaqueMeshIndexs)
 							{
 								IS_PROFILE_SCOPE("Draw Entity");
 								const RenderMesh& mesh = world.Meshes.at(meshIndex);
@@ -871,11 +928,7 @@ namespace Insight
 
 								cmdList->SetUniform(2, 0, object);
 
-								const Runtime::MeshLOD& renderMeshLod = mesh.GetLOD(MeshLod);
-								cmdList->SetVertexBuffer(renderMeshLod.Vertex_buffer);
-								cmdList->SetIndexBuffer(renderMeshLod.Index_buffer, Graphics::IndexType::Uint32);
-								cmdList->DrawIndexed(renderMeshLod.Index_count, 1, renderMeshLod.First_index, renderMeshLod.Vertex_offset, 0);
-								++RenderStats::Instance().MeshCount;
+								DrawRenderMesh(cmdList, mesh, mesh.Lod);
 							}
 						}
 					}
@@ -1017,17 +1070,13 @@ namespace Insight
 									object.Previous_Transform = mesh.Transform;
 									cmdList->SetUniform(2, 0, object);
 
-									const Runtime::MeshLOD& renderMeshLod = mesh.GetLOD(MeshLod);
-									cmdList->SetVertexBuffer(renderMeshLod.Vertex_buffer);
-									cmdList->SetIndexBuffer(renderMeshLod.Index_buffer, Graphics::IndexType::Uint32);
-									cmdList->DrawIndexed(renderMeshLod.Index_count, 1, renderMeshLod.First_index, renderMeshLod.Vertex_offset, 0);
-									++RenderStats::Instance().MeshCount;
+									DrawRenderMesh(cmdList, mesh, mesh.Lod);
 								}
 							}
 						}
 						else
 						{
-							for (const u64 meshIndex : world.TransparentMeshIndexs)
+							for (const u64 meshIndex : world.VisibleTransparentMeshIndexs)
 							{
 								IS_PROFILE_SCOPE("Draw Entity");
 								const RenderMesh& mesh = world.Meshes.at(meshIndex);
@@ -1047,11 +1096,7 @@ namespace Insight
 
 								cmdList->SetUniform(2, 0, object);
 
-								const Runtime::MeshLOD& renderMeshLod = mesh.GetLOD(MeshLod);
-								cmdList->SetVertexBuffer(renderMeshLod.Vertex_buffer);
-								cmdList->SetIndexBuffer(renderMeshLod.Index_buffer, Graphics::IndexType::Uint32);
-								cmdList->DrawIndexed(renderMeshLod.Index_count, 1, renderMeshLod.First_index, renderMeshLod.Vertex_offset, 0);
-								++RenderStats::Instance().MeshCount;
+								DrawRenderMesh(cmdList, mesh, mesh.Lod);
 							}
 						}
 					}
@@ -74,5 +74,39 @@ namespace Insight
 		{
 			return static_cast<u32>(m_lods.size());
 		}
+
+		const OccluderGeometry& Mesh::GetOccluderGeometry() const
+		{
+			return m_occluderGeometry;
+		}
+
+		void Mesh::SetOccluderGeometry(const Graphics::Vertex* vertices, const u32* indices)
+		{
+			m_occluderGeometry = OccluderGeometry();
+
+			const MeshLOD* occluderLod = nullptr;
+			for (const MeshLOD& meshLod : m_lods)
+			{
+				if (meshLod.Index_count > 0 && meshLod.Index_count / 3 <= OccluderGeometry::c_MaxTriangleCount)
+				{
+					occluderLod = &meshLod;
+					break;
+				}
+			}
+			if (!occluderLod)
+			{
+				return;
+			}
+
+			// LOD indices are relative to the LOD's first vertex.
+			const Graphics::Vertex* lodVertices = vertices + occluderLod->Vertex_offset;
+			m_occluderGeometry.Positions.reserve(occluderLod->Vertex_count);
+			for (u32 vertexIdx = 0; vertexIdx < occluderLod->Vertex_count; ++vertexIdx)
+			{
+				const float* position = lodVertices[vertexIdx].Position;
+				m_occluderGeometry.Positions.push_back(Maths::Vector3(position[0], position[1], position[2]));
+			}
+			m_occluderGeometry.Indices.assign(indices + occluderLod->First_index, indices + occluderLod->First_index + occluderLod->Index_count);
+		}
 	}
 }
\ No newline at end of file
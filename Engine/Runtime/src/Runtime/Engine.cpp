@@ -10,11 +10,16 @@
 #include "Runtime/CommandLineDefines.h"
 
 #include "Core/ImGuiSystem.h"
+#include "Core/CPUDispatch.h"
 #include "Core/Profiler.h"
 #include "Core/Logger.h"
 #include "Core/Timer.h"
+#include "Core/MemoryTracker.h"
+#include "Memory/AllocationTrace.h"
+#include "Memory/MemoryBudget.h"
 #include "Core/Delegate.h"
 #include "Core/EnginePaths.h"
+#include "Core/StringUtils.h"
 
 #include "Core/Collections/Span.h"
 
@@ -30,16 +35,49 @@
 
 #include "Physics/PhysicsWorld.h"
 
+#include "Maths/Batch.h"
+
 #include "imgui.h"
 
 #include "Core/ProxyAllocator.h"
 
+#include <charconv>
+#include <limits>
+
 namespace Insight
 {
 	namespace App
 	{
 		Core::Timer Engine::s_FrameTimer;
 
+		static float ToMilliseconds(const Core::DurationNano duration)
+		{
+			return static_cast<float>(duration.count() / 1'000'000.0);
+		}
+
+		/// @brief Parse a whole number of megabytes into bytes. Returns false if 'value' isn't a valid number.
+		static bool ParseMegabytes(const std::string& value, u64& bytes)
+		{
+			const u64 first = value.find_first_not_of(' ');
+			const u64 last = value.find_last_not_of(' ');
+			if (first == std::string::npos)
+			{
+				return false;
+			}
+
+			const char* begin = value.data() + first;
+			const char* end = value.data() + last + 1;
+			u64 megabytes = 0;
+			const std::from_chars_result result = std::from_chars(begin, end, megabytes);
+			if (result.ec != std::errc() || result.ptr != end
+				|| megabytes > std::numeric_limits<u64>::max() / 1_MB)
+			{
+				return false;
+			}
+			bytes = megabytes * 1_MB;
+			return true;
+		}
+
 		Engine::Engine()
 		{
 			ProxyAllocator<int*> p;
@@ -106,11 +144,20 @@ namespace Insight
 			{
 				while (!Platform::IsDebuggerAttached());
 			}
+			m_pipelinedFrame = Core::CommandLineArgs::GetCommandLineValue(CMD_PIPELINED_FRAME)->GetBool();
+			if (const u32 memorySampleRate = Core::CommandLineArgs::GetCommandLineValue(CMD_MEMORY_SAMPLE_RATE)->GetU32();
+				memorySampleRate > 0)
+			{
+				Core::MemoryTracker::Instance().SetSampleRate(memorySampleRate);
+			}
+			m_recordAllocationTraceFrame = Core::CommandLineArgs::GetCommandLineValue(CMD_RECORD_ALLOCATION_TRACE)->GetU32();
+			ParseMemoryBudgets();
 
 			m_assetRegistry.Initialise();
 
 			m_updateThread = std::this_thread::get_id();
 			Platform::Initialise();
+			InitialiseCPUDispatch();
 			EnginePaths::Initialise();
 
 			OnPreInit();
@@ -146,6 +193,7 @@ namespace Insight
 		void Engine::Update()
 		{
 			s_FrameTimer.Start();
+			m_pendingFrameLatencyTimer.Start();
 
 			while (!Graphics::Window::Instance().ShouldClose() && !m_shouldClose)
 			{
@@ -154,93 +202,277 @@ namespace Insight
 
 				ASSERT(Platform::IsMainThread());
 
+				const bool recordAllocationTrace = m_recordAllocationTraceFrame != 0 && FrameCount == m_recordAllocationTraceFrame;
+				if (recordAllocationTrace)
+				{
+					Core::AllocationTrace::Start();
+				}
+
 				s_FrameTimer.Stop();
 				float delta_time = s_FrameTimer.GetElapsedTimeMillFloat();
 				delta_time = std::max(delta_time, 1.0f / 1000.0f);
 				s_FrameTimer.Start();
-				{
-					IS_PROFILE_SCOPE("Game Update");
+				m_frameStageTimings.Frame = ToMilliseconds(s_FrameTimer.GetElapsedTimeNano());
 
-					Graphics::Window::Instance().Update();
-					Graphics::RenderContext::Instance().ImGuiBeginFrame();
-					GPUProfiler::Instance().GetFrameData().Draw();
+				// Sampled before the event system updates so pressure events are handled this frame.
+				Core::MemoryBudget::Instance().Update(FrameCount);
+				UpdateSimulation(delta_time);
 
+				{
+					IS_PROFILE_SCOPE("Render Update");
+					if (m_pipelinedFrame)
 					{
-						IS_PROFILE_SCOPE("EventSystem");
-						m_eventSystem.Update();
+						RenderPipelined();
 					}
-
+					else
 					{
-						IS_PROFILE_SCOPE("GraphicsSystem Update");
-						m_graphicsSystem.Update();
+						RenderSerial();
 					}
+				}
 
-					{
-						IS_PROFILE_SCOPE("InputSsytem Update");
-						m_inputSystem.Update(delta_time);
-					}
+				m_inputSystem.ClearFrame();
 
-					{
-						IS_PROFILE_SCOPE("AnimationSystem Update");
-						m_animationSystem.Update(delta_time);
-					}
+				if (recordAllocationTrace)
+				{
+					Core::AllocationTrace::Stop();
+					Core::AllocationTrace::Save("AllocationTrace.bin");
+				}
+				++FrameCount;
+			}
 
-					{
-						Input::InputDevice_KeyboardMouse* mouseAndKeyboardDevice = m_inputSystem.GetKeyboardMouseDevice();
-						Input::InputDevice_Controller* controllerDevice = m_inputSystem.GetController(0);
-						if ((mouseAndKeyboardDevice && mouseAndKeyboardDevice->WasReleased(Input::KeyboardButtons::Key_Tilde))
-							|| (controllerDevice && controllerDevice->WasReleased(Input::ControllerButtons::Thumbstick_Left) && controllerDevice->WasReleased(Input::ControllerButtons::Thumbstick_Right)))
-						{
-							m_console.Show(!m_console.IsShowing());
-						}
-					}
+			m_graphicsSystem.WaitForRenderFramePreparation();
+		}
 
-					OnUpdate();
+		void Engine::UpdateSimulation(const float deltaTime)
+		{
+			IS_PROFILE_SCOPE("Game Update");
+			Core::Timer simulationTimer;
+			simulationTimer.Start();
 
-					{
-						IS_PROFILE_SCOPE("PhysicsWorld Update");
-						TObjectPtr<Runtime::World> activeWorld = m_worldSystem.GetActiveWorld();
-						if (activeWorld && activeWorld->GetWorldState() == Runtime::WorldStates::Running)
-						{
-							Physics::PhysicsWorld::Update(delta_time);
-						}
-					}
+			Graphics::Window::Instance().Update();
+			Graphics::RenderContext::Instance().ImGuiBeginFrame();
+			GPUProfiler::Instance().GetFrameData().Draw();
 
-					{
-						IS_PROFILE_SCOPE("EarlyUpdate");
-						m_worldSystem.EarlyUpdate();
-					}
-					{
-						IS_PROFILE_SCOPE("Update");
-						m_worldSystem.Update(delta_time);
-					}
-					{
-						IS_PROFILE_SCOPE("LateUpdate");
-						m_worldSystem.LateUpdate();
-					}
+			{
+				IS_PROFILE_SCOPE("EventSystem");
+				m_eventSystem.Update();
+			}
+
+			{
+				IS_PROFILE_SCOPE("GraphicsSystem Update");
+				m_graphicsSystem.Update();
+			}
+
+			{
+				IS_PROFILE_SCOPE("InputSsytem Update");
+				m_inputSystem.Update(deltaTime);
+			}
+
+			{
+				IS_PROFILE_SCOPE("AnimationSystem Update");
+				m_animationSystem.Update(deltaTime);
+			}
+
+			{
+				Input::InputDevice_KeyboardMouse* mouseAndKeyboardDevice = m_inputSystem.GetKeyboardMouseDevice();
+				Input::InputDevice_Controller* controllerDevice = m_inputSystem.GetController(0);
+				if ((mouseAndKeyboardDevice && mouseAndKeyboardDevice->WasReleased(Input::KeyboardButtons::Key_Tilde))
+					|| (controllerDevice && controllerDevice->WasReleased(Input::ControllerButtons::Thumbstick_Left) && controllerDevice->WasReleased(Input::ControllerButtons::Thumbstick_Right)))
+				{
+					m_console.Show(!m_console.IsShowing());
 				}
+			}
+
+			OnUpdate();
 
+			{
+				IS_PROFILE_SCOPE("PhysicsWorld Update");
+				TObjectPtr<Runtime::World> activeWorld = m_worldSystem.GetActiveWorld();
+				if (activeWorld && activeWorld->GetWorldState() == Runtime::WorldStates::Running)
 				{
-					IS_PROFILE_SCOPE("Render Update");
-					m_graphicsSystem.CreateRenderFrame();
-					Graphics::RenderStats::Instance().Draw();
+					Physics::PhysicsWorld::Update(deltaTime);
+				}
+			}
 
-					{
-						m_animationSystem.WaitForAllAnimationUpdates();
-						m_animationSystem.GPUSkinning(RemoveConst(m_graphicsSystem.GetRenderFrame()));
-					}
+			{
+				IS_PROFILE_SCOPE("EarlyUpdate");
+				m_worldSystem.EarlyUpdate();
+			}
+			{
+				IS_PROFILE_SCOPE("Update");
+				m_worldSystem.Update(deltaTime);
+			}
+			{
+				IS_PROFILE_SCOPE("LateUpdate");
+				m_worldSystem.LateUpdate();
+			}
 
-					OnRender();
+			simulationTimer.Stop();
+			m_frameStageTimings.Simulation = ToMilliseconds(simulationTimer.GetElapsedTimeNano());
+			m_simulationEndTimer.Start();
+		}
 
-					{
-						IS_PROFILE_SCOPE("GraphicsSystem Render");
-						m_graphicsSystem.Render();
-					}
+		void Engine::RenderSerial()
+		{
+			Core::Timer stageTimer;
+			stageTimer.Start();
+			m_graphicsSystem.ExtractRenderFrame();
+			stageTimer.Stop();
+			m_frameStageTimings.Extraction = ToMilliseconds(stageTimer.GetElapsedTimeNano());
+
+			m_graphicsSystem.PrepareRenderFrame();
+			m_frameStageTimings.Preparation = m_graphicsSystem.GetRenderFramePreparationTime();
+			m_frameStageTimings.PreparationWait = 0.0f;
+
+			Graphics::RenderStats::Instance().Draw();
+			DrawFrameStageTimings();
+
+			{
+				m_animationSystem.WaitForAllAnimationUpdates();
+				m_animationSystem.GPUSkinning(RemoveConst(m_graphicsSystem.GetRenderFrame()));
+			}
+
+			stageTimer.Start();
+			OnRender();
+			{
+				IS_PROFILE_SCOPE("GraphicsSystem Render");
+				m_graphicsSystem.Render();
+			}
+			stageTimer.Stop();
+			m_frameStageTimings.Submit = ToMilliseconds(stageTimer.GetElapsedTimeNano());
+
+			m_simulationEndTimer.Stop();
+			m_frameStageTimings.Latency = ToMilliseconds(m_simulationEndTimer.GetElapsedTimeNano());
+			m_pendingFrameLatencyTimer = m_simulationEndTimer;
+		}
+
+		void Engine::RenderPipelined()
+		{
+			// Submit the previous frame. It was prepared on the workers while this frame simulated.
+			Core::Timer stageTimer;
+			stageTimer.Start();
+			m_graphicsSystem.WaitForRenderFramePreparation();
+			stageTimer.Stop();
+			m_frameStageTimings.PreparationWait = ToMilliseconds(stageTimer.GetElapsedTimeNano());
+			m_frameStageTimings.Preparation = m_graphicsSystem.GetRenderFramePreparationTime();
+
+			Graphics::RenderStats::Instance().Draw();
+			DrawFrameStageTimings();
+
+			stageTimer.Start();
+			OnRender();
+			{
+				IS_PROFILE_SCOPE("GraphicsSystem Render");
+				m_graphicsSystem.Render();
+			}
+			stageTimer.Stop();
+			m_frameStageTimings.Submit = ToMilliseconds(stageTimer.GetElapsedTimeNano());
+
+			m_pendingFrameLatencyTimer.Stop();
+			m_frameStageTimings.Latency = ToMilliseconds(m_pendingFrameLatencyTimer.GetElapsedTimeNano());
+			m_pendingFrameLatencyTimer = m_simulationEndTimer;
+
+			// Extract this frame while the world is not being updated, then prepare it while the next frame simulates.
+			// Skinning is setup now so it uses this frame's poses and is submitted with this frame.
+			stageTimer.Start();
+			m_graphicsSystem.ExtractRenderFrame();
+			stageTimer.Stop();
+			m_frameStageTimings.Extraction = ToMilliseconds(stageTimer.GetElapsedTimeNano());
+
+			{
+				m_animationSystem.WaitForAllAnimationUpdates();
+				m_animationSystem.GPUSkinning(RemoveConst(m_graphicsSystem.GetRenderFrame()));
+			}
+
+			m_graphicsSystem.PrepareRenderFrameAsync();
+		}
+
+		void Engine::DrawFrameStageTimings()
+		{
+			IS_PROFILE_FUNCTION();
+
+			ImGui::Begin("Frame Stages");
+			ImGui::Checkbox("Pipelined", &m_pipelinedFrame);
+			ImGui::Text("Frame: %.3fms", m_frameStageTimings.Frame);
+			ImGui::Text("Simulation: %.3fms", m_frameStageTimings.Simulation);
+			ImGui::Text("Extraction: %.3fms", m_frameStageTimings.Extraction);
+			ImGui::Text("Preparation: %.3fms", m_frameStageTimings.Preparation);
+			ImGui::SetItemTooltip("Runs on a worker thread overlapping the next simulation when pipelined.");
+			ImGui::Text("Preparation Wait: %.3fms", m_frameStageTimings.PreparationWait);
+			ImGui::Text("Submit: %.3fms", m_frameStageTimings.Submit);
+			ImGui::Text("Latency: %.3fms", m_frameStageTimings.Latency);
+			ImGui::SetItemTooltip("Time from a frame's simulation finishing to it being submitted.");
+			ImGui::End();
+		}
+
+		void Engine::ParseMemoryBudgets()
+		{
+			for (u64 categoryIdx = 0; categoryIdx < static_cast<u64>(Core::MemoryAllocCategory::Size); ++categoryIdx)
+			{
+				std::string key = std::string(CMD_MEMORY_BUDGET_PREFIX) + Core::MemoryAllocCategoryToString[categoryIdx];
+				ToLower(key);
+				if (!Core::CommandLineArgs::CommandListExists(key))
+				{
+					continue;
 				}
 
-				m_inputSystem.ClearFrame();
-				++FrameCount;
+				// Values are in MB, "soft,hard" or a single value used for both.
+				const std::string value = Core::CommandLineArgs::GetCommandLineValue(key)->GetString();
+				const std::vector<std::string> limits = SplitString(value, ',');
+				if (limits.empty() || limits.size() > 2)
+				{
+					IS_LOG_CORE_WARN("[Engine::ParseMemoryBudgets] '{}' must be 'soft,hard' in MB, got '{}'.", key, value);
+					continue;
+				}
+
+				Core::MemoryCategoryBudget budget;
+				if (!ParseMegabytes(limits.front(), budget.SoftLimitBytes)
+					|| !ParseMegabytes(limits.back(), budget.HardLimitBytes))
+				{
+					IS_LOG_CORE_WARN("[Engine::ParseMemoryBudgets] '{}' must be 'soft,hard' in MB, got '{}'.", key, value);
+					continue;
+				}
+				if (budget.HardLimitBytes != 0 && budget.SoftLimitBytes > budget.HardLimitBytes)
+				{
+					IS_LOG_CORE_WARN("[Engine::ParseMemoryBudgets] '{}' soft limit is above the hard limit, using the hard limit for both.", key);
+					budget.SoftLimitBytes = budget.HardLimitBytes;
+				}
+				Core::MemoryBudget::Instance().SetBudget(static_cast<Core::MemoryAllocCategory>(categoryIdx), budget);
+				IS_LOG_CORE_INFO("[Engine::ParseMemoryBudgets] '{}' budget, soft {}MB, hard {}MB.",
+					Core::MemoryAllocCategoryToString[categoryIdx], budget.SoftLimitBytes / 1_MB, budget.HardLimitBytes / 1_MB);
 			}
+
+			m_memoryBudgetCsvPath = Core::CommandLineArgs::GetCommandLineValue(CMD_MEMORY_BUDGET_CSV)->GetString();
+		}
+
+		void Engine::InitialiseCPUDispatch()
+		{
+			static_assert(static_cast<u8>(Core::CPUInstructionSet::Count) == static_cast<u8>(Maths::BatchInstructionSet::Count));
+
+			Core::CPUDispatch::Initialise(Platform::GetCPUInformation());
+			Core::CPUDispatch::AddOnChangedCallback([](const Core::CPUInstructionSet instructionSet)
+				{
+					Maths::Batch::SetInstructionSet(static_cast<Maths::BatchInstructionSet>(instructionSet));
+				});
+
+			if (const std::string value = Core::CommandLineArgs::GetCommandLineValue(CMD_CPU_INSTRUCTION_SET)->GetString();
+				!value.empty())
+			{
+				const Core::CPUInstructionSet instructionSet = Core::CPUInstructionSetFromString(value);
+				if (instructionSet == Core::CPUInstructionSet::Count)
+				{
+					IS_LOG_CORE_WARN("[Engine::InitialiseCPUDispatch] Unknown instruction set '{}'.", value);
+				}
+				else
+				{
+					Core::CPUDispatch::SetOverride(instructionSet);
+				}
+			}
+
+			IS_LOG_CORE_INFO("[Engine::InitialiseCPUDispatch] Supported instruction set '{}', using '{}' (maths batches '{}').",
+				Core::CPUInstructionSetToString(Core::CPUDispatch::GetSupported()),
+				Core::CPUInstructionSetToString(Core::CPUDispatch::GetActive()),
+				Maths::BatchInstructionSetToString(Maths::Batch::GetInstructionSet()));
 		}
 
 		void Engine::Destroy()
@@ -252,6 +484,11 @@ namespace Insight
 
 			OnDestroy();
 
+			if (!m_memoryBudgetCsvPath.empty())
+			{
+				Core::MemoryBudget::Instance().SaveCsv(m_memoryBudgetCsvPath);
+			}
+
 			m_eventSystem.Shutdown();
 
 			m_projectSystem.Shutdown();
@@ -4,6 +4,10 @@
 #include "Core/Logger.h"
 
 #include "ECS/Components/TransformComponent.h"
+#include "ECS/Components/MeshComponent.h"
+#include "ECS/Components/SkinnedMeshComponent.h"
+
+#include "Resource/Mesh.h"
 
 #include "Event/EventSystem.h"
 #include "Runtime/RuntimeEvents.h"
@@ -50,6 +54,7 @@ namespace Insight
 			m_worldType = WorldTypes::Game;
 			m_root_entities_guids.clear();
 			m_entityManager.Destroy();
+			ClearSpatialIndex();
 
 			m_persistentScene = false;
 			m_onlySearchable = false;
@@ -71,9 +76,12 @@ namespace Insight
 			if (m_worldState == WorldStates::Paused)
 			{
 				m_entityManager.UpdateComponents<ECS::TransformComponent>();
-				return;
 			}
-			m_entityManager.Update(deltaTime);
+			else
+			{
+				m_entityManager.Update(deltaTime);
+			}
+			UpdateSpatialIndex();
 		}
 
 		void World::LateUpdate()
@@ -174,6 +182,154 @@ namespace Insight
 			return m_entityManager.GetEntityByGUID(guid);
 		}
 
+		std::vector<Core::GUID> World::QueryEntitiesInBox(const Graphics::BoundingBox& box) const
+		{
+			IS_PROFILE_FUNCTION();
+			std::vector<Core::GUID> entities;
+			m_spatialIndex.QueryAABB(box, [this, &entities](const u32, const u64 spatialEntityIdx)
+				{
+					entities.push_back(m_spatialEntities[spatialEntityIdx].EntityGuid);
+					return true;
+				});
+			return entities;
+		}
+
+		std::vector<Core::GUID> World::QueryEntitiesInSphere(const Maths::Vector3& center, const float radius) const
+		{
+			IS_PROFILE_FUNCTION();
+			std::vector<Core::GUID> entities;
+			m_spatialIndex.QuerySphere(center, radius, [this, &entities](const u32, const u64 spatialEntityIdx)
+				{
+					entities.push_back(m_spatialEntities[spatialEntityIdx].EntityGuid);
+					return true;
+				});
+			return entities;
+		}
+
+		std::vector<Core::GUID> World::QueryEntitiesInFrustum(const Graphics::Frustum& frustum) const
+		{
+			IS_PROFILE_FUNCTION();
+			std::vector<Core::GUID> entities;
+			m_spatialIndex.QueryFrustum(frustum, [this, &entities](const u32, const u64 spatialEntityIdx)
+				{
+					entities.push_back(m_spatialEntities[spatialEntityIdx].EntityGuid);
+					return true;
+				});
+			return entities;
+		}
+
+		Core::GUID World::RayCastEntity(const Graphics::Ray& ray, const float maxDistance, float* hitDistance) const
+		{
+			IS_PROFILE_FUNCTION();
+			Core::GUID closestEntity = Core::GUID::s_InvalidGUID;
+			float closestDistance = maxDistance;
+			m_spatialIndex.RayCast(ray, maxDistance, [&](const u32, const u64 spatialEntityIdx)
+				{
+					// The tree holds enlarged bounds, test the exact ones.
+					const SpatialEntity& spatialEntity = m_spatialEntities[spatialEntityIdx];
+					const float distance = ray.IntersectDistance(spatialEntity.WorldBounds);
+					if (distance >= 0.0f && distance < closestDistance)
+					{
+						closestDistance = distance;
+						closestEntity = spatialEntity.EntityGuid;
+					}
+					return closestDistance;
+				});
+
+			if (hitDistance && closestEntity.IsValid())
+			{
+				*hitDistance = closestDistance;
+			}
+			return closestEntity;
+		}
+
+		void World::UpdateSpatialIndex()
+		{
+			IS_PROFILE_FUNCTION();
+			// There are no transform change notifications, so every entity is visited but only changed ones touch the tree.
+			++m_spatialIndexStamp;
+
+			std::vector<Ptr<ECS::Entity>> entities = m_entityManager.GetAllEntities();
+			for (const Ptr<ECS::Entity>& entity : entities)
+			{
+				if (!entity->IsEnabled())
+				{
+					continue;
+				}
+
+				const ECS::MeshComponent* meshComponent = entity->GetComponent<ECS::MeshComponent>();
+				const ECS::SkinnedMeshComponent* skinnedMeshComponent = entity->GetComponent<ECS::SkinnedMeshComponent>();
+				Runtime::Mesh* mesh = nullptr;
+				if (meshComponent && meshComponent->IsEnabled())
+				{
+					mesh = meshComponent->GetMesh().Ptr();
+				}
+				else if (skinnedMeshComponent && skinnedMeshComponent->IsEnabled())
+				{
+					mesh = skinnedMeshComponent->GetMesh().Ptr();
+				}
+				if (!mesh)
+				{
+					continue;
+				}
+
+				const ECS::TransformComponent* transformComponent = entity->GetComponent<ECS::TransformComponent>();
+				const Maths::Matrix4 transform = transformComponent->GetTransform();
+
+				auto [lookupIter, inserted] = m_spatialEntityLookup.try_emplace(entity->GetGUID(), static_cast<u32>(m_spatialEntities.size()));
+				if (inserted)
+				{
+					SpatialEntity spatialEntity;
+					spatialEntity.EntityGuid = entity->GetGUID();
+					spatialEntity.Mesh = mesh;
+					spatialEntity.Transform = transform;
+					spatialEntity.WorldBounds = mesh->GetBoundingBox().Transform(transform);
+					spatialEntity.ProxyId = m_spatialIndex.CreateProxy(spatialEntity.WorldBounds, lookupIter->second);
+					spatialEntity.UpdateStamp = m_spatialIndexStamp;
+					m_spatialEntities.push_back(spatialEntity);
+					continue;
+				}
+
+				SpatialEntity& spatialEntity = m_spatialEntities[lookupIter->second];
+				spatialEntity.UpdateStamp = m_spatialIndexStamp;
+				if (spatialEntity.Mesh != mesh || spatialEntity.Transform != transform)
+				{
+					spatialEntity.Mesh = mesh;
+					spatialEntity.Transform = transform;
+					spatialEntity.WorldBounds = mesh->GetBoundingBox().Transform(transform);
+					m_spatialIndex.MoveProxy(spatialEntity.ProxyId, spatialEntity.WorldBounds);
+				}
+			}
+
+			// Remove entities which weren't seen, swapping the last entity into their slot.
+			for (u64 spatialEntityIdx = 0; spatialEntityIdx < m_spatialEntities.size();)
+			{
+				SpatialEntity& spatialEntity = m_spatialEntities[spatialEntityIdx];
+				if (spatialEntity.UpdateStamp == m_spatialIndexStamp)
+				{
+					++spatialEntityIdx;
+					continue;
+				}
+
+				m_spatialIndex.DestroyProxy(spatialEntity.ProxyId);
+				m_spatialEntityLookup.erase(spatialEntity.EntityGuid);
+				if (spatialEntityIdx != m_spatialEntities.size() - 1)
+				{
+					spatialEntity = m_spatialEntities.back();
+					m_spatialIndex.SetUserData(spatialEntity.ProxyId, spatialEntityIdx);
+					m_spatialEntityLookup[spatialEntity.EntityGuid] = static_cast<u32>(spatialEntityIdx);
+				}
+				m_spatialEntities.pop_back();
+			}
+		}
+
+		void World::ClearSpatialIndex()
+		{
+			m_spatialIndex.Clear();
+			m_spatialEntities.clear();
+			m_spatialEntityLookup.clear();
+		}
+
 		void World::OnUnload()
 		{
 
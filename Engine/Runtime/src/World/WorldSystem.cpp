@@ -88,7 +88,7 @@ namespace Insight
 
         TObjectPtr<World> WorldSystem::CreateWorld(std::string worldName, WorldTypes worldType)
         {
-            TObjectOPtr<World> world = TObjectOPtr<World>(New<World, Core::MemoryAllocCategory::World>(worldName));
+            TObjectOPtr<World> world = MakeTObject<World, Core::MemoryAllocCategory::World>(worldName);
             world->m_worldName = worldName;
             world->m_worldType = worldType;
             world->Initialise();
@@ -147,6 +147,8 @@ project "InsightStandalone"
     --PhysicsConfig.FilterPlatforms()
     RuntimeConfig.FilterPlatforms()
 
+    MathsConfig.FilterFiles()
+
     removelinks
     {
         "Insight_Core" .. output_project_subfix .. ".lib",
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Insight
+{
+    namespace MathsBenchmark
+    {
+        /// @brief Timing and accuracy of one operation for one implementation.
+        struct BenchmarkResult
+        {
+            std::string Operation;
+            std::string Implementation;
+            double NsPerOp = 0.0;
+            /// @brief Error against the double precision reference, in units in the last place of the reference
+            /// rounded to float. Negative if the operation has no reference.
+            double MaxUlp = -1.0;
+            double MeanUlp = -1.0;
+        };
+
+        struct BenchmarkOptions
+        {
+            /// @brief Number of elements each operation is applied to per repetition.
+            size_t ElementCount = 4096;
+            /// @brief Number of timed passes over all elements, the fastest pass is reported.
+            size_t Repetitions = 64;
+            /// @brief Only run operations whose name contains this string.
+            std::string Filter;
+        };
+
+        /// @brief Runs each operation over 'ElementCount' inputs and records how long it took and how far its results
+        /// are from a double precision reference.
+        class BenchmarkRunner
+        {
+        public:
+            BenchmarkRunner(const BenchmarkOptions& options);
+
+            const BenchmarkOptions& GetOptions() const { return m_options; }
+            size_t GetElementCount() const { return m_options.ElementCount; }
+            std::mt19937& GetRandom() { return m_random; }
+
+            /// @brief Random values in [min, max).
+            std::vector<float> RandomFloats(const size_t count, const float min, const float max);
+
+            bool IsEnabled(const std::string& operation) const;
+
+            /// @brief Time 'op(i, out)' for every element, where 'out' points at 'components' floats for element i.
+            /// If 'reference' is not empty it holds 'components' doubles per element and the results are compared to it.
+            template<typename Op>
+            void Run(const std::string& operation, const std::string& implementation, const size_t components
+                , const std::vector<double>& reference, Op&& op);
+
+            /// @brief Time 'op(count)' which processes all elements at once, then compare 'results' to 'reference'.
+            template<typename Op>
+            void RunBulk(const std::string& operation, const std::string& implementation
+                , const std::vector<float>& results, const std::vector<double>& reference, Op&& op);
+
+            const std::vector<BenchmarkResult>& GetResults() const { return m_results; }
+
+            /// @brief Human readable table of all results.
+            std::string ToTable() const;
+            /// @brief All results as JSON, see 'main.cpp' for the layout.
+            std::string ToJson(const std::string& backend, const std::string& instructionSet) const;
+
+        private:
+            void AddResult(const std::string& operation, const std::string& implementation, const double nsPerOp
+                , const float* results, const std::vector<double>& reference);
+
+        private:
+            BenchmarkOptions m_options;
+            std::mt19937 m_random;
+            std::vector<BenchmarkResult> m_results;
+            /// @brief Written by each operation so the optimiser can't remove it.
+            std::vector<float> m_output;
+        };
+
+        /// @brief Distance between 'value' and 'reference' in float ulps at the magnitude of 'reference'.
+        /// References smaller than 'c_UlpFloor' are measured in ulps of 'c_UlpFloor'. Inputs are around unit scale, so
+        /// without a floor results which cancel to almost zero would report huge errors for a few bits of rounding.
+        double UlpError(const float value, const double reference);
+        constexpr double c_UlpFloor = 0.0625;
+
+        template<typename Op>
+        void BenchmarkRunner::Run(const std::string& operation, const std::string& implementation, const size_t components
+            , const std::vector<double>& reference, Op&& op)
+        {
+            if (!IsEnabled(operation))
+            {
+                return;
+            }
+
+            const size_t count = m_options.ElementCount;
+            m_output.assign(count * components, 0.0f);
+            float* output = m_output.data();
+
+            double bestNs = 0.0;
+            for (size_t repetition = 0; repetition < m_options.Repetitions; ++repetition)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    op(i, output + i * components);
+                }
+                const auto end = std::chrono::steady_clock::now();
+                const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                if (repetition == 0 || ns < bestNs)
+                {
+                    bestNs = ns;
+                }
+            }
+
+            AddResult(operation, implementation, bestNs / static_cast<double>(count), output, reference);
+        }
+
+        template<typename Op>
+        void BenchmarkRunner::RunBulk(const std::string& operation, const std::string& implementation
+            , const std::vector<float>& results, const std::vector<double>& reference, Op&& op)
+        {
+            if (!IsEnabled(operation))
+            {
+                return;
+            }
+
+            const size_t count = m_options.ElementCount;
+            double bestNs = 0.0;
+            for (size_t repetition = 0; repetition < m_options.Repetitions; ++repetition)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                op(count);
+                const auto end = std::chrono::steady_clock::now();
+                const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                if (repetition == 0 || ns < bestNs)
+                {
+                    bestNs = ns;
+                }
+            }
+
+            AddResult(operation, implementation, bestNs / static_cast<double>(count), results.data(), reference);
+        }
+
+        void RunVectorBenchmarks(BenchmarkRunner& runner);
+        void RunMatrixBenchmarks(BenchmarkRunner& runner);
+        void RunQuaternionBenchmarks(BenchmarkRunner& runner);
+        void RunGeometryBenchmarks(BenchmarkRunner& runner);
+        void RunBatchBenchmarks(BenchmarkRunner& runner);
+    }
+}
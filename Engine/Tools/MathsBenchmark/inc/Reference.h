@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if defined(_WIN32)
+#define IS_BENCHMARK_DIRECTX_MATHS
+#endif
+
+namespace Insight
+{
+    namespace MathsBenchmark
+    {
+        /// @brief Double precision versions of the maths operations, used as the ground truth for the ulp error.
+        /// Matrices are 'n * n' values in the same memory order as the Insight matrices (m[i][j] at i * n + j)
+        /// and quaternions are w, x, y, z.
+        namespace Reference
+        {
+            inline std::vector<double> ToDouble(const std::vector<float>& values)
+            {
+                return std::vector<double>(values.begin(), values.end());
+            }
+
+            inline double Dot(const double* a, const double* b, const int n)
+            {
+                double result = 0.0;
+                for (int i = 0; i < n; ++i)
+                {
+                    result += a[i] * b[i];
+                }
+                return result;
+            }
+
+            inline void Cross(const double* a, const double* b, double* out)
+            {
+                out[0] = a[1] * b[2] - a[2] * b[1];
+                out[1] = a[2] * b[0] - a[0] * b[2];
+                out[2] = a[0] * b[1] - a[1] * b[0];
+            }
+
+            /// @brief out = lhs * rhs, out[i][j] = sum(lhs[k][j] * rhs[i][k]).
+            inline void Multiply(const double* lhs, const double* rhs, double* out, const int n)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    for (int j = 0; j < n; ++j)
+                    {
+                        double value = 0.0;
+                        for (int k = 0; k < n; ++k)
+                        {
+                            value += lhs[k * n + j] * rhs[i * n + k];
+                        }
+                        out[i * n + j] = value;
+                    }
+                }
+            }
+
+            /// @brief out = m * v, out[j] = sum(m[k][j] * v[k]).
+            inline void Transform(const double* m, const double* v, double* out, const int n)
+            {
+                for (int j = 0; j < n; ++j)
+                {
+                    double value = 0.0;
+                    for (int k = 0; k < n; ++k)
+                    {
+                        value += m[k * n + j] * v[k];
+                    }
+                    out[j] = value;
+                }
+            }
+
+            inline void Transpose(const double* m, double* out, const int n)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    for (int j = 0; j < n; ++j)
+                    {
+                        out[j * n + i] = m[i * n + j];
+                    }
+                }
+            }
+
+            /// @brief Gauss-Jordan elimination with partial pivoting. Returns false if 'm' is singular.
+            inline bool Inverse(const double* m, double* out, const int n)
+            {
+                std::vector<double> a(m, m + n * n);
+                for (int i = 0; i < n * n; ++i)
+                {
+                    out[i] = (i / n == i % n) ? 1.0 : 0.0;
+                }
+
+                for (int column = 0; column < n; ++column)
+                {
+                    int pivot = column;
+                    for (int row = column + 1; row < n; ++row)
+                    {
+                        if (std::abs(a[row * n + column]) > std::abs(a[pivot * n + column]))
+                        {
+                            pivot = row;
+                        }
+                    }
+                    if (a[pivot * n + column] == 0.0)
+                    {
+                        return false;
+                    }
+                    for (int k = 0; k < n; ++k)
+                    {
+                        std::swap(a[pivot * n + k], a[column * n + k]);
+                        std::swap(out[pivot * n + k], out[column * n + k]);
+                    }
+
+                    const double scale = 1.0 / a[column * n + column];
+                    for (int k = 0; k < n; ++k)
+                    {
+                        a[column * n + k] *= scale;
+                        out[column * n + k] *= scale;
+                    }
+                    for (int row = 0; row < n; ++row)
+                    {
+                        if (row == column)
+                        {
+                            continue;
+                        }
+                        const double factor = a[row * n + column];
+                        for (int k = 0; k < n; ++k)
+                        {
+                            a[row * n + k] -= factor * a[column * n + k];
+                            out[row * n + k] -= factor * out[column * n + k];
+                        }
+                    }
+                }
+                return true;
+            }
+
+            inline void QuaternionMultiply(const double* q, const double* p, double* out)
+            {
+                out[0] = q[0] * p[0] - q[1] * p[1] - q[2] * p[2] - q[3] * p[3];
+                out[1] = q[0] * p[1] + q[1] * p[0] + q[2] * p[3] - q[3] * p[2];
+                out[2] = q[0] * p[2] + q[2] * p[0] + q[3] * p[1] - q[1] * p[3];
+                out[3] = q[0] * p[3] + q[3] * p[0] + q[1] * p[2] - q[2] * p[1];
+            }
+
+            /// @brief Shortest path slerp, the same as 'Quaternion::Slerp'.
+            inline void QuaternionSlerp(const double* from, const double* to, const double time, double* out)
+            {
+                double target[4] = { to[0], to[1], to[2], to[3] };
+                double cosTheta = Dot(from, to, 4);
+                if (cosTheta < 0.0)
+                {
+                    for (double& value : target)
+                    {
+                        value = -value;
+                    }
+                    cosTheta = -cosTheta;
+                }
+
+                double fromWeight = 1.0 - time;
+                double toWeight = time;
+                if (cosTheta < 1.0 - 1.0e-7)
+                {
+                    const double angle = std::acos(cosTheta);
+                    const double sinAngle = std::sin(angle);
+                    fromWeight = std::sin((1.0 - time) * angle) / sinAngle;
+                    toWeight = std::sin(time * angle) / sinAngle;
+                }
+                for (int i = 0; i < 4; ++i)
+                {
+                    out[i] = from[i] * fromWeight + target[i] * toWeight;
+                }
+            }
+
+            /// @brief Rotation matrix for a unit quaternion, the same layout as 'Matrix4(const Quaternion&)'.
+            inline void QuaternionToMatrix4(const double* q, double* out)
+            {
+                const double w = q[0], x = q[1], y = q[2], z = q[3];
+                const double values[16] =
+                {
+                    1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y + w * z), 2.0 * (x * z - w * y), 0.0,
+                    2.0 * (x * y - w * z), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z + w * x), 0.0,
+                    2.0 * (x * z + w * y), 2.0 * (y * z - w * x), 1.0 - 2.0 * (x * x + y * y), 0.0,
+                    0.0, 0.0, 0.0, 1.0,
+                };
+                std::copy(values, values + 16, out);
+            }
+
+            /// @brief Box enclosing the box 'min', 'max' transformed by 'm', the same as 'BoundingBox::Transform'.
+            inline void TransformAABB(const double* m, const double* min, const double* max, double* out)
+            {
+                double center[3];
+                double extent[3];
+                for (int k = 0; k < 3; ++k)
+                {
+                    center[k] = (min[k] + max[k]) * 0.5;
+                    extent[k] = (max[k] - min[k]) * 0.5;
+                }
+
+                for (int j = 0; j < 3; ++j)
+                {
+                    double newCenter = m[12 + j];
+                    double newExtent = 0.0;
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        newCenter += m[k * 4 + j] * center[k];
+                        newExtent += std::abs(m[k * 4 + j]) * extent[k];
+                    }
+                    out[j] = newCenter - newExtent;
+                    out[3 + j] = newCenter + newExtent;
+                }
+            }
+        }
+    }
+}
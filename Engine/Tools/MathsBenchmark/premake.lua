@@ -0,0 +1,96 @@
+local MathsConfig = require "../../Maths/lua/MathsConfig"
+
+newoption
+{
+    trigger = "maths_backend",
+    value = "BACKEND",
+    description = "Maths backend MathsBenchmark is built against",
+    default = "insight",
+    allowed =
+    {
+        { "insight", "Insight scalar maths" },
+        { "simd", "Insight SSE4.1/AVX2 maths (IS_MATHS_SIMD)" },
+        { "directx", "DirectXMath (IS_MATHS_DIRECTX_MATHS)" },
+        { "glm", "GLM (IS_MATHS_GLM)" },
+    }
+}
+
+project "MathsBenchmark"
+    configurations { "Debug", "Release" }
+    location "./"
+    kind "ConsoleApp"
+
+    targetname ("%{prj.name}" .. output_project_subfix)
+    targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+    debugdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+
+    -- The maths sources are built into the benchmark so the backend can be switched without rebuilding the engine.
+    defines
+    {
+        "IS_MONOLITH",
+    }
+    removedefines
+    {
+        "IS_PROFILE_ENABLED",
+    }
+
+    includedirs
+    {
+        "inc",
+        "%{IncludeDirs.glm}",
+        "%{IncludeDirs.nlohmann_json}",
+    }
+
+    files
+    {
+        "inc/**.hpp",
+        "inc/**.h",
+        "inc/**.inl",
+        "src/**.cpp",
+        "src/**.inl",
+
+        "../../Maths/src/**.cpp",
+        "../../Maths/src/**.inl",
+        "../../Graphics/src/Graphics/BoundingBox.cpp",
+        "../../Graphics/src/Graphics/Frustum.cpp",
+    }
+
+    MathsConfig.FilterFiles()
+
+    filter "options:maths_backend=simd"
+        defines { "IS_MATHS_SIMD" }
+    filter "options:maths_backend=directx"
+        defines { "IS_MATHS_DIRECTX_MATHS" }
+    filter "options:maths_backend=glm"
+        defines { "IS_MATHS_GLM" }
+
+    filter "configurations:Debug or configurations:Testing"
+        buildoptions "/MDd"
+        defines
+        {
+            "_DEBUG",
+            "IS_DEBUG",
+        }
+
+    filter "configurations:Release"
+    buildoptions "/MD"
+        optimize "On"
+                defines
+        {
+            "NDEBUG",
+            "IS_RELEASE",
+            "DOCTEST_CONFIG_DISABLE",
+        }
+
+    filter "system:Windows"
+    	system "windows"
+    	toolset("msc-v143")
+
+    filter "system:Unix"
+    	system "linux"
+    	toolset("clang")
+        defines
+        {
+            "IS_PLATFORM_LINUX",
+        }
@@ -0,0 +1,140 @@
+#include "BenchmarkRunner.h"
+#include "Reference.h"
+
+#include "Maths/Batch.h"
+
+namespace Insight
+{
+    namespace MathsBenchmark
+    {
+        namespace
+        {
+            /// @brief Transpose 'count' elements of 'components' values into one stream per component.
+            template<typename T>
+            std::vector<T> ToStreams(const std::vector<T>& values, const size_t components, const size_t count)
+            {
+                std::vector<T> streams(values.size());
+                for (size_t i = 0; i < count; ++i)
+                {
+                    for (size_t k = 0; k < components; ++k)
+                    {
+                        streams[k * count + i] = values[i * components + k];
+                    }
+                }
+                return streams;
+            }
+        }
+
+        void RunBatchBenchmarks(BenchmarkRunner& runner)
+        {
+            const size_t count = runner.GetElementCount();
+
+            // Inputs and references are generated per element then transposed into structure of arrays form,
+            // so result stream 'k' element 'i' is compared against reference 'k * count + i'.
+            const std::vector<float> a = runner.RandomFloats(count * 16, -1.0f, 1.0f);
+            const std::vector<float> b = runner.RandomFloats(count * 16, -1.0f, 1.0f);
+            const std::vector<float> boxes = runner.RandomFloats(count * 6, -10.0f, 10.0f);
+            std::vector<float> rotations = runner.RandomFloats(count * 8, -1.0f, 1.0f);
+            std::vector<float> time = runner.RandomFloats(count, 0.0f, 1.0f);
+
+            std::vector<float> aabbs(count * 6);
+            for (size_t i = 0; i < count; ++i)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    aabbs[i * 6 + k] = std::min(boxes[i * 6 + k], boxes[i * 6 + 3 + k]);
+                    aabbs[i * 6 + 3 + k] = std::max(boxes[i * 6 + k], boxes[i * 6 + 3 + k]);
+                }
+                for (int q = 0; q < 2; ++q)
+                {
+                    float* quaternion = &rotations[i * 8 + q * 4];
+                    const double d[4] = { quaternion[0], quaternion[1], quaternion[2], quaternion[3] };
+                    const double length = std::sqrt(Reference::Dot(d, d, 4));
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        quaternion[k] = static_cast<float>(d[k] / length);
+                    }
+                }
+            }
+
+            std::vector<double> multiplyReference(count * 16);
+            std::vector<double> aabbReference(count * 6);
+            std::vector<double> slerpReference(count * 4);
+            std::vector<float> from(count * 4);
+            std::vector<float> to(count * 4);
+            for (size_t i = 0; i < count; ++i)
+            {
+                double da[16];
+                double db[16];
+                for (int k = 0; k < 16; ++k)
+                {
+                    da[k] = a[i * 16 + k];
+                    db[k] = b[i * 16 + k];
+                }
+                Reference::Multiply(da, db, &multiplyReference[i * 16], 4);
+
+                const double min[3] = { aabbs[i * 6], aabbs[i * 6 + 1], aabbs[i * 6 + 2] };
+                const double max[3] = { aabbs[i * 6 + 3], aabbs[i * 6 + 4], aabbs[i * 6 + 5] };
+                Reference::TransformAABB(da, min, max, &aabbReference[i * 6]);
+
+                double dFrom[4];
+                double dTo[4];
+                for (int k = 0; k < 4; ++k)
+                {
+                    from[i * 4 + k] = rotations[i * 8 + k];
+                    to[i * 4 + k] = rotations[i * 8 + 4 + k];
+                    dFrom[k] = from[i * 4 + k];
+                    dTo[k] = to[i * 4 + k];
+                }
+                Reference::QuaternionSlerp(dFrom, dTo, time[i], &slerpReference[i * 4]);
+            }
+            multiplyReference = ToStreams(multiplyReference, 16, count);
+            aabbReference = ToStreams(aabbReference, 6, count);
+            slerpReference = ToStreams(slerpReference, 4, count);
+
+            std::vector<float> lhsStreams = ToStreams(a, 16, count);
+            std::vector<float> rhsStreams = ToStreams(b, 16, count);
+            std::vector<float> aabbStreams = ToStreams(aabbs, 6, count);
+            std::vector<float> fromStreams = ToStreams(from, 4, count);
+            std::vector<float> toStreams = ToStreams(to, 4, count);
+            std::vector<float> matrixResult(count * 16);
+            std::vector<float> aabbResult(count * 6);
+            std::vector<float> slerpResult(count * 4);
+
+            const Maths::Matrix4SoA lhs = Maths::Matrix4SoA::FromBuffer(lhsStreams.data(), count);
+            const Maths::Matrix4SoA rhs = Maths::Matrix4SoA::FromBuffer(rhsStreams.data(), count);
+            const Maths::Matrix4SoA matrixOut = Maths::Matrix4SoA::FromBuffer(matrixResult.data(), count);
+            const Maths::AABBSoA aabbIn = Maths::AABBSoA::FromBuffer(aabbStreams.data(), count);
+            const Maths::AABBSoA aabbOut = Maths::AABBSoA::FromBuffer(aabbResult.data(), count);
+            const Maths::QuaternionSoA fromIn = Maths::QuaternionSoA::FromBuffer(fromStreams.data(), count);
+            const Maths::QuaternionSoA toIn = Maths::QuaternionSoA::FromBuffer(toStreams.data(), count);
+            const Maths::QuaternionSoA slerpOut = Maths::QuaternionSoA::FromBuffer(slerpResult.data(), count);
+
+            const Maths::BatchInstructionSet previous = Maths::Batch::GetInstructionSet();
+            for (int set = 0; set < static_cast<int>(Maths::BatchInstructionSet::Count); ++set)
+            {
+                const Maths::BatchInstructionSet instructionSet = static_cast<Maths::BatchInstructionSet>(set);
+                if (!Maths::Batch::IsInstructionSetAvailable(instructionSet))
+                {
+                    continue;
+                }
+                Maths::Batch::SetInstructionSet(instructionSet);
+                const std::string implementation = std::string("Batch ") + Maths::BatchInstructionSetToString(instructionSet);
+
+                runner.RunBulk("Matrix4 Multiply", implementation, matrixResult, multiplyReference, [&](const size_t elementCount)
+                    {
+                        Maths::Batch::Multiply(lhs, rhs, matrixOut, elementCount);
+                    });
+                runner.RunBulk("BoundingBox Transform", implementation, aabbResult, aabbReference, [&](const size_t elementCount)
+                    {
+                        Maths::Batch::TransformAABB(lhs, aabbIn, aabbOut, elementCount);
+                    });
+                runner.RunBulk("Quaternion Slerp", implementation, slerpResult, slerpReference, [&](const size_t elementCount)
+                    {
+                        Maths::Batch::Slerp(fromIn, toIn, time.data(), slerpOut, elementCount);
+                    });
+            }
+            Maths::Batch::SetInstructionSet(previous);
+        }
+    }
+}
@@ -0,0 +1,123 @@
+#include "BenchmarkRunner.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace Insight
+{
+    namespace MathsBenchmark
+    {
+        double UlpError(const float value, const double reference)
+        {
+            if (std::isnan(value) || std::isnan(reference))
+            {
+                return std::isnan(value) && std::isnan(reference) ? 0.0 : std::numeric_limits<double>::infinity();
+            }
+
+            const float magnitude = static_cast<float>(std::max(std::abs(reference), c_UlpFloor));
+            const double ulp = static_cast<double>(std::nextafter(magnitude, std::numeric_limits<float>::infinity()) - magnitude);
+            return std::abs(static_cast<double>(value) - reference) / ulp;
+        }
+
+        BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options)
+            : m_options(options)
+            , m_random(0x1A5B)
+        { }
+
+        std::vector<float> BenchmarkRunner::RandomFloats(const size_t count, const float min, const float max)
+        {
+            std::uniform_real_distribution<float> distribution(min, max);
+            std::vector<float> values(count);
+            for (float& value : values)
+            {
+                value = distribution(m_random);
+            }
+            return values;
+        }
+
+        bool BenchmarkRunner::IsEnabled(const std::string& operation) const
+        {
+            return m_options.Filter.empty() || operation.find(m_options.Filter) != std::string::npos;
+        }
+
+        void BenchmarkRunner::AddResult(const std::string& operation, const std::string& implementation, const double nsPerOp
+            , const float* results, const std::vector<double>& reference)
+        {
+            BenchmarkResult result;
+            result.Operation = operation;
+            result.Implementation = implementation;
+            result.NsPerOp = nsPerOp;
+
+            if (!reference.empty())
+            {
+                double maxUlp = 0.0;
+                double sumUlp = 0.0;
+                for (size_t i = 0; i < reference.size(); ++i)
+                {
+                    const double ulp = UlpError(results[i], reference[i]);
+                    maxUlp = std::max(maxUlp, ulp);
+                    sumUlp += ulp;
+                }
+                result.MaxUlp = maxUlp;
+                result.MeanUlp = sumUlp / static_cast<double>(reference.size());
+            }
+
+            m_results.push_back(std::move(result));
+        }
+
+        std::string BenchmarkRunner::ToTable() const
+        {
+            std::string table;
+            char line[256];
+            std::snprintf(line, sizeof(line), "%-28s %-20s %12s %12s %12s\n", "Operation", "Implementation", "ns/op", "max ulp", "mean ulp");
+            table += line;
+
+            for (const BenchmarkResult& result : m_results)
+            {
+                if (result.MaxUlp < 0.0)
+                {
+                    std::snprintf(line, sizeof(line), "%-28s %-20s %12.3f %12s %12s\n"
+                        , result.Operation.c_str(), result.Implementation.c_str(), result.NsPerOp, "-", "-");
+                }
+                else
+                {
+                    std::snprintf(line, sizeof(line), "%-28s %-20s %12.3f %12.2f %12.3f\n"
+                        , result.Operation.c_str(), result.Implementation.c_str(), result.NsPerOp, result.MaxUlp, result.MeanUlp);
+                }
+                table += line;
+            }
+            return table;
+        }
+
+        std::string BenchmarkRunner::ToJson(const std::string& backend, const std::string& instructionSet) const
+        {
+            nlohmann::json json;
+            json["backend"] = backend;
+            json["batchInstructionSet"] = instructionSet;
+            json["elementCount"] = m_options.ElementCount;
+            json["repetitions"] = m_options.Repetitions;
+
+            nlohmann::json results = nlohmann::json::array();
+            for (const BenchmarkResult& result : m_results)
+            {
+                nlohmann::json entry;
+                entry["operation"] = result.Operation;
+                entry["implementation"] = result.Implementation;
+                entry["nsPerOp"] = result.NsPerOp;
+                if (result.MaxUlp >= 0.0)
+                {
+                    entry["maxUlp"] = std::isfinite(result.MaxUlp) ? nlohmann::json(result.MaxUlp) : nlohmann::json();
+                    entry["meanUlp"] = std::isfinite(result.MeanUlp) ? nlohmann::json(result.MeanUlp) : nlohmann::json();
+                }
+                results.push_back(std::move(entry));
+            }
+            json["results"] = std::move(results);
+
+            return json.dump(4);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#include "BenchmarkRunner.h"
+#include "Reference.h"
+
+#include "Graphics/BoundingBox.h"
+#include "Graphics/Frustum.h"
+
+#include <glm/glm.hpp>
+
+namespace Insight
+{
+    namespace MathsBenchmark
+    {
+        namespace
+        {
+            /// @brief 'count' random affine transforms (rotation, scale in [0.5, 2) and translation) as 16 floats each.
+            std::vector<float> RandomTransforms(BenchmarkRunner& runner, const size_t count)
+            {
+                const std::vector<float> rotations = runner.RandomFloats(count * 4, -1.0f, 1.0f);
+                const std::vector<float> scales = runner.RandomFloats(count * 3, 0.5f, 2.0f);
+                const std::vector<float> translations = runner.RandomFloats(count * 3, -100.0f, 100.0f);
+
+                std::vector<float> transforms(count * 16);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    double q[4] = { rotations[i * 4], rotations[i * 4 + 1], rotations[i * 4 + 2], rotations[i * 4 + 3] };
+                    const double length = std::sqrt(Reference::Dot(q, q, 4));
+                    for (double& value : q)
+                    {
+                        value /= length;
+                    }
+
+                    double m[16];
+                    Reference::QuaternionToMatrix4(q, m);
+                    for (int row = 0; row < 3; ++row)
+                    {
+                        for (int column = 0; column < 3; ++column)
+                        {
+                            m[row * 4 + column] *= scales[i * 3 + row];
+                        }
+                        m[12 + row] = translations[i * 3 + row];
+                    }
+                    for (int k = 0; k < 16; ++k)
+                    {
+                        transforms[i * 16 + k] = static_cast<float>(m[k]);
+                    }
+                }
+                return transforms;
+            }
+        }
+
+        void RunGeometryBenchmarks(BenchmarkRunner& runner)
+        {
+            const size_t count = runner.GetElementCount();
+            const std::vector<float> transforms = RandomTransforms(runner, count);
+            const std::vector<float> centers = runner.RandomFloats(count * 3, -50.0f, 50.0f);
+            const std::vector<float> extents = runner.RandomFloats(count * 3, 0.1f, 10.0f);
+
+            const std::vector<double> dTransforms = Reference::ToDouble(transforms);
+            std::vector<double> transformReference(count * 6);
+            std::vector<Maths::Matrix4> insightTransforms;
+            std::vector<Graphics::BoundingBox> insightBoxes;
+            std::vector<glm::mat4> glmTransforms;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float* m = &transforms[i * 16];
+                const Maths::Vector3 center(centers[i * 3], centers[i * 3 + 1], centers[i * 3 + 2]);
+                const Maths::Vector3 extent(extents[i * 3], extents[i * 3 + 1], extents[i * 3 + 2]);
+                const Maths::Vector3 min = center - extent;
+                const Maths::Vector3 max = center + extent;
+
+                const double dMin[3] = { min.x, min.y, min.z };
+                const double dMax[3] = { max.x, max.y, max.z };
+                Reference::TransformAABB(&dTransforms[i * 16], dMin, dMax, &transformReference[i * 6]);
+
+                insightTransforms.push_back(Maths::Matrix4(
+                    Maths::Vector4(m[0], m[1], m[2], m[3]), Maths::Vector4(m[4], m[5], m[6], m[7]),
+                    Maths::Vector4(m[8], m[9], m[10], m[11]), Maths::Vector4(m[12], m[13], m[14], m[15])));
+                insightBoxes.push_back(Graphics::BoundingBox(min, max));
+
+                glm::mat4 glmTransform;
+                for (int k = 0; k < 16; ++k)
+                {
+                    glmTransform[k / 4][k % 4] = m[k];
+                }
+                glmTransforms.push_back(glmTransform);
+            }
+
+            runner.Run("BoundingBox Transform", "Insight", 6, transformReference, [&](const size_t i, float* out)
+                {
+                    const Graphics::BoundingBox result = insightBoxes[i].Transform(insightTransforms[i]);
+                    const Maths::Vector3& min = result.GetMin();
+                    const Maths::Vector3& max = result.GetMax();
+                    out[0] = min.x;
+                    out[1] = min.y;
+                    out[2] = min.z;
+                    out[3] = max.x;
+                    out[4] = max.y;
+                    out[5] = max.z;
+                });
+            runner.Run("BoundingBox Transform", "GLM", 6, transformReference, [&](const size_t i, float* out)
+                {
+                    const glm::vec3 min(insightBoxes[i].GetMin().x, insightBoxes[i].GetMin().y, insightBoxes[i].GetMin().z);
+                    const glm::vec3 max(insightBoxes[i].GetMax().x, insightBoxes[i].GetMax().y, insightBoxes[i].GetMax().z);
+                    const glm::mat4& transform = glmTransforms[i];
+                    const glm::mat3 absolute(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])), glm::abs(glm::vec3(transform[2])));
+
+                    const glm::vec3 center = glm::vec3(transform * glm::vec4((min + max) * 0.5f, 1.0f));
+                    const glm::vec3 extent = absolute * ((max - min) * 0.5f);
+                    const glm::vec3 resultMin = center - extent;
+                    const glm::vec3 resultMax = center + extent;
+                    out[0] = resultMin.x;
+                    out[1] = resultMin.y;
+                    out[2] = resultMin.z;
+                    out[3] = resultMax.x;
+                    out[4] = resultMax.y;
+                    out[5] = resultMax.z;
+                });
+
+            // Visibility is a yes/no answer so only the time is reported.
+            const Maths::Matrix4 view = Maths::Matrix4::LookAt(Maths::Vector3(0.0f, 0.0f, -60.0f), Maths::Vector3(0.0f), Maths::Vector3(0.0f, 1.0f, 0.0f));
+            const Maths::Matrix4 projection = Maths::Matrix4::CreatePerspective(1.0472f, 16.0f / 9.0f, 0.1f, 1000.0f);
+            const Graphics::Frustum frustum(view, projection, 1000.0f);
+            runner.Run("Frustum IsVisible", "Insight", 1, { }, [&](const size_t i, float* out)
+                {
+                    out[0] = frustum.IsVisible(insightBoxes[i]) ? 1.0f : 0.0f;
+                });
+        }
+    }
+}
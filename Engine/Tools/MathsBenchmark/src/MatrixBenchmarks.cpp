@@ -0,0 +1,223 @@
+#include "BenchmarkRunner.h"
+#include "Reference.h"
+
+#include "Maths/Matrix2.h"
+#include "Maths/Matrix3.h"
+#include "Maths/Matrix4.h"
+
+#include <glm/glm.hpp>
+#ifdef IS_BENCHMARK_DIRECTX_MATHS
+#include <DirectXMath.h>
+#endif
+
+namespace Insight
+{
+    namespace MathsBenchmark
+    {
+        namespace
+        {
+            template<int N>
+            struct MatrixTraits;
+
+            template<>
+            struct MatrixTraits<2>
+            {
+                using Type = Maths::Matrix2;
+                using VectorType = Maths::Vector2;
+                using GlmType = glm::mat2;
+                using GlmVectorType = glm::vec2;
+                static constexpr const char* c_Name = "Matrix2";
+                static VectorType MakeVector(const float* v) { return VectorType(v[0], v[1]); }
+                static Type Make(const float* m) { return Type(MakeVector(m), MakeVector(m + 2)); }
+            };
+
+            template<>
+            struct MatrixTraits<3>
+            {
+                using Type = Maths::Matrix3;
+                using VectorType = Maths::Vector3;
+                using GlmType = glm::mat3;
+                using GlmVectorType = glm::vec3;
+                static constexpr const char* c_Name = "Matrix3";
+                static VectorType MakeVector(const float* v) { return VectorType(v[0], v[1], v[2]); }
+                static Type Make(const float* m) { return Type(MakeVector(m), MakeVector(m + 3), MakeVector(m + 6)); }
+            };
+
+            template<>
+            struct MatrixTraits<4>
+            {
+                using Type = Maths::Matrix4;
+                using VectorType = Maths::Vector4;
+                using GlmType = glm::mat4;
+                using GlmVectorType = glm::vec4;
+                static constexpr const char* c_Name = "Matrix4";
+                static VectorType MakeVector(const float* v) { return VectorType(v[0], v[1], v[2], v[3]); }
+                static Type Make(const float* m) { return Type(MakeVector(m), MakeVector(m + 4), MakeVector(m + 8), MakeVector(m + 12)); }
+            };
+
+            template<int N, typename Matrix>
+            void StoreMatrix(const Matrix& m, float* out)
+            {
+                for (int i = 0; i < N; ++i)
+                {
+                    for (int j = 0; j < N; ++j)
+                    {
+                        out[i * N + j] = m[i][j];
+                    }
+                }
+            }
+
+            template<int N, typename Vector>
+            void StoreVector(const Vector& v, float* out)
+            {
+                for (int j = 0; j < N; ++j)
+                {
+                    out[j] = v[j];
+                }
+            }
+
+            template<int N>
+            void RunMatrix(BenchmarkRunner& runner)
+            {
+                using Traits = MatrixTraits<N>;
+                constexpr int c_Size = N * N;
+                const std::string name = Traits::c_Name;
+                const size_t count = runner.GetElementCount();
+
+                // Random entries with a dominant diagonal so every matrix is well conditioned and invertible.
+                std::vector<float> a = runner.RandomFloats(count * c_Size, -1.0f, 1.0f);
+                std::vector<float> b = runner.RandomFloats(count * c_Size, -1.0f, 1.0f);
+                const std::vector<float> v = runner.RandomFloats(count * N, -10.0f, 10.0f);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    for (int k = 0; k < N; ++k)
+                    {
+                        a[i * c_Size + k * N + k] += 3.0f;
+                        b[i * c_Size + k * N + k] += 3.0f;
+                    }
+                }
+
+                const std::vector<double> da = Reference::ToDouble(a);
+                const std::vector<double> db = Reference::ToDouble(b);
+                const std::vector<double> dv = Reference::ToDouble(v);
+                std::vector<double> multiplyReference(count * c_Size);
+                std::vector<double> inverseReference(count * c_Size);
+                std::vector<double> transposeReference(count * c_Size);
+                std::vector<double> transformReference(count * N);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    Reference::Multiply(&da[i * c_Size], &db[i * c_Size], &multiplyReference[i * c_Size], N);
+                    Reference::Inverse(&da[i * c_Size], &inverseReference[i * c_Size], N);
+                    Reference::Transpose(&da[i * c_Size], &transposeReference[i * c_Size], N);
+                    Reference::Transform(&da[i * c_Size], &dv[i * N], &transformReference[i * N], N);
+                }
+
+                std::vector<typename Traits::Type> insightA;
+                std::vector<typename Traits::Type> insightB;
+                std::vector<typename Traits::VectorType> insightV;
+                std::vector<typename Traits::GlmType> glmA;
+                std::vector<typename Traits::GlmType> glmB;
+                std::vector<typename Traits::GlmVectorType> glmV;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    insightA.push_back(Traits::Make(&a[i * c_Size]));
+                    insightB.push_back(Traits::Make(&b[i * c_Size]));
+                    insightV.push_back(Traits::MakeVector(&v[i * N]));
+
+                    typename Traits::GlmType glmMatrixA;
+                    typename Traits::GlmType glmMatrixB;
+                    typename Traits::GlmVectorType glmVector;
+                    for (int row = 0; row < N; ++row)
+                    {
+                        for (int column = 0; column < N; ++column)
+                        {
+                            glmMatrixA[row][column] = a[i * c_Size + row * N + column];
+                            glmMatrixB[row][column] = b[i * c_Size + row * N + column];
+                        }
+                        glmVector[row] = v[i * N + row];
+                    }
+                    glmA.push_back(glmMatrixA);
+                    glmB.push_back(glmMatrixB);
+                    glmV.push_back(glmVector);
+                }
+
+                runner.Run(name + " Multiply", "Insight", c_Size, multiplyReference, [&](const size_t i, float* out)
+                    {
+                        StoreMatrix<N>(insightA[i] * insightB[i], out);
+                    });
+                runner.Run(name + " Multiply", "GLM", c_Size, multiplyReference, [&](const size_t i, float* out)
+                    {
+                        StoreMatrix<N>(glmA[i] * glmB[i], out);
+                    });
+
+                runner.Run(name + " Inverse", "Insight", c_Size, inverseReference, [&](const size_t i, float* out)
+                    {
+                        StoreMatrix<N>(insightA[i].Inversed(), out);
+                    });
+                runner.Run(name + " Inverse", "GLM", c_Size, inverseReference, [&](const size_t i, float* out)
+                    {
+                        StoreMatrix<N>(glm::inverse(glmA[i]), out);
+                    });
+
+                runner.Run(name + " Transpose", "Insight", c_Size, transposeReference, [&](const size_t i, float* out)
+                    {
+                        StoreMatrix<N>(insightA[i].Transposed(), out);
+                    });
+                runner.Run(name + " Transpose", "GLM", c_Size, transposeReference, [&](const size_t i, float* out)
+                    {
+                        StoreMatrix<N>(glm::transpose(glmA[i]), out);
+                    });
+
+                runner.Run(name + " Transform", "Insight", N, transformReference, [&](const size_t i, float* out)
+                    {
+                        StoreVector<N>(insightA[i] * insightV[i], out);
+                    });
+                runner.Run(name + " Transform", "GLM", N, transformReference, [&](const size_t i, float* out)
+                    {
+                        StoreVector<N>(glmA[i] * glmV[i], out);
+                    });
+
+#ifdef IS_BENCHMARK_DIRECTX_MATHS
+                if constexpr (N == 4)
+                {
+                    // DirectXMath uses row vectors, so with the same memory layout 'lhs * rhs' is
+                    // 'XMMatrixMultiply(rhs, lhs)' and 'm * v' is 'XMVector4Transform(v, m)'.
+                    std::vector<DirectX::XMMATRIX> dxA;
+                    std::vector<DirectX::XMMATRIX> dxB;
+                    std::vector<DirectX::XMVECTOR> dxV;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        dxA.push_back(DirectX::XMLoadFloat4x4(reinterpret_cast<const DirectX::XMFLOAT4X4*>(&a[i * c_Size])));
+                        dxB.push_back(DirectX::XMLoadFloat4x4(reinterpret_cast<const DirectX::XMFLOAT4X4*>(&b[i * c_Size])));
+                        dxV.push_back(DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&v[i * N])));
+                    }
+
+                    runner.Run(name + " Multiply", "DirectXMath", c_Size, multiplyReference, [&](const size_t i, float* out)
+                        {
+                            DirectX::XMStoreFloat4x4(reinterpret_cast<DirectX::XMFLOAT4X4*>(out), DirectX::XMMatrixMultiply(dxB[i], dxA[i]));
+                        });
+                    runner.Run(name + " Inverse", "DirectXMath", c_Size, inverseReference, [&](const size_t i, float* out)
+                        {
+                            DirectX::XMStoreFloat4x4(reinterpret_cast<DirectX::XMFLOAT4X4*>(out), DirectX::XMMatrixInverse(nullptr, dxA[i]));
+                        });
+                    runner.Run(name + " Transpose", "DirectXMath", c_Size, transposeReference, [&](const size_t i, float* out)
+                        {
+                            DirectX::XMStoreFloat4x4(reinterpret_cast<DirectX::XMFLOAT4X4*>(out), DirectX::XMMatrixTranspose(dxA[i]));
+                        });
+                    runner.Run(name + " Transform", "DirectXMath", N, transformReference, [&](const size_t i, float* out)
+                        {
+                            DirectX::XMStoreFloat4(reinterpret_cast<DirectX::XMFLOAT4*>(out), DirectX::XMVector4Transform(dxV[i], dxA[i]));
+                        });
+                }
+#endif
+            }
+        }
+
+        void RunMatrixBenchmarks(BenchmarkRunner& runner)
+        {
+            RunMatrix<2>(runner);
+            RunMatrix<3>(runner);
+            RunMatrix<4>(runner);
+        }
+    }
+}
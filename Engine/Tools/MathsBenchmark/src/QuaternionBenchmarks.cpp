@@ -0,0 +1,161 @@
+#include "BenchmarkRunner.h"
+#include "Reference.h"
+
+#include "Maths/Matrix4.h"
+#include "Maths/Quaternion.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#ifdef IS_BENCHMARK_DIRECTX_MATHS
+#include <DirectXMath.h>
+#endif
+
+namespace Insight
+{
+    namespace MathsBenchmark
+    {
+        namespace
+        {
+            /// @brief 'count' random unit quaternions as w, x, y, z.
+            std::vector<float> RandomQuaternions(BenchmarkRunner& runner, const size_t count)
+            {
+                std::vector<float> values = runner.RandomFloats(count * 4, -1.0f, 1.0f);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    double q[4] = { values[i * 4], values[i * 4 + 1], values[i * 4 + 2], values[i * 4 + 3] };
+                    const double length = std::sqrt(Reference::Dot(q, q, 4));
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        values[i * 4 + k] = static_cast<float>(q[k] / length);
+                    }
+                }
+                return values;
+            }
+
+            void StoreQuaternion(const Maths::Quaternion& q, float* out)
+            {
+                out[0] = q.w;
+                out[1] = q.x;
+                out[2] = q.y;
+                out[3] = q.z;
+            }
+
+            void StoreQuaternion(const glm::quat& q, float* out)
+            {
+                out[0] = q.w;
+                out[1] = q.x;
+                out[2] = q.y;
+                out[3] = q.z;
+            }
+
+#ifdef IS_BENCHMARK_DIRECTX_MATHS
+            void StoreQuaternion(const DirectX::XMVECTOR q, float* out)
+            {
+                DirectX::XMFLOAT4 value;
+                DirectX::XMStoreFloat4(&value, q);
+                out[0] = value.w;
+                out[1] = value.x;
+                out[2] = value.y;
+                out[3] = value.z;
+            }
+#endif
+        }
+
+        void RunQuaternionBenchmarks(BenchmarkRunner& runner)
+        {
+            const size_t count = runner.GetElementCount();
+            const std::vector<float> a = RandomQuaternions(runner, count);
+            const std::vector<float> b = RandomQuaternions(runner, count);
+            const std::vector<float> time = runner.RandomFloats(count, 0.0f, 1.0f);
+
+            const std::vector<double> da = Reference::ToDouble(a);
+            const std::vector<double> db = Reference::ToDouble(b);
+            std::vector<double> multiplyReference(count * 4);
+            std::vector<double> slerpReference(count * 4);
+            std::vector<double> matrixReference(count * 16);
+            for (size_t i = 0; i < count; ++i)
+            {
+                Reference::QuaternionMultiply(&da[i * 4], &db[i * 4], &multiplyReference[i * 4]);
+                Reference::QuaternionSlerp(&da[i * 4], &db[i * 4], time[i], &slerpReference[i * 4]);
+                Reference::QuaternionToMatrix4(&da[i * 4], &matrixReference[i * 16]);
+            }
+
+            std::vector<Maths::Quaternion> insightA;
+            std::vector<Maths::Quaternion> insightB;
+            std::vector<glm::quat> glmA;
+            std::vector<glm::quat> glmB;
+            for (size_t i = 0; i < count; ++i)
+            {
+                insightA.push_back(Maths::Quaternion(a[i * 4], a[i * 4 + 1], a[i * 4 + 2], a[i * 4 + 3]));
+                insightB.push_back(Maths::Quaternion(b[i * 4], b[i * 4 + 1], b[i * 4 + 2], b[i * 4 + 3]));
+                glmA.push_back(glm::quat(a[i * 4], a[i * 4 + 1], a[i * 4 + 2], a[i * 4 + 3]));
+                glmB.push_back(glm::quat(b[i * 4], b[i * 4 + 1], b[i * 4 + 2], b[i * 4 + 3]));
+            }
+
+            runner.Run("Quaternion Multiply", "Insight", 4, multiplyReference, [&](const size_t i, float* out)
+                {
+                    StoreQuaternion(insightA[i] * insightB[i], out);
+                });
+            runner.Run("Quaternion Multiply", "GLM", 4, multiplyReference, [&](const size_t i, float* out)
+                {
+                    StoreQuaternion(glmA[i] * glmB[i], out);
+                });
+
+            runner.Run("Quaternion Slerp", "Insight", 4, slerpReference, [&](const size_t i, float* out)
+                {
+                    StoreQuaternion(insightA[i].Slerp(insightB[i], time[i]), out);
+                });
+            runner.Run("Quaternion Slerp", "GLM", 4, slerpReference, [&](const size_t i, float* out)
+                {
+                    StoreQuaternion(glm::slerp(glmA[i], glmB[i], time[i]), out);
+                });
+
+            runner.Run("Quaternion ToMatrix4", "Insight", 16, matrixReference, [&](const size_t i, float* out)
+                {
+                    const Maths::Matrix4 result(insightA[i]);
+                    for (int row = 0; row < 4; ++row)
+                    {
+                        for (int column = 0; column < 4; ++column)
+                        {
+                            out[row * 4 + column] = result[row][column];
+                        }
+                    }
+                });
+            runner.Run("Quaternion ToMatrix4", "GLM", 16, matrixReference, [&](const size_t i, float* out)
+                {
+                    const glm::mat4 result = glm::mat4_cast(glmA[i]);
+                    for (int row = 0; row < 4; ++row)
+                    {
+                        for (int column = 0; column < 4; ++column)
+                        {
+                            out[row * 4 + column] = result[row][column];
+                        }
+                    }
+                });
+
+#ifdef IS_BENCHMARK_DIRECTX_MATHS
+            // DirectXMath stores x, y, z, w and 'XMQuaternionMultiply(q, p)' returns p * q.
+            std::vector<DirectX::XMVECTOR> dxA;
+            std::vector<DirectX::XMVECTOR> dxB;
+            for (size_t i = 0; i < count; ++i)
+            {
+                dxA.push_back(DirectX::XMVectorSet(a[i * 4 + 1], a[i * 4 + 2], a[i * 4 + 3], a[i * 4]));
+                dxB.push_back(DirectX::XMVectorSet(b[i * 4 + 1], b[i * 4 + 2], b[i * 4 + 3], b[i * 4]));
+            }
+
+            runner.Run("Quaternion Multiply", "DirectXMath", 4, multiplyReference, [&](const size_t i, float* out)
+                {
+                    StoreQuaternion(DirectX::XMQuaternionMultiply(dxB[i], dxA[i]), out);
+                });
+            runner.Run("Quaternion Slerp", "DirectXMath", 4, slerpReference, [&](const size_t i, float* out)
+                {
+                    StoreQuaternion(DirectX::XMQuaternionSlerp(dxA[i], dxB[i], time[i]), out);
+                });
+            runner.Run("Quaternion ToMatrix4", "DirectXMath", 16, matrixReference, [&](const size_t i, float* out)
+                {
+                    DirectX::XMStoreFloat4x4(reinterpret_cast<DirectX::XMFLOAT4X4*>(out), DirectX::XMMatrixRotationQuaternion(dxA[i]));
+                });
+#endif
+        }
+    }
+}
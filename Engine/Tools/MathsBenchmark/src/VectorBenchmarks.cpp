@@ -0,0 +1,229 @@
+#include "BenchmarkRunner.h"
+#include "Reference.h"
+
+#include "Maths/Vector2.h"
+#include "Maths/Vector3.h"
+#include "Maths/Vector4.h"
+
+#include <glm/glm.hpp>
+#ifdef IS_BENCHMARK_DIRECTX_MATHS
+#include <DirectXMath.h>
+#endif
+
+namespace Insight
+{
+    namespace MathsBenchmark
+    {
+        namespace
+        {
+            template<int N>
+            struct VectorTraits;
+
+            template<>
+            struct VectorTraits<2>
+            {
+                using Type = Maths::Vector2;
+                using GlmType = glm::vec2;
+                static constexpr const char* c_Name = "Vector2";
+                static Type Make(const float* v) { return Type(v[0], v[1]); }
+                static GlmType MakeGlm(const float* v) { return GlmType(v[0], v[1]); }
+            };
+
+            template<>
+            struct VectorTraits<3>
+            {
+                using Type = Maths::Vector3;
+                using GlmType = glm::vec3;
+                static constexpr const char* c_Name = "Vector3";
+                static Type Make(const float* v) { return Type(v[0], v[1], v[2]); }
+                static GlmType MakeGlm(const float* v) { return GlmType(v[0], v[1], v[2]); }
+            };
+
+            template<>
+            struct VectorTraits<4>
+            {
+                using Type = Maths::Vector4;
+                using GlmType = glm::vec4;
+                static constexpr const char* c_Name = "Vector4";
+                static Type Make(const float* v) { return Type(v[0], v[1], v[2], v[3]); }
+                static GlmType MakeGlm(const float* v) { return GlmType(v[0], v[1], v[2], v[3]); }
+            };
+
+#ifdef IS_BENCHMARK_DIRECTX_MATHS
+            template<int N>
+            DirectX::XMVECTOR DxDot(const DirectX::XMVECTOR a, const DirectX::XMVECTOR b)
+            {
+                if constexpr (N == 2) { return DirectX::XMVector2Dot(a, b); }
+                else if constexpr (N == 3) { return DirectX::XMVector3Dot(a, b); }
+                else { return DirectX::XMVector4Dot(a, b); }
+            }
+
+            template<int N>
+            DirectX::XMVECTOR DxLength(const DirectX::XMVECTOR v)
+            {
+                if constexpr (N == 2) { return DirectX::XMVector2Length(v); }
+                else if constexpr (N == 3) { return DirectX::XMVector3Length(v); }
+                else { return DirectX::XMVector4Length(v); }
+            }
+
+            template<int N>
+            DirectX::XMVECTOR DxNormalise(const DirectX::XMVECTOR v)
+            {
+                if constexpr (N == 2) { return DirectX::XMVector2Normalize(v); }
+                else if constexpr (N == 3) { return DirectX::XMVector3Normalize(v); }
+                else { return DirectX::XMVector4Normalize(v); }
+            }
+#endif
+
+            template<int N>
+            void RunVector(BenchmarkRunner& runner)
+            {
+                using Traits = VectorTraits<N>;
+                const std::string name = Traits::c_Name;
+                const size_t count = runner.GetElementCount();
+
+                const std::vector<float> a = runner.RandomFloats(count * 4, -10.0f, 10.0f);
+                const std::vector<float> b = runner.RandomFloats(count * 4, -10.0f, 10.0f);
+
+                std::vector<double> dotReference(count);
+                std::vector<double> lengthReference(count);
+                std::vector<double> normalisedReference(count * N);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    double da[4];
+                    double db[4];
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        da[k] = a[i * 4 + k];
+                        db[k] = b[i * 4 + k];
+                    }
+                    dotReference[i] = Reference::Dot(da, db, N);
+                    lengthReference[i] = std::sqrt(Reference::Dot(da, da, N));
+                    for (int k = 0; k < N; ++k)
+                    {
+                        normalisedReference[i * N + k] = da[k] / lengthReference[i];
+                    }
+                }
+
+                std::vector<typename Traits::Type> insightA;
+                std::vector<typename Traits::Type> insightB;
+                std::vector<typename Traits::GlmType> glmA;
+                std::vector<typename Traits::GlmType> glmB;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    insightA.push_back(Traits::Make(&a[i * 4]));
+                    insightB.push_back(Traits::Make(&b[i * 4]));
+                    glmA.push_back(Traits::MakeGlm(&a[i * 4]));
+                    glmB.push_back(Traits::MakeGlm(&b[i * 4]));
+                }
+
+                runner.Run(name + " Dot", "Insight", 1, dotReference, [&](const size_t i, float* out)
+                    {
+                        out[0] = insightA[i].Dot(insightB[i]);
+                    });
+                runner.Run(name + " Dot", "GLM", 1, dotReference, [&](const size_t i, float* out)
+                    {
+                        out[0] = glm::dot(glmA[i], glmB[i]);
+                    });
+
+                runner.Run(name + " Length", "Insight", 1, lengthReference, [&](const size_t i, float* out)
+                    {
+                        out[0] = insightA[i].Length();
+                    });
+                runner.Run(name + " Length", "GLM", 1, lengthReference, [&](const size_t i, float* out)
+                    {
+                        out[0] = glm::length(glmA[i]);
+                    });
+
+                runner.Run(name + " Normalised", "Insight", N, normalisedReference, [&](const size_t i, float* out)
+                    {
+                        const typename Traits::Type result = insightA[i].Normalised();
+                        for (int k = 0; k < N; ++k)
+                        {
+                            out[k] = result[k];
+                        }
+                    });
+                runner.Run(name + " Normalised", "GLM", N, normalisedReference, [&](const size_t i, float* out)
+                    {
+                        const typename Traits::GlmType result = glm::normalize(glmA[i]);
+                        for (int k = 0; k < N; ++k)
+                        {
+                            out[k] = result[k];
+                        }
+                    });
+
+#ifdef IS_BENCHMARK_DIRECTX_MATHS
+                std::vector<DirectX::XMVECTOR> dxA;
+                std::vector<DirectX::XMVECTOR> dxB;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    dxA.push_back(DirectX::XMVectorSet(a[i * 4], a[i * 4 + 1], N > 2 ? a[i * 4 + 2] : 0.0f, N > 3 ? a[i * 4 + 3] : 0.0f));
+                    dxB.push_back(DirectX::XMVectorSet(b[i * 4], b[i * 4 + 1], N > 2 ? b[i * 4 + 2] : 0.0f, N > 3 ? b[i * 4 + 3] : 0.0f));
+                }
+
+                runner.Run(name + " Dot", "DirectXMath", 1, dotReference, [&](const size_t i, float* out)
+                    {
+                        out[0] = DirectX::XMVectorGetX(DxDot<N>(dxA[i], dxB[i]));
+                    });
+                runner.Run(name + " Length", "DirectXMath", 1, lengthReference, [&](const size_t i, float* out)
+                    {
+                        out[0] = DirectX::XMVectorGetX(DxLength<N>(dxA[i]));
+                    });
+                runner.Run(name + " Normalised", "DirectXMath", N, normalisedReference, [&](const size_t i, float* out)
+                    {
+                        DirectX::XMFLOAT4 result;
+                        DirectX::XMStoreFloat4(&result, DxNormalise<N>(dxA[i]));
+                        const float* values = &result.x;
+                        for (int k = 0; k < N; ++k)
+                        {
+                            out[k] = values[k];
+                        }
+                    });
+#endif
+
+                if constexpr (N == 3)
+                {
+                    std::vector<double> crossReference(count * 3);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        const double da[3] = { a[i * 4], a[i * 4 + 1], a[i * 4 + 2] };
+                        const double db[3] = { b[i * 4], b[i * 4 + 1], b[i * 4 + 2] };
+                        Reference::Cross(da, db, &crossReference[i * 3]);
+                    }
+
+                    runner.Run("Vector3 Cross", "Insight", 3, crossReference, [&](const size_t i, float* out)
+                        {
+                            const Maths::Vector3 result = insightA[i].Cross(insightB[i]);
+                            out[0] = result.x;
+                            out[1] = result.y;
+                            out[2] = result.z;
+                        });
+                    runner.Run("Vector3 Cross", "GLM", 3, crossReference, [&](const size_t i, float* out)
+                        {
+                            const glm::vec3 result = glm::cross(glmA[i], glmB[i]);
+                            out[0] = result.x;
+                            out[1] = result.y;
+                            out[2] = result.z;
+                        });
+#ifdef IS_BENCHMARK_DIRECTX_MATHS
+                    runner.Run("Vector3 Cross", "DirectXMath", 3, crossReference, [&](const size_t i, float* out)
+                        {
+                            DirectX::XMFLOAT3 result;
+                            DirectX::XMStoreFloat3(&result, DirectX::XMVector3Cross(dxA[i], dxB[i]));
+                            out[0] = result.x;
+                            out[1] = result.y;
+                            out[2] = result.z;
+                        });
+#endif
+                }
+            }
+        }
+
+        void RunVectorBenchmarks(BenchmarkRunner& runner)
+        {
+            RunVector<2>(runner);
+            RunVector<3>(runner);
+            RunVector<4>(runner);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include "BenchmarkRunner.h"
+
+#include "Maths/Batch.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/// Benchmarks the maths types and reports ns per operation and ulp error against double precision references.
+///
+/// Usage: MathsBenchmark [--output=<path>] [--count=<elements>] [--repetitions=<passes>] [--filter=<operation>]
+///
+/// The Insight maths backend is chosen at compile time (IS_MATHS_DIRECTX_MATHS, IS_MATHS_GLM, IS_MATHS_SIMD), so
+/// generate one build per backend with 'premake5 --maths_backend=<backend>'. GLM and DirectXMath (Windows) are
+/// always run directly alongside the "Insight" results, and the batch functions are run for every instruction set
+/// the CPU supports.
+///
+/// JSON layout:
+/// {
+///     "backend": "Insight", "batchInstructionSet": "AVX2", "elementCount": 4096, "repetitions": 64,
+///     "results": [ { "operation": "Matrix4 Multiply", "implementation": "GLM", "nsPerOp": 3.1, "maxUlp": 2.0, "meanUlp": 0.2 } ]
+/// }
+/// "maxUlp" and "meanUlp" are missing for operations without a reference.
+
+namespace
+{
+    const char* GetMathsBackendName()
+    {
+#if defined(IS_MATHS_DIRECTX_MATHS)
+        return "DirectXMath";
+#elif defined(IS_MATHS_GLM)
+        return "GLM";
+#elif defined(IS_MATHS_SIMD)
+        return "SIMD";
+#else
+        return "Insight";
+#endif
+    }
+
+    bool ParseArgument(const std::string& argument, const char* name, std::string& value)
+    {
+        const std::string prefix = std::string("--") + name + "=";
+        if (argument.compare(0, prefix.size(), prefix) != 0)
+        {
+            return false;
+        }
+        value = argument.substr(prefix.size());
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Insight;
+
+    MathsBenchmark::BenchmarkOptions options;
+    std::string outputPath;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        std::string value;
+        if (ParseArgument(argument, "output", value))
+        {
+            outputPath = value;
+        }
+        else if (ParseArgument(argument, "count", value))
+        {
+            options.ElementCount = std::max<size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+        }
+        else if (ParseArgument(argument, "repetitions", value))
+        {
+            options.Repetitions = std::max<size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+        }
+        else if (ParseArgument(argument, "filter", value))
+        {
+            options.Filter = value;
+        }
+        else
+        {
+            std::cerr << "Unknown argument '" << argument << "'.\n";
+            return 1;
+        }
+    }
+
+    MathsBenchmark::BenchmarkRunner runner(options);
+    MathsBenchmark::RunVectorBenchmarks(runner);
+    MathsBenchmark::RunMatrixBenchmarks(runner);
+    MathsBenchmark::RunQuaternionBenchmarks(runner);
+    MathsBenchmark::RunGeometryBenchmarks(runner);
+    MathsBenchmark::RunBatchBenchmarks(runner);
+
+    const std::string json = runner.ToJson(GetMathsBackendName(), Maths::BatchInstructionSetToString(Maths::Batch::GetInstructionSet()));
+    if (outputPath.empty())
+    {
+        std::cout << json << "\n";
+    }
+    else
+    {
+        std::cout << "Maths backend: " << GetMathsBackendName() << "\n" << runner.ToTable();
+
+        std::ofstream file(outputPath);
+        if (!file.is_open())
+        {
+            std::cerr << "Unable to open '" << outputPath << "' for writing.\n";
+            return 1;
+        }
+        file << json << "\n";
+    }
+
+    return 0;
+}
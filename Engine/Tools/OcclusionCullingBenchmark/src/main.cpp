@@ -0,0 +1,280 @@
+#include "Graphics/OcclusionCulling.h"
+#include "Graphics/RenderCulling.h"
+
+#include "Threading/TaskSystem.h"
+#include "Core/Timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Runs the CPU occlusion culler headless on scene dumps and reports how many occludees are culled and how long each
+/// frame takes.
+///
+/// Usage: OcclusionCullingBenchmark [--iterations=<frames>] [--threads=<workers>] [--resolution=<width>x<height>]
+///                                  [--synthetic=<buildings>] [scene.isoc ...]
+///
+/// Scene dumps are written by the editor's "Dump Occlusion Scene" button or 'OcclusionCulling::RequestSceneDump'.
+/// Without any dumps a synthetic city block scene is generated. '--threads=0' runs everything on the calling thread.
+
+namespace
+{
+    using namespace Insight;
+
+    struct BenchmarkOptions
+    {
+        u32 Iterations = 100;
+        u32 ThreadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        u32 Width = OcclusionBuffer::c_DefaultWidth;
+        u32 Height = OcclusionBuffer::c_DefaultHeight;
+        u32 SyntheticBuildingCount = 400;
+    };
+
+    struct BenchmarkResult
+    {
+        u64 OccluderCount = 0;
+        u64 TriangleCount = 0;
+        u64 OccludeeCount = 0;
+        u64 OccludedCount = 0;
+        double RasteriseMs = 0.0;
+        double TestMs = 0.0;
+        double MinFrameMs = 0.0;
+    };
+
+    bool ParseArgument(const std::string& argument, const char* name, std::string& value)
+    {
+        const std::string prefix = std::string("--") + name + "=";
+        if (argument.compare(0, prefix.size(), prefix) != 0)
+        {
+            return false;
+        }
+        value = argument.substr(prefix.size());
+        return true;
+    }
+
+    OccluderGeometry CreateUnitCube()
+    {
+        OccluderGeometry geometry;
+        for (u32 corner = 0; corner < 8; ++corner)
+        {
+            geometry.Positions.push_back(Maths::Vector3(
+                corner & 1 ? 0.5f : -0.5f,
+                corner & 2 ? 0.5f : -0.5f,
+                corner & 4 ? 0.5f : -0.5f));
+        }
+        geometry.Indices =
+        {
+            0, 2, 1, 1, 2, 3, // -z
+            4, 5, 6, 5, 7, 6, // +z
+            0, 1, 4, 1, 5, 4, // -y
+            2, 6, 3, 3, 6, 7, // +y
+            0, 4, 2, 2, 4, 6, // -x
+            1, 3, 5, 3, 7, 5, // +x
+        };
+        return geometry;
+    }
+
+    /// @brief Street level camera looking down a grid of buildings with props scattered between them.
+    OcclusionScene CreateSyntheticScene(const u32 buildingCount, const u32 width, const u32 height)
+    {
+        constexpr float c_BlockSize = 20.0f;
+        constexpr u32 c_PropsPerBuilding = 40;
+
+        OcclusionScene scene;
+        scene.NearPlane = 0.1f;
+        const Maths::Matrix4 projection = Maths::Matrix4::CreatePerspective(1.0f, static_cast<float>(width) / static_cast<float>(height), scene.NearPlane, 1000.0f);
+        const Maths::Matrix4 view = Maths::Matrix4::LookAt(Maths::Vector3(c_BlockSize * 0.5f, 1.8f, -5.0f), Maths::Vector3(c_BlockSize * 0.7f, 1.5f, 100.0f), Maths::Vector3(0.0f, 1.0f, 0.0f));
+        scene.ProjectionView = projection * view;
+        scene.Geometries.push_back(CreateUnitCube());
+
+        std::mt19937 generator(11);
+        std::uniform_real_distribution<float> buildingSize(8.0f, 16.0f);
+        std::uniform_real_distribution<float> buildingHeight(6.0f, 40.0f);
+        std::uniform_real_distribution<float> propOffset(-c_BlockSize * 0.5f, c_BlockSize * 0.5f);
+        std::uniform_real_distribution<float> propSize(0.2f, 1.5f);
+
+        const u32 gridWidth = std::max(1u, static_cast<u32>(std::sqrt(static_cast<float>(buildingCount))));
+        for (u32 buildingIdx = 0; buildingIdx < buildingCount; ++buildingIdx)
+        {
+            const float centerX = static_cast<float>(buildingIdx % gridWidth) * c_BlockSize - static_cast<float>(gridWidth / 2) * c_BlockSize;
+            const float centerZ = static_cast<float>(buildingIdx / gridWidth) * c_BlockSize;
+            const float size = buildingSize(generator);
+            const float buildingY = buildingHeight(generator);
+
+            OcclusionScene::Occluder occluder;
+            occluder.Transform[0][0] = size;
+            occluder.Transform[1][1] = buildingY;
+            occluder.Transform[2][2] = size;
+            occluder.Transform[3] = Maths::Vector4(centerX, buildingY * 0.5f, centerZ, 1.0f);
+            scene.Occluders.push_back(occluder);
+
+            const Maths::Vector3 buildingExtents(size * 0.5f, buildingY * 0.5f, size * 0.5f);
+            const Maths::Vector3 buildingCenter(centerX, buildingY * 0.5f, centerZ);
+            scene.Occludees.push_back(Graphics::BoundingBox(buildingCenter - buildingExtents, buildingCenter + buildingExtents));
+
+            for (u32 propIdx = 0; propIdx < c_PropsPerBuilding; ++propIdx)
+            {
+                const float propExtent = propSize(generator) * 0.5f;
+                const Maths::Vector3 propCenter(centerX + propOffset(generator), propExtent, centerZ + propOffset(generator));
+                const Maths::Vector3 propExtents(propExtent, propExtent, propExtent);
+                scene.Occludees.push_back(Graphics::BoundingBox(propCenter - propExtents, propCenter + propExtents));
+            }
+        }
+        return scene;
+    }
+
+    BenchmarkResult RunScene(const OcclusionScene& scene, const BenchmarkOptions& options)
+    {
+        std::vector<OccluderInstance> occluders;
+        occluders.reserve(scene.Occluders.size());
+        for (const OcclusionScene::Occluder& occluder : scene.Occluders)
+        {
+            occluders.push_back(OccluderInstance{ &scene.Geometries[occluder.GeometryIndex], occluder.Transform });
+        }
+
+        RenderCullingBounds bounds;
+        bounds.Reserve(scene.Occludees.size());
+        for (const Graphics::BoundingBox& occludee : scene.Occludees)
+        {
+            bounds.Add(occludee);
+        }
+
+        OcclusionBuffer buffer(options.Width, options.Height);
+        std::vector<u32> meshIndexs(scene.Occludees.size());
+
+        BenchmarkResult result;
+        result.OccluderCount = occluders.size();
+        result.OccludeeCount = scene.Occludees.size();
+        result.MinFrameMs = std::numeric_limits<double>::max();
+
+        Core::Timer timer;
+        for (u32 iteration = 0; iteration < options.Iterations; ++iteration)
+        {
+            for (u32 meshIdx = 0; meshIdx < meshIndexs.size(); ++meshIdx)
+            {
+                meshIndexs[meshIdx] = meshIdx;
+            }
+
+            timer.Start();
+            buffer.Begin(scene.ProjectionView, scene.NearPlane);
+            buffer.RenderOccluders(occluders.data(), occluders.size());
+            timer.Stop();
+            const double rasteriseMs = timer.GetElapsedTimeNano().count() / 1'000'000.0;
+
+            timer.Start();
+            const u64 visibleCount = buffer.RemoveOccluded(bounds, meshIndexs.data(), meshIndexs.size());
+            timer.Stop();
+            const double testMs = timer.GetElapsedTimeNano().count() / 1'000'000.0;
+
+            result.RasteriseMs += rasteriseMs;
+            result.TestMs += testMs;
+            result.MinFrameMs = std::min(result.MinFrameMs, rasteriseMs + testMs);
+            result.OccludedCount = result.OccludeeCount - visibleCount;
+        }
+        result.RasteriseMs /= options.Iterations;
+        result.TestMs /= options.Iterations;
+        result.TriangleCount = buffer.GetTriangleCount();
+        return result;
+    }
+
+    void PrintResult(const std::string& name, const BenchmarkResult& result)
+    {
+        const double culledPercent = result.OccludeeCount > 0
+            ? 100.0 * static_cast<double>(result.OccludedCount) / static_cast<double>(result.OccludeeCount)
+            : 0.0;
+        std::printf("%-32s %10llu %10llu %10llu %8.2f%% %10.3f %10.3f %10.3f %10.3f\n",
+            name.c_str(),
+            static_cast<unsigned long long>(result.OccluderCount),
+            static_cast<unsigned long long>(result.TriangleCount),
+            static_cast<unsigned long long>(result.OccludeeCount),
+            culledPercent,
+            result.RasteriseMs,
+            result.TestMs,
+            result.RasteriseMs + result.TestMs,
+            result.MinFrameMs);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    std::vector<std::string> scenePaths;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        std::string value;
+        if (ParseArgument(argument, "iterations", value))
+        {
+            options.Iterations = std::max<u32>(1, static_cast<u32>(std::strtoul(value.c_str(), nullptr, 10)));
+        }
+        else if (ParseArgument(argument, "threads", value))
+        {
+            options.ThreadCount = static_cast<u32>(std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else if (ParseArgument(argument, "resolution", value))
+        {
+            const u64 separator = value.find('x');
+            if (separator == std::string::npos)
+            {
+                std::cerr << "Resolution '" << value << "' should be <width>x<height>.\n";
+                return 1;
+            }
+            options.Width = std::max<u32>(1, static_cast<u32>(std::strtoul(value.substr(0, separator).c_str(), nullptr, 10)));
+            options.Height = std::max<u32>(1, static_cast<u32>(std::strtoul(value.substr(separator + 1).c_str(), nullptr, 10)));
+        }
+        else if (ParseArgument(argument, "synthetic", value))
+        {
+            options.SyntheticBuildingCount = std::max<u32>(1, static_cast<u32>(std::strtoul(value.c_str(), nullptr, 10)));
+        }
+        else if (argument.compare(0, 2, "--") == 0)
+        {
+            std::cerr << "Unknown argument '" << argument << "'.\n";
+            return 1;
+        }
+        else
+        {
+            scenePaths.push_back(argument);
+        }
+    }
+
+    Threading::TaskSystem taskSystem;
+    if (options.ThreadCount > 0)
+    {
+        taskSystem.Initialise(options.ThreadCount);
+    }
+
+    std::printf("Resolution: %ux%u, worker threads: %u, iterations: %u\n", options.Width, options.Height, options.ThreadCount, options.Iterations);
+    std::printf("%-32s %10s %10s %10s %9s %10s %10s %10s %10s\n",
+        "Scene", "Occluders", "Triangles", "Occludees", "Culled", "Raster ms", "Test ms", "Frame ms", "Min ms");
+
+    int exitCode = 0;
+    if (scenePaths.empty())
+    {
+        const OcclusionScene scene = CreateSyntheticScene(options.SyntheticBuildingCount, options.Width, options.Height);
+        PrintResult("Synthetic (" + std::to_string(options.SyntheticBuildingCount) + " buildings)", RunScene(scene, options));
+    }
+    for (const std::string& scenePath : scenePaths)
+    {
+        OcclusionScene scene;
+        if (!scene.Load(scenePath))
+        {
+            std::cerr << "Unable to load occlusion scene '" << scenePath << "'.\n";
+            exitCode = 1;
+            continue;
+        }
+        PrintResult(scenePath, RunScene(scene, options));
+    }
+
+    if (options.ThreadCount > 0)
+    {
+        taskSystem.Shutdown();
+    }
+    return exitCode;
+}